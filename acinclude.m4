@@ -21,3 +21,4 @@ m4_include([config/runldpath.m4])
 m4_include([config/swig.m4])
 m4_include([config/xercesc.m4])
 m4_include([config/zlib.m4])
+m4_include([config/zstd.m4])
@@ -0,0 +1,93 @@
+dnl
+dnl Filename    : zstd.m4
+dnl Description : Autoconf macro to check for existence of zstd library
+dnl Author(s)   : SBML Team <sbml-team@googlegroups.com>
+dnl Organization: California Institute of Technology
+dnl
+dnl <!-------------------------------------------------------------------------
+dnl This file is part of libSBML.  Please visit http://sbml.org for more
+dnl information about SBML, and the latest version of libSBML.
+dnl
+dnl This library is free software; you can redistribute it and/or modify it
+dnl under the terms of the GNU Lesser General Public License as published by
+dnl the Free Software Foundation.  A copy of the license agreement is provided
+dnl in the file named "LICENSE.txt" included with this software distribution
+dnl and also available online as http://sbml.org/software/libsbml/license.html
+dnl --------------------------------------------------------------------- -->*/
+
+dnl
+dnl Unlike zlib and bzip2, zstd is only used when asked for with --with-zstd.
+dnl The streaming interface used needs zstd 1.4.0 or later.
+dnl
+
+AC_DEFUN([CONFIG_LIB_ZSTD],
+[
+  AC_ARG_WITH([zstd],
+    AS_HELP_STRING([--with-zstd@<:@=PREFIX@:>@], 
+	           [enable reading/writing files compressed with zstd @<:@default=no@:>@ ]
+              ),
+    [with_zstd="$withval"], 
+    [with_zstd=no]
+  )
+
+  if test "x$enable_compression" = "xno"; then
+    with_zstd=no
+  fi
+
+  AC_MSG_CHECKING(for zstd library)
+  if test "x$with_zstd" != "xno" ; then
+    AC_MSG_RESULT(yes)
+
+    if test "x$with_zstd" != "xyes"; then
+      if test -d "$with_zstd/lib${LIBSUFFIX}"; then
+        ZSTD_LDFLAGS="-L${with_zstd}/lib${LIBSUFFIX}"
+      elif test -d "$with_zstd/lib"; then
+        ZSTD_LDFLAGS="-L${with_zstd}/lib"
+      else
+        ZSTD_LDFLAGS="-L${with_zstd}"
+      fi
+      if test -d "$with_zstd/include"; then
+        ZSTD_CPPFLAGS="-I${with_zstd}/include"
+      fi
+    fi
+
+    ZSTD_LIBS="-lzstd"
+
+    saved_CPPFLAGS=$CPPFLAGS
+    saved_LDFLAGS=$LDFLAGS
+    saved_LIBS=$LIBS
+
+    CPPFLAGS="${CPPFLAGS} ${ZSTD_CPPFLAGS}"
+    LDFLAGS="${LDFLAGS} ${ZSTD_LDFLAGS}"
+    LIBS="${LIBS} ${ZSTD_LIBS}"
+
+    AC_LINK_IFELSE(
+      [AC_LANG_CALL([], [ZSTD_compressStream2])],
+      [],
+      [AC_MSG_ERROR([*** zstd 1.4.0 or later missing - please install zstd first or check config.log.
+        *** Please run the configure command without the "--with-zstd" option if you
+        *** want to build libSBML without support for zstd compressed SBML file.])]
+    )
+
+    AC_CHECK_HEADER([zstd.h], [],
+      [AC_MSG_ERROR([*** zstd.h missing - please install zstd first or check config.log.])]
+    )
+
+    CPPFLAGS=$saved_CPPFLAGS
+    LDFLAGS=$saved_LDFLAGS
+    LIBS=$saved_LIBS
+
+    AC_DEFINE([USE_ZSTD], 1, [Define to 1 to use the zstd library])
+    AC_SUBST(USE_ZSTD, 1)
+    AC_SUBST(ZSTD_CPPFLAGS)
+    AC_SUBST(ZSTD_LDFLAGS)
+    AC_SUBST(ZSTD_LIBS)
+
+    dnl We record the USE_XXX flag, for later testing in Makefiles.
+
+    LIBSBML_OPTIONS="$LIBSBML_OPTIONS USE_ZSTD"
+  else
+    AC_MSG_RESULT(no)
+    ZSTD_LIBS=""
+  fi
+])
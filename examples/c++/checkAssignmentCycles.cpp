@@ -0,0 +1,170 @@
+/**
+ * @file    checkAssignmentCycles.cpp
+ * @brief   Times the assignment cycle check on a long chain of rules
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Creates a model with a chain of count assignment rules, x1 = x0 + 1,
+ * x2 = x1 + x0, x3 = x2 + x1 and so on.  If cycle is true, three further
+ * rules that form a cycle are added at the end of the chain.
+ */
+SBMLDocument*
+createChain (unsigned int count, bool cycle)
+{
+  SBMLDocument* document = new SBMLDocument(3, 1);
+  Model* model = document->createModel();
+
+  Parameter* p = model->createParameter();
+  p->setId("x0");
+  p->setValue(0);
+  p->setConstant(true);
+
+  for (unsigned int i = 1; i <= count + (cycle ? 3 : 0); ++i)
+  {
+    ostringstream id, formula;
+    id << "x" << i;
+
+    if (cycle && i == count + 1)
+    {
+      // x[count+1] depends on x[count+3], which closes the cycle
+      formula << "x" << (count + 3) << " + x" << (i - 1);
+    }
+    else if (i == 1)
+    {
+      formula << "x0 + 1";
+    }
+    else
+    {
+      formula << "x" << (i - 1) << " + x" << (i - 2);
+    }
+
+    p = model->createParameter();
+    p->setId(id.str());
+    p->setConstant(false);
+
+    AssignmentRule* rule = model->createAssignmentRule();
+    rule->setVariable(id.str());
+    ASTNode* math = SBML_parseL3Formula(formula.str().c_str());
+    rule->setMath(math);
+    delete math;
+  }
+
+  return document;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 2)
+  {
+    cout << endl << "Usage: checkAssignmentCycles [count]" << endl << endl;
+    return 1;
+  }
+
+  unsigned int count = (argc > 1) ? (unsigned int) atol(argv[1]) : 5000;
+  unsigned int failures = 0;
+
+#ifdef __BORLANDC__
+  unsigned long start, stop;
+#else
+  unsigned long long start, stop;
+#endif
+
+  cout << endl;
+  cout << "          assignment rules: " << count << endl;
+
+  for (int cycle = 0; cycle < 2; ++cycle)
+  {
+    SBMLDocument* document = createChain(count, cycle == 1);
+
+    // only the general consistency checks include the cycle detection
+    document->setConsistencyChecks(LIBSBML_CAT_IDENTIFIER_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_MATHML_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_SBO_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_OVERDETERMINED_MODEL, false);
+    document->setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_MODELING_PRACTICE, false);
+
+    start = getCurrentMillis();
+    document->checkConsistency();
+    stop = getCurrentMillis();
+
+    // a three rule cycle is reported once for each pair of rules
+    unsigned int expected = (cycle == 1) ? 3 : 0;
+    unsigned int found = 0;
+    for (unsigned int n = 0; n < document->getNumErrors(); ++n)
+    {
+      if (document->getError(n)->getErrorId() == 20906)
+      {
+        ++found;
+      }
+    }
+    if (found != expected)
+    {
+      ++failures;
+    }
+
+    cout << (cycle == 1 ? "      with cycle " : "   without cycle ")
+         << "time (ms): " << stop - start << endl;
+    cout << "           cycles reported: " << found
+         << " (expected " << expected << ")" << endl;
+
+    delete document;
+  }
+  cout << endl;
+
+  return (failures == 0) ? 0 : 1;
+}
+
+END_C_DECLS
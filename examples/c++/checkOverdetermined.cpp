@@ -0,0 +1,178 @@
+/**
+ * @file    checkOverdetermined.cpp
+ * @brief   Times the overdetermined model check on a chain of algebraic rules
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Adds an algebraic rule with the given formula to the model.
+ */
+void
+addAlgebraicRule (Model* model, const string& formula)
+{
+  AlgebraicRule* rule = model->createAlgebraicRule();
+  ASTNode* math = SBML_parseL3Formula(formula.c_str());
+  rule->setMath(math);
+  delete math;
+}
+
+
+/*
+ * Creates a model with count parameters x1 ... xn and the algebraic rules
+ * x1 + x2, x2 + x3, ..., x[n-1] + xn and x1.  Matching each rule to the
+ * first variable it mentions leaves the last rule unmatched, so the
+ * matching has to be augmented along the whole chain.  If over is true,
+ * an unused parameter and a second rule on x1 are added, which makes the
+ * system overdetermined without having more equations than variables.
+ */
+SBMLDocument*
+createChain (unsigned int count, bool over)
+{
+  SBMLDocument* document = new SBMLDocument(3, 1);
+  Model* model = document->createModel();
+
+  for (unsigned int i = 1; i <= count; ++i)
+  {
+    ostringstream id, formula;
+    id << "x" << i;
+
+    Parameter* p = model->createParameter();
+    p->setId(id.str());
+    p->setValue(0);
+    p->setConstant(false);
+
+    if (i < count)
+    {
+      formula << "x" << i << " + x" << (i + 1);
+      addAlgebraicRule(model, formula.str());
+    }
+  }
+  addAlgebraicRule(model, "x1");
+
+  if (over)
+  {
+    Parameter* p = model->createParameter();
+    p->setId("y");
+    p->setValue(0);
+    p->setConstant(false);
+
+    addAlgebraicRule(model, "x1");
+  }
+
+  return document;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 2)
+  {
+    cout << endl << "Usage: checkOverdetermined [count]" << endl << endl;
+    return 1;
+  }
+
+  unsigned int count = (argc > 1) ? (unsigned int) atol(argv[1]) : 5000;
+  unsigned int failures = 0;
+
+#ifdef __BORLANDC__
+  unsigned long start, stop;
+#else
+  unsigned long long start, stop;
+#endif
+
+  cout << endl;
+  cout << "           algebraic rules: " << count << endl;
+
+  for (int over = 0; over < 2; ++over)
+  {
+    SBMLDocument* document = createChain(count, over == 1);
+
+    // only run the overdetermined model check
+    document->setConsistencyChecks(LIBSBML_CAT_GENERAL_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_IDENTIFIER_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_MATHML_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_SBO_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_MODELING_PRACTICE, false);
+
+    start = getCurrentMillis();
+    document->checkConsistency();
+    stop = getCurrentMillis();
+
+    bool expected = (over == 1);
+    bool found = false;
+    for (unsigned int n = 0; n < document->getNumErrors(); ++n)
+    {
+      if (document->getError(n)->getErrorId() == OverdeterminedSystem)
+      {
+        found = true;
+      }
+    }
+    if (found != expected)
+    {
+      ++failures;
+    }
+
+    cout << (over == 1 ? "  overdetermined " : "         matched ")
+         << "time (ms): " << stop - start << endl;
+    cout << "            overdetermined: " << (found ? "yes" : "no")
+         << " (expected " << (expected ? "yes" : "no") << ")" << endl;
+
+    delete document;
+  }
+  cout << endl;
+
+  return (failures == 0) ? 0 : 1;
+}
+
+END_C_DECLS
@@ -0,0 +1,185 @@
+/**
+ * @file    compareChunkSizes.cpp
+ * @brief   Times reading an SBML file with different parser chunk sizes
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/xml/XMLInputStream.h>
+#include <sbml/xml/XMLParser.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Pulls every token of filename from an XMLInputStream that reads
+ * chunkSize bytes at a time, repeats times, and returns the fastest time
+ * in milliseconds.
+ */
+millis_t
+timeTokens (const char* filename, unsigned int chunkSize,
+            unsigned int repeats, unsigned long& tokens)
+{
+  millis_t best = 0;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    tokens = 0;
+
+    millis_t start = getCurrentMillis();
+    XMLInputStream stream(filename, true, "", NULL, false, chunkSize);
+    while (stream.isGood())
+    {
+      stream.next();
+      ++tokens;
+    }
+    millis_t stop  = getCurrentMillis();
+
+    if (i == 0 || stop - start < best)
+    {
+      best = stop - start;
+    }
+  }
+
+  return best;
+}
+
+
+/*
+ * Reads filename as SBML with the given chunk size repeats times and
+ * returns the fastest time in milliseconds.
+ */
+millis_t
+timeRead (const char* filename, unsigned int chunkSize, unsigned int repeats)
+{
+  SBMLReader reader;
+  reader.setChunkSize(chunkSize);
+
+  millis_t best = 0;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    millis_t start = getCurrentMillis();
+    SBMLDocument* doc = reader.readSBML(filename);
+    millis_t stop  = getCurrentMillis();
+
+    delete doc;
+
+    if (i == 0 || stop - start < best)
+    {
+      best = stop - start;
+    }
+  }
+
+  return best;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc < 2 || argc > 3)
+  {
+    cout << endl << "Usage: compareChunkSizes filename [repeats]"
+         << endl << endl;
+    return 1;
+  }
+
+  const char*  filename = argv[1];
+  unsigned int repeats  = (argc > 2) ? (unsigned int) atol(argv[2]) : 3;
+
+  if (repeats == 0) repeats = 1;
+
+  unsigned long size     = getFileSize(filename);
+  unsigned int  adaptive = XMLParser::getAdaptiveChunkSize(size);
+
+  cout << endl;
+  cout << "                 filename: " << filename << endl;
+  cout << "        file size (bytes): " << size << endl;
+  cout << "        repeats (best of): " << repeats << endl;
+  cout << "      adaptive chunk (kB): " << adaptive / 1024 << endl;
+  cout << endl;
+  cout << "  chunk (kB)   tokens (ms)   readSBML (ms)" << endl;
+
+  // 0 is the adaptive chunk size
+  const unsigned int sizes[] = { 4096, 8192, 16384, 65536, 262144, 1048576, 0 };
+  unsigned long      expected = 0;
+  unsigned int       failures = 0;
+
+  for (unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+  {
+    unsigned long tokens = 0;
+
+    millis_t tokenTime = timeTokens(filename, sizes[i], repeats, tokens);
+    millis_t readTime  = timeRead(filename, sizes[i], repeats);
+
+    // the chunk size must not change what is read
+    if (i == 0)
+    {
+      expected = tokens;
+    }
+    else if (tokens != expected)
+    {
+      ++failures;
+    }
+
+    if (sizes[i] == 0)
+    {
+      cout << "    adaptive";
+    }
+    else
+    {
+      cout << setw(12) << sizes[i] / 1024;
+    }
+    cout << setw(14) << tokenTime << setw(16) << readTime << endl;
+  }
+  cout << endl;
+
+  return (failures == 0) ? 0 : 1;
+}
+
+END_C_DECLS
@@ -0,0 +1,163 @@
+/**
+ * @file    compareCompressedReads.cpp
+ * @brief   Times reading a large model from uncompressed and compressed files
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ */
+millis_t
+timeRead (const string& filename, unsigned int repeats, bool& ok)
+{
+  millis_t best = 0;
+
+  ok = true;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    millis_t start = getCurrentMillis();
+
+    SBMLDocument* doc = readSBML(filename.c_str());
+
+    millis_t stop = getCurrentMillis();
+
+    ok = ok && doc->getNumErrors() == 0 && doc->getModel() != NULL;
+    delete doc;
+
+    if (i == 0 || stop - start < best)
+    {
+      best = stop - start;
+    }
+  }
+
+  return best;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 3)
+  {
+    cout << endl << "Usage: compareCompressedReads [size [repeats]]"
+         << endl << endl;
+    return 1;
+  }
+
+  unsigned int size    = (argc > 1) ? (unsigned int) atol(argv[1]) : 100000;
+  unsigned int repeats = (argc > 2) ? (unsigned int) atol(argv[2]) : 3;
+
+  if (repeats == 0) repeats = 1;
+
+  const char* labels[]    = { ".xml", ".xml.gz", ".xml.bz2", ".xml.zst" };
+  const bool  available[] = { true, SBMLReader::hasZlib(),
+                              SBMLReader::hasBzip2(), SBMLReader::hasZstd() };
+  const unsigned int count = sizeof(labels) / sizeof(labels[0]);
+
+  SBMLDocument* doc = createSampleModel(size, SAMPLE_PARAMETERS);
+  SBMLWriter    writer;
+  millis_t      plain  = 0;
+  int           status = 0;
+
+  cout << endl;
+  cout << "   parameters and species: " << size << " each" << endl;
+  cout << "        repeats (best of): " << repeats << endl << endl;
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    string filename = string("compareCompressedReads") + labels[i];
+
+    cout.width(25);
+    cout << labels[i] << ": ";
+
+    if (!available[i])
+    {
+      cout << "not supported by this copy of libSBML" << endl;
+      continue;
+    }
+
+    if (!writer.writeSBML(doc, filename))
+    {
+      cout << "Error: writing " << filename << " failed." << endl;
+      status = 1;
+      continue;
+    }
+
+    bool     ok     = false;
+    millis_t millis = timeRead(filename, repeats, ok);
+
+    if (!ok)
+    {
+      cout << "Error: reading " << filename << " failed." << endl;
+      status = 1;
+    }
+
+    if (i == 0) plain = millis;
+
+    cout << millis << " ms, " << getFileSize(filename.c_str()) << " bytes";
+    if (i > 0 && millis >= plain)
+    {
+      cout << ", " << (millis - plain) << " ms decompressing";
+    }
+    cout << endl;
+
+    remove(filename.c_str());
+  }
+
+  cout << endl;
+
+  delete doc;
+
+  return status;
+}
+
+END_C_DECLS
@@ -0,0 +1,218 @@
+/**
+ * @file    compareDeferredAnnotations.cpp
+ * @brief   Compares reading annotated models with and without deferral
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <cstdio>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+/*
+ * Every operator new in the program, including those made inside libSBML,
+ * goes through the replacements below, which keep the number of bytes in
+ * use in a header in front of each block.
+ */
+static size_t bytesInUse = 0;
+
+static const size_t header = 16;
+
+
+void*
+operator new (size_t size)
+{
+  char* p = (char*) malloc(size + header);
+  if (p == NULL) throw std::bad_alloc();
+
+  *(size_t*) p = size;
+  bytesInUse += size;
+
+  return p + header;
+}
+
+
+void*
+operator new[] (size_t size)
+{
+  return operator new(size);
+}
+
+
+void
+operator delete (void* p) throw()
+{
+  if (p == NULL) return;
+
+  char* block = (char*) p - header;
+  bytesInUse -= *(size_t*) block;
+  free(block);
+}
+
+
+void
+operator delete[] (void* p) throw()
+{
+  operator delete(p);
+}
+
+
+BEGIN_C_DECLS
+
+/*
+ * Reads filename repeats times and returns the best time; memory is set
+ * to the number of bytes the document holds.  If touch is true, the
+ * CVTerms of all species are used after each read and included in the
+ * time.
+ */
+millis_t
+timeRead (const string& filename, bool defer, bool touch,
+          unsigned int repeats, size_t& memory, bool& ok)
+{
+  SBMLReader reader;
+  reader.setDeferAnnotations(defer);
+
+  millis_t best = 0;
+
+  ok = true;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    size_t   before = bytesInUse;
+    millis_t start  = getCurrentMillis();
+
+    SBMLDocument* doc   = reader.readSBML(filename);
+    unsigned int  terms = 0;
+
+    if (touch && doc->getModel() != NULL)
+    {
+      for (unsigned int n = 0; n < doc->getModel()->getNumSpecies(); ++n)
+      {
+        terms += doc->getModel()->getSpecies(n)->getNumCVTerms();
+      }
+    }
+
+    millis_t stop = getCurrentMillis();
+
+    memory = bytesInUse - before;
+
+    ok = ok && doc->getNumErrors() == 0 && doc->getModel() != NULL
+            && (!touch || terms == 2 * doc->getModel()->getNumSpecies());
+    delete doc;
+
+    if (i == 0 || stop - start < best)
+    {
+      best = stop - start;
+    }
+  }
+
+  return best;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 3)
+  {
+    cout << endl << "Usage: compareDeferredAnnotations [size [repeats]]"
+         << endl << endl;
+    return 1;
+  }
+
+  unsigned int size    = (argc > 1) ? (unsigned int) atol(argv[1]) : 20000;
+  unsigned int repeats = (argc > 2) ? (unsigned int) atol(argv[2]) : 3;
+
+  if (repeats == 0) repeats = 1;
+
+  const char* filename = "compareDeferredAnnotations.xml";
+
+  SBMLDocument* doc = createSampleModel(size, SAMPLE_ANNOTATIONS);
+  bool written = writeSBML(doc, filename) != 0;
+  delete doc;
+
+  if (!written)
+  {
+    cout << "Error: writing " << filename << " failed." << endl;
+    return 1;
+  }
+
+  const char* labels[] = { "read in full", "deferred",
+                           "full, using CVTerms", "deferred, using CVTerms" };
+  int status = 0;
+
+  cout << endl;
+  cout << "        annotated species: " << size << endl;
+  cout << "        file size (bytes): " << getFileSize(filename) << endl;
+  cout << "        repeats (best of): " << repeats << endl << endl;
+
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    bool     ok     = false;
+    size_t   memory = 0;
+    millis_t millis = timeRead(filename, (i % 2) == 1, i >= 2, repeats,
+                               memory, ok);
+
+    if (!ok)
+    {
+      cout << "Error: reading " << filename << " failed." << endl;
+      status = 1;
+    }
+
+    cout.width(25);
+    cout << labels[i] << ": " << millis << " ms, "
+         << memory / 1024 << " KB held by the document" << endl;
+  }
+
+  cout << endl;
+
+  remove(filename);
+
+  return status;
+}
+
+END_C_DECLS
@@ -0,0 +1,182 @@
+/**
+ * @file    compareSkippedElements.cpp
+ * @brief   Compares reading whole models with reading parts of them
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+BEGIN_C_DECLS
+
+/*
+ * Reads filename with reader repeats times and returns the best time; ok
+ * is set to false if a read logs an error or lacks the model.
+ */
+millis_t
+timeRead (SBMLReader& reader, const string& filename, unsigned int repeats,
+          unsigned int& objects, bool& ok)
+{
+  millis_t best = 0;
+
+  ok = true;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    millis_t start = getCurrentMillis();
+
+    SBMLDocument* doc = reader.readSBML(filename);
+
+    millis_t stop = getCurrentMillis();
+
+    ok = ok && doc->getModel() != NULL
+            && doc->getNumErrors(LIBSBML_SEV_ERROR) == 0;
+
+    objects = 0;
+    if (doc->getModel() != NULL)
+    {
+      List* all = doc->getModel()->getAllElements();
+      objects = all->getSize();
+      delete all;
+    }
+
+    delete doc;
+
+    if (i == 0 || stop - start < best)
+    {
+      best = stop - start;
+    }
+  }
+
+  return best;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 3)
+  {
+    cout << endl << "Usage: compareSkippedElements [size [repeats]]"
+         << endl << endl;
+    return 1;
+  }
+
+  unsigned int size    = (argc > 1) ? (unsigned int) atol(argv[1]) : 20000;
+  unsigned int repeats = (argc > 2) ? (unsigned int) atol(argv[2]) : 3;
+
+  if (repeats == 0) repeats = 1;
+
+  const char* filename = "compareSkippedElements.xml";
+
+  SBMLDocument* doc =
+    createSampleModel(size, SAMPLE_ANNOTATIONS | SAMPLE_REACTIONS);
+  bool written = writeSBML(doc, filename) != 0;
+  delete doc;
+
+  if (!written)
+  {
+    cout << "Error: writing " << filename << " failed." << endl;
+    return 1;
+  }
+
+  const char* labels[] = { "read in full", "species only",
+                           "stoichiometry only", "no notes or annotations" };
+  int status = 0;
+
+  cout << endl;
+  cout << "      species & reactions: " << size << endl;
+  cout << "        file size (bytes): " << getFileSize(filename) << endl;
+  cout << "        repeats (best of): " << repeats << endl << endl;
+
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    SBMLReader reader;
+
+    switch (i)
+    {
+    case 1:
+      reader.addSkippedElement("listOfReactions");
+      reader.addSkippedElement("notes");
+      reader.addSkippedElement("annotation");
+      break;
+    case 2:
+      reader.addSkippedElement("listOfSpecies");
+      reader.addSkippedElement("kineticLaw");
+      break;
+    case 3:
+      reader.addSkippedElement("notes");
+      reader.addSkippedElement("annotation");
+      break;
+    default:
+      break;
+    }
+
+    bool         ok      = false;
+    unsigned int objects = 0;
+    millis_t     millis  = timeRead(reader, filename, repeats, objects, ok);
+
+    if (!ok)
+    {
+      cout << "Error: reading " << filename << " failed." << endl;
+      status = 1;
+    }
+
+    cout.width(25);
+    cout << labels[i] << ": " << millis << " ms, "
+         << objects << " objects" << endl;
+  }
+
+  cout << endl;
+
+  remove(filename);
+
+  return status;
+}
+
+END_C_DECLS
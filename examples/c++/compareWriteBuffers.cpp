@@ -0,0 +1,167 @@
+/**
+ * @file    compareWriteBuffers.cpp
+ * @brief   Times writing a large model to a file through buffers of several sizes
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Writes doc to filename repeats times and returns the fastest time in
+ * milliseconds.  If bufferSize is negative, the document is written
+ * through a std::ofstream, as SBMLWriter used to write files; otherwise
+ * SBMLWriter writes the file through a buffer of that size.
+ */
+millis_t
+timeWrite (const SBMLDocument* doc, const string& filename,
+           long bufferSize, unsigned int repeats, bool& ok)
+{
+  SBMLWriter writer;
+  millis_t   best = 0;
+
+  if (bufferSize >= 0) writer.setBufferSize((unsigned int) bufferSize);
+
+  ok = true;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    millis_t start = getCurrentMillis();
+
+    if (bufferSize < 0)
+    {
+      ofstream stream(filename.c_str());
+      ok = writer.writeSBML(doc, stream) && ok;
+    }
+    else
+    {
+      ok = writer.writeSBML(doc, filename) && ok;
+    }
+
+    millis_t stop = getCurrentMillis();
+
+    if (i == 0 || stop - start < best)
+    {
+      best = stop - start;
+    }
+  }
+
+  return best;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 4)
+  {
+    cout << endl << "Usage: compareWriteBuffers [size [repeats [filename]]]"
+         << endl << endl;
+    return 1;
+  }
+
+  unsigned int size     = (argc > 1) ? (unsigned int) atol(argv[1]) : 100000;
+  unsigned int repeats  = (argc > 2) ? (unsigned int) atol(argv[2]) : 3;
+  string       filename = (argc > 3) ? argv[3] : "compareWriteBuffers.xml";
+
+  if (repeats == 0) repeats = 1;
+
+  const char* labels[] = { "std::ofstream", "8 KB", "64 KB",
+                           "256 KB (default)", "1 MB", "4 MB" };
+  const long  sizes[]  = { -1, 8192, 65536, 0, 1048576, 4194304 };
+  const unsigned int count = sizeof(sizes) / sizeof(sizes[0]);
+
+  SBMLDocument* doc = createSampleModel(size, SAMPLE_PARAMETERS);
+
+  unsigned long bytes  = 0;
+  int                status = 0;
+
+  cout << endl;
+  cout << "   parameters and species: " << size << " each" << endl;
+  cout << "        repeats (best of): " << repeats << endl;
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    bool     ok     = false;
+    millis_t millis = timeWrite(doc, filename, sizes[i], repeats, ok);
+
+    unsigned long written = getFileSize(filename.c_str());
+
+    if (i == 0)
+    {
+      bytes = written;
+      cout << "    document size (bytes): " << bytes << endl << endl;
+    }
+
+    if (!ok || written != bytes)
+    {
+      cout << "Error: writing " << filename << " through a buffer of "
+           << labels[i] << " failed." << endl;
+      status = 1;
+    }
+
+    cout.width(25);
+    cout << labels[i] << ": " << millis << " ms";
+    if (millis > 0)
+    {
+      cout << ", " << (bytes / 1048576.0) / (millis / 1000.0) << " MB/s";
+    }
+    cout << endl;
+  }
+
+  cout << endl;
+
+  remove(filename.c_str());
+  delete doc;
+
+  return status;
+}
+
+END_C_DECLS
@@ -0,0 +1,169 @@
+/**
+ * @file    countAllocations.cpp
+ * @brief   Counts the heap allocations made while reading an SBML file
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <new>
+#include <string>
+
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/xml/XMLInputStream.h>
+#include <sbml/xml/XMLToken.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+/*
+ * Every operator new in the program, including those made inside libSBML,
+ * goes through the replacements below and bumps this counter.
+ */
+static unsigned long allocations = 0;
+
+
+void*
+operator new (size_t size)
+{
+  ++allocations;
+
+  void* p = malloc(size == 0 ? 1 : size);
+  if (p == NULL) throw std::bad_alloc();
+
+  return p;
+}
+
+
+void*
+operator new[] (size_t size)
+{
+  return operator new(size);
+}
+
+
+void
+operator delete (void* p) throw()
+{
+  free(p);
+}
+
+
+void
+operator delete[] (void* p) throw()
+{
+  free(p);
+}
+
+
+/*
+ * Pulls every token of filename from an XMLInputStream and returns the
+ * number of allocations made; tokens is set to the number of tokens read.
+ */
+unsigned long
+countTokens (const char* filename, unsigned long& tokens)
+{
+  tokens = 0;
+
+  unsigned long before = allocations;
+  {
+    XMLInputStream stream(filename);
+    while (stream.isGood())
+    {
+      XMLToken token = stream.next();
+      ++tokens;
+    }
+  }
+
+  return allocations - before;
+}
+
+
+/*
+ * Reads filename as SBML and returns the number of allocations made.
+ */
+unsigned long
+countRead (const char* filename, unsigned int& errors)
+{
+  unsigned long before = allocations;
+
+  SBMLDocument* doc = readSBML(filename);
+  errors = doc->getNumErrors();
+  delete doc;
+
+  return allocations - before;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    cout << endl << "Usage: countAllocations filename" << endl << endl;
+    return 1;
+  }
+
+  const char* filename = argv[1];
+
+  // the first pass fills the parser's and libSBML's one-time tables, so
+  // only the second pass is reported
+  unsigned long tokens = 0;
+  unsigned int  errors = 0;
+  countTokens(filename, tokens);
+  countRead(filename, errors);
+
+  unsigned long tokenAllocs = countTokens(filename, tokens);
+  unsigned long readAllocs  = countRead(filename, errors);
+
+  cout << endl;
+  cout << "                 filename: " << filename << endl;
+  cout << "        file size (bytes): " << getFileSize(filename) << endl;
+  cout << "                   tokens: " << tokens << endl;
+  cout << "     allocations (tokens): " << tokenAllocs << endl;
+  cout << "    allocations per token: "
+       << (tokens > 0 ? (double) tokenAllocs / tokens : 0.0) << endl;
+  cout << "   allocations (readSBML): " << readAllocs << endl;
+  cout << "                   errors: " << errors << endl;
+  cout << endl;
+
+  return (tokens > 0) ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file    evaluateMath.cpp
+ * @brief   Compares the speed of the ways of evaluating an expression
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/SBMLTransforms.h>
+#include <sbml/math/CompiledMath.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 3)
+  {
+    cout << endl << "Usage: evaluateMath [formula [count]]" << endl << endl;
+    return 1;
+  }
+
+  const char* formula = (argc > 1) ? argv[1]
+    : "Vmax * S / (Km + S) * piecewise(exp(-k * S), S > 0.5, 1) + pow(S, h)";
+  size_t count = (argc > 2) ? (size_t) atol(argv[2]) : 200000;
+
+  ASTNode* math = SBML_parseL3Formula(formula);
+  if (math == NULL)
+  {
+    cerr << SBML_getLastParseL3Error() << endl;
+    return 1;
+  }
+
+  CompiledMath compiled(math);
+  unsigned int numSymbols = compiled.getNumSymbols();
+
+  // one column of values per symbol
+  vector< vector<double> > values(numSymbols, vector<double>(count));
+  vector<const double*> columns(numSymbols);
+  for (unsigned int n = 0; n < numSymbols; ++n)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      values[n][i] = 0.1 + (double)((i * (n + 7)) % 1000) / 1000.0;
+    }
+    columns[n] = &values[n][0];
+  }
+
+  vector<double> tree(count), scalar(count), batch(count);
+  map<string, double> named;
+
+#ifdef __BORLANDC__
+  unsigned long start, stop;
+#else
+  unsigned long long start, stop;
+#endif
+
+  start = getCurrentMillis();
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (unsigned int n = 0; n < numSymbols; ++n)
+    {
+      named[compiled.getSymbol(n)] = values[n][i];
+    }
+    tree[i] = SBMLTransforms::evaluateASTNode(math, named);
+  }
+  stop = getCurrentMillis();
+  unsigned long long treeTime = stop - start;
+
+  vector<double> row(numSymbols + 1);
+  start = getCurrentMillis();
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (unsigned int n = 0; n < numSymbols; ++n)
+    {
+      row[n] = values[n][i];
+    }
+    scalar[i] = compiled.evaluate(&row[0]);
+  }
+  stop = getCurrentMillis();
+  unsigned long long scalarTime = stop - start;
+
+  start = getCurrentMillis();
+  compiled.evaluate(numSymbols > 0 ? &columns[0] : NULL, count, &batch[0]);
+  stop = getCurrentMillis();
+  unsigned long long batchTime = stop - start;
+
+  unsigned int mismatches = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    double a = tree[i];
+    double b = batch[i];
+    if (!(a == b || (a != a && b != b) || fabs(a - b) <= 1e-12 * fabs(a)))
+    {
+      ++mismatches;
+    }
+  }
+
+  cout << endl;
+  cout << "                   formula: " << formula    << endl;
+  cout << "                value sets: " << count      << endl;
+  cout << " evaluateASTNode time (ms): " << treeTime   << endl;
+  cout << "    CompiledMath time (ms): " << scalarTime << endl;
+  cout << "  batch evaluate time (ms): " << batchTime  << endl;
+  cout << "       differing result(s): " << mismatches << endl;
+  cout << endl;
+
+  delete math;
+  return (mismatches == 0) ? 0 : 1;
+}
+
+END_C_DECLS
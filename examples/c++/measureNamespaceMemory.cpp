@@ -0,0 +1,230 @@
+/**
+ * @file    measureNamespaceMemory.cpp
+ * @brief   Reports the memory used by the documents of a large model
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <cstdio>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+/*
+ * Every operator new in the program, including those made inside libSBML,
+ * goes through the replacements below, which count the allocations and
+ * the bytes in use.  Each block starts with a header holding its size; the
+ * header is as large as the alignment malloc() guarantees.
+ */
+static unsigned long allocations = 0;
+static size_t        bytesInUse  = 0;
+
+static const size_t HEADER_SIZE = 16;
+
+
+void*
+operator new (size_t size)
+{
+  char* p = static_cast<char*>(malloc(size + HEADER_SIZE));
+  if (p == NULL) throw std::bad_alloc();
+
+  ++allocations;
+  bytesInUse += size;
+
+  *reinterpret_cast<size_t*>(p) = size;
+  return p + HEADER_SIZE;
+}
+
+
+void*
+operator new[] (size_t size)
+{
+  return operator new(size);
+}
+
+
+void
+operator delete (void* p) throw()
+{
+  if (p == NULL) return;
+
+  char* base = static_cast<char*>(p) - HEADER_SIZE;
+  bytesInUse -= *reinterpret_cast<size_t*>(base);
+  free(base);
+}
+
+
+void
+operator delete[] (void* p) throw()
+{
+  operator delete(p);
+}
+
+
+BEGIN_C_DECLS
+
+/*
+ * The allocations and bytes still in use after some step, counted from
+ * the start of the step.
+ */
+struct MemoryCosts
+{
+  millis_t      millis;
+  unsigned long allocations;
+  size_t        heldBytes;
+};
+
+
+/*
+ * Starts counting the costs of a step.
+ */
+void
+startStep (MemoryCosts& costs, unsigned long& allocsBefore,
+           size_t& bytesBefore)
+{
+  allocsBefore = allocations;
+  bytesBefore  = bytesInUse;
+  costs.millis = getCurrentMillis();
+}
+
+
+/*
+ * Finishes counting the costs of a step.
+ */
+void
+endStep (MemoryCosts& costs, unsigned long allocsBefore, size_t bytesBefore)
+{
+  costs.millis      = getCurrentMillis() - costs.millis;
+  costs.allocations = allocations - allocsBefore;
+  costs.heldBytes   = bytesInUse - bytesBefore;
+}
+
+
+/*
+ * Prints the costs of one step, with the bytes held per element.
+ */
+void
+printCosts (const char* label, const MemoryCosts& costs,
+            unsigned int elements)
+{
+  cout << label << endl;
+  cout.width(25);
+  cout << "time" << ": " << costs.millis << " ms" << endl;
+  cout.width(25);
+  cout << "allocations" << ": " << costs.allocations << endl;
+  cout.width(25);
+  cout << "bytes held" << ": " << costs.heldBytes << endl;
+  cout.width(25);
+  cout << "bytes held per element" << ": "
+       << (elements > 0 ? costs.heldBytes / elements : 0) << endl;
+  cout << endl;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 2)
+  {
+    cout << endl << "Usage: measureNamespaceMemory [size]" << endl << endl;
+    return 1;
+  }
+
+  unsigned int size = (argc > 1) ? (unsigned int) atol(argv[1]) : 20000;
+
+  const char* filename = "measureNamespaceMemory.xml";
+
+  SBMLDocument* doc =
+    createSampleModel(size, SAMPLE_ANNOTATIONS | SAMPLE_REACTIONS);
+  bool written = SBMLWriter().writeSBML(doc, filename);
+  delete doc;
+
+  if (!written)
+  {
+    cout << "Error: writing " << filename << " failed." << endl;
+    return 1;
+  }
+
+  MemoryCosts   read, clone;
+  unsigned long allocsBefore;
+  size_t        bytesBefore;
+
+  startStep(read, allocsBefore, bytesBefore);
+  doc = readSBML(filename);
+  endStep(read, allocsBefore, bytesBefore);
+
+  List*        all      = doc->getAllElements();
+  unsigned int elements = all->getSize();
+  delete all;
+
+  startStep(clone, allocsBefore, bytesBefore);
+  SBMLDocument* copy = doc->clone();
+  endStep(clone, allocsBefore, bytesBefore);
+
+  cout << endl;
+  cout << "      species & reactions: " << size << endl;
+  cout << "        file size (bytes): " << getFileSize(filename) << endl;
+  cout << "                 elements: " << elements << endl << endl;
+
+  printCosts("readSBML:", read, elements);
+  printCosts("clone:", clone, elements);
+
+  int status = 0;
+
+  if (writeSBMLToStdString(doc) != writeSBMLToStdString(copy))
+  {
+    cout << "Error: the document and its clone differ." << endl << endl;
+    status = 1;
+  }
+
+  delete copy;
+  delete doc;
+  remove(filename);
+
+  return status;
+}
+
+END_C_DECLS
@@ -0,0 +1,154 @@
+/**
+ * @file    parseL3Formulas.cpp
+ * @brief   Measures the throughput of the L3 formula parser in several threads
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <vector>
+
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#include <thread>
+#define HAVE_STD_THREAD 1
+#endif
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+static const char* formulas[] =
+{
+  "Vmax * S / (Km + S)",
+  "k1 * A * B - k2 * C",
+  "piecewise(kf * S^h / (K^h + S^h), S > 0, 0)",
+  "compartment * (kcat * E * S / (Km * (1 + I / Ki) + S))",
+  "exp(-Ea / (R * T)) * A0 * pow(X, 2)"
+};
+static const size_t numFormulas = sizeof(formulas) / sizeof(formulas[0]);
+
+
+/*
+ * Parses count formulas, cycling through the list, and returns the number
+ * that could not be parsed.
+ */
+static void
+parseFormulas (size_t count, size_t* failures)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    ASTNode* math = SBML_parseL3Formula(formulas[i % numFormulas]);
+    if (math == NULL)
+    {
+      ++(*failures);
+    }
+    delete math;
+  }
+}
+
+
+BEGIN_C_DECLS
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 3)
+  {
+    cout << endl << "Usage: parseL3Formulas [count [threads]]" << endl << endl;
+    return 1;
+  }
+
+  size_t count = (argc > 1) ? (size_t) atol(argv[1]) : 200000;
+  size_t numThreads = (argc > 2) ? (size_t) atol(argv[2]) : 4;
+  if (numThreads == 0)
+  {
+    numThreads = 1;
+  }
+
+#ifdef __BORLANDC__
+  unsigned long start, stop;
+#else
+  unsigned long long start, stop;
+#endif
+
+  size_t failures = 0;
+
+  start = getCurrentMillis();
+  parseFormulas(count, &failures);
+  stop = getCurrentMillis();
+  unsigned long long serialTime = stop - start;
+
+#ifdef HAVE_STD_THREAD
+  vector<size_t> threadFailures(numThreads, 0);
+  vector<thread> threads;
+
+  start = getCurrentMillis();
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    size_t share = count / numThreads + (t < count % numThreads ? 1 : 0);
+    threads.push_back(thread(parseFormulas, share, &threadFailures[t]));
+  }
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    threads[t].join();
+    failures += threadFailures[t];
+  }
+  stop = getCurrentMillis();
+  unsigned long long parallelTime = stop - start;
+#endif
+
+  cout << endl;
+  cout << "          formulas: " << count        << endl;
+  cout << "  serial time (ms): " << serialTime   << endl;
+#ifdef HAVE_STD_THREAD
+  cout << "           threads: " << numThreads   << endl;
+  cout << "parallel time (ms): " << parallelTime << endl;
+#else
+  cout << "(threads are not available with this compiler)" << endl;
+#endif
+  cout << "   failed to parse: " << failures     << endl;
+  cout << endl;
+
+  return (failures == 0) ? 0 : 1;
+}
+
+END_C_DECLS
@@ -0,0 +1,201 @@
+/**
+ * @file    readMemoryMapped.cpp
+ * @brief   Compares reading an SBML file through a stream and memory-mapped
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <string>
+
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/xml/XMLInputStream.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Reads filename repeats times and returns the fastest time in
+ * milliseconds.  The document of the last read is kept in doc.
+ */
+millis_t
+timeRead (const char* filename, bool useMemoryMap, unsigned int repeats,
+          SBMLDocument*& doc)
+{
+  SBMLReader reader;
+  reader.setUseMemoryMap(useMemoryMap);
+
+  millis_t best = 0;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    delete doc;
+
+    millis_t start = getCurrentMillis();
+    doc = reader.readSBML(filename);
+    millis_t stop  = getCurrentMillis();
+
+    if (i == 0 || stop - start < best)
+    {
+      best = stop - start;
+    }
+  }
+
+  return best;
+}
+
+
+/*
+ * Pulls every token of filename from an XMLInputStream repeats times and
+ * returns the fastest time in milliseconds.  This leaves out building the
+ * SBML objects, so that the cost of reading and parsing the XML shows.
+ */
+millis_t
+timeTokens (const char* filename, bool useMemoryMap, unsigned int repeats,
+            unsigned long& tokens)
+{
+  millis_t best = 0;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    tokens = 0;
+
+    millis_t start = getCurrentMillis();
+    XMLInputStream stream(filename, true, "", NULL, useMemoryMap);
+    while (stream.isGood())
+    {
+      stream.next();
+      ++tokens;
+    }
+    millis_t stop  = getCurrentMillis();
+
+    if (i == 0 || stop - start < best)
+    {
+      best = stop - start;
+    }
+  }
+
+  return best;
+}
+
+
+void
+printResult (const char* label, millis_t millis, unsigned long size,
+             const SBMLDocument* doc)
+{
+  cout << endl;
+  cout << "         " << label << " time (ms): " << millis << endl;
+  if (millis > 0)
+  {
+    cout << "        throughput (MB/s): "
+         << (size / 1048576.0) / (millis / 1000.0) << endl;
+  }
+  cout << "                   errors: " << doc->getNumErrors() << endl;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc < 2 || argc > 3)
+  {
+    cout << endl << "Usage: readMemoryMapped filename [repeats]"
+         << endl << endl;
+    return 1;
+  }
+
+  const char*  filename = argv[1];
+  unsigned int repeats  = (argc > 2) ? (unsigned int) atol(argv[2]) : 5;
+
+  if (repeats == 0) repeats = 1;
+
+  unsigned long size = getFileSize(filename);
+
+  SBMLDocument* streamed = NULL;
+  SBMLDocument* mapped   = NULL;
+
+  millis_t streamTime = timeRead(filename, false, repeats, streamed);
+  millis_t mapTime    = timeRead(filename, true,  repeats, mapped);
+
+  cout << endl;
+  cout << "                 filename: " << filename << endl;
+  cout << "        file size (bytes): " << size << endl;
+  cout << "        repeats (best of): " << repeats << endl;
+
+  printResult("stream", streamTime, size, streamed);
+  printResult("mapped", mapTime, size, mapped);
+
+  unsigned long streamTokens = 0;
+  unsigned long mapTokens    = 0;
+
+  millis_t streamTokenTime = timeTokens(filename, false, repeats, streamTokens);
+  millis_t mapTokenTime    = timeTokens(filename, true,  repeats, mapTokens);
+
+  cout << endl;
+  cout << "               XML tokens: " << streamTokens << endl;
+  cout << "  stream tokens time (ms): " << streamTokenTime << endl;
+  cout << "  mapped tokens time (ms): " << mapTokenTime << endl;
+  cout << endl;
+
+  // both ways of reading must see the same document
+  char* streamedXML = writeSBMLToString(streamed);
+  char* mappedXML   = writeSBMLToString(mapped);
+
+  bool same = (streamed->getNumErrors() == mapped->getNumErrors()) &&
+              (streamTokens == mapTokens) &&
+              string(streamedXML) == string(mappedXML);
+
+  if (!same)
+  {
+    cout << "The memory-mapped read differs from the stream read." << endl
+         << endl;
+  }
+
+  free(streamedXML);
+  free(mappedXML);
+  delete streamed;
+  delete mapped;
+
+  return same ? 0 : 1;
+}
+
+END_C_DECLS
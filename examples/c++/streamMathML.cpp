@@ -0,0 +1,176 @@
+/**
+ * @file    streamMathML.cpp
+ * @brief   Compares pulling MathML tokens with counting children ahead
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <stdlib.h>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/xml/XMLInputStream.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Returns a MathML document holding a single sum with count terms.
+ */
+string
+createSum (unsigned int count)
+{
+  ostringstream math;
+
+  math << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << endl
+       << "<math xmlns=\"http://www.w3.org/1998/Math/MathML\">" << endl
+       << "  <apply>" << endl
+       << "    <plus/>" << endl;
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    math << "    <ci> x" << i << " </ci>" << endl;
+  }
+
+  math << "  </apply>" << endl
+       << "</math>" << endl;
+
+  return math.str();
+}
+
+
+/*
+ * Consumes the <math> and <apply> start elements of the stream, so that
+ * the next token is the function of the <apply>.
+ */
+void
+skipToFunction (XMLInputStream& stream)
+{
+  stream.skipText();
+  stream.next();
+  stream.skipText();
+  stream.next();
+  stream.skipText();
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 2)
+  {
+    cout << endl << "Usage: streamMathML [count]" << endl << endl;
+    return 1;
+  }
+
+  unsigned int count = (argc > 1) ? (unsigned int) atol(argv[1]) : 200000;
+  unsigned int failures = 0;
+
+#ifdef __BORLANDC__
+  unsigned long start, stop;
+#else
+  unsigned long long start, stop;
+#endif
+
+  string math = createSum(count);
+
+  cout << endl;
+  cout << "                  children: " << count << endl;
+  cout << "             document (kB): " << math.size() / 1024 << endl;
+  cout << "    peak memory start (kB): " << getPeakMemory() << endl;
+
+  // pull the tokens one at a time; the stream only holds those of the
+  // chunk of the document that the parser is working on
+  {
+    XMLInputStream stream(math.c_str(), false);
+    unsigned int children = 0;
+
+    start = getCurrentMillis();
+    skipToFunction(stream);
+    while (stream.isGood())
+    {
+      const XMLToken token = stream.next();
+      if (token.isStart() && token.getName() == "ci")
+      {
+        ++children;
+      }
+    }
+    stop = getCurrentMillis();
+
+    if (children != count)
+    {
+      ++failures;
+    }
+
+    cout << endl;
+    cout << "           pulled children: " << children << endl;
+    cout << "                 time (ms): " << stop - start << endl;
+    cout << "          peak memory (kB): " << getPeakMemory() << endl;
+  }
+
+  // count the arguments of the sum before reading them; this has to hold
+  // every token up to the end of the <apply> element
+  {
+    XMLInputStream stream(math.c_str(), false);
+
+    start = getCurrentMillis();
+    skipToFunction(stream);
+    unsigned int children = stream.determineNumberChildren();
+    stop = getCurrentMillis();
+
+    if (children != count)
+    {
+      ++failures;
+    }
+
+    cout << endl;
+    cout << "          counted children: " << children << endl;
+    cout << "                 time (ms): " << stop - start << endl;
+    cout << "          peak memory (kB): " << getPeakMemory() << endl;
+  }
+  cout << endl;
+
+  return (failures == 0) ? 0 : 1;
+}
+
+END_C_DECLS
@@ -0,0 +1,165 @@
+/**
+ * @file    timeWriteSBML.cpp
+ * @brief   Times writing a model full of numbers and checks they read back exactly
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <string>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Writes doc to a string repeats times and returns the fastest time in
+ * milliseconds.  The text of the last write is kept in text.
+ */
+millis_t
+timeWrite (const SBMLDocument* doc, unsigned int repeats, string& text)
+{
+  SBMLWriter writer;
+  millis_t   best = 0;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    millis_t start = getCurrentMillis();
+    char*    chars = writer.writeSBMLToString(doc);
+    millis_t stop  = getCurrentMillis();
+
+    text = chars;
+    free(chars);
+
+    if (i == 0 || stop - start < best)
+    {
+      best = stop - start;
+    }
+  }
+
+  return best;
+}
+
+
+/*
+ * Returns the number of parameter values and species concentrations of
+ * copy that are not bit for bit equal to those of doc.
+ */
+unsigned int
+countMismatches (const SBMLDocument* doc, const SBMLDocument* copy)
+{
+  const Model* model     = doc->getModel();
+  const Model* readModel = copy->getModel();
+
+  if (readModel == NULL
+      || readModel->getNumParameters() != model->getNumParameters()
+      || readModel->getNumSpecies()    != model->getNumSpecies())
+  {
+    return model->getNumParameters() + model->getNumSpecies();
+  }
+
+  unsigned int mismatches = 0;
+
+  for (unsigned int i = 0; i < model->getNumParameters(); ++i)
+  {
+    double written = model->getParameter(i)->getValue();
+    double read    = readModel->getParameter(i)->getValue();
+
+    if (memcmp(&written, &read, sizeof(double)) != 0) ++mismatches;
+  }
+
+  for (unsigned int i = 0; i < model->getNumSpecies(); ++i)
+  {
+    double written = model->getSpecies(i)->getInitialConcentration();
+    double read    = readModel->getSpecies(i)->getInitialConcentration();
+
+    if (memcmp(&written, &read, sizeof(double)) != 0) ++mismatches;
+  }
+
+  return mismatches;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 3)
+  {
+    cout << endl << "Usage: timeWriteSBML [size [repeats]]" << endl << endl;
+    return 1;
+  }
+
+  unsigned int size    = (argc > 1) ? (unsigned int) atol(argv[1]) : 10000;
+  unsigned int repeats = (argc > 2) ? (unsigned int) atol(argv[2]) : 3;
+
+  if (repeats == 0) repeats = 1;
+
+  SBMLDocument* doc = createSampleModel(size, SAMPLE_PARAMETERS);
+
+  string       text;
+  millis_t     millis = timeWrite(doc, repeats, text);
+
+  SBMLDocument* copy       = readSBMLFromString(text.c_str());
+  unsigned int  mismatches = countMismatches(doc, copy);
+
+  cout << endl;
+  cout << "   parameters and species: " << size << " each" << endl;
+  cout << "        repeats (best of): " << repeats << endl;
+  cout << "    document size (bytes): " << text.size() << endl;
+  cout << "               write (ms): " << millis << endl;
+  if (millis > 0)
+  {
+    cout << "        throughput (MB/s): "
+         << (text.size() / 1048576.0) / (millis / 1000.0) << endl;
+  }
+  cout << "     values not read back: " << mismatches << endl;
+  cout << endl;
+
+  delete copy;
+  delete doc;
+
+  return (mismatches == 0) ? 0 : 1;
+}
+
+END_C_DECLS
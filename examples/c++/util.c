@@ -40,15 +40,21 @@
 
 
 #include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <sys/stat.h>
 
 #if defined(WIN32) && !defined(CYGWIN)
 #  include <windows.h>
 #else
 #  include <sys/time.h>
+#  include <sys/resource.h>
 #endif /* WIN32 && !CYGWIN */
 
 #include <sbml/common/extern.h>
+#include <sbml/annotation/CVTerm.h>
+
+#include "util.h"
 
 BEGIN_C_DECLS
 
@@ -56,11 +62,7 @@ BEGIN_C_DECLS
 /**
  * @return the number of milliseconds elapsed since the Epoch.
  */
-#ifdef __BORLANDC__
-unsigned long
-#else 
-unsigned long long
-#endif
+millis_t
 getCurrentMillis (void)
 {
 #ifdef __BORLANDC__
@@ -113,5 +115,180 @@ getFileSize (const char* filename)
   return result;
 }
 
+
+/**
+ * @return the peak resident memory of this process (in kilobytes), or 0
+ * where it cannot be determined.
+ */
+unsigned long
+getPeakMemory (void)
+{
+  unsigned long result = 0;
+
+#if !defined(WIN32) || defined(CYGWIN)
+
+  struct rusage usage;
+
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    result = (unsigned long) (usage.ru_maxrss / 1024);
+#else
+    result = (unsigned long) usage.ru_maxrss;
+#endif
+  }
+
+#endif /* !WIN32 || CYGWIN */
+
+  return result;
+}
+
+
+/**
+ * Adds notes, two CVTerms and an annotation of its own to the nth species
+ * of a sample model.
+ */
+static void
+annotateSpecies (SBase_t* species, unsigned int n)
+{
+  char      text[256];
+  CVTerm_t* term;
+
+  sprintf(text, "_s%u", n);
+  SBase_setMetaId(species, text);
+
+  sprintf(text, "<body xmlns=\"http://www.w3.org/1999/xhtml\"><p>Species %u,"
+                " curated from the literature.</p></body>", n);
+  SBase_setNotesString(species, text);
+
+  sprintf(text, "<ex:record ex:source=\"import\" ex:index=\"%u\">"
+                "<ex:note>unchecked</ex:note></ex:record>", n);
+  SBase_appendAnnotationString(species, text);
+
+  term = CVTerm_createWithQualifierType(BIOLOGICAL_QUALIFIER);
+  CVTerm_setBiologicalQualifierType(term, BQB_IS);
+  sprintf(text, "urn:miriam:chebi:CHEBI%%3A%u", n);
+  CVTerm_addResource(term, text);
+  sprintf(text, "urn:miriam:kegg.compound:C%u", n);
+  CVTerm_addResource(term, text);
+  SBase_addCVTerm(species, term);
+  CVTerm_free(term);
+
+  term = CVTerm_createWithQualifierType(BIOLOGICAL_QUALIFIER);
+  CVTerm_setBiologicalQualifierType(term, BQB_IS_PART_OF);
+  CVTerm_addResource(term, "urn:miriam:go:GO%3A0005737");
+  SBase_addCVTerm(species, term);
+  CVTerm_free(term);
+}
+
+
+/**
+ * Adds a reaction converting species n into species next with mass-action
+ * kinetics to a sample model.
+ */
+static void
+addReaction (Model_t* model, unsigned int n, unsigned int next)
+{
+  char                id[32];
+  char                formula[64];
+  Reaction_t*         r = Model_createReaction(model);
+  SpeciesReference_t* sr;
+  KineticLaw_t*       kl;
+  LocalParameter_t*   k;
+  ASTNode_t*          math;
+
+  sprintf(id, "r%u", n);
+  Reaction_setId(r, id);
+  Reaction_setReversible(r, 0);
+
+  sr = Reaction_createReactant(r);
+  sprintf(id, "s%u", n);
+  SpeciesReference_setSpecies(sr, id);
+  SpeciesReference_setStoichiometry(sr, 1.0);
+  SpeciesReference_setConstant(sr, 1);
+
+  sr = Reaction_createProduct(r);
+  sprintf(id, "s%u", next);
+  SpeciesReference_setSpecies(sr, id);
+  SpeciesReference_setStoichiometry(sr, 2.0);
+  SpeciesReference_setConstant(sr, 1);
+
+  kl = Reaction_createKineticLaw(r);
+  k  = KineticLaw_createLocalParameter(kl);
+  LocalParameter_setId(k, "k");
+  LocalParameter_setValue(k, 0.1);
+
+  sprintf(formula, "k * s%u", n);
+  math = SBML_parseL3Formula(formula);
+  KineticLaw_setMath(kl, math);
+  ASTNode_free(math);
+}
+
+
+/**
+ * @return a new SBML Level 3 Version 2 document whose model has one
+ * compartment and size species, and the components selected by contents.
+ */
+SBMLDocument_t*
+createSampleModel (unsigned int size, unsigned int contents)
+{
+  SBMLDocument_t* doc   = SBMLDocument_createWithLevelAndVersion(3, 2);
+  Model_t*        model = SBMLDocument_createModel(doc);
+  Compartment_t*  c     = Model_createCompartment(model);
+  char            id[32];
+  unsigned int    i;
+
+  Compartment_setId(c, "c");
+  Compartment_setSize(c, 1.0);
+  Compartment_setConstant(c, 1);
+
+  if (contents & SAMPLE_ANNOTATIONS)
+  {
+    XMLNamespaces_add((XMLNamespaces_t*) SBMLDocument_getNamespaces(doc),
+                      "http://example.org/annotation", "ex");
+  }
+
+  srand(42);
+
+  for (i = 0; i < size; ++i)
+  {
+    Species_t* s;
+
+    if (contents & SAMPLE_PARAMETERS)
+    {
+      Parameter_t* p = Model_createParameter(model);
+
+      sprintf(id, "p%u", i);
+      Parameter_setId(p, id);
+      Parameter_setValue(p, (rand() / (double) RAND_MAX) * 1000.0);
+      Parameter_setConstant(p, 1);
+    }
+
+    s = Model_createSpecies(model);
+    sprintf(id, "s%u", i);
+    Species_setId(s, id);
+    Species_setCompartment(s, "c");
+    Species_setInitialConcentration(s, 1.0 / (i + 3));
+    Species_setHasOnlySubstanceUnits(s, 0);
+    Species_setBoundaryCondition(s, 0);
+    Species_setConstant(s, 0);
+
+    if (contents & SAMPLE_ANNOTATIONS)
+    {
+      annotateSpecies((SBase_t*) s, i);
+    }
+  }
+
+  if (contents & SAMPLE_REACTIONS)
+  {
+    for (i = 0; i < size; ++i)
+    {
+      addReaction(model, i, (i + 1) % size);
+    }
+  }
+
+  return doc;
+}
+
 END_C_DECLS
 
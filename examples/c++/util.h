@@ -1,6 +1,6 @@
 /**
  * @file    util.h
- * @brief   Supporting functions for example code
+ * @brief   Supporting functions and sample models for example code
  * @author  Ben Bornstein
  *
  * <!--------------------------------------------------------------------------
@@ -39,18 +39,24 @@
  */
 
 #include <sbml/common/extern.h>
+#include <sbml/SBMLTypes.h>
 
 
 BEGIN_C_DECLS
 
 /**
- * @return the number of milliseconds elapsed since the Epoch.
+ * The type of the times returned by getCurrentMillis().
  */
 #ifdef __BORLANDC__
-unsigned long
+typedef unsigned long      millis_t;
 #else
-unsigned long long
+typedef unsigned long long millis_t;
 #endif
+
+/**
+ * @return the number of milliseconds elapsed since the Epoch.
+ */
+millis_t
 getCurrentMillis (void);
 
 /**
@@ -59,4 +65,30 @@ getCurrentMillis (void);
 unsigned long
 getFileSize (const char* filename);
 
+/**
+ * @return the peak resident memory of this process (in kilobytes), or 0
+ * where it cannot be determined.
+ */
+unsigned long
+getPeakMemory (void);
+
+/**
+ * Contents of the models made by createSampleModel(), to be combined with
+ * bitwise or.
+ */
+#define SAMPLE_PARAMETERS   1  /* a constant parameter per species, with
+                                  values that need all 17 digits */
+#define SAMPLE_ANNOTATIONS  2  /* notes, two CVTerms and an annotation of
+                                  its own on every species */
+#define SAMPLE_REACTIONS    4  /* a mass-action reaction from each species
+                                  to the next */
+
+/**
+ * @return a new SBML Level 3 Version 2 document whose model has one
+ * compartment and @p size species, and the components selected by
+ * @p contents.  The same arguments always give the same document.
+ */
+SBMLDocument_t*
+createSampleModel (unsigned int size, unsigned int contents);
+
 END_C_DECLS
@@ -484,7 +484,9 @@ Compartment::setId (const std::string& sid)
   }
   else
   {
+    std::string oldId(mId);
     mId = sid;
+    updateIdIndexes(oldId);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -507,7 +509,9 @@ Compartment::setName (const std::string& name)
     }
     else
     {
+      std::string oldId(mId);
       mId = name;
+      updateIdIndexes(oldId);
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -699,7 +703,9 @@ Compartment::unsetName ()
 {
   if (getLevel() == 1) 
   {
+    std::string oldId(mId);
     mId.erase();
+    updateIdIndexes(oldId);
   }
   else 
   {
@@ -1927,13 +1933,8 @@ ListOfCompartments::get (const std::string& sid)
 const Compartment*
 ListOfCompartments::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  {
-    result = find_if( mItems.begin(), mItems.end(), IdEq<Compartment>(sid) );
-    return (result == mItems.end()) ? NULL : 
-                                      static_cast <Compartment*> (*result);
-  }
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <const Compartment*> (mItems[n]);
 }
 
 
@@ -1949,18 +1950,8 @@ ListOfCompartments::remove (unsigned int n)
 Compartment*
 ListOfCompartments::remove (const std::string& sid)
 {
-  SBase* item = NULL;
-  vector<SBase*>::iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEq<Compartment>(sid) );
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <Compartment*> (item);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <Compartment*> (ListOf::remove(n));
 }
 
 
@@ -183,7 +183,9 @@ CompartmentType::setId (const std::string& sid)
   }
   else
   {
+    std::string oldId(mId);
     mId = sid;
+    updateIdIndexes(oldId);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -206,7 +208,9 @@ CompartmentType::setName (const std::string& name)
     }
     else
     {
+      std::string oldId(mId);
       mId = name;
+      updateIdIndexes(oldId);
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -226,7 +230,9 @@ CompartmentType::unsetName ()
 {
   if (getLevel() == 1) 
   {
+    std::string oldId(mId);
     mId.erase();
+    updateIdIndexes(oldId);
   }
   else 
   {
@@ -715,19 +721,6 @@ ListOfCompartmentTypes::get(unsigned int n) const
 }
 
 
-/**
- * Used by ListOf::get() to lookup an SBase based by its id.
- */
-struct IdEqCT
-{
-  const string& mId;
-
-  IdEqCT (const string& id) : mId(id) { }
-  bool operator() (SBase* sb) 
-       { return static_cast <CompartmentType *> (sb)->getId() == mId; }
-};
-
-
 /* return item by id */
 CompartmentType*
 ListOfCompartmentTypes::get (const std::string& sid)
@@ -741,11 +734,8 @@ ListOfCompartmentTypes::get (const std::string& sid)
 const CompartmentType*
 ListOfCompartmentTypes::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqCT(sid) );
-  return (result == mItems.end()) ? NULL : 
-                    static_cast <CompartmentType*> (*result);  
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <const CompartmentType*> (mItems[n]);
 }
 
 
@@ -761,18 +751,8 @@ ListOfCompartmentTypes::remove (unsigned int n)
 CompartmentType*
 ListOfCompartmentTypes::remove (const std::string& sid)
 {
-  SBase* item = NULL;
-  vector<SBase*>::iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqCT(sid) );
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <CompartmentType*> (item);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <CompartmentType*> (ListOf::remove(n));
 }
 
 
@@ -517,7 +517,9 @@ Event::setId (const std::string& sid)
   }
   else
   {
+    std::string oldId(mId);
     mId = sid;
+    updateIdIndexes(oldId);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -540,7 +542,9 @@ Event::setName (const std::string& name)
     }
     else
     {
+      std::string oldId(mId);
       mId = name;
+      updateIdIndexes(oldId);
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -718,7 +722,9 @@ Event::setUseValuesFromTriggerTime (bool value)
 int
 Event::unsetId ()
 {
+  std::string oldId(mId);
   mId.erase();
+  updateIdIndexes(oldId);
 
   if (mId.empty())
   {
@@ -739,7 +745,9 @@ Event::unsetName ()
 {
   if (getLevel() == 1) 
   {
+    std::string oldId(mId);
     mId.erase();
+    updateIdIndexes(oldId);
   }
   else 
   {
@@ -2202,19 +2210,6 @@ ListOfEvents::get(unsigned int n) const
 }
 
 
-/**
- * Used by ListOf::get() to lookup an SBase based by its id.
- */
-struct IdEqE
-{
-  const string& mId;
-
-  IdEqE (const string& id) : mId(id) { }
-  bool operator() (SBase* sb) 
-       { return static_cast <Event *> (sb)->getId() == mId; }
-};
-
-
 /* return item by id */
 Event*
 ListOfEvents::get (const std::string& sid)
@@ -2228,10 +2223,8 @@ ListOfEvents::get (const std::string& sid)
 const Event*
 ListOfEvents::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqE(sid) );
-  return (result == mItems.end()) ? NULL : static_cast <Event*> (*result);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <const Event*> (mItems[n]);
 }
 
 
@@ -2247,18 +2240,8 @@ ListOfEvents::remove (unsigned int n)
 Event*
 ListOfEvents::remove (const std::string& sid)
 {
-  SBase* item = NULL;
-  vector<SBase*>::iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqE(sid) );
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <Event*> (item);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <Event*> (ListOf::remove(n));
 }
 
 
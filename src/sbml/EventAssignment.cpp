@@ -1161,6 +1161,7 @@ ListOfEventAssignments::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <EventAssignment*> (item);
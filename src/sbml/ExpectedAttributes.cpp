@@ -46,14 +46,34 @@
 #include <sbml/common/common.h>
 #include <sbml/common/operationReturnValues.h>
 #include <sbml/ExpectedAttributes.h>
+#include <sbml/xml/XMLStringTable.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 #ifdef __cplusplus
 
+/*
+ * Lists of at least this many attributes are looked up through mIndex.
+ */
+static const size_t MIN_INDEXED_ATTRIBUTES = 8;
+
+
 bool ExpectedAttributes::hasAttribute(const std::string & attribute) const
 {
-  return (std::find(mAttributes.begin(), mAttributes.end(), attribute)
-    != mAttributes.end());
+  if (mIndex.empty())
+  {
+    return (std::find(mAttributes.begin(), mAttributes.end(), attribute)
+      != mAttributes.end());
+  }
+
+  const size_t mask = mIndex.size() - 1;
+  size_t slot = XMLStringTable::hash(attribute.data(), attribute.size()) & mask;
+
+  for ( ; mIndex[slot] != -1; slot = (slot + 1) & mask)
+  {
+    if (mAttributes[(size_t)mIndex[slot]] == attribute) return true;
+  }
+
+  return false;
 }
 
 std::string ExpectedAttributes::get(unsigned int i) const
@@ -64,6 +84,35 @@ std::string ExpectedAttributes::get(unsigned int i) const
 void ExpectedAttributes::add(const std::string & attribute) 
 { 
   mAttributes.push_back(attribute);
+
+  const size_t length = mAttributes.size();
+  if (length < MIN_INDEXED_ATTRIBUTES) return;
+
+  // keep at least half of the slots empty
+  if (mIndex.size() < 2 * length)
+  {
+    size_t slots = 2 * MIN_INDEXED_ATTRIBUTES;
+    while (slots < 4 * length) slots *= 2;
+
+    mIndex.assign(slots, -1);
+    for (size_t n = 0; n < length; ++n) indexAttribute(n);
+  }
+  else
+  {
+    indexAttribute(length - 1);
+  }
+}
+
+void ExpectedAttributes::indexAttribute(size_t n)
+{
+  const std::string& attribute = mAttributes[n];
+
+  const size_t mask = mIndex.size() - 1;
+  size_t slot = XMLStringTable::hash(attribute.data(), attribute.size()) & mask;
+
+  while (mIndex[slot] != -1) slot = (slot + 1) & mask;
+
+  mIndex[slot] = (int)n;
 }
 
 ExpectedAttributes::ExpectedAttributes()
@@ -70,7 +70,13 @@ public:
   bool hasAttribute(const std::string& attribute) const;
 
 private:
+  void indexAttribute(size_t n);
+
   std::vector<std::string> mAttributes;
+
+  // open addressing hash index of mAttributes, kept once there are enough
+  // attributes for a hash lookup to beat a linear search
+  std::vector<int> mIndex;
 };
 
 
@@ -230,7 +230,9 @@ FunctionDefinition::setId (const std::string& sid)
   }
   else
   {
+    std::string oldId(mId);
     mId = sid;
+    updateIdIndexes(oldId);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -253,7 +255,9 @@ FunctionDefinition::setName (const std::string& name)
     }
     else
     {
+      std::string oldId(mId);
       mId = name;
+      updateIdIndexes(oldId);
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -303,7 +307,9 @@ FunctionDefinition::unsetName ()
 {
   if (getLevel() == 1) 
   {
+    std::string oldId(mId);
     mId.erase();
+    updateIdIndexes(oldId);
   }
   else 
   {
@@ -1199,19 +1205,6 @@ ListOfFunctionDefinitions::get(unsigned int n) const
 }
 
 
-/**
- * Used by ListOf::get() to lookup an SBase based by its id.
- */
-struct IdEqFD
-{
-  const string& mId;
-
-  IdEqFD (const string& id) : mId(id) { }
-  bool operator() (SBase* sb) 
-       { return static_cast <FunctionDefinition *> (sb)->getId() == mId; }
-};
-
-
 /* return item by id */
 FunctionDefinition*
 ListOfFunctionDefinitions::get (const std::string& sid)
@@ -1225,12 +1218,8 @@ ListOfFunctionDefinitions::get (const std::string& sid)
 const FunctionDefinition*
 ListOfFunctionDefinitions::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqFD(sid) );
-  return (result == mItems.end()) ? NULL : 
-                             static_cast <FunctionDefinition*> (*result);
-
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <const FunctionDefinition*> (mItems[n]);
 }
 
 
@@ -1246,18 +1235,8 @@ ListOfFunctionDefinitions::remove (unsigned int n)
 FunctionDefinition*
 ListOfFunctionDefinitions::remove (const std::string& sid)
 {
-  SBase* item = NULL;
-  vector<SBase*>::iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqFD(sid) );
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <FunctionDefinition*> (item);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <FunctionDefinition*> (ListOf::remove(n));
 }
 
 
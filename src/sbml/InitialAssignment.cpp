@@ -1143,6 +1143,7 @@ ListOfInitialAssignments::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <InitialAssignment*> (item);
@@ -42,7 +42,16 @@
 #include <algorithm>
 #include <functional>
 
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#include <unordered_map>
+#define LIBSBML_ID_INDEX_MAP std::unordered_map
+#else
+#include <map>
+#define LIBSBML_ID_INDEX_MAP std::map
+#endif
+
 #include <sbml/SBMLVisitor.h>
+#include <sbml/SBMLDocument.h>
 #include <sbml/ListOf.h>
 #include <sbml/SBO.h>
 #include <sbml/common/common.h>
@@ -56,12 +65,115 @@ using namespace std;
 LIBSBML_CPP_NAMESPACE_BEGIN
 #ifdef __cplusplus
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Lists with fewer items than this are always searched linearly.
+ */
+static const size_t ID_INDEX_MIN_SIZE = 16;
+
+
+/*
+ * Maps the identifiers of the items of a ListOf to their positions in
+ * ListOf::mItems.  Positions are always checked against mItems before
+ * they are used, so a stale entry can never yield a wrong item.
+ */
+class ListOfIdIndex
+{
+public:
+  typedef LIBSBML_ID_INDEX_MAP<std::string, unsigned int> PositionMap;
+
+  ListOfIdIndex() : mNumItems(0), mHasDuplicates(false) { }
+
+  /*
+   * Records that an item with identifier id was inserted at position n,
+   * moving the items from n on one place up.
+   */
+  void insert(unsigned int n, const std::string& id)
+  {
+    for (PositionMap::iterator it = mPositions.begin();
+         it != mPositions.end(); ++it)
+    {
+      if (it->second >= n) ++it->second;
+    }
+    for (size_t u = 0; u < mUnset.size(); ++u)
+    {
+      if (mUnset[u] >= n) ++mUnset[u];
+    }
+
+    if (id.empty())
+    {
+      mUnset.push_back(n);
+    }
+    else
+    {
+      std::pair<PositionMap::iterator, bool> added =
+        mPositions.insert(std::make_pair(id, n));
+      if (!added.second)
+      {
+        mHasDuplicates = true;
+        if (added.first->second > n) added.first->second = n;
+      }
+    }
+    ++mNumItems;
+  }
+
+  /*
+   * Records that the item at position n was removed, moving the items
+   * after it one place down.  Returns false if the index can no longer
+   * tell which item comes first for some identifier.
+   */
+  bool remove(unsigned int n)
+  {
+    bool removed = false;
+    PositionMap::iterator it = mPositions.begin();
+    while (it != mPositions.end())
+    {
+      if (it->second == n)
+      {
+        mPositions.erase(it++);
+        removed = true;
+        continue;
+      }
+      if (it->second > n) --it->second;
+      ++it;
+    }
+
+    size_t numKept = 0;
+    for (size_t u = 0; u < mUnset.size(); ++u)
+    {
+      if (mUnset[u] == n) continue;
+      mUnset[numKept++] = (mUnset[u] > n) ? mUnset[u] - 1 : mUnset[u];
+    }
+    mUnset.resize(numKept);
+
+    --mNumItems;
+
+    // a later item with the same identifier now comes first
+    return !(removed && mHasDuplicates);
+  }
+
+  /* first position of each identifier */
+  PositionMap mPositions;
+
+  /* positions of items that had no identifier when they were indexed */
+  std::vector<unsigned int> mUnset;
+
+  /* number of items in the list when it was indexed */
+  size_t mNumItems;
+
+  /* true if two items share an identifier */
+  bool mHasDuplicates;
+};
+/** @endcond */
+
+
 /*
  * Creates a new ListOf items.
  */
 ListOf::ListOf (unsigned int level, unsigned int version)
 : SBase(level,version)
 , mExplicitlyListed (false)
+, mIdIndex (NULL)
 {
     if (!hasValidLevelVersionNamespaceCombination())
     throw SBMLConstructorException();
@@ -74,6 +186,7 @@ ListOf::ListOf (unsigned int level, unsigned int version)
 ListOf::ListOf (SBMLNamespaces* sbmlns)
 : SBase(sbmlns)
 , mExplicitlyListed (false)
+, mIdIndex (NULL)
 {
     if (!hasValidLevelVersionNamespaceCombination())
     throw SBMLConstructorException();
@@ -95,6 +208,7 @@ struct Delete
 ListOf::~ListOf ()
 {
   for_each( mItems.begin(), mItems.end(), Delete() );
+  delete mIdIndex;
 }
 
 
@@ -110,7 +224,7 @@ struct Clone
 /*
  * Copy constructor. Creates a copy of this ListOf items.
  */
-ListOf::ListOf (const ListOf& orig) : SBase(orig), mItems()
+ListOf::ListOf (const ListOf& orig) : SBase(orig), mItems(), mIdIndex(NULL)
 {
   mItems.resize( orig.size() );
   transform( orig.mItems.begin(), orig.mItems.end(), mItems.begin(), Clone() );
@@ -128,6 +242,7 @@ ListOf& ListOf::operator=(const ListOf& rhs)
   {
     this->SBase::operator =(rhs);
     // Deletes existing items
+    invalidateIdIndex();
     for_each( mItems.begin(), mItems.end(), Delete() );
     mItems.resize( rhs.size() );
     transform( rhs.mItems.begin(), rhs.mItems.end(), mItems.begin(), Clone() );
@@ -181,6 +296,13 @@ ListOf::insertAndOwn(int location, SBase* item)
   {
     mItems.insert( mItems.begin() + location, item );
     item->connectToParent(this);
+    if (mIdIndex != NULL)
+    {
+      if (mIdIndex->mNumItems + 1 == mItems.size())
+        mIdIndex->insert((unsigned int)location, item->getId());
+      else
+        invalidateIdIndex();
+    }
     return LIBSBML_OPERATION_SUCCESS;
   }
   else if (!isValidTypeForList(item))
@@ -191,6 +313,13 @@ ListOf::insertAndOwn(int location, SBase* item)
   {
     mItems.insert( mItems.begin() + location, item );
     item->connectToParent(this);
+    if (mIdIndex != NULL)
+    {
+      if (mIdIndex->mNumItems + 1 == mItems.size())
+        mIdIndex->insert((unsigned int)location, item->getId());
+      else
+        invalidateIdIndex();
+    }
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -223,6 +352,7 @@ ListOf::appendAndOwn (SBase* item)
   {
     mItems.push_back( item );
     item->connectToParent(this);
+    updateIdIndex(item, "");
     return LIBSBML_OPERATION_SUCCESS;
   }
   else if (!isValidTypeForList(item))
@@ -233,6 +363,7 @@ ListOf::appendAndOwn (SBase* item)
   {
     mItems.push_back( item );
     item->connectToParent(this);
+    updateIdIndex(item, "");
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -342,7 +473,12 @@ ListOf::clear (bool doDelete)
 {
   if (doDelete)
     for_each( mItems.begin(), mItems.end(), Delete() );
+  else if (!mItems.empty() && getSBMLDocument() != NULL)
+    // the caller keeps the items and may already have deleted them, so
+    // they are not looked at: the document indexes itself again instead
+    getSBMLDocument()->clearIdIndex();
   mItems.clear();
+  invalidateIdIndex();
 }
 
 int ListOf::removeFromParentAndDelete()
@@ -368,7 +504,16 @@ SBase*
 ListOf::remove (unsigned int n)
 {
   SBase* item = get(n);
-  if (item != NULL) mItems.erase( mItems.begin() + n );
+  if (item != NULL)
+  {
+    if (mIdIndex != NULL &&
+        (mIdIndex->mNumItems != mItems.size() || !mIdIndex->remove(n)))
+    {
+      invalidateIdIndex();
+    }
+    item->removeIdentifiersFromIndex();
+    mItems.erase( mItems.begin() + n );
+  }
   return item;
 }
 
@@ -383,6 +528,171 @@ ListOf::size () const
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+bool
+ListOf::isIdIndexEnabled () const
+{
+  const SBMLDocument* doc = getSBMLDocument();
+  return (doc != NULL && doc->isIdIndexEnabled());
+}
+
+
+void
+ListOf::buildIdIndex () const
+{
+  if (mIdIndex == NULL)
+  {
+    mIdIndex = new ListOfIdIndex();
+  }
+
+  mIdIndex->mPositions.clear();
+  mIdIndex->mUnset.clear();
+  mIdIndex->mHasDuplicates = false;
+
+  for (unsigned int n = 0; n < mItems.size(); ++n)
+  {
+    const std::string& id = mItems[n]->getId();
+    if (id.empty())
+    {
+      mIdIndex->mUnset.push_back(n);
+    }
+    else if (!mIdIndex->mPositions.insert(make_pair(id, n)).second)
+    {
+      mIdIndex->mHasDuplicates = true;
+    }
+  }
+
+  mIdIndex->mNumItems = mItems.size();
+}
+
+
+void
+ListOf::invalidateIdIndex ()
+{
+  delete mIdIndex;
+  mIdIndex = NULL;
+}
+
+
+void
+ListOf::updateIdIndex (const SBase* item, const std::string& oldId)
+{
+  if (mIdIndex == NULL) return;
+
+  // the item has just been appended
+  if (mIdIndex->mNumItems + 1 == mItems.size() && mItems.back() == item)
+  {
+    unsigned int n = (unsigned int)(mItems.size() - 1);
+    const std::string& id = item->getId();
+    if (id.empty())
+    {
+      mIdIndex->mUnset.push_back(n);
+    }
+    else if (!mIdIndex->mPositions.insert(make_pair(id, n)).second)
+    {
+      mIdIndex->mHasDuplicates = true;
+    }
+    mIdIndex->mNumItems = mItems.size();
+    return;
+  }
+
+  // out of sync; it will be rebuilt on the next lookup anyway
+  if (mIdIndex->mNumItems != mItems.size()) return;
+
+  const std::string& newId = item->getId();
+  if (newId == oldId) return;
+
+  if (mIdIndex->mHasDuplicates)
+  {
+    invalidateIdIndex();
+    return;
+  }
+
+  unsigned int n = 0;
+  if (oldId.empty())
+  {
+    std::vector<unsigned int>& unset = mIdIndex->mUnset;
+    std::vector<unsigned int>::iterator it = unset.begin();
+    while (it != unset.end() && mItems[*it] != item) ++it;
+    if (it == unset.end())
+    {
+      invalidateIdIndex();
+      return;
+    }
+    n = *it;
+    unset.erase(it);
+  }
+  else
+  {
+    ListOfIdIndex::PositionMap::iterator it = mIdIndex->mPositions.find(oldId);
+    if (it == mIdIndex->mPositions.end() || mItems[it->second] != item)
+    {
+      invalidateIdIndex();
+      return;
+    }
+    n = it->second;
+    mIdIndex->mPositions.erase(it);
+  }
+
+  if (newId.empty())
+  {
+    mIdIndex->mUnset.push_back(n);
+  }
+  else if (!mIdIndex->mPositions.insert(make_pair(newId, n)).second)
+  {
+    // another item already uses the new id; rebuild to keep the first one
+    invalidateIdIndex();
+  }
+}
+
+
+int
+ListOf::getIndexOfId (const std::string& sid) const
+{
+  if (mItems.size() < ID_INDEX_MIN_SIZE || !isIdIndexEnabled())
+  {
+    if (mIdIndex != NULL)
+    {
+      delete mIdIndex;
+      mIdIndex = NULL;
+    }
+
+    for (unsigned int n = 0; n < mItems.size(); ++n)
+    {
+      if (mItems[n]->getId() == sid) return (int)n;
+    }
+    return -1;
+  }
+
+  if (mIdIndex == NULL || mIdIndex->mNumItems != mItems.size())
+  {
+    buildIdIndex();
+  }
+
+  ListOfIdIndex::PositionMap::const_iterator it = mIdIndex->mPositions.find(sid);
+  if (it != mIdIndex->mPositions.end() && it->second < mItems.size() &&
+      mItems[it->second]->getId() == sid)
+  {
+    return (int)it->second;
+  }
+
+  // the identifier may have been given without going through the setters
+  // of the items, so a miss is confirmed by searching the items, and the
+  // index is rebuilt if that finds one
+  for (unsigned int n = 0; n < mItems.size(); ++n)
+  {
+    if (mItems[n]->getId() == sid)
+    {
+      buildIdIndex();
+      return (int)n;
+    }
+  }
+
+  return -1;
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 /*
  * Enables/Disables the given package with this element and child
@@ -666,6 +976,7 @@ struct ListOfComparator
 void ListOf::sort()
 {
     std::sort(mItems.begin(), mItems.end(), ListOfComparator());
+    invalidateIdIndex();
 }
 
 
@@ -105,6 +105,7 @@
 LIBSBML_CPP_NAMESPACE_BEGIN
 
 class SBMLVisitor;
+class ListOfIdIndex;
 
 
 /** @cond doxygenLibsbmlInternal */
@@ -623,6 +624,27 @@ public:
   void sort();
   /** @endcond */
 
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Updates the SId index of this ListOf after @p item has been appended
+   * to it, or after the identifier of @p item has changed from @p oldId
+   * to its current identifier.
+   *
+   * Called by appendAndOwn() and by the setId()/unsetId() methods of the
+   * items themselves; does nothing if no index has been built for this
+   * list.
+   */
+  void updateIdIndex (const SBase* item, const std::string& oldId);
+
+
+  /**
+   * Discards the SId index of this ListOf (if any).  The index is rebuilt
+   * on the next lookup that needs it.
+   */
+  void invalidateIdIndex ();
+  /** @endcond */
+
 protected:
   /** @cond doxygenLibsbmlInternal */
   typedef std::vector<SBase*>           ListItem;
@@ -660,10 +682,39 @@ protected:
   virtual bool isValidTypeForList(SBase * item);
 
 
+  /**
+   * Returns the position of the first item in this ListOf whose
+   * identifier (as returned by getId()) is @p sid, or @c -1 if there is
+   * no such item.
+   *
+   * If the SId index is enabled on the parent SBMLDocument (see
+   * SBMLDocument::setIdIndexEnabled()), the lookup uses a hash index
+   * that is built lazily and kept up to date by append, insert, remove
+   * and the setId()/unsetId() methods of the items; otherwise the items
+   * are searched linearly.
+   */
+  int getIndexOfId (const std::string& sid) const;
+
+
+  /**
+   * Predicate returning @c true if the SId index is enabled on the
+   * SBMLDocument containing this ListOf.
+   */
+  bool isIdIndexEnabled () const;
+
+
+  /**
+   * (Re)builds the SId index from the current items.
+   */
+  void buildIdIndex () const;
+
+
   ListItem mItems;
 
   bool mExplicitlyListed;
 
+  mutable ListOfIdIndex* mIdIndex;
+
   /** @endcond */
 };
 
@@ -643,19 +643,6 @@ ListOfLocalParameters::get(unsigned int n) const
 }
 
 
-/**
- * Used by ListOf::get() to lookup an SBase based by its id.
- */
-struct IdEqP
-{
-  const string& mId;
-
-  IdEqP (const string& id) : mId(id) { }
-  bool operator() (SBase* sb) 
-       { return static_cast <LocalParameter *> (sb)->getId() == mId; }
-};
-
-
 /* return item by id */
 LocalParameter*
 ListOfLocalParameters::get (const std::string& sid)
@@ -669,12 +656,8 @@ ListOfLocalParameters::get (const std::string& sid)
 const LocalParameter*
 ListOfLocalParameters::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqP(sid) );
-  return (result == mItems.end()) ? NULL : 
-                           static_cast <LocalParameter*> (*result);
-  
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <const LocalParameter*> (mItems[n]);
 }
 
 
@@ -704,18 +687,8 @@ ListOfLocalParameters::remove (unsigned int n)
 LocalParameter*
 ListOfLocalParameters::remove (const std::string& sid)
 {
-  SBase* item = NULL;
-  vector<SBase*>::iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqP(sid) );
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <LocalParameter*> (item);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <LocalParameter*> (ListOf::remove(n));
 }
 
 
@@ -330,7 +330,10 @@ SBase*
 Model::getElementBySId(const std::string& id)
 {
   if (id.empty()) return NULL;
-  SBase* obj = mFunctionDefinitions.getElementBySId(id);
+  SBase* obj = NULL;
+  if (getSBMLDocument() != NULL
+    && getSBMLDocument()->lookupIdIndex(this, id, false, obj)) return obj;
+  obj = mFunctionDefinitions.getElementBySId(id);
   if (obj != NULL) return obj;
   obj = mUnitDefinitions.getElementBySId(id);
   if (obj != NULL) return obj;
@@ -363,6 +366,9 @@ SBase*
 Model::getElementByMetaId(const std::string& metaid)
 {
   if (metaid.empty()) return NULL;
+  SBase* obj = NULL;
+  if (getSBMLDocument() != NULL
+    && getSBMLDocument()->lookupIdIndex(this, metaid, true, obj)) return obj;
   if (mFunctionDefinitions.getMetaId()==metaid) return &mFunctionDefinitions;
   if (mUnitDefinitions.getMetaId()==metaid) return &mUnitDefinitions;
   if (mCompartmentTypes.getMetaId()==metaid) return &mCompartmentTypes;
@@ -376,7 +382,7 @@ Model::getElementByMetaId(const std::string& metaid)
   if (mReactions.getMetaId()==metaid) return &mReactions;
   if (mEvents.getMetaId()==metaid) return &mEvents;
 
-  SBase* obj = mFunctionDefinitions.getElementByMetaId(metaid);
+  obj = mFunctionDefinitions.getElementByMetaId(metaid);
   if (obj != NULL) return obj;
   obj = mUnitDefinitions.getElementByMetaId(metaid);
   if (obj != NULL) return obj;
@@ -722,7 +728,9 @@ Model::setId (const std::string& sid)
   }
   else
   {
+    std::string oldId(mId);
     mId = sid;
+    updateIdIndexes(oldId);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -745,7 +753,9 @@ Model::setName (const std::string& name)
     }
     else
     {
+      std::string oldId(mId);
       mId = name;
+      updateIdIndexes(oldId);
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -917,7 +927,9 @@ Model::setConversionFactor (const std::string& id)
 int
 Model::unsetId ()
 {
+  std::string oldId(mId);
   mId.erase();
+  updateIdIndexes(oldId);
 
   if (mId.empty())
   {
@@ -938,7 +950,9 @@ Model::unsetName ()
 {
   if (getLevel() == 1) 
   {
+    std::string oldId(mId);
     mId.erase();
+    updateIdIndexes(oldId);
   }
   else 
   {
@@ -340,7 +340,9 @@ Parameter::setId (const std::string& sid)
   }
   else
   {
+    std::string oldId(mId);
     mId = sid;
+    updateIdIndexes(oldId);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -363,7 +365,9 @@ Parameter::setName (const std::string& name)
     }
     else
     {
+      std::string oldId(mId);
       mId = name;
+      updateIdIndexes(oldId);
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -434,7 +438,9 @@ Parameter::unsetName ()
 {
   if (getLevel() == 1) 
   {
+    std::string oldId(mId);
     mId.erase();
+    updateIdIndexes(oldId);
   }
   else 
   {
@@ -1827,17 +1833,6 @@ ListOfParameters::get(unsigned int n) const
 }
 
 
-/**
- * Used by ListOf::get() to lookup an SBase based by its id.
- */
-struct IdEqP 
-{
-  const string& mId;
-
-  IdEqP (const string& id) : mId(id) { }
-  bool operator() (SBase* sb) 
-       { return static_cast <Parameter *> (sb)->getId() == mId; }
-};
 /* return item by id */
 Parameter*
 ListOfParameters::get (const std::string& sid)
@@ -1851,10 +1846,8 @@ ListOfParameters::get (const std::string& sid)
 const Parameter*
 ListOfParameters::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqP(sid) );
-  return (result == mItems.end()) ? NULL : static_cast <Parameter*> (*result);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <const Parameter*> (mItems[n]);
 }
 
 
@@ -1870,18 +1863,8 @@ ListOfParameters::remove (unsigned int n)
 Parameter*
 ListOfParameters::remove (const std::string& sid)
 {
-  SBase* item = NULL;
-  vector<SBase*>::iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqP(sid) );
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <Parameter*> (item);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <Parameter*> (ListOf::remove(n));
 }
 
 
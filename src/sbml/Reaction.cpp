@@ -522,7 +522,9 @@ Reaction::setId (const std::string& sid)
   }
   else
   {
+    std::string oldId(mId);
     mId = sid;
+    updateIdIndexes(oldId);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -545,7 +547,9 @@ Reaction::setName (const std::string& name)
     }
     else
     {
+      std::string oldId(mId);
       mId = name;
+      updateIdIndexes(oldId);
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -659,7 +663,9 @@ Reaction::unsetName ()
 {
   if (getLevel() == 1) 
   {
+    std::string oldId(mId);
     mId.erase();
+    updateIdIndexes(oldId);
   }
   else 
   {
@@ -2530,10 +2536,8 @@ ListOfReactions::get (const std::string& sid)
 const Reaction*
 ListOfReactions::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEq<Reaction>(sid) );
-  return (result == mItems.end()) ? NULL : static_cast <Reaction*> (*result);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <const Reaction*> (mItems[n]);
 }
 
 
@@ -2549,19 +2553,8 @@ ListOfReactions::remove (unsigned int n)
 Reaction*
 ListOfReactions::remove (const std::string& sid)
 {
-  SBase* item = NULL;
-  vector<SBase*>::iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEq<Reaction>(sid) );
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-
-  return static_cast <Reaction*> (item);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <Reaction*> (ListOf::remove(n));
 }
 
 
@@ -1559,6 +1559,7 @@ Rule::setL1TypeCode (int type)
        || (type == SBML_SPECIES_CONCENTRATION_RULE) 
      )
   {
+    unshareSBMLNamespaces();
     mSBMLNamespaces->setLevel(1);
     mL1Type = type;
   }
@@ -1704,6 +1705,7 @@ ListOfRules::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <Rule*> (item);
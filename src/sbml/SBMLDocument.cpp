@@ -41,7 +41,17 @@
  * and also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <vector>
+
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1700)
+#include <unordered_map>
+#define LIBSBML_ID_INDEX_MAP std::unordered_map
+#else
+#define LIBSBML_ID_INDEX_MAP std::map
+#endif
 
 #include <sbml/xml/XMLAttributes.h>
 #include <sbml/xml/XMLNamespaces.h>
@@ -79,6 +89,391 @@ using namespace std;
 LIBSBML_CPP_NAMESPACE_BEGIN
 #ifdef __cplusplus
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * The document-wide index behind getElementBySId() and getElementByMetaId().
+ *
+ * It maps every SId and metaid of the document to the elements carrying
+ * it.  The index is built from getAllElements() on the first lookup and
+ * from then on kept up to date in place: elements enter it when they are
+ * connected to the document or given an identifier, and leave it when they
+ * are removed from the document or deleted.  Only ListOf::clear(false),
+ * whose items may already be deleted by the caller, has the index built
+ * again on the next lookup.  Each element indexed records
+ * the document whose index holds it (SBase::mIdIndexDocument), and this is
+ * cleared when the index is deleted, so an element that outlives its
+ * document never reaches it.
+ *
+ * Identifiers written without going through the setters are caught on
+ * lookup: indexed elements whose identifier no longer matches are
+ * re-indexed, and an identifier the index does not know is searched for.
+ *
+ * Whether an element with a given SId is actually found by getElementBySId()
+ * depends on its type (local parameters, units, rules, ports etc. are not
+ * in the SId namespace), so for every chain of element names from an
+ * element up to the root of a lookup the first lookup is answered by
+ * searching the document, and the outcome is remembered for later lookups.
+ */
+class SBMLDocumentIdIndex
+{
+public:
+  typedef LIBSBML_ID_INDEX_MAP<std::string, SBase*> ElementMap;
+  typedef std::map<std::string, std::vector<SBase*> > DuplicateMap;
+  typedef std::map<std::string, bool> AcceptedMap;
+
+  struct Table
+  {
+    /* first element indexed with each identifier */
+    ElementMap mFirst;
+    /* all elements, for identifiers used more than once */
+    DuplicateMap mAll;
+  };
+
+  /* the identifiers an element is indexed under */
+  struct Entry
+  {
+    std::string mSId;
+    std::string mMetaId;
+  };
+
+  typedef LIBSBML_ID_INDEX_MAP<SBase*, Entry> EntryMap;
+
+  SBMLDocumentIdIndex(SBMLDocument* document);
+  ~SBMLDocumentIdIndex();
+
+  void build();
+  void clear();
+  void update(SBase* element);
+  void remove(SBase* element);
+  bool lookup(SBase* root, const std::string& id, bool isMetaId,
+              SBase*& element);
+
+  SBMLDocument* mDocument;
+  bool mBuilt;
+  bool mSearching;
+  Table mSIds;
+  Table mMetaIds;
+  EntryMap mEntries;
+  AcceptedMap mAcceptedSIds;
+  AcceptedMap mAcceptedMetaIds;
+
+  unsigned long mNumLookups;
+  unsigned long mNumHits;
+  unsigned long mNumBuilds;
+
+private:
+  void getCandidates(SBase* root, const std::string& id, bool isMetaId,
+                     std::vector<SBase*>& candidates);
+  SBase* search(SBase* root, const std::string& id, bool isMetaId);
+  static void add(Table& table, const std::string& id, SBase* element);
+  static void remove(Table& table, const std::string& id, SBase* element);
+  static std::string getTypeKey(const SBase* element, const SBase* root);
+};
+
+
+SBMLDocumentIdIndex::SBMLDocumentIdIndex(SBMLDocument* document)
+  : mDocument(document)
+  , mBuilt(false)
+  , mSearching(false)
+  , mNumLookups(0)
+  , mNumHits(0)
+  , mNumBuilds(0)
+{
+  build();
+}
+
+
+SBMLDocumentIdIndex::~SBMLDocumentIdIndex()
+{
+  clear();
+}
+
+
+/*
+ * Indexes the document and all elements below it.
+ */
+void
+SBMLDocumentIdIndex::build()
+{
+  ++mNumBuilds;
+  mBuilt = true;
+  update(mDocument);
+
+  List* elements = mDocument->getAllElements();
+  for (ListIterator iter = elements->begin(); iter != elements->end(); ++iter)
+  {
+    update(static_cast<SBase*>(*iter));
+  }
+  delete elements;
+}
+
+
+/*
+ * Empties the index until the next lookup builds it again; what has been
+ * learned about element types is kept.
+ */
+void
+SBMLDocumentIdIndex::clear()
+{
+  for (EntryMap::iterator it = mEntries.begin(); it != mEntries.end(); ++it)
+  {
+    it->first->mIdIndexDocument = NULL;
+  }
+  mEntries.clear();
+  mSIds.mFirst.clear();
+  mSIds.mAll.clear();
+  mMetaIds.mFirst.clear();
+  mMetaIds.mAll.clear();
+  mBuilt = false;
+}
+
+
+void
+SBMLDocumentIdIndex::add(Table& table, const std::string& id, SBase* element)
+{
+  if (id.empty()) return;
+
+  std::pair<ElementMap::iterator, bool> result =
+    table.mFirst.insert(make_pair(id, element));
+  if (!result.second && result.first->second != element)
+  {
+    std::vector<SBase*>& all = table.mAll[id];
+    if (all.empty()) all.push_back(result.first->second);
+    if (std::find(all.begin(), all.end(), element) == all.end())
+    {
+      all.push_back(element);
+    }
+  }
+}
+
+
+void
+SBMLDocumentIdIndex::remove(Table& table, const std::string& id,
+                            SBase* element)
+{
+  if (id.empty()) return;
+
+  DuplicateMap::iterator all = table.mAll.find(id);
+  if (all != table.mAll.end())
+  {
+    std::vector<SBase*>& elements = all->second;
+    elements.erase(std::remove(elements.begin(), elements.end(), element),
+                   elements.end());
+    table.mFirst[id] = elements.front();
+    if (elements.size() == 1) table.mAll.erase(all);
+    return;
+  }
+
+  ElementMap::iterator first = table.mFirst.find(id);
+  if (first != table.mFirst.end() && first->second == element)
+  {
+    table.mFirst.erase(first);
+  }
+}
+
+
+/*
+ * Indexes element under its current SId and metaid.
+ */
+void
+SBMLDocumentIdIndex::update(SBase* element)
+{
+  Entry& entry = mEntries[element];
+  element->mIdIndexDocument = mDocument;
+
+  const std::string& sid = element->getId();
+  if (entry.mSId != sid)
+  {
+    remove(mSIds, entry.mSId, element);
+    add(mSIds, sid, element);
+    entry.mSId = sid;
+  }
+
+  const std::string& metaid = element->getMetaId();
+  if (entry.mMetaId != metaid)
+  {
+    remove(mMetaIds, entry.mMetaId, element);
+    add(mMetaIds, metaid, element);
+    entry.mMetaId = metaid;
+  }
+}
+
+
+/*
+ * Takes element out of the index; it may already be partly destroyed, so
+ * only the identifiers recorded for it are used.
+ */
+void
+SBMLDocumentIdIndex::remove(SBase* element)
+{
+  element->mIdIndexDocument = NULL;
+
+  EntryMap::iterator it = mEntries.find(element);
+  if (it == mEntries.end()) return;
+
+  remove(mSIds, it->second.mSId, element);
+  remove(mMetaIds, it->second.mMetaId, element);
+  mEntries.erase(it);
+}
+
+
+/*
+ * Searches the document as if the index did not exist.
+ */
+SBase*
+SBMLDocumentIdIndex::search(SBase* root, const std::string& id, bool isMetaId)
+{
+  mSearching = true;
+  SBase* element = isMetaId ? root->getElementByMetaId(id)
+                            : root->getElementBySId(id);
+  mSearching = false;
+  return element;
+}
+
+
+/*
+ * Returns the element names from element up to root, e.g.
+ * "core:species/core:listOfSpecies/core:model/", or an empty string if
+ * element is not below root.
+ */
+std::string
+SBMLDocumentIdIndex::getTypeKey(const SBase* element, const SBase* root)
+{
+  std::string key;
+  while (element != NULL)
+  {
+    key += element->getPackageName();
+    key += ':';
+    key += element->getElementName();
+    key += '/';
+    if (element == root) return key;
+    element = element->getParentSBMLObject();
+  }
+  return "";
+}
+
+
+/*
+ * Fills candidates with the elements indexed under id that still carry it.
+ */
+void
+SBMLDocumentIdIndex::getCandidates(SBase* root, const std::string& id,
+                                   bool isMetaId,
+                                   std::vector<SBase*>& candidates)
+{
+  const Table& table = isMetaId ? mMetaIds : mSIds;
+
+  candidates.clear();
+  DuplicateMap::const_iterator all = table.mAll.find(id);
+  if (all != table.mAll.end())
+  {
+    candidates = all->second;
+  }
+  else
+  {
+    ElementMap::const_iterator first = table.mFirst.find(id);
+    if (first != table.mFirst.end()) candidates.push_back(first->second);
+  }
+
+  size_t numCurrent = 0;
+  for (size_t n = 0; n < candidates.size(); ++n)
+  {
+    const std::string& current = isMetaId ? candidates[n]->getMetaId()
+                                          : candidates[n]->getId();
+    if (current == id)
+    {
+      candidates[numCurrent++] = candidates[n];
+    }
+    else
+    {
+      // the identifier was changed by a path that does not report it
+      update(candidates[n]);
+    }
+  }
+  candidates.resize(numCurrent);
+}
+
+
+bool
+SBMLDocumentIdIndex::lookup(SBase* root, const std::string& id,
+                            bool isMetaId, SBase*& element)
+{
+  if (mSearching) return false;
+
+  if (!mBuilt) build();
+  ++mNumLookups;
+
+  std::vector<SBase*> candidates;
+  getCandidates(root, id, isMetaId, candidates);
+
+  if (candidates.empty())
+  {
+    // the identifier may have been given by a path that does not report
+    // it, so a miss is confirmed by searching, and anything found indexed
+    element = search(root, id, isMetaId);
+    if (element != NULL && element->getSBMLDocument() == mDocument)
+    {
+      update(element);
+    }
+    return true;
+  }
+
+  AcceptedMap& accepted = isMetaId ? mAcceptedMetaIds : mAcceptedSIds;
+  std::vector<SBase*> below;
+  std::vector<std::string> keys;
+  SBase* found = NULL;
+  unsigned int numAccepted = 0;
+  bool unknown = false;
+  for (size_t n = 0; n < candidates.size(); ++n)
+  {
+    std::string key = getTypeKey(candidates[n], root);
+    if (key.empty())
+    {
+      // an element assigned over takes the parent and document of what it
+      // was assigned from, yet stays in its list: only a search can tell
+      if (candidates[n]->getSBMLDocument() != mDocument) unknown = true;
+      continue;
+    }
+
+    below.push_back(candidates[n]);
+    keys.push_back(key);
+    AcceptedMap::const_iterator it = accepted.find(key);
+    if (it == accepted.end())
+    {
+      unknown = true;
+    }
+    else if (it->second)
+    {
+      found = candidates[n];
+      ++numAccepted;
+    }
+  }
+
+  if (!unknown && numAccepted <= 1)
+  {
+    ++mNumHits;
+    element = found;
+    return true;
+  }
+
+  // several elements could be meant, or the index has not yet learned
+  // whether elements of this type are found: search, and learn from that
+  element = search(root, id, isMetaId);
+  for (size_t n = 0; n < below.size(); ++n)
+  {
+    if (below[n] == element)
+    {
+      accepted[keys[n]] = true;
+    }
+    else if (element == NULL && accepted.find(keys[n]) == accepted.end())
+    {
+      accepted[keys[n]] = false;
+    }
+  }
+  return true;
+}
+/** @endcond */
+
 
 /*
  * Get the most recent Level of SBML supported by this release of
@@ -125,6 +520,10 @@ SBMLDocument::SBMLDocument (unsigned int level, unsigned int version) :
  , mVersion ( version )
  , mModel   ( NULL       )
  , mLocationURI     ("")
+ , mIdIndexEnabled  (false)
+ , mElementIdIndex  (NULL)
+ , mDeferAnnotations(false)
+ , mReadFilter(NULL)
  , mRequiredAttrOfUnknownPkg()
  , mRequiredAttrOfUnknownDisabledPkg()
 {
@@ -150,6 +549,7 @@ SBMLDocument::SBMLDocument (unsigned int level, unsigned int version) :
   mInternalValidator->setConversionValidators(AllChecksON);
 
   mSBML = this;
+  unshareSBMLNamespaces();
 
   setElementNamespace(mSBMLNamespaces->getURI());
 }
@@ -159,6 +559,10 @@ SBMLDocument::SBMLDocument (SBMLNamespaces* sbmlns) :
    SBase  (sbmlns)
  , mModel ( NULL       )
  , mLocationURI ("")
+ , mIdIndexEnabled (false)
+ , mElementIdIndex (NULL)
+ , mDeferAnnotations(false)
+ , mReadFilter(NULL)
  , mRequiredAttrOfUnknownPkg()
  , mRequiredAttrOfUnknownDisabledPkg()
 {
@@ -173,6 +577,7 @@ SBMLDocument::SBMLDocument (SBMLNamespaces* sbmlns) :
   mInternalValidator->setConversionValidators(AllChecksON);
 
   mSBML = this;
+  unshareSBMLNamespaces();
   mLevel   = sbmlns->getLevel();
   mVersion = sbmlns->getVersion();
 
@@ -232,6 +637,9 @@ SBMLDocument::SBMLDocument (SBMLNamespaces* sbmlns) :
  */
 SBMLDocument::~SBMLDocument ()
 {
+  delete mElementIdIndex;
+  mElementIdIndex = NULL;
+
   if (mInternalValidator != NULL)
     delete mInternalValidator;
   if (mModel != NULL)
@@ -249,6 +657,10 @@ SBMLDocument::SBMLDocument (const SBMLDocument& orig)
  , mVersion ( orig.mVersion )
  , mModel ( NULL          )
  , mLocationURI (orig.mLocationURI )
+ , mIdIndexEnabled (orig.mIdIndexEnabled )
+ , mElementIdIndex (NULL)
+ , mDeferAnnotations(false)
+ , mReadFilter(NULL)
  , mErrorLog()
  , mValidators ()
  , mInternalValidator(new SBMLInternalValidator())
@@ -256,9 +668,8 @@ SBMLDocument::SBMLDocument (const SBMLDocument& orig)
  , mRequiredAttrOfUnknownDisabledPkg(orig.mRequiredAttrOfUnknownDisabledPkg)
  , mPkgUseDefaultNSMap()
 {
-  
-  
   SBMLDocument::setSBMLDocument(this);
+  unshareSBMLNamespaces();
   
   mInternalValidator->setDocument(this);
   mInternalValidator->setApplicableValidators(orig.getApplicableValidators());
@@ -283,10 +694,15 @@ SBMLDocument& SBMLDocument::operator=(const SBMLDocument& rhs)
   {
     this->SBase::operator =(rhs);
     setSBMLDocument(this);
+    unshareSBMLNamespaces();
 
     mLevel                             = rhs.mLevel;
     mVersion                           = rhs.mVersion;
     mLocationURI                       = rhs.mLocationURI;
+    mIdIndexEnabled                    = rhs.mIdIndexEnabled;
+
+    delete mElementIdIndex;
+    mElementIdIndex = NULL;
 
     if (mInternalValidator != NULL)
     {
@@ -402,9 +818,11 @@ SBase*
 SBMLDocument::getElementBySId(const std::string& id)
 {
   if (id.empty()) return NULL;
+  SBase* obj = NULL;
+  if (lookupIdIndex(this, id, false, obj)) return obj;
   if (mModel != NULL) {
     if (mModel->getId() == id) return mModel;
-    SBase* obj = mModel->getElementBySId(id);
+    obj = mModel->getElementBySId(id);
     if (obj != NULL) return obj;
   }
   return getElementFromPluginsBySId(id);
@@ -415,10 +833,12 @@ SBase*
 SBMLDocument::getElementByMetaId(const std::string& metaid)
 {
   if (metaid.empty()) return NULL;
+  SBase* obj = NULL;
+  if (lookupIdIndex(this, metaid, true, obj)) return obj;
   if (getMetaId()==metaid) return this;
   if (mModel != NULL) {
     if (mModel->getMetaId() == metaid) return mModel;
-    SBase * obj = mModel->getElementByMetaId(metaid);
+    obj = mModel->getElementByMetaId(metaid);
     if (obj != NULL) return obj;
   }
   return getElementFromPluginsByMetaId(metaid);
@@ -669,6 +1089,95 @@ SBMLDocument::getLocationURI()
 }
 
 
+void
+SBMLDocument::setIdIndexEnabled (bool enabled)
+{
+  mIdIndexEnabled = enabled;
+}
+
+
+bool
+SBMLDocument::isIdIndexEnabled () const
+{
+  return mIdIndexEnabled;
+}
+
+
+unsigned long
+SBMLDocument::getNumIdIndexLookups () const
+{
+  return (mElementIdIndex != NULL) ? mElementIdIndex->mNumLookups : 0;
+}
+
+
+unsigned long
+SBMLDocument::getNumIdIndexHits () const
+{
+  return (mElementIdIndex != NULL) ? mElementIdIndex->mNumHits : 0;
+}
+
+
+unsigned long
+SBMLDocument::getNumIdIndexBuilds () const
+{
+  return (mElementIdIndex != NULL) ? mElementIdIndex->mNumBuilds : 0;
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+void
+SBMLDocument::updateIdIndex (SBase* element)
+{
+  if (mElementIdIndex != NULL)
+  {
+    mElementIdIndex->update(element);
+  }
+}
+
+
+void
+SBMLDocument::clearIdIndex ()
+{
+  if (mElementIdIndex != NULL)
+  {
+    mElementIdIndex->clear();
+  }
+}
+
+
+void
+SBMLDocument::removeFromIdIndex (SBase* element, bool withDescendants)
+{
+  if (mElementIdIndex == NULL) return;
+
+  mElementIdIndex->remove(element);
+  if (!withDescendants) return;
+
+  List* elements = element->getAllElements();
+  for (ListIterator iter = elements->begin(); iter != elements->end(); ++iter)
+  {
+    mElementIdIndex->remove(static_cast<SBase*>(*iter));
+  }
+  delete elements;
+}
+
+
+bool
+SBMLDocument::lookupIdIndex (SBase* root, const std::string& id,
+                             bool isMetaId, SBase*& element)
+{
+  if (!mIdIndexEnabled) return false;
+
+  if (mElementIdIndex == NULL)
+  {
+    mElementIdIndex = new SBMLDocumentIdIndex(this);
+  }
+
+  return mElementIdIndex->lookup(root, id, isMetaId, element);
+}
+/** @endcond */
+
+
 void 
 SBMLDocument::setConsistencyChecks(SBMLErrorCategory_t category,
                                    bool apply)
@@ -1950,6 +2459,7 @@ SBMLDocument::readAttributes (const XMLAttributes& attributes,
     }
     else
     {
+      unshareSBMLNamespaces();
       mSBMLNamespaces->setLevel(mLevel);
       mSBMLNamespaces->setVersion(mVersion);
       setElementNamespace(mSBMLNamespaces->getURI());
@@ -2363,6 +2873,20 @@ SBMLDocument_getLocationURI(SBMLDocument_t *d)
   return (d != NULL) ? safe_strdup( d->getLocationURI().c_str() ) : NULL;
 }
 
+LIBSBML_EXTERN
+void
+SBMLDocument_setIdIndexEnabled (SBMLDocument_t *d, int enabled)
+{
+  if (d != NULL) d->setIdIndexEnabled(enabled != 0);
+}
+
+LIBSBML_EXTERN
+int
+SBMLDocument_isIdIndexEnabled (const SBMLDocument_t *d)
+{
+  return (d != NULL) ? static_cast<int>(d->isIdIndexEnabled()) : 0;
+}
+
 
 LIBSBML_EXTERN
 void
@@ -345,6 +345,10 @@ class SBMLLevelVersionConverter;
 /** @endcond */
 
 
+/** @cond doxygenLibsbmlInternal */
+class SBMLDocumentIdIndex;
+/** @endcond */
+
 class LIBSBML_EXTERN SBMLDocument: public SBase
 {
 public:
@@ -771,6 +775,116 @@ public:
    */
   std::string getLocationURI();
 
+
+  /**
+   * Enables or disables the identifier index of this SBMLDocument.
+   *
+   * When the index is enabled, looking up an element of a ListOf by its
+   * identifier (for example with Model::getSpecies(const std::string& sid),
+   * Model::getParameter(const std::string& sid) or
+   * Model::getReaction(const std::string& sid)) uses a hash index on the
+   * identifiers instead of a linear search.  The index of each list is
+   * built on the first lookup and kept up to date as items are added,
+   * removed or renamed.
+   *
+   * In addition, getElementBySId() and getElementByMetaId() on this
+   * document and on its Model objects use a document-wide index of the
+   * SIds and metaids of all core and package elements.  That index is
+   * built on the first lookup and then kept up to date as elements are
+   * added, removed or given a new identifier.  Metaids of ListOf objects
+   * that were empty when the index was built are not found through it.
+   *
+   * The indexes are disabled by default.
+   *
+   * @param enabled @c true to enable the index, @c false to disable it.
+   *
+   * @see isIdIndexEnabled()
+   */
+  void setIdIndexEnabled (bool enabled);
+
+
+  /**
+   * Predicate returning @c true if the identifier index of this
+   * SBMLDocument is enabled.
+   *
+   * @return @c true if the index is enabled, @c false otherwise.
+   *
+   * @see setIdIndexEnabled(bool enabled)
+   */
+  bool isIdIndexEnabled () const;
+
+
+  /**
+   * Returns the number of calls to getElementBySId() and
+   * getElementByMetaId() that went through the document-wide identifier
+   * index of this SBMLDocument.
+   *
+   * @return the number of lookups made through the index.
+   *
+   * @see setIdIndexEnabled(bool enabled)
+   * @see getNumIdIndexHits()
+   */
+  unsigned long getNumIdIndexLookups () const;
+
+
+  /**
+   * Returns the number of lookups made through the document-wide
+   * identifier index of this SBMLDocument that were answered by the index
+   * alone, without searching the document.
+   *
+   * @return the number of lookups answered by the index.
+   *
+   * @see getNumIdIndexLookups()
+   */
+  unsigned long getNumIdIndexHits () const;
+
+
+  /**
+   * Returns the number of times the document-wide identifier index of this
+   * SBMLDocument has been built.
+   *
+   * @return the number of times the index has been built.
+   *
+   * @see getNumIdIndexLookups()
+   */
+  unsigned long getNumIdIndexBuilds () const;
+
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Records the current SId and metaid of @p element, which belongs to this
+   * document, in the document-wide identifier index (if it has been built).
+   */
+  void updateIdIndex (SBase* element);
+
+
+  /**
+   * Removes @p element, and if @p withDescendants is @c true the elements
+   * below it, from the document-wide identifier index.
+   */
+  void removeFromIdIndex (SBase* element, bool withDescendants);
+
+
+  /**
+   * Empties the document-wide identifier index without looking at the
+   * elements in it; the next lookup builds it again.
+   */
+  void clearIdIndex ();
+
+
+  /**
+   * Looks up the element with the given SId (or metaid, if @p isMetaId is
+   * @c true) below @p root in the document-wide identifier index.
+   *
+   * @return @c true if the index could answer the lookup, in which case
+   * @p element is set to the result (which may be @c NULL); @c false if
+   * the index is disabled or cannot decide, in which case the caller must
+   * search the document itself.
+   */
+  bool lookupIdIndex (SBase* root, const std::string& id, bool isMetaId,
+                      SBase*& element);
+  /** @endcond */
+
   
   /**
    * Controls the consistency checks that are performed when
@@ -1697,6 +1811,16 @@ protected:
 
   Model* mModel;
   std::string mLocationURI;
+  bool mIdIndexEnabled;
+  SBMLDocumentIdIndex* mElementIdIndex;
+
+  /* set by SBMLReader while reading with deferred annotations and notes */
+  bool mDeferAnnotations;
+
+  /* set by SBMLReader while reading with element or package filters, with
+   * the number of elements skipped so far under each name */
+  const SBMLReader* mReadFilter;
+  std::map<std::string, unsigned int> mNumSkippedOnRead;
 
   SBMLErrorLog mErrorLog;
 
@@ -2178,6 +2302,37 @@ LIBSBML_EXTERN
 char*
 SBMLDocument_getLocationURI(SBMLDocument_t *d);
 
+
+/**
+ * Enables or disables the identifier index of this SBMLDocument_t.
+ *
+ * When enabled, looking up the elements of a ListOf_t by identifier uses
+ * a hash index instead of a linear search.
+ *
+ * @param d the SBMLDocument_t structure.
+ * @param enabled nonzero to enable the index, zero to disable it.
+ *
+ * @memberof SBMLDocument_t
+ */
+LIBSBML_EXTERN
+void
+SBMLDocument_setIdIndexEnabled (SBMLDocument_t *d, int enabled);
+
+
+/**
+ * Predicate returning @c true or @c false depending on whether the
+ * identifier index of this SBMLDocument_t is enabled.
+ *
+ * @param d the SBMLDocument_t structure to query.
+ *
+ * @return nonzero if the index is enabled, zero otherwise.
+ *
+ * @memberof SBMLDocument_t
+ */
+LIBSBML_EXTERN
+int
+SBMLDocument_isIdIndexEnabled (const SBMLDocument_t *d);
+
 /**
  * Allows particular validators to be turned on or off prior to
  * calling checkConsistency. 
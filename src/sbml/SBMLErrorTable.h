@@ -12168,6 +12168,33 @@ static const sbmlErrorTableEntry errorTable[] =
 		 ""}
 	},
 
+	//99951
+	{
+		ElementSkippedWhileReading ,
+		"Elements were skipped while reading.",
+		LIBSBML_CAT_SBML,
+		LIBSBML_SEV_INFO,
+		LIBSBML_SEV_INFO,
+		LIBSBML_SEV_INFO,
+		LIBSBML_SEV_INFO,
+		LIBSBML_SEV_INFO,
+		LIBSBML_SEV_INFO,
+		LIBSBML_SEV_INFO,
+		LIBSBML_SEV_INFO,
+		LIBSBML_SEV_INFO,
+		"Elements were skipped, with their content, as requested by the "
+		"element and package filters of the SBMLReader.  They are not part "
+		"of the model that was read and are not written with it.",
+		{"",
+		 "",
+		 "",
+		 "",
+		 "",
+		 "",
+		 "",
+		 ""}
+	},
+
       /* Explanation about 99994 and 99995:
 
 If SBase::readAttributes function finds an attribute it does not know about
@@ -119,6 +119,7 @@ SBMLNamespaces::initSBMLNamespace()
 SBMLNamespaces::SBMLNamespaces(unsigned int level, unsigned int version)
  : mLevel(level)
   ,mVersion(version)
+  ,mNumOwners(0)
 {
   initSBMLNamespace();
 }
@@ -137,6 +138,7 @@ SBMLNamespaces::SBMLNamespaces(unsigned int level, unsigned int version,
                                const std::string pkgPrefix)
  : mLevel(level)
   ,mVersion(version)
+  ,mNumOwners(0)
 {
   initSBMLNamespace();
 
@@ -181,12 +183,14 @@ SBMLNamespaces::~SBMLNamespaces()
 
 
 /*
- * Copy constructor; creates a copy of a SBMLNamespaces.
+ * Copy constructor; creates a copy of a SBMLNamespaces.  The copy is not
+ * owned by any SBase yet.
  */
 SBMLNamespaces::SBMLNamespaces(const SBMLNamespaces& orig)
  : mLevel(orig.mLevel)
  , mVersion(orig.mVersion)
  , mNamespaces(NULL)
+ , mNumOwners(0)
 {
   if(orig.mNamespaces != NULL)
     this->mNamespaces = 
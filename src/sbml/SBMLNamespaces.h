@@ -141,6 +141,8 @@ static const char* const SBML_XMLNS_L3V2 = "http://www.sbml.org/sbml/level3/vers
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+class SBase;
+
 class LIBSBML_EXTERN SBMLNamespaces
 {
 public:
@@ -632,6 +634,17 @@ protected:
   unsigned int    mVersion;
   XMLNamespaces * mNamespaces;
 
+#ifndef SWIG
+  /*
+   * The number of SBase objects sharing this object, or 0 if no SBase owns
+   * it.  SBase objects copy a shared object before changing it, and change
+   * the count atomically where the compiler allows.
+   */
+  unsigned int    mNumOwners;
+
+  friend class SBase;
+#endif
+
   /** @endcond */
 };
 
@@ -53,6 +53,8 @@
 #include <sbml/compress/CompressCommon.h>
 #include <sbml/compress/InputDecompressor.h>
 
+#include <sstream>
+
 /** @cond doxygenIgnored */
 using namespace std;
 /** @endcond */
@@ -63,7 +65,10 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 /*
  * Creates a new SBMLReader and returns it. 
  */
-SBMLReader::SBMLReader ()
+SBMLReader::SBMLReader () :
+    mUseMemoryMap ( false )
+  , mChunkSize    ( 0 )
+  , mDeferAnnotations ( false )
 {
 }
 
@@ -92,19 +97,19 @@ SBMLReader::~SBMLReader ()
  * </code>
  *
  * If the filename ends with @em .gz, the file will be read as a @em gzip file.
- * Similary, if the filename ends with @em .zip or @em .bz2, the file will be
- * read as a @em zip or @em bzip2 file, respectively. Otherwise, the fill will be
- * read as an uncompressed file.
+ * Similary, if the filename ends with @em .zip, @em .bz2 or @em .zst, the file
+ * will be read as a @em zip, @em bzip2 or @em Zstandard file, respectively.
+ * Otherwise, the fill will be read as an uncompressed file.
  * If the filename ends with @em .zip, only the first file in the archive will
  * be read if the zip archive contains two or more files.
  *
  * To read a gzip/zip file, underlying libSBML needs to be linked with zlib
  * at compile time. Also, underlying libSBML needs to be linked with bzip2 
- * to read a bzip2 file. File unreadable error will be logged if a compressed 
- * file name is given and underlying libSBML is not linked with the corresponding 
- * required library.
- * SBMLReader::hasZlib() and SBMLReader::hasBzip2() can be used to check 
- * whether libSBML is linked with each library.
+ * to read a bzip2 file, and with zstd to read a Zstandard file. File unreadable
+ * error will be logged if a compressed file name is given and underlying libSBML
+ * is not linked with the corresponding required library.
+ * SBMLReader::hasZlib(), SBMLReader::hasBzip2() and SBMLReader::hasZstd() can be
+ * used to check whether libSBML is linked with each library.
  * 
  * @return a pointer to the SBMLDocument read.
  */
@@ -185,6 +190,143 @@ SBMLReader::hasBzip2()
 }
 
 
+/*
+ * Predicate returning @c true if
+ * libSBML is linked with zstd.
+ *
+ * @return @c true if libSBML is linked with zstd, @c false otherwise.
+ */
+bool 
+SBMLReader::hasZstd() 
+{
+  return LIBSBML_CPP_NAMESPACE ::hasZstd();
+}
+
+
+/*
+ * Sets whether this SBMLReader memory-maps the files it reads.
+ */
+int
+SBMLReader::setUseMemoryMap (bool useMemoryMap)
+{
+  mUseMemoryMap = useMemoryMap;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return true if this SBMLReader memory-maps the files it reads.
+ */
+bool
+SBMLReader::getUseMemoryMap () const
+{
+  return mUseMemoryMap;
+}
+
+
+/*
+ * Sets the number of bytes the XML parser reads at a time.
+ */
+int
+SBMLReader::setChunkSize (unsigned int bytes)
+{
+  // keep in step with the limit of XMLParser::setChunkSize()
+  if (bytes > 1073741824) return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+
+  mChunkSize = bytes;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the chunk size set with setChunkSize(), or 0.
+ */
+unsigned int
+SBMLReader::getChunkSize () const
+{
+  return mChunkSize;
+}
+
+
+/*
+ * Sets whether this SBMLReader defers reading annotations and notes.
+ */
+int
+SBMLReader::setDeferAnnotations (bool deferAnnotations)
+{
+  mDeferAnnotations = deferAnnotations;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return true if this SBMLReader defers reading annotations and notes.
+ */
+bool
+SBMLReader::getDeferAnnotations () const
+{
+  return mDeferAnnotations;
+}
+
+
+/*
+ * Makes this SBMLReader skip all elements with the given name.
+ */
+int
+SBMLReader::addSkippedElement (const std::string& name)
+{
+  if (name.empty()) return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+
+  mSkippedElements.insert(name);
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Makes this SBMLReader skip all elements of the given package.
+ */
+int
+SBMLReader::addSkippedPackage (const std::string& package)
+{
+  if (package.empty()) return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+
+  mSkippedPackages.insert(package);
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return true if this SBMLReader skips elements with the given name.
+ */
+bool
+SBMLReader::isSkippedElement (const std::string& name) const
+{
+  return mSkippedElements.find(name) != mSkippedElements.end();
+}
+
+
+/*
+ * @return true if this SBMLReader skips the elements of the given package.
+ */
+bool
+SBMLReader::isSkippedPackage (const std::string& package) const
+{
+  return mSkippedPackages.find(package) != mSkippedPackages.end();
+}
+
+
+/*
+ * Removes all element and package filters from this SBMLReader.
+ */
+int
+SBMLReader::clearSkipped ()
+{
+  mSkippedElements.clear();
+  mSkippedPackages.clear();
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
 /** @cond doxygenLibsbmlInternal */
 static bool
 isCriticalError(const unsigned int errorId)
@@ -248,6 +390,32 @@ void sortReportedErrors(SBMLDocument* d)
 
 /** @endcond */
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Reports the elements that were skipped while reading the given document,
+ * one diagnostic per element.
+ */
+void
+SBMLReader::logSkippedElements (SBMLDocument* d)
+{
+  const std::map<std::string, unsigned int>& skipped = d->mNumSkippedOnRead;
+
+  for (std::map<std::string, unsigned int>::const_iterator it =
+       skipped.begin(); it != skipped.end(); ++it)
+  {
+    ostringstream msg;
+    msg << "Skipped " << it->second << " " << it->first
+        << (it->second == 1 ? " element" : " elements")
+        << " and the content within, as requested by the filters of the "
+        << "SBMLReader.";
+    d->getErrorLog()->logError(ElementSkippedWhileReading,
+                               d->getLevel(), d->getVersion(), msg.str());
+  }
+
+  d->mNumSkippedOnRead.clear();
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 
 /*
@@ -267,7 +435,8 @@ SBMLReader::readInternal (const char* content, bool isFile)
   }
   else 
   {
-    XMLInputStream stream(content, isFile, "", d->getErrorLog());
+    XMLInputStream stream(content, isFile, "", d->getErrorLog(),
+                          mUseMemoryMap, mChunkSize);
 
     if (stream.peek().isStart())
     {
@@ -294,7 +463,15 @@ SBMLReader::readInternal (const char* content, bool isFile)
       return d;
     }
 
+    d->mDeferAnnotations = mDeferAnnotations;
+    if (!mSkippedElements.empty() || !mSkippedPackages.empty())
+    {
+      d->mReadFilter = this;
+    }
     d->read(stream);
+    d->mDeferAnnotations = false;
+    d->mReadFilter = NULL;
+    logSkippedElements(d);
 
     if (stream.isError())
     {
@@ -441,6 +618,111 @@ SBMLReader_hasBzip2 (void)
 }
 
 
+LIBSBML_EXTERN
+int
+SBMLReader_hasZstd (void)
+{
+  return static_cast<int>( SBMLReader::hasZstd() );
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLReader_setUseMemoryMap (SBMLReader_t *sr, int useMemoryMap)
+{
+  if (sr == NULL) return LIBSBML_INVALID_OBJECT;
+  return sr->setUseMemoryMap(useMemoryMap != 0);
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLReader_getUseMemoryMap (const SBMLReader_t *sr)
+{
+  return (sr != NULL) ? static_cast<int>( sr->getUseMemoryMap() ) : 0;
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLReader_setChunkSize (SBMLReader_t *sr, unsigned int bytes)
+{
+  if (sr == NULL) return LIBSBML_INVALID_OBJECT;
+  return sr->setChunkSize(bytes);
+}
+
+
+LIBSBML_EXTERN
+unsigned int
+SBMLReader_getChunkSize (const SBMLReader_t *sr)
+{
+  return (sr != NULL) ? sr->getChunkSize() : 0;
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLReader_setDeferAnnotations (SBMLReader_t *sr, int deferAnnotations)
+{
+  if (sr == NULL) return LIBSBML_INVALID_OBJECT;
+  return sr->setDeferAnnotations(deferAnnotations != 0);
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLReader_getDeferAnnotations (const SBMLReader_t *sr)
+{
+  return (sr != NULL) ? static_cast<int>( sr->getDeferAnnotations() ) : 0;
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLReader_addSkippedElement (SBMLReader_t *sr, const char *name)
+{
+  if (sr == NULL) return LIBSBML_INVALID_OBJECT;
+  if (name == NULL) return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+  return sr->addSkippedElement(name);
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLReader_addSkippedPackage (SBMLReader_t *sr, const char *package)
+{
+  if (sr == NULL) return LIBSBML_INVALID_OBJECT;
+  if (package == NULL) return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+  return sr->addSkippedPackage(package);
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLReader_isSkippedElement (const SBMLReader_t *sr, const char *name)
+{
+  return (sr != NULL && name != NULL) ?
+    static_cast<int>( sr->isSkippedElement(name) ) : 0;
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLReader_isSkippedPackage (const SBMLReader_t *sr, const char *package)
+{
+  return (sr != NULL && package != NULL) ?
+    static_cast<int>( sr->isSkippedPackage(package) ) : 0;
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLReader_clearSkipped (SBMLReader_t *sr)
+{
+  return (sr != NULL) ? sr->clearSkipped() : LIBSBML_INVALID_OBJECT;
+}
+
+
 LIBSBML_EXTERN
 SBMLDocument_t *
 readSBML (const char *filename)
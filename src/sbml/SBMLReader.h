@@ -67,8 +67,9 @@
  * SBML files.  The process is transparent to the calling
  * application---the application does not need to do anything
  * deliberate to invoke the functionality.  If a given SBML filename ends
- * with an extension for the @em gzip, @em zip or @em bzip2 compression
- * formats (respectively, @c .gz, @c .zip, or @c .bz2), then the methods
+ * with an extension for the @em gzip, @em zip, @em bzip2 or @em Zstandard
+ * compression formats (respectively, @c .gz, @c .zip, @c .bz2 or @c .zst),
+ * then the methods
  * @if python @link SBMLReader::readSBML() SBMLReader.readSBML()@endlink@endif@if java @link SBMLReader::readSBML(String) SBMLReader.readSBML(String)@endlink@endif@if cpp SBMLReader::readSBML()@endif@if csharp SBMLReader.readSBML()@endif@~ and
  * @if python @link SBMLWriter::writeSBML() SBMLWriter.writeSBML()@endlink@endif@if java @link SBMLWriter::writeSBML(String) SBMLWriter.writeSBML(String)@endlink@endif@if cpp SBMLWriter::writeSBML()@endif@if csharp SBMLWriter.writeSBML()@endif@~
  * will automatically decompress and compress the file while reading and
@@ -76,13 +77,14 @@
  * written uncompressed as normal.
  *
  * The compression feature requires that the @em zlib (for @em gzip and @em
- * zip formats) and/or @em bzip2 (for @em bzip2 format) be available on the
- * system running libSBML, and that libSBML was configured with their
+ * zip formats), @em bzip2 (for @em bzip2 format) and/or @em zstd (for
+ * @em Zstandard format) be available on the system running libSBML, and that libSBML was configured with their
  * support compiled-in.  Please see the libSBML
  * @if java <a href="../../../libsbml-installation.html">installation instructions</a> @else <a href="libsbml-installation.html">installation instructions</a>@endif@~
  * for more information about this.  The methods
- * @if java SBMLReader::hasZlib()@else hasZlib()@endif@~ and
- * @if java SBMLReader::hasBzip2()@else hasBzip2()@endif@~
+ * @if java SBMLReader::hasZlib()@else hasZlib()@endif@~,
+ * @if java SBMLReader::hasBzip2()@else hasBzip2()@endif@~ and
+ * @if java SBMLReader::hasZstd()@else hasZstd()@endif@~
  * can be used by an application to query at run-time whether support
  * for the compression libraries is available in the present copy of
  * libSBML.
@@ -106,9 +108,9 @@
  * If the given filename ends with the suffix @c ".gz" (for example,
  * @c "myfile.xml.gz"), the file is assumed to be compressed in @em gzip
  * format and will be automatically decompressed upon reading.
- * Similarly, if the given filename ends with @c ".zip" or @c ".bz2", the
- * file is assumed to be compressed in @em zip or @em bzip2 format
- * (respectively).  Files whose names lack these suffixes will be read
+ * Similarly, if the given filename ends with @c ".zip", @c ".bz2" or
+ * @c ".zst", the file is assumed to be compressed in @em zip, @em bzip2 or
+ * @em Zstandard format (respectively).  Files whose names lack these suffixes will be read
  * uncompressed.  Note that if the file is in @em zip format but the
  * archive contains more than one file, only the first file in the
  * archive will be read and the rest ignored.
@@ -332,6 +334,7 @@ if (doc.getNumErrors() > 0)
 #ifdef __cplusplus
 
 
+#include <set>
 #include <string>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
@@ -441,6 +444,225 @@ public:
   static bool hasBzip2();
 
 
+  /**
+   * Static method; returns @c true if this copy of libSBML supports
+   * <i>Zstandard</i> format compression.
+   *
+   * @return @c true if libSBML is linked with the <i>zstd</i>
+   * library, @c false otherwise.
+   *
+   * @copydetails doc_note_static_methods
+   *
+   * @see @if clike hasZlib() @else SBMLReader::hasZlib()@endif@~
+   */
+  static bool hasZstd();
+
+
+  /**
+   * Sets whether this SBMLReader memory-maps the files it reads.
+   *
+   * When enabled, readSBML() and readSBMLFromFile() map an uncompressed
+   * file into memory and hand its content to the XML parser directly,
+   * instead of copying it through a file stream.  This is usually faster
+   * for large files.  Compressed files (<em>.gz</em>, <em>.zip</em>,
+   * <em>.bz2</em>), and files that cannot be mapped, are read as usual.
+   * The default is @c false.
+   *
+   * @param useMemoryMap @c true to memory-map input files, @c false to
+   * read them through a stream.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   *
+   * @see getUseMemoryMap()
+   */
+  int setUseMemoryMap (bool useMemoryMap);
+
+
+  /**
+   * Returns @c true if this SBMLReader memory-maps the files it reads.
+   *
+   * @return @c true if input files are memory-mapped, @c false otherwise.
+   *
+   * @see setUseMemoryMap(bool useMemoryMap)
+   */
+  bool getUseMemoryMap () const;
+
+
+  /**
+   * Sets the number of bytes the XML parser reads from a file or string
+   * at a time.
+   *
+   * Larger chunks make reading large files faster, as the parser is
+   * called fewer times; smaller chunks keep less parsed content pending
+   * at once.  The default, @c 0, chooses the chunk size from the size of
+   * the content: 8 KB for documents up to 2 MB, growing with the document
+   * up to 256 KB.  The chunk size applies to the Expat and libxml2
+   * parsers and is ignored by Xerces.
+   *
+   * @param bytes the chunk size in bytes, or @c 0 for the adaptive size.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   *
+   * @see getChunkSize()
+   */
+  int setChunkSize (unsigned int bytes);
+
+
+  /**
+   * Returns the chunk size set with setChunkSize(), or @c 0 if it is
+   * chosen from the size of the content.
+   *
+   * @return the chunk size in bytes, or @c 0.
+   *
+   * @see setChunkSize(unsigned int bytes)
+   */
+  unsigned int getChunkSize () const;
+
+
+  /**
+   * Sets whether this SBMLReader defers reading annotations and notes.
+   *
+   * When enabled, the <code>&lt;annotation&gt;</code> and
+   * <code>&lt;notes&gt;</code> elements of SBML components are kept as XML
+   * text when a document is read.  Their XMLNode trees, and the CVTerm and
+   * ModelHistory objects of the annotations, are only built the first time
+   * they are used, for example by SBase::getAnnotation(),
+   * SBase::getNotes(), SBase::getCVTerms() or when the document is
+   * written.  This saves time and memory for applications that do not use
+   * most annotations.  The content is the same as with reading in full.
+   * The default is @c false.
+   *
+   * Errors in deferred annotations and notes (for example malformed RDF or
+   * XHTML) are logged when the content is built, not when the document is
+   * read; writing the document builds all of them.  The annotations and
+   * notes of the SBMLDocument and its Model, of objects from SBML
+   * Level&nbsp;3 packages, and the annotations of species references are
+   * always read in full.
+   *
+   * @warning Deferred content is built by accessors that otherwise only
+   * read, such as SBase::getNotes() const and SBase::getCVTerms() const, so
+   * a document read with deferral must not be used from more than one
+   * thread at a time, even if no thread changes it.  Writing the document
+   * once, or reading it without deferral, makes it safe to share between
+   * threads that only read.
+   *
+   * @param deferAnnotations @c true to defer reading annotations and notes,
+   * @c false to read them in full.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   *
+   * @see getDeferAnnotations()
+   */
+  int setDeferAnnotations (bool deferAnnotations);
+
+
+  /**
+   * Returns @c true if this SBMLReader defers reading annotations and notes.
+   *
+   * @return @c true if annotations and notes are read when first used,
+   * @c false otherwise.
+   *
+   * @see setDeferAnnotations(bool deferAnnotations)
+   */
+  bool getDeferAnnotations () const;
+
+
+  /**
+   * Makes this SBMLReader skip all elements with the given name.
+   *
+   * Skipped elements are consumed by the XML parser together with their
+   * content, without constructing any SBML objects from them, which makes
+   * reading faster for applications that only need part of a model.  The
+   * name is matched against the name of each element that an SBML object
+   * reads as its child, without its prefix and in any namespace; for
+   * example <code>"annotation"</code>, <code>"notes"</code>,
+   * <code>"listOfReactions"</code> or <code>"kineticLaw"</code>.  The
+   * elements skipped while reading a document are reported in its error
+   * log, with one diagnostic of severity
+   * @sbmlconstant{LIBSBML_SEV_INFO, XMLErrorSeverity_t} and code
+   * @sbmlconstant{ElementSkippedWhileReading, SBMLErrorCode_t} per element
+   * name.
+   *
+   * The document that is read lacks the skipped parts: writing it does not
+   * restore them, and validating it may report errors about them, for
+   * example when a <code>&lt;reaction&gt;</code> refers to species of a
+   * skipped <code>&lt;listOfSpecies&gt;</code>.
+   *
+   * @param name the name of the elements to skip.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   *
+   * @see addSkippedPackage(const std::string& package)
+   * @see clearSkipped()
+   */
+  int addSkippedElement (const std::string& name);
+
+
+  /**
+   * Makes this SBMLReader skip all elements of the given SBML Level&nbsp;3
+   * package.
+   *
+   * The package is given by its name, for example <code>"layout"</code>
+   * or <code>"render"</code>, or by the URI of its namespace.  The name
+   * can only be used for packages that are enabled in this copy of
+   * libSBML.  Elements in the namespace of a skipped package are consumed
+   * with their content as described for addSkippedElement(); attributes of
+   * the package on other elements are still read.  Layouts stored in the
+   * annotation of an SBML Level&nbsp;2 model are not elements of the
+   * package and are not skipped.
+   *
+   * @param package the name or namespace URI of the package to skip.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   *
+   * @see addSkippedElement(const std::string& name)
+   * @see clearSkipped()
+   */
+  int addSkippedPackage (const std::string& package);
+
+
+  /**
+   * Returns @c true if this SBMLReader skips elements with the given name.
+   *
+   * @param name the name of an element.
+   *
+   * @return @c true if the name was given to addSkippedElement(),
+   * @c false otherwise.
+   */
+  bool isSkippedElement (const std::string& name) const;
+
+
+  /**
+   * Returns @c true if this SBMLReader skips the elements of the given
+   * package.
+   *
+   * @param package the name or namespace URI of a package, as given to
+   * addSkippedPackage().
+   *
+   * @return @c true if the package was given to addSkippedPackage(),
+   * @c false otherwise.
+   */
+  bool isSkippedPackage (const std::string& package) const;
+
+
+  /**
+   * Removes all element and package filters from this SBMLReader, so that
+   * documents are read in full.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   */
+  int clearSkipped ();
+
+
 protected:
   /** @cond doxygenLibsbmlInternal */
   /**
@@ -450,6 +672,22 @@ protected:
    */
   SBMLDocument* readInternal (const char* content, bool isFile = true);
 
+
+  /**
+   * Logs the elements skipped while reading the given document.
+   */
+  void logSkippedElements (SBMLDocument* d);
+
+
+  bool         mUseMemoryMap;
+  unsigned int mChunkSize;
+  bool         mDeferAnnotations;
+
+  std::set<std::string> mSkippedElements;
+  std::set<std::string> mSkippedPackages;
+
+  friend class SBase;
+
   /** @endcond */
 };
 
@@ -596,6 +834,259 @@ LIBSBML_EXTERN
 int
 SBMLReader_hasBzip2 ();
 
+
+/**
+ * Returns @c 1 (true) if the underlying libSBML supports @em Zstandard
+ * format compression.
+ *
+ * This predicate tests whether the underlying copy of the libSBML library
+ * has been linked with the necessary libraries to support @em Zstandard
+ * compression.
+ *
+ * @return @c 1 (true) if libSBML is linked with zstd, @c 0 (false) otherwise.
+ *
+ * @if conly
+ * @memberof SBMLReader_t
+ * @endif
+ */
+LIBSBML_EXTERN
+int
+SBMLReader_hasZstd ();
+
+
+/**
+ * Sets whether the given SBMLReader_t memory-maps the files it reads.
+ *
+ * When enabled, uncompressed files are mapped into memory and handed to
+ * the XML parser directly instead of being read through a file stream.
+ * Compressed files, and files that cannot be mapped, are read as usual.
+ *
+ * @param sr the SBMLReader_t structure to use.
+ *
+ * @param useMemoryMap @c 1 (true) to memory-map input files, @c 0 (false)
+ * otherwise.
+ *
+ * @copydetails doc_returns_success_code
+ * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+ *
+ * @if conly
+ * @memberof SBMLReader_t
+ * @endif
+ */
+LIBSBML_EXTERN
+int
+SBMLReader_setUseMemoryMap (SBMLReader_t *sr, int useMemoryMap);
+
+
+/**
+ * Returns @c 1 (true) if the given SBMLReader_t memory-maps the files it
+ * reads.
+ *
+ * @param sr the SBMLReader_t structure to use.
+ *
+ * @return @c 1 (true) if input files are memory-mapped, @c 0 (false)
+ * otherwise or if @p sr is @c NULL.
+ *
+ * @if conly
+ * @memberof SBMLReader_t
+ * @endif
+ */
+LIBSBML_EXTERN
+int
+SBMLReader_getUseMemoryMap (const SBMLReader_t *sr);
+
+
+/**
+ * Sets the number of bytes the XML parser of the given SBMLReader_t reads
+ * at a time, or @c 0 to choose it from the size of the content.
+ *
+ * @param sr the SBMLReader_t structure to use.
+ *
+ * @param bytes the chunk size in bytes, or @c 0 for the adaptive size.
+ *
+ * @copydetails doc_returns_success_code
+ * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+ *
+ * @if conly
+ * @memberof SBMLReader_t
+ * @endif
+ */
+LIBSBML_EXTERN
+int
+SBMLReader_setChunkSize (SBMLReader_t *sr, unsigned int bytes);
+
+
+/**
+ * Returns the chunk size set on the given SBMLReader_t, or @c 0 if it is
+ * chosen from the size of the content.
+ *
+ * @param sr the SBMLReader_t structure to use.
+ *
+ * @return the chunk size in bytes, or @c 0 (also if @p sr is @c NULL).
+ *
+ * @if conly
+ * @memberof SBMLReader_t
+ * @endif
+ */
+LIBSBML_EXTERN
+unsigned int
+SBMLReader_getChunkSize (const SBMLReader_t *sr);
+
+
+/**
+ * Sets whether the given SBMLReader_t defers reading annotations and
+ * notes until they are first used.
+ *
+ * When enabled, annotations and notes of SBML components are kept as XML
+ * text and only turned into XMLNode_t trees, CVTerm_t and ModelHistory_t
+ * structures when first accessed.  Errors in them are logged at that
+ * point.  Because that happens in accessors that otherwise only read, a
+ * document read with deferral must not be used from more than one thread
+ * at a time.
+ *
+ * @param sr the SBMLReader_t structure to use.
+ *
+ * @param deferAnnotations @c 1 (true) to defer reading annotations and
+ * notes, @c 0 (false) otherwise.
+ *
+ * @copydetails doc_returns_success_code
+ * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+ *
+ * @if conly
+ * @memberof SBMLReader_t
+ * @endif
+ */
+LIBSBML_EXTERN
+int
+SBMLReader_setDeferAnnotations (SBMLReader_t *sr, int deferAnnotations);
+
+
+/**
+ * Returns @c 1 (true) if the given SBMLReader_t defers reading annotations
+ * and notes.
+ *
+ * @param sr the SBMLReader_t structure to use.
+ *
+ * @return @c 1 (true) if annotations and notes are read when first used,
+ * @c 0 (false) otherwise or if @p sr is @c NULL.
+ *
+ * @if conly
+ * @memberof SBMLReader_t
+ * @endif
+ */
+LIBSBML_EXTERN
+int
+SBMLReader_getDeferAnnotations (const SBMLReader_t *sr);
+
+
+/**
+ * Makes the given SBMLReader_t skip all elements with the given name.
+ *
+ * Skipped elements are consumed together with their content, without
+ * constructing any SBML structures from them.  The elements skipped while
+ * reading a document are reported in its error log.
+ *
+ * @param sr the SBMLReader_t structure to use.
+ *
+ * @param name the name of the elements to skip, without prefix.
+ *
+ * @copydetails doc_returns_success_code
+ * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+ *
+ * @if conly
+ * @memberof SBMLReader_t
+ * @endif
+ */
+LIBSBML_EXTERN
+int
+SBMLReader_addSkippedElement (SBMLReader_t *sr, const char *name);
+
+
+/**
+ * Makes the given SBMLReader_t skip all elements of the given SBML
+ * Level&nbsp;3 package.
+ *
+ * @param sr the SBMLReader_t structure to use.
+ *
+ * @param package the name or namespace URI of the package to skip.
+ *
+ * @copydetails doc_returns_success_code
+ * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+ *
+ * @if conly
+ * @memberof SBMLReader_t
+ * @endif
+ */
+LIBSBML_EXTERN
+int
+SBMLReader_addSkippedPackage (SBMLReader_t *sr, const char *package);
+
+
+/**
+ * Returns @c 1 (true) if the given SBMLReader_t skips elements with the
+ * given name.
+ *
+ * @param sr the SBMLReader_t structure to use.
+ *
+ * @param name the name of an element.
+ *
+ * @return @c 1 (true) if the elements are skipped, @c 0 (false) otherwise
+ * or if @p sr or @p name is @c NULL.
+ *
+ * @if conly
+ * @memberof SBMLReader_t
+ * @endif
+ */
+LIBSBML_EXTERN
+int
+SBMLReader_isSkippedElement (const SBMLReader_t *sr, const char *name);
+
+
+/**
+ * Returns @c 1 (true) if the given SBMLReader_t skips the elements of the
+ * given package.
+ *
+ * @param sr the SBMLReader_t structure to use.
+ *
+ * @param package the name or namespace URI of a package.
+ *
+ * @return @c 1 (true) if the elements are skipped, @c 0 (false) otherwise
+ * or if @p sr or @p package is @c NULL.
+ *
+ * @if conly
+ * @memberof SBMLReader_t
+ * @endif
+ */
+LIBSBML_EXTERN
+int
+SBMLReader_isSkippedPackage (const SBMLReader_t *sr, const char *package);
+
+
+/**
+ * Removes all element and package filters from the given SBMLReader_t.
+ *
+ * @param sr the SBMLReader_t structure to use.
+ *
+ * @copydetails doc_returns_success_code
+ * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+ *
+ * @if conly
+ * @memberof SBMLReader_t
+ * @endif
+ */
+LIBSBML_EXTERN
+int
+SBMLReader_clearSkipped (SBMLReader_t *sr);
+
 #endif  /* !SWIG */
 
 
@@ -56,7 +56,18 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 #ifdef __cplusplus
 
 /** @cond doxygenLibsbmlInternal */
-SBMLTransforms::IdValueMap SBMLTransforms::mValues;
+/*
+ * The values used by the static mapComponentValues()/evaluateASTNode()
+ * API, and the values of the evaluation in progress while an AST plugin
+ * evaluates its node.  Both are per thread where the compiler allows it.
+ */
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1900)
+static thread_local SBMLEvaluationContext sThreadContext;
+static thread_local const SBMLTransforms::IdValueMap* sPluginValues = NULL;
+#else
+static SBMLEvaluationContext sThreadContext;
+static const SBMLTransforms::IdValueMap* sPluginValues = NULL;
+#endif
 
 void
 SBMLTransforms::replaceFD(ASTNode * node, const ListOfFunctionDefinitions *lofd, const IdList* idsToExclude /*= NULL*/)
@@ -246,7 +257,7 @@ SBMLTransforms::nodeContainsNameNotInList(const ASTNode * node, IdList& ids)
 IdList 
 SBMLTransforms::mapComponentValues(const Model * m)
 {
-  return getComponentValuesForModel(m, mValues);
+  return sThreadContext.mapComponentValues(m);
 }
 
 /**
@@ -525,7 +536,7 @@ SBMLTransforms::getComponentValuesForModel(const Model * m, IdValueMap& values)
 void 
 SBMLTransforms::clearComponentValues()
 {
-  mValues.clear();
+  sThreadContext.clear();
 }
 
 
@@ -533,11 +544,18 @@ SBMLTransforms::clearComponentValues()
 double
 SBMLTransforms::evaluateASTNode(const ASTNode *node, const Model *m)
 {
-  if (mValues.size() == 0)
+  // an AST plugin evaluating its children continues the evaluation that
+  // called it
+  if (sPluginValues != NULL)
   {
-    mapComponentValues(m);
+    return evaluateASTNode(node, *sPluginValues, m);
   }
-  return evaluateASTNode(node, mValues, m);
+
+  if (sThreadContext.isEmpty())
+  {
+    sThreadContext.mapComponentValues(m);
+  }
+  return evaluateASTNode(node, sThreadContext.getValues(), m);
 }
 
 double 
@@ -844,7 +862,16 @@ SBMLTransforms::evaluateASTNode(const ASTNode * node, const IdValueMap& values,
     break;
 
   case AST_FUNCTION_FACTORIAL:
-    i = (int)(floor(evaluateASTNode(node->getChild(0), values, m)));
+    result = evaluateASTNode(node->getChild(0), values, m);
+    // converting NaN or a value out of the range of int is undefined;
+    // every factorial from 171! on overflows to infinity
+    if (util_isNaN(result)) break;
+    if (result >= 171)
+    {
+      result = numeric_limits<double>::infinity();
+      break;
+    }
+    i = (result < 2) ? 1 : (int)(floor(result));
     result = 1;
     for(; i>1; --i)
     {
@@ -1092,7 +1119,10 @@ SBMLTransforms::evaluateASTNode(const ASTNode * node, const IdValueMap& values,
       const ASTBasePlugin* baseplugin = node->getPlugin(p);
       if (baseplugin->defines(node->getType()))
       {
+        const IdValueMap* previous = sPluginValues;
+        sPluginValues = &values;
         result = baseplugin->evaluateASTNode(node, m);
+        sPluginValues = previous;
       }
     }
   }
@@ -1102,14 +1132,15 @@ SBMLTransforms::evaluateASTNode(const ASTNode * node, const IdValueMap& values,
 }
 
 bool
-SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia)
+SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia,
+                         IdValueMap& values)
 {
   bool removed = false;
   std::string id = ia->getSymbol();
   if (m->getCompartment(id) != NULL) 
   {
     if (expandInitialAssignment(m->getCompartment(id), 
-                                ia))
+                                ia, values))
     {
       delete m->removeInitialAssignment(id);
       removed = true;
@@ -1118,7 +1149,7 @@ SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia)
   else if (m->getParameter(id) != NULL)
   {
     if (expandInitialAssignment(m->getParameter(id), 
-                                ia))
+                                ia, values))
     {
       delete m->removeInitialAssignment(id);
       removed = true;
@@ -1127,7 +1158,7 @@ SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia)
   else if (m->getSpecies(id) != NULL)
   {
     if (expandInitialAssignment(m->getSpecies(id), 
-                                ia))
+                                ia, values))
     {
       delete m->removeInitialAssignment(id);
       removed = true;
@@ -1144,7 +1175,7 @@ SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia)
         if (r->getProduct(k)->getId() == id)
         {
           if (expandInitialAssignment(r->getProduct(k), 
-                                      ia))
+                                      ia, values))
           {
             delete m->removeInitialAssignment(id);
             removed = true;
@@ -1156,7 +1187,7 @@ SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia)
         if (r->getReactant(k)->getId() == id)
         {
           if (expandInitialAssignment(r->getReactant(k), 
-                                      ia))
+                                      ia, values))
           {
             delete m->removeInitialAssignment(id);
             removed = true;
@@ -1172,7 +1203,9 @@ SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia)
 bool 
 SBMLTransforms::expandInitialAssignments(Model * m)
 {
-  IdList idsNoValues = mapComponentValues(m);
+  SBMLEvaluationContext context;
+  IdValueMap& values = context.getValues();
+  IdList idsNoValues = context.mapComponentValues(m);
   IdList idsWithValues;
 
   IdValueIter iter;
@@ -1187,7 +1220,7 @@ SBMLTransforms::expandInitialAssignments(Model * m)
     
     /* list ids that have a calculated/assigned value */
     idsWithValues.clear();
-    for (iter = mValues.begin(); iter != mValues.end(); ++iter)
+    for (iter = values.begin(); iter != values.end(); ++iter)
     {
       if (((*iter).second).second)
       {
@@ -1204,7 +1237,7 @@ SBMLTransforms::expandInitialAssignments(Model * m)
           if (!nodeContainsNameNotInList(m->getInitialAssignment(i)->getMath(), 
                                                                    idsWithValues))
           {
-            bool removed = expandIA(m, m->getInitialAssignment(i));
+            bool removed = expandIA(m, m->getInitialAssignment(i), values);
             if (removed) count--;
           }
         }
@@ -1226,9 +1259,6 @@ SBMLTransforms::expandInitialAssignments(Model * m)
   }
   while(count > 0 && needToBail == false);
 
-  // clear the internal map of values
-  mValues.clear();
-
   return true;
 }
 
@@ -1236,7 +1266,9 @@ SBMLTransforms::expandInitialAssignments(Model * m)
 bool 
 SBMLTransforms::expandL3V2InitialAssignments(Model * m)
 {
-  IdList idsNoValues = mapComponentValues(m);
+  SBMLEvaluationContext context;
+  IdValueMap& values = context.getValues();
+  IdList idsNoValues = context.mapComponentValues(m);
   IdList idsWithValues;
 
   IdValueIter iter;
@@ -1251,7 +1283,7 @@ SBMLTransforms::expandL3V2InitialAssignments(Model * m)
     
     /* list ids that have a calculated/assigned value */
     idsWithValues.clear();
-    for (iter = mValues.begin(); iter != mValues.end(); ++iter)
+    for (iter = values.begin(); iter != values.end(); ++iter)
     {
       if (((*iter).second).second)
       {
@@ -1269,7 +1301,7 @@ SBMLTransforms::expandL3V2InitialAssignments(Model * m)
         {
           if (!nodeContainsNameNotInList(ia->getMath(), idsWithValues))
           {
-            bool removed = expandIA(m, ia);
+            bool removed = expandIA(m, ia, values);
             if (removed) count--;
           }
         }
@@ -1291,23 +1323,20 @@ SBMLTransforms::expandL3V2InitialAssignments(Model * m)
   }
   while(count > 0 && needToBail == false);
 
-  // clear the internal map of values
-  mValues.clear();
-
   return true;
 }
 
 
 bool 
 SBMLTransforms::expandInitialAssignment(Compartment * c, 
-    const InitialAssignment *ia)
+    const InitialAssignment *ia, IdValueMap& values)
 {
   bool success = false; 
-  double value = evaluateASTNode(ia->getMath(), c->getModel());
+  double value = evaluateASTNode(ia->getMath(), values, c->getModel());
   if (!util_isNaN(value))
   {
     c->setSize(value);
-    IdValueIter it = mValues.find(c->getId());
+    IdValueIter it = values.find(c->getId());
     ((*it).second).first = value;
     ((*it).second).second = true;
     success = true;
@@ -1318,14 +1347,14 @@ SBMLTransforms::expandInitialAssignment(Compartment * c,
 
 bool 
 SBMLTransforms::expandInitialAssignment(Parameter * p, 
-    const InitialAssignment *ia)
+    const InitialAssignment *ia, IdValueMap& values)
 {
   bool success = false; 
-  double value = evaluateASTNode(ia->getMath(), p->getModel());
+  double value = evaluateASTNode(ia->getMath(), values, p->getModel());
   if (!util_isNaN(value))
   {
     p->setValue(value);
-    IdValueIter it = mValues.find(p->getId());
+    IdValueIter it = values.find(p->getId());
     ((*it).second).first = value;
     ((*it).second).second = true;
     success = true;
@@ -1336,14 +1365,14 @@ SBMLTransforms::expandInitialAssignment(Parameter * p,
 
 bool 
 SBMLTransforms::expandInitialAssignment(SpeciesReference * sr, 
-    const InitialAssignment *ia)
+    const InitialAssignment *ia, IdValueMap& values)
 {
   bool success = false; 
-  double value = evaluateASTNode(ia->getMath(), sr->getModel());
+  double value = evaluateASTNode(ia->getMath(), values, sr->getModel());
   if (!util_isNaN(value))
   {
     sr->setStoichiometry(value);
-    IdValueIter it = mValues.find(sr->getId());
+    IdValueIter it = values.find(sr->getId());
     ((*it).second).first = value;
     ((*it).second).second = true;
     success = true;
@@ -1354,10 +1383,10 @@ SBMLTransforms::expandInitialAssignment(SpeciesReference * sr,
 
 bool 
 SBMLTransforms::expandInitialAssignment(Species * s, 
-    const InitialAssignment *ia)
+    const InitialAssignment *ia, IdValueMap& values)
 {
   bool success = false; 
-  double value = evaluateASTNode(ia->getMath(), s->getModel());
+  double value = evaluateASTNode(ia->getMath(), values, s->getModel());
   if (!util_isNaN(value))
   {
     if (s->getHasOnlySubstanceUnits())
@@ -1369,7 +1398,7 @@ SBMLTransforms::expandInitialAssignment(Species * s,
       s->setInitialConcentration(value);
     }
 
-    IdValueIter it = mValues.find(s->getId());
+    IdValueIter it = values.find(s->getId());
     ((*it).second).first = value;
     ((*it).second).second = true;
     success = true;
@@ -1379,6 +1408,72 @@ SBMLTransforms::expandInitialAssignment(Species * s,
 }
 /** @endcond */
 
+
+SBMLEvaluationContext::SBMLEvaluationContext()
+  : mValues ()
+  , mModel ( NULL )
+{
+}
+
+
+SBMLEvaluationContext::SBMLEvaluationContext(const Model * m)
+  : mValues ()
+  , mModel ( NULL )
+{
+  mapComponentValues(m);
+}
+
+
+IdList
+SBMLEvaluationContext::mapComponentValues(const Model * m)
+{
+  mModel = m;
+  return SBMLTransforms::getComponentValuesForModel(m, mValues);
+}
+
+
+void
+SBMLEvaluationContext::clear()
+{
+  mValues.clear();
+  mModel = NULL;
+}
+
+
+bool
+SBMLEvaluationContext::isEmpty() const
+{
+  return mValues.empty();
+}
+
+
+const Model *
+SBMLEvaluationContext::getModel() const
+{
+  return mModel;
+}
+
+
+SBMLTransforms::IdValueMap&
+SBMLEvaluationContext::getValues()
+{
+  return mValues;
+}
+
+
+const SBMLTransforms::IdValueMap&
+SBMLEvaluationContext::getValues() const
+{
+  return mValues;
+}
+
+
+double
+SBMLEvaluationContext::evaluateASTNode(const ASTNode * node) const
+{
+  return SBMLTransforms::evaluateASTNode(node, mValues, mModel);
+}
+
 #endif /* __cplusplus */
 /** @cond doxygenIgnored */
 /** @endcond */
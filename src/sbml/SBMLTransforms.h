@@ -139,6 +139,16 @@ public:
   static bool expandInitialAssignments(Model * m);
 
 
+  /**
+   * Evaluates the math using the component values mapped by
+   * mapComponentValues(); if none have been mapped the values of @p m are
+   * mapped first.
+   *
+   * The mapped values belong to the calling thread (when libSBML is built
+   * with a C++11 compiler), so threads working on different models do not
+   * interfere.  Code evaluating math for several models should use an
+   * SBMLEvaluationContext instead.
+   */
   static double evaluateASTNode(const ASTNode * node, const Model * m = NULL);
 
   static bool expandL3V2InitialAssignments(Model * m);
@@ -150,8 +160,16 @@ public:
   static IdList getComponentValuesForModel(const Model * m, IdValueMap& values);
 #endif
   
+  /**
+   * Maps the component values of @p m for later calls to
+   * evaluateASTNode(const ASTNode * node, const Model * m); this is a
+   * wrapper around the SBMLEvaluationContext of the calling thread.
+   */
   static IdList mapComponentValues(const Model * m);
 
+  /**
+   * Clears the values mapped by mapComponentValues() for the calling thread.
+   */
   static void clearComponentValues();
 
   static bool nodeContainsId(const ASTNode * node, IdList& ids);
@@ -166,27 +184,118 @@ protected:
   static bool nodeContainsNameNotInList(const ASTNode * node, IdList& ids);
   
   static bool expandInitialAssignment(Parameter * p, 
-                                          const InitialAssignment *ia);
+                                          const InitialAssignment *ia,
+                                          IdValueMap& values);
   
   static bool expandInitialAssignment(Compartment * c, 
-                                          const InitialAssignment *ia);
+                                          const InitialAssignment *ia,
+                                          IdValueMap& values);
   
   static bool expandInitialAssignment(SpeciesReference * sr, 
-                                          const InitialAssignment *ia);
+                                          const InitialAssignment *ia,
+                                          IdValueMap& values);
   
   static bool expandInitialAssignment(Species * s, 
-                                          const InitialAssignment *ia);
+                                          const InitialAssignment *ia,
+                                          IdValueMap& values);
 
-  static bool expandIA(Model* m, const InitialAssignment *ia);
+  static bool expandIA(Model* m, const InitialAssignment *ia,
+                       IdValueMap& values);
 
   static void recurseReplaceFD(ASTNode * math, const FunctionDefinition * fd,
                         const IdList* idsToExclude);
 
+};
 
-  static IdValueMap mValues;
 
+#ifndef SWIG
+
+/**
+ * The component values of a Model used to evaluate its math.
+ *
+ * An SBMLEvaluationContext holds the values that
+ * SBMLTransforms::mapComponentValues() used to keep in a single static
+ * map.  Each context is independent, so threads evaluating math for
+ * different models can each use their own without any locking:
+ *
+ * @code
+ * SBMLEvaluationContext context(model);
+ * double value = context.evaluateASTNode(math);
+ * @endcode
+ */
+class LIBSBML_EXTERN SBMLEvaluationContext
+{
+public:
+
+  /**
+   * Creates a context holding no values.
+   */
+  SBMLEvaluationContext();
+
+
+  /**
+   * Creates a context holding the component values of @p m.
+   */
+  SBMLEvaluationContext(const Model * m);
+
+
+  /**
+   * Replaces the values of this context with the component values of @p m.
+   *
+   * @return the list of ids of components whose value could not be
+   * determined.
+   */
+  IdList mapComponentValues(const Model * m);
+
+
+  /**
+   * Removes all values from this context.
+   */
+  void clear();
+
+
+  /**
+   * Returns @c true if this context holds no values.
+   */
+  bool isEmpty() const;
+
+
+  /**
+   * Returns the Model whose values were last mapped, or @c NULL.
+   */
+  const Model * getModel() const;
+
+
+  /**
+   * Returns the values of this context.
+   */
+  SBMLTransforms::IdValueMap& getValues();
+
+
+  /**
+   * Returns the values of this context.
+   */
+  const SBMLTransforms::IdValueMap& getValues() const;
+
+
+  /**
+   * Evaluates the math using the values of this context and the rules,
+   * initial assignments and function definitions of its Model.
+   */
+  double evaluateASTNode(const ASTNode * node) const;
+
+
+protected:
+  /** @cond doxygenLibsbmlInternal */
+
+  SBMLTransforms::IdValueMap mValues;
+  const Model * mModel;
+
+  /** @endcond */
 };
 
+#endif  /* !SWIG */
+
 LIBSBML_CPP_NAMESPACE_END
 
 #endif  /* __cplusplus */
@@ -43,9 +43,11 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <vector>
 
 #include <sbml/common/common.h>
 #include <sbml/xml/XMLOutputStream.h>
+#include <sbml/xml/XMLFileOutputBuffer.h>
 
 #include <sbml/SBMLError.h>
 #include <sbml/SBMLDocument.h>
@@ -64,7 +66,10 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 /*
  * Creates a new SBMLWriter.
  */
-SBMLWriter::SBMLWriter ()
+SBMLWriter::SBMLWriter () :
+    mBufferSize         ( 0 )
+  , mCompressionThreads ( 0 )
+  , mCompressionLevel   ( 0 )
 {
 }
 
@@ -111,13 +116,85 @@ SBMLWriter::setProgramVersion (const std::string& version)
 }
 
 
+/*
+ * Sets the size of the buffer through which files are written.
+ */
+int
+SBMLWriter::setBufferSize (unsigned int bytes)
+{
+  // keep in step with the limit of XMLFileOutputBuffer
+  if (bytes > 1073741824) return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+
+  mBufferSize = bytes;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the buffer size set with setBufferSize(), or 0.
+ */
+unsigned int
+SBMLWriter::getBufferSize () const
+{
+  return mBufferSize;
+}
+
+
+/*
+ * Sets the number of threads compressing .gz, .zip and .zst files.
+ */
+int
+SBMLWriter::setCompressionThreads (unsigned int threads)
+{
+  if (threads > 256) return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+
+  mCompressionThreads = threads;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the number of compressing threads, or 0.
+ */
+unsigned int
+SBMLWriter::getCompressionThreads () const
+{
+  return mCompressionThreads;
+}
+
+
+/*
+ * Sets the compression level of .zst files.
+ */
+int
+SBMLWriter::setCompressionLevel (int level)
+{
+  // ZSTD_MAX_CLEVEL; the lower bound depends on the zstd version and is
+  // checked when the file is opened
+  if (level > 22) return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+
+  mCompressionLevel = level;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the compression level of .zst files, or 0.
+ */
+int
+SBMLWriter::getCompressionLevel () const
+{
+  return mCompressionLevel;
+}
+
+
 /*
  * Writes the given SBML document to filename.
  *
  * If the filename ends with @em .gz, the file will be compressed by @em gzip.
- * Similary, if the filename ends with @em .zip or @em .bz2, the file will be
- * compressed by @em zip or @em bzip2, respectively. Otherwise, the fill will be
- * uncompressed.
+ * Similary, if the filename ends with @em .zip, @em .bz2 or @em .zst, the file
+ * will be compressed by @em zip, @em bzip2 or @em zstd, respectively. Otherwise,
+ * the fill will be uncompressed.
  * If the filename ends with @em .zip, a filename that will be added to the
  * zip archive file will end with @em .xml or @em .sbml. For example, the filename
  * in the zip archive will be @em test.xml if the given filename is @em test.xml.zip
@@ -126,12 +203,12 @@ SBMLWriter::setProgramVersion (const std::string& version)
  *
  * @note To create a gzip/zip file, underlying libSBML needs to be linked with zlib at 
  * compile time. Also, underlying libSBML needs to be linked with bzip2 to create a 
- * bzip2 file.
+ * bzip2 file, and with zstd to create a Zstandard file.
  * File unwritable error will be logged and @c false will be returned if a compressed 
  * file name is given and underlying libSBML is not linked with the corresponding 
  * required library.
- * SBMLWriter::hasZlib() and SBMLWriter::hasBzip2() can be used to check whether
- * underlying libSBML is linked with the library.
+ * SBMLWriter::hasZlib(), SBMLWriter::hasBzip2() and SBMLWriter::hasZstd() can be
+ * used to check whether underlying libSBML is linked with the library.
  *
  * @return @c true on success and false if the filename could not be opened
  * for writing.
@@ -139,25 +216,34 @@ SBMLWriter::setProgramVersion (const std::string& version)
 bool
 SBMLWriter::writeSBML (const SBMLDocument* d, const std::string& filename)
 {
-  std::ostream* stream = NULL;
+  std::ostream* stream       = NULL;
+  bool          uncompressed = false;
+  bool          parallel     = false;
 
   try
   {
     // open an uncompressed XML file.
     if ( string::npos != filename.find(".xml", filename.length() - 4) )
     {
-      stream = new(std::nothrow) std::ofstream(filename.c_str());
+      uncompressed = true;
     }
     // open a gzip file
     else if ( string::npos != filename.find(".gz", filename.length() - 3) )
     {
-     stream = OutputCompressor::openGzipOStream(filename);
+     stream = OutputCompressor::openGzipOStream(filename, mCompressionThreads);
+     parallel = (mCompressionThreads > 0);
     }
     // open a bz2 file
     else if ( string::npos != filename.find(".bz2", filename.length() - 4) )
     {
       stream = OutputCompressor::openBzip2OStream(filename);
     }
+    // open a zstd file
+    else if ( string::npos != filename.find(".zst", filename.length() - 4) )
+    {
+      stream = OutputCompressor::openZstdOStream(filename, mCompressionLevel,
+                                                 mCompressionThreads);
+    }
     // open a zip file
     else if ( string::npos != filename.find(".zip", filename.length() - 4) )
     {
@@ -183,11 +269,13 @@ SBMLWriter::writeSBML (const SBMLDocument* d, const std::string& filename)
       }
 
       
-      stream = OutputCompressor::openZipOStream(filename, filenameinzip);
+      stream = OutputCompressor::openZipOStream(filename, filenameinzip,
+                                                mCompressionThreads);
+      parallel = (mCompressionThreads > 0);
     }
     else
     {
-      stream = new(std::nothrow) std::ofstream(filename.c_str());
+      uncompressed = true;
     }
   }
   catch ( ZlibNotLinked& )
@@ -210,7 +298,21 @@ SBMLWriter::writeSBML (const SBMLDocument* d, const std::string& filename)
     log->add(XMLError( XMLFileUnwritable, oss.str(), 0, 0) );
     return false;
   } 
+  catch ( ZstdNotLinked& )
+  {
+    // libSBML is not linked with zstd.
+    XMLErrorLog *log = (const_cast<SBMLDocument *>(d))->getErrorLog();
+    std::ostringstream oss;
+    oss << "Tried to write " << filename << ". Writing a zstd file is not enabled because "
+        << "underlying libSBML is not linked with zstd."; 
+    log->add(XMLError( XMLFileUnwritable, oss.str(), 0, 0) );
+    return false;
+  } 
 
+  if (uncompressed)
+  {
+    return writeUncompressed(d, filename);
+  }
 
   if ( stream == NULL || stream->fail() || stream->bad())
   {
@@ -220,6 +322,15 @@ SBMLWriter::writeSBML (const SBMLDocument* d, const std::string& filename)
     return false;
   }
 
+  // the compressor collects output in a buffer that outlives the stream;
+  // parallel compressors collect whole blocks themselves
+  vector<char> buffer;
+  if (!parallel)
+  {
+    buffer.resize((mBufferSize > 0) ? mBufferSize : 262144);
+    stream->rdbuf()->pubsetbuf(&buffer[0], (streamsize)buffer.size());
+  }
+
    bool result = writeSBML(d, *stream);
    delete stream;
 
@@ -228,6 +339,39 @@ SBMLWriter::writeSBML (const SBMLDocument* d, const std::string& filename)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Writes the given SBML document to an uncompressed file, through a
+ * buffer that is handed straight to the operating system.
+ */
+bool
+SBMLWriter::writeUncompressed (const SBMLDocument* d, const std::string& filename)
+{
+  XMLFileOutputBuffer buffer(filename, mBufferSize);
+
+  if (!buffer.isOpen())
+  {
+    SBMLErrorLog *log = (const_cast<SBMLDocument *>(d))->getErrorLog();
+    log->logError(XMLFileUnwritable);
+    return false;
+  }
+
+  std::ostream stream(&buffer);
+  bool         result = writeSBML(d, stream);
+
+  // a failure to write out the last of the buffer is only noticed here
+  if (!buffer.close() && result)
+  {
+    SBMLErrorLog *log = (const_cast<SBMLDocument *>(d))->getErrorLog();
+    log->logError(XMLFileOperationError);
+    result = false;
+  }
+
+  return result;
+}
+/** @endcond */
+
+
 /*
  * Writes the given SBML document to the output stream.
  *
@@ -331,6 +475,19 @@ SBMLWriter::hasBzip2()
 }
 
 
+/*
+ * Predicate returning @c true if
+ * underlying libSBML is linked with zstd.
+ *
+ * @return @c true if libSBML is linked with zstd, @c false otherwise.
+ */
+bool 
+SBMLWriter::hasZstd() 
+{
+  return LIBSBML_CPP_NAMESPACE ::hasZstd();
+}
+
+
 #endif /* __cplusplus */
 /** @cond doxygenIgnored */
 LIBSBML_EXTERN
@@ -372,6 +529,57 @@ SBMLWriter_setProgramVersion (SBMLWriter_t *sw, const char *version)
 }
 
 
+LIBSBML_EXTERN
+int
+SBMLWriter_setBufferSize (SBMLWriter_t *sw, unsigned int bytes)
+{
+  if (sw == NULL) return LIBSBML_INVALID_OBJECT;
+  return sw->setBufferSize(bytes);
+}
+
+
+LIBSBML_EXTERN
+unsigned int
+SBMLWriter_getBufferSize (const SBMLWriter_t *sw)
+{
+  return (sw != NULL) ? sw->getBufferSize() : 0;
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLWriter_setCompressionThreads (SBMLWriter_t *sw, unsigned int threads)
+{
+  if (sw == NULL) return LIBSBML_INVALID_OBJECT;
+  return sw->setCompressionThreads(threads);
+}
+
+
+LIBSBML_EXTERN
+unsigned int
+SBMLWriter_getCompressionThreads (const SBMLWriter_t *sw)
+{
+  return (sw != NULL) ? sw->getCompressionThreads() : 0;
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLWriter_setCompressionLevel (SBMLWriter_t *sw, int level)
+{
+  if (sw == NULL) return LIBSBML_INVALID_OBJECT;
+  return sw->setCompressionLevel(level);
+}
+
+
+LIBSBML_EXTERN
+int
+SBMLWriter_getCompressionLevel (const SBMLWriter_t *sw)
+{
+  return (sw != NULL) ? sw->getCompressionLevel() : 0;
+}
+
+
 LIBSBML_EXTERN
 int
 SBMLWriter_writeSBML ( SBMLWriter_t         *sw,
@@ -427,6 +635,14 @@ SBMLWriter_hasBzip2 ()
 }
 
 
+LIBSBML_EXTERN
+int
+SBMLWriter_hasZstd ()
+{
+   return static_cast<int>( SBMLWriter::hasZstd() );
+}
+
+
 LIBSBML_EXTERN
 int
 writeSBML (const SBMLDocument_t *d, const char *filename)
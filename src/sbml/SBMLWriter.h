@@ -56,10 +56,10 @@
  * SBML files.  The process is transparent to the calling
  * application---the application does not need to do anything
  * deliberate to invoke the functionality.  If a given SBML filename ends
- * with an extension for the @em gzip, @em zip or @em bzip2 compression
- * formats (respectively, <code>&quot;.gz&quot;</code>,
- * <code>&quot;.zip&quot;</code>, or <code>&quot;.bz2&quot;</code>),
- * then the methods
+ * with an extension for the @em gzip, @em zip, @em bzip2 or @em Zstandard
+ * compression formats (respectively, <code>&quot;.gz&quot;</code>,
+ * <code>&quot;.zip&quot;</code>, <code>&quot;.bz2&quot;</code> or
+ * <code>&quot;.zst&quot;</code>), then the methods
  * SBMLWriter::writeSBML(@if java SBMLDocument, String@endif)
  * and SBMLReader::readSBML(@if java String@endif)
  * will automatically compress and decompress the file while writing and
@@ -67,12 +67,13 @@
  * will be written and read uncompressed as normal.
  *
  * The compression feature requires that the @em zlib (for @em gzip and @em
- * zip formats) and/or @em bzip2 (for @em bzip2 format) be available on the
- * system running libSBML, and that libSBML was configured with their
+ * zip formats), @em bzip2 (for @em bzip2 format) and/or @em zstd (for
+ * @em Zstandard format) be available on the system running libSBML, and that libSBML was configured with their
  * support compiled-in.  Please see the libSBML @if clike <a href="libsbml-installation.html">installation instructions</a>@endif@if python <a href="libsbml-installation.html">installation instructions</a>@endif@if java  <a href="../../../libsbml-installation.html">installation instructions</a>@endif@~ for 
  * more information about this.  The methods
- * SBMLWriter::hasZlib() and
- * SBMLWriter::hasBzip2()
+ * SBMLWriter::hasZlib(),
+ * SBMLWriter::hasBzip2() and
+ * SBMLWriter::hasZstd()
  * can be used by an application to query at run-time whether support
  * for the compression libraries is available in the present copy of
  * libSBML.
@@ -184,6 +185,107 @@ public:
   int setProgramVersion (const std::string& version);
 
 
+  /**
+   * Sets the size of the buffer through which files are written.
+   *
+   * Uncompressed files are written through a buffer of this size straight
+   * to the underlying file, and the compressed streams used for
+   * @em .gz, @em .bz2, @em .zip and @em .zst files collect output in a buffer of
+   * this size before handing it to the compressor.  Larger buffers mean
+   * fewer calls into the operating system when writing large models.  The
+   * default, @c 0, uses a buffer of 256 KB.  The setting does not affect
+   * writing to a stream or a string.
+   *
+   * @param bytes the buffer size in bytes, or @c 0 for the default size.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   *
+   * @see getBufferSize()
+   */
+  int setBufferSize (unsigned int bytes);
+
+
+  /**
+   * Returns the buffer size set with setBufferSize(), or @c 0 if the
+   * default size is used.
+   *
+   * @return the buffer size in bytes, or @c 0.
+   *
+   * @see setBufferSize(unsigned int bytes)
+   */
+  unsigned int getBufferSize () const;
+
+
+  /**
+   * Sets the number of threads compressing @em .gz, @em .zip and @em .zst
+   * files.
+   *
+   * With a nonzero number of threads, the output is split into blocks of
+   * 128 KB that are compressed in parallel, in the manner of
+   * <a target="_blank" href="http://zlib.net/pigz/">pigz</a>, while the
+   * document is still being written.  The result is a standard gzip file
+   * or zip archive, a little larger than one compressed in a single
+   * piece.  The default, @c 0, compresses on the calling thread.  Where
+   * libSBML is built without C++11 threads, the blocks are compressed on
+   * the calling thread.  @em .zst files are compressed by the worker
+   * threads of the zstd library, where it has been built with them.  The
+   * setting does not affect @em .bz2 files.
+   *
+   * @param threads the number of compressing threads, or @c 0.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   *
+   * @see getCompressionThreads()
+   */
+  int setCompressionThreads (unsigned int threads);
+
+
+  /**
+   * Returns the number of compressing threads set with
+   * setCompressionThreads().
+   *
+   * @return the number of threads, or @c 0 if files are compressed on the
+   * calling thread.
+   *
+   * @see setCompressionThreads(unsigned int threads)
+   */
+  unsigned int getCompressionThreads () const;
+
+
+  /**
+   * Sets the compression level of @em .zst files.
+   *
+   * Levels run from @c 1 (fastest) to @c 22 (smallest); negative levels
+   * trade compression ratio for yet more speed.  The default, @c 0, uses
+   * the default level of the zstd library, currently @c 3.  Decompression
+   * is about equally fast at every level.  The setting does not affect
+   * other file formats.
+   *
+   * @param level the compression level, or @c 0 for the default level.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   *
+   * @see getCompressionLevel()
+   */
+  int setCompressionLevel (int level);
+
+
+  /**
+   * Returns the compression level set with setCompressionLevel().
+   *
+   * @return the compression level, or @c 0 if the default level is used.
+   *
+   * @see setCompressionLevel(int level)
+   */
+  int getCompressionLevel () const;
+
+
   /**
    * Writes the given SBML document to filename.
    *
@@ -334,10 +436,38 @@ public:
   static bool hasBzip2();
 
 
+  /**
+   * Predicate returning @c true if this copy of libSBML has been linked
+   * with the <em>zstd</em> library.
+   *
+   * LibSBML supports reading and writing files compressed with the
+   * Zstandard format where it has been compiled with the zstd library.
+   * This method allows a calling program to inquire whether that is the
+   * case for the copy of libSBML it is using.
+   *
+   * @return @c true if libSBML is linked with zstd, @c false otherwise.
+   *
+   * @copydetails doc_note_static_methods
+   *
+   * @see @if clike hasZlib() @else SBMLWriter::hasZlib() @endif@~
+   */
+  static bool hasZstd();
+
+
  protected:
   /** @cond doxygenLibsbmlInternal */
-  std::string mProgramName;
-  std::string mProgramVersion;
+  /**
+   * Writes the given SBML document to an uncompressed file through an
+   * XMLFileOutputBuffer of the size set with setBufferSize().
+   */
+  bool writeUncompressed (const SBMLDocument* d, const std::string& filename);
+
+
+  std::string  mProgramName;
+  std::string  mProgramVersion;
+  unsigned int mBufferSize;
+  unsigned int mCompressionThreads;
+  int          mCompressionLevel;
 
   /** @endcond */
 };
@@ -431,15 +561,115 @@ LIBSBML_EXTERN
 int
 SBMLWriter_setProgramVersion (SBMLWriter_t *sw, const char *version);
 
+/**
+ * Sets the size of the buffer through which the given SBMLWriter_t writes
+ * files, or @c 0 to use the default of 256 KB.
+ *
+ * @param sw the SBMLWriter_t structure to use.
+ *
+ * @param bytes the buffer size in bytes, or @c 0 for the default size.
+ *
+ * @copydetails doc_returns_success_code
+ * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+ *
+ * @memberof SBMLWriter_t
+ */
+LIBSBML_EXTERN
+int
+SBMLWriter_setBufferSize (SBMLWriter_t *sw, unsigned int bytes);
+
+/**
+ * Returns the buffer size set on the given SBMLWriter_t, or @c 0 if the
+ * default size is used.
+ *
+ * @param sw the SBMLWriter_t structure to use.
+ *
+ * @return the buffer size in bytes, or @c 0 (also if @p sw is @c NULL).
+ *
+ * @memberof SBMLWriter_t
+ */
+LIBSBML_EXTERN
+unsigned int
+SBMLWriter_getBufferSize (const SBMLWriter_t *sw);
+
+/**
+ * Sets the number of threads with which the given SBMLWriter_t compresses
+ * @em .gz and @em .zip files, or @c 0 to compress on the calling thread.
+ *
+ * @param sw the SBMLWriter_t structure to use.
+ *
+ * @param threads the number of compressing threads, or @c 0.
+ *
+ * @copydetails doc_returns_success_code
+ * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+ *
+ * @memberof SBMLWriter_t
+ */
+LIBSBML_EXTERN
+int
+SBMLWriter_setCompressionThreads (SBMLWriter_t *sw, unsigned int threads);
+
+/**
+ * Returns the number of compressing threads set on the given
+ * SBMLWriter_t.
+ *
+ * @param sw the SBMLWriter_t structure to use.
+ *
+ * @return the number of threads, or @c 0 (also if @p sw is @c NULL).
+ *
+ * @memberof SBMLWriter_t
+ */
+LIBSBML_EXTERN
+unsigned int
+SBMLWriter_getCompressionThreads (const SBMLWriter_t *sw);
+
+
+/**
+ * Sets the compression level of @em .zst files written by the given
+ * SBMLWriter_t structure.
+ *
+ * @param sw the SBMLWriter_t structure.
+ * @param level the compression level, or @c 0 for the default level.
+ *
+ * @copydetails doc_returns_success_code
+ * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+ * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+ *
+ * @memberof SBMLWriter_t
+ */
+LIBSBML_EXTERN
+int
+SBMLWriter_setCompressionLevel (SBMLWriter_t *sw, int level);
+
+
+/**
+ * Returns the compression level of @em .zst files written by the given
+ * SBMLWriter_t structure.
+ *
+ * @param sw the SBMLWriter_t structure.
+ *
+ * @return the compression level, or @c 0 if the default level is used.
+ *
+ * @memberof SBMLWriter_t
+ */
+LIBSBML_EXTERN
+int
+SBMLWriter_getCompressionLevel (const SBMLWriter_t *sw);
+
 /**
  * Writes the given SBML document to filename.
  *
  * @htmlinclude assuming-compressed-file.html
  *
  * If the filename ends with @em .gz, the file will be compressed by @em gzip.
- * Similary, if the filename ends with @em .zip or @em .bz2, the file will be
- * compressed by @em zip or @em bzip2, respectively. Otherwise, the fill will be
- * uncompressed.
+ * Similary, if the filename ends with @em .zip, @em .bz2 or @em .zst, the file
+ * will be compressed by @em zip, @em bzip2 or @em zstd, respectively. Otherwise,
+ * the fill will be uncompressed.
  * If the filename ends with @em .zip, a filename that will be added to the
  * zip archive file will end with @em .xml or @em .sbml. For example, the filename
  * in the zip archive will be @em test.xml if the given filename is @em test.xml.zip
@@ -450,13 +680,15 @@ SBMLWriter_setProgramVersion (SBMLWriter_t *sw, const char *version);
  * linked with the <a target="_blank" href="http://www.zlib.net/">zlib</a> library at
  * compile time.  It also needs to be linked with the <a target="_blank"
  * href="">bzip2</a> library to write files in @em bzip2 format.  (Both
- * of these are the default configurations for libSBML.)  Errors about
+ * of these are the default configurations for libSBML.)  Files in
+ * @em Zstandard format need the <a target="_blank"
+ * href="https://facebook.github.io/zstd/">zstd</a> library.  Errors about
  * unreadable files will be logged and this method will return @c 0 (false)
  * if a compressed filename is given and libSBML was @em not linked with
  * the corresponding required library.
  *
- * @note SBMLWriter_hasZlib() and SBMLWriter_hasBzip2() can be used to
- * check whether libSBML has been linked with each library.
+ * @note SBMLWriter_hasZlib(), SBMLWriter_hasBzip2() and SBMLWriter_hasZstd()
+ * can be used to check whether libSBML has been linked with each library.
  *
  * @return @c 1 (true) on success and @c 0 (false) if the filename could not be opened
  * for writing.
@@ -473,9 +705,9 @@ SBMLWriter_writeSBML ( SBMLWriter_t         *sw,
  * Writes the given SBML document to filename.
  *
  * If the filename ends with @em .gz, the file will be compressed by @em gzip.
- * Similary, if the filename ends with @em .zip or @em .bz2, the file will be
- * compressed by @em zip or @em bzip2, respectively. Otherwise, the fill will be
- * uncompressed.
+ * Similary, if the filename ends with @em .zip, @em .bz2 or @em .zst, the file
+ * will be compressed by @em zip, @em bzip2 or @em zstd, respectively. Otherwise,
+ * the fill will be uncompressed.
  * If the filename ends with @em .zip, a filename that will be added to the
  * zip archive file will end with @em .xml or @em .sbml. For example, the filename
  * in the zip archive will be @em test.xml if the given filename is @em test.xml.zip
@@ -483,10 +715,11 @@ SBMLWriter_writeSBML ( SBMLWriter_t         *sw,
  * given filename is @em test.sbml.zip.
  *
  * @note To create a gzip/zip file, libSBML needs to be linked with zlib at 
- * compile time. Also, libSBML needs to be linked with bzip2 to create a bzip2 file.
+ * compile time. Also, libSBML needs to be linked with bzip2 to create a bzip2 file,
+ * and with zstd to create a Zstandard file.
  * File unwritable error will be logged and @c 0 (false) will be returned if a compressed 
  * file name is given and libSBML is not linked with the required library.
- * SBMLWriter_hasZlib() and SBMLWriter_hasBzip2() can be used to check whether
+ * SBMLWriter_hasZlib(), SBMLWriter_hasBzip2() and SBMLWriter_hasZstd() can be used to check whether
  * libSBML was linked with the library at compile time.
  *
  * @return @c 1 (true) on success and @c 0 (false) if the filename could not be opened
@@ -541,6 +774,19 @@ LIBSBML_EXTERN
 int
 SBMLWriter_hasBzip2 ();
 
+
+/**
+ * Predicate returning @c 1 (true) or @c 0 (false) depending on whether
+ * libSBML is linked with zstd at compile time.
+ *
+ * @return @c 1 (true) if zstd is linked, @c 0 (false) otherwise.
+ *
+ * @memberof SBMLWriter_t
+ */
+LIBSBML_EXTERN
+int
+SBMLWriter_hasZstd ();
+
 #endif  /* !SWIG */
 
 
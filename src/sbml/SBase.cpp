@@ -40,6 +40,11 @@
  * ---------------------------------------------------------------------- -->*/
 
 #include <sstream>
+#include <typeinfo>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 #include <sbml/xml/XMLError.h>
 #include <sbml/xml/XMLErrorLog.h>
@@ -56,6 +61,7 @@
 #include <sbml/SBMLError.h>
 #include <sbml/SBMLErrorLog.h>
 #include <sbml/SBMLDocument.h>
+#include <sbml/SBMLReader.h>
 #include <sbml/Model.h>
 #include <sbml/ListOf.h>
 #include <sbml/SBase.h>
@@ -68,6 +74,10 @@
 #include <sbml/extension/SBMLExtensionException.h>
 #include <sbml/util/CallbackRegistry.h>
 
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#define LIBSBML_SHARE_NAMESPACE_COPIES
+#endif
+
 /** @cond doxygenIgnored */
 using namespace std;
 /** @endcond */
@@ -96,6 +106,51 @@ struct ClonePluginEntity
     return sb->clone();
   }
 };
+
+
+/*
+ * Read and change the owner count of shared SBMLNamespaces, atomically
+ * where the compiler allows, as elements sharing them may be copied and
+ * deleted in different threads.
+ */
+static unsigned int
+getNumOwners (const unsigned int& count)
+{
+#if defined(__GNUC__)
+  return __atomic_load_n(&count, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+  return *static_cast<const volatile unsigned int*>(&count);
+#else
+  return count;
+#endif
+}
+
+
+static void
+addOwner (unsigned int& count)
+{
+#if defined(__GNUC__)
+  __atomic_add_fetch(&count, 1, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+  _InterlockedIncrement(reinterpret_cast<volatile long*>(&count));
+#else
+  ++count;
+#endif
+}
+
+
+static unsigned int
+dropOwner (unsigned int& count)
+{
+#if defined(__GNUC__)
+  return __atomic_sub_fetch(&count, 1, __ATOMIC_ACQ_REL);
+#elif defined(_MSC_VER)
+  return (unsigned int)
+    _InterlockedDecrement(reinterpret_cast<volatile long*>(&count));
+#else
+  return --count;
+#endif
+}
 /** @endcond */
 
 
@@ -317,7 +372,10 @@ SBase::SBase (unsigned int level, unsigned int version) :
  , mMetaId ( "" )
  , mNotes     ( NULL )
  , mAnnotation( NULL )
+ , mDeferredNotes     ( NULL )
+ , mDeferredAnnotation( NULL )
  , mSBML      ( NULL )
+ , mIdIndexDocument ( NULL )
  , mSBMLNamespaces (NULL)
  , mUserData(NULL)
  , mSBOTerm   ( -1 )
@@ -337,6 +395,7 @@ SBase::SBase (unsigned int level, unsigned int version) :
  , mElementsOfUnknownDisabledPkg()
 {
   mSBMLNamespaces = new SBMLNamespaces(level, version);
+  addOwner(mSBMLNamespaces->mNumOwners);
 
   //
   // Sets the XMLNS URI of corresponding SBML Level/Version to
@@ -363,7 +422,10 @@ SBase::SBase (const SBMLNamespaces *sbmlns) :
  , mMetaId ( "" )
  , mNotes     ( NULL )
  , mAnnotation( NULL )
+ , mDeferredNotes     ( NULL )
+ , mDeferredAnnotation( NULL )
  , mSBML      ( NULL )
+ , mIdIndexDocument ( NULL )
  , mSBMLNamespaces (NULL)
  , mUserData(NULL)
  , mSBOTerm   ( -1 )
@@ -387,7 +449,7 @@ SBase::SBase (const SBMLNamespaces *sbmlns) :
     std::string err("SBase::SBase(SBMLNamespaces*, SBaseExtensionPoint*) : SBMLNamespaces is null");
     throw SBMLConstructorException(err);
   }
-  mSBMLNamespaces = sbmlns->clone();
+  mSBMLNamespaces = shareSBMLNamespaces(sbmlns);
 
   //
   // Sets the XMLNS URI of corresponding SBML Level/Version to
@@ -417,7 +479,10 @@ SBase::SBase(const SBase& orig)
   , mMetaId (orig.mMetaId)
   , mNotes (NULL)
   , mAnnotation (NULL)
+  , mDeferredNotes (NULL)
+  , mDeferredAnnotation (NULL)
   , mSBML (NULL)
+  , mIdIndexDocument (NULL)
   , mSBMLNamespaces(NULL)
   , mUserData(orig.mUserData)
   , mSBOTerm(orig.mSBOTerm)
@@ -444,9 +509,33 @@ SBase::SBase(const SBase& orig)
   if(orig.mAnnotation != NULL)
     this->mAnnotation = new XMLNode(*const_cast<SBase&>(orig).mAnnotation);
 
-  if(orig.getSBMLNamespaces() != NULL)
-    this->mSBMLNamespaces =
-    new SBMLNamespaces(*const_cast<SBase&>(orig).getSBMLNamespaces());
+  // content that was never used is copied as it was read
+  if(orig.mDeferredNotes != NULL)
+    this->mDeferredNotes = new std::string(*orig.mDeferredNotes);
+
+  if(orig.mDeferredAnnotation != NULL)
+    this->mDeferredAnnotation = new std::string(*orig.mDeferredAnnotation);
+
+  // the namespaces of an element in a document are the document's, which
+  // callers change in place, so a copy shares the element's own only as
+  // long as they match the document's, and a snapshot of those otherwise
+  if(orig.mSBML != NULL)
+  {
+    const SBMLNamespaces* docns = orig.mSBML->mSBMLNamespaces;
+    if (orig.mSBMLNamespaces != NULL &&
+        isSameSBMLNamespaces(orig.mSBMLNamespaces, docns))
+    {
+      this->mSBMLNamespaces = shareSBMLNamespaces(orig.mSBMLNamespaces);
+    }
+    else if (docns != NULL)
+    {
+      this->mSBMLNamespaces = copyDocumentNamespaces(docns);
+    }
+  }
+  else if(orig.mSBMLNamespaces != NULL)
+    this->mSBMLNamespaces = shareSBMLNamespaces(orig.mSBMLNamespaces);
+  else if(orig.getSBMLNamespaces() != NULL)
+    this->mSBMLNamespaces = shareSBMLNamespaces(orig.getSBMLNamespaces());
 
   if(orig.mCVTerms != NULL)
   {
@@ -480,9 +569,14 @@ SBase::SBase(const SBase& orig)
  */
 SBase::~SBase ()
 {
+  if (mIdIndexDocument != NULL)
+    mIdIndexDocument->removeFromIdIndex(this, false);
+
   if (mNotes != NULL)       delete mNotes;
   if (mAnnotation != NULL)  delete mAnnotation;
-  if (mSBMLNamespaces != NULL)  delete mSBMLNamespaces;
+  delete mDeferredNotes;
+  delete mDeferredAnnotation;
+  releaseSBMLNamespaces();
   if (mCVTerms != NULL)
   {
     unsigned int size = mCVTerms->getSize();
@@ -507,9 +601,12 @@ SBase& SBase::operator=(const SBase& rhs)
 {
   if(&rhs!=this)
   {
+    std::string oldId(mId);
     this->mId     = rhs.mId;
     this->mName   = rhs.mName;
     this->mMetaId = rhs.mMetaId;
+    // before the parent and document are replaced by those of rhs
+    updateIdIndexes(oldId);
 
     delete this->mNotes;
 
@@ -525,6 +622,20 @@ SBase& SBase::operator=(const SBase& rhs)
     else
       this->mAnnotation = NULL;
 
+    delete this->mDeferredNotes;
+
+    if(rhs.mDeferredNotes != NULL)
+      this->mDeferredNotes = new std::string(*rhs.mDeferredNotes);
+    else
+      this->mDeferredNotes = NULL;
+
+    delete this->mDeferredAnnotation;
+
+    if(rhs.mDeferredAnnotation != NULL)
+      this->mDeferredAnnotation = new std::string(*rhs.mDeferredAnnotation);
+    else
+      this->mDeferredAnnotation = NULL;
+
     this->mSBML       = rhs.mSBML;
     this->mSBOTerm    = rhs.mSBOTerm;
     this->mLine       = rhs.mLine;
@@ -536,13 +647,11 @@ SBase& SBase::operator=(const SBase& rhs)
     this->mElementsOfUnknownPkg = rhs.mElementsOfUnknownPkg;
     this->mElementsOfUnknownDisabledPkg = rhs.mElementsOfUnknownDisabledPkg;
 
-    delete this->mSBMLNamespaces;
-
-    if(rhs.mSBMLNamespaces != NULL)
-      this->mSBMLNamespaces =
-      new SBMLNamespaces(*const_cast<SBase&>(rhs).mSBMLNamespaces);
-    else
-      this->mSBMLNamespaces = NULL;
+    SBMLNamespaces* sbmlns = (rhs.mSBMLNamespaces != NULL)
+                             ? shareSBMLNamespaces(rhs.mSBMLNamespaces)
+                             : NULL;
+    releaseSBMLNamespaces();
+    this->mSBMLNamespaces = sbmlns;
 
 
     if(this->mCVTerms != NULL)
@@ -752,6 +861,7 @@ SBase::getIdAttribute () const
 XMLNode*
 SBase::getNotes()
 {
+  loadDeferredNotes();
   return mNotes;
 }
 
@@ -759,6 +869,7 @@ SBase::getNotes()
 XMLNode*
 SBase::getNotes() const
 {
+  const_cast <SBase *> (this)->loadDeferredNotes();
   return mNotes;
 }
 
@@ -769,6 +880,7 @@ SBase::getNotes() const
 std::string
 SBase::getNotesString()
 {
+  loadDeferredNotes();
   return XMLNode::convertXMLNodeToString(mNotes);
 }
 
@@ -776,6 +888,7 @@ SBase::getNotesString()
 std::string
 SBase::getNotesString() const
 {
+  const_cast <SBase *> (this)->loadDeferredNotes();
   return XMLNode::convertXMLNodeToString(mNotes);
 }
 
@@ -1055,12 +1168,14 @@ SBase::getColumn () const
 ModelHistory*
 SBase::getModelHistory() const
 {
+  const_cast <SBase *> (this)->loadDeferredAnnotation();
   return mHistory;
 }
 
 ModelHistory*
 SBase::getModelHistory()
 {
+  loadDeferredAnnotation();
   return mHistory;
 }
 
@@ -1116,6 +1231,7 @@ SBase::isSetIdAttribute () const
 bool
 SBase::isSetNotes () const
 {
+  const_cast <SBase *> (this)->loadDeferredNotes();
   return (mNotes != NULL);
 }
 
@@ -1146,6 +1262,7 @@ SBase::isSetSBOTerm () const
 bool
 SBase::isSetModelHistory() const
 {
+  const_cast <SBase *> (this)->loadDeferredAnnotation();
   return (mHistory != NULL);
 }
 
@@ -1156,6 +1273,7 @@ SBase::isSetModelHistory() const
 int
 SBase::setMetaId (const std::string& metaid)
 {
+  loadDeferredAnnotation();
   if (getLevel() == 1)
   {
     return LIBSBML_UNEXPECTED_ATTRIBUTE;
@@ -1163,6 +1281,8 @@ SBase::setMetaId (const std::string& metaid)
   else if (metaid.empty())
   {
     mMetaId.erase();
+    if (mIdIndexDocument != NULL)
+      mIdIndexDocument->updateIdIndex(this);
     // force any annotation to synchronize
     if (isSetAnnotation())
     {
@@ -1177,6 +1297,8 @@ SBase::setMetaId (const std::string& metaid)
   else
   {
     mMetaId = metaid;
+    if (mIdIndexDocument != NULL)
+      mIdIndexDocument->updateIdIndex(this);
     // force any annotation to synchronize
     if (isSetAnnotation())
     {
@@ -1209,7 +1331,9 @@ SBase::setId (const std::string& sid)
     }
     else
     {
+      std::string oldId(mId);
       mId = sid;
+      updateIdIndexes(oldId);
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -1244,7 +1368,9 @@ SBase::setIdAttribute (const std::string& sid)
   }
   else
   {
+    std::string oldId(mId);
     mId = sid;
+    updateIdIndexes(oldId);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -1255,6 +1381,7 @@ SBase::setIdAttribute (const std::string& sid)
 int
 SBase::setAnnotation (const XMLNode* annotation)
 {
+  loadDeferredAnnotation();
   //
   // (*NOTICE*)
   //
@@ -1420,6 +1547,7 @@ SBase::setAnnotation (const std::string& annotation)
 int
 SBase::appendAnnotation (const XMLNode* annotation)
 {
+  loadDeferredAnnotation();
   int success = LIBSBML_OPERATION_FAILED;
   unsigned int duplicates = 0;
 
@@ -1532,6 +1660,7 @@ SBase::appendAnnotation (const XMLNode* annotation)
 int
 SBase::appendAnnotation (const std::string& annotation)
 {
+  loadDeferredAnnotation();
   //
   // (*NOTICE*)
   //
@@ -1573,6 +1702,7 @@ int
 SBase::removeTopLevelAnnotationElement(const std::string& elementName,
     const std::string elementURI, bool removeEmpty)
 {
+  loadDeferredAnnotation();
 
   int success = LIBSBML_OPERATION_FAILED;
   if (mAnnotation == NULL)
@@ -1646,6 +1776,7 @@ SBase::removeTopLevelAnnotationElement(const std::string& elementName,
 int
 SBase::replaceTopLevelAnnotationElement(const XMLNode* annotation)
 {
+  loadDeferredAnnotation();
   int success = LIBSBML_OPERATION_FAILED;
   XMLNode * replacement = NULL;
   if (annotation->getName() == "annotation")
@@ -1709,6 +1840,7 @@ SBase::replaceTopLevelAnnotationElement(const std::string& annotation)
 int
 SBase::setNotes(const XMLNode* notes)
 {
+  loadDeferredNotes();
   if (mNotes == notes)
   {
     return LIBSBML_OPERATION_SUCCESS;
@@ -1857,6 +1989,7 @@ SBase::setNotes(const std::string& notes, bool addXHTMLMarkup)
 int
 SBase::appendNotes(const XMLNode* notes)
 {
+  loadDeferredNotes();
   int success = LIBSBML_OPERATION_FAILED;
   if(notes == NULL)
   {
@@ -2229,6 +2362,7 @@ SBase::appendNotes(const std::string& notes)
 int
 SBase::setModelHistory(ModelHistory * history)
 {
+  loadDeferredAnnotation();
   /* ModelHistory is only allowed on Model in L2
    * but on any element in L3
    */
@@ -2276,7 +2410,12 @@ SBase::setModelHistory(ModelHistory * history)
 void
 SBase::setSBMLDocument (SBMLDocument* d)
 {
+  if (mIdIndexDocument != NULL && mIdIndexDocument != d)
+    mIdIndexDocument->removeFromIdIndex(this, false);
+
   mSBML = d;
+  if (d != NULL)
+    d->updateIdIndex(this);
 
   //
   // (EXTENSION)
@@ -2288,6 +2427,16 @@ SBase::setSBMLDocument (SBMLDocument* d)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+SBase::removeIdentifiersFromIndex ()
+{
+  if (mIdIndexDocument != NULL)
+    mIdIndexDocument->removeFromIdIndex(this, true);
+}
+/** @endcond */
+
+
 /*
   * Sets the parent SBML object of this SBML object.
   *
@@ -2432,6 +2581,8 @@ SBase::setSBOTerm (const std::string &sboid)
 int
 SBase::setNamespaces(XMLNamespaces* xmlns)
 {
+  unshareSBMLNamespaces();
+
   if (xmlns == NULL)
   {
     mSBMLNamespaces->setNamespaces(NULL);
@@ -2452,6 +2603,7 @@ SBase::setNamespaces(XMLNamespaces* xmlns)
 int
 SBase::unsetMetaId ()
 {
+  loadDeferredAnnotation();
   /* only in L2 onwards */
   if (getLevel() < 2)
   {
@@ -2459,6 +2611,8 @@ SBase::unsetMetaId ()
   }
 
   mMetaId.erase();
+  if (mIdIndexDocument != NULL)
+    mIdIndexDocument->updateIdIndex(this);
 
   if (mMetaId.empty())
   {
@@ -2479,7 +2633,9 @@ SBase::unsetId ()
 {
   if (getLevel() == 3 && getVersion() > 1)
   {
+    std::string oldId(mId);
     mId.erase();
+    updateIdIndexes(oldId);
     // HACK to make a rule in l3v2 not able to use this function
     int tc = getTypeCode();
     if (tc == SBML_ALGEBRAIC_RULE || tc == SBML_ASSIGNMENT_RULE ||
@@ -2509,7 +2665,9 @@ SBase::unsetId ()
 int
 SBase::unsetIdAttribute ()
 {
+  std::string oldId(mId);
   mId.erase();
+  updateIdIndexes(oldId);
 
   if (mId.empty())
   {
@@ -2554,6 +2712,7 @@ SBase::unsetName ()
 int
 SBase::unsetNotes ()
 {
+  loadDeferredNotes();
   delete mNotes;
   mNotes = NULL;
   return LIBSBML_OPERATION_SUCCESS;
@@ -2566,6 +2725,7 @@ SBase::unsetNotes ()
 int
 SBase::unsetAnnotation ()
 {
+  loadDeferredAnnotation();
   const XMLNode* empty = NULL;
   return setAnnotation(empty);
 }
@@ -2687,6 +2847,7 @@ int SBase::addTermToExistingBag(CVTerm *term, QualifierType_t type ) const
 int
 SBase::addCVTerm(CVTerm * term, bool newBag)
 {
+  loadDeferredAnnotation();
   unsigned int added = 0;
   // shouldnt add a CVTerm to an object with no metaid
   if (!isSetMetaId())
@@ -2751,6 +2912,7 @@ SBase::addCVTerm(CVTerm * term, bool newBag)
 List*
 SBase::getCVTerms()
 {
+  loadDeferredAnnotation();
   return mCVTerms;
 }
 
@@ -2761,6 +2923,7 @@ SBase::getCVTerms()
 List*
 SBase::getCVTerms() const
 {
+  const_cast <SBase *> (this)->loadDeferredAnnotation();
   return mCVTerms;
 }
 
@@ -2773,6 +2936,7 @@ SBase::getCVTerms() const
 unsigned int
 SBase::getNumCVTerms() const
 {
+  const_cast <SBase *> (this)->loadDeferredAnnotation();
   if (mCVTerms != NULL)
   {
     return mCVTerms->getSize();
@@ -2795,6 +2959,7 @@ SBase::getNumCVTerms() const
 CVTerm*
 SBase::getCVTerm(unsigned int n)
 {
+  loadDeferredAnnotation();
   return (mCVTerms) ? static_cast <CVTerm*> (mCVTerms->get(n)) : NULL;
 }
 
@@ -2806,6 +2971,7 @@ SBase::getCVTerm(unsigned int n)
 int
 SBase::unsetCVTerms()
 {
+  loadDeferredAnnotation();
   if (mCVTerms != NULL)
   {
     unsigned int size = mCVTerms->getSize();
@@ -2825,6 +2991,7 @@ SBase::unsetCVTerms()
 int
 SBase::unsetModelHistory()
 {
+  loadDeferredAnnotation();
   if (mHistory != NULL)
     mHistoryChanged = true;
 
@@ -2862,6 +3029,7 @@ SBase::unsetModelHistory()
 BiolQualifierType_t
 SBase::getResourceBiologicalQualifier(std::string resource) const
 {
+  const_cast <SBase *> (this)->loadDeferredAnnotation();
   if (mCVTerms != NULL)
   {
     for (unsigned int n = 0; n < mCVTerms->getSize(); n++)
@@ -2899,6 +3067,7 @@ SBase::getResourceBiologicalQualifier(std::string resource) const
 ModelQualifierType_t
 SBase::getResourceModelQualifier(std::string resource) const
 {
+  const_cast <SBase *> (this)->loadDeferredAnnotation();
   if (mCVTerms != NULL)
   {
     for (unsigned int n = 0; n < mCVTerms->getSize(); n++)
@@ -3566,6 +3735,7 @@ SBase::enablePackageInternal(const std::string& pkgURI, const std::string& pkgPr
       cout << "[DEBUG] SBase::enablePackageInternal() (uri) " <<  pkgURI
         << " (prefix) " << pkgPrefix << " (element) " << getElementName() << endl;
 #endif
+      unshareSBMLNamespaces();
       mSBMLNamespaces->addNamespace(pkgURI, pkgPrefix);
     }
 
@@ -3669,6 +3839,7 @@ SBase::enablePackageInternal(const std::string& pkgURI, const std::string& pkgPr
 
     if (mSBMLNamespaces)
     {
+      unshareSBMLNamespaces();
       mSBMLNamespaces->removeNamespace(pkgURI);
     }
 
@@ -4211,8 +4382,13 @@ SBase::setSBMLNamespaces(const SBMLNamespaces * sbmlns)
   if (sbmlns == NULL)
     return LIBSBML_INVALID_OBJECT;
 
-  SBMLNamespaces* sbmlnsClone = (sbmlns) ? sbmlns->clone() : 0;
-  setSBMLNamespacesAndOwn(sbmlnsClone);
+  SBMLNamespaces* shared = shareSBMLNamespaces(sbmlns);
+  releaseSBMLNamespaces();
+  mSBMLNamespaces = shared;
+  setElementNamespace(shared->getURI());
+
+  if (mSBML == this)
+    unshareSBMLNamespaces();
 
   return LIBSBML_OPERATION_SUCCESS;
 }
@@ -4224,11 +4400,17 @@ SBase::setSBMLNamespaces(const SBMLNamespaces * sbmlns)
 void
 SBase::setSBMLNamespacesAndOwn(SBMLNamespaces * sbmlns)
 {
-  delete mSBMLNamespaces;
+  releaseSBMLNamespaces();
   mSBMLNamespaces = sbmlns;
 
   if(sbmlns != NULL)
+  {
+    addOwner(sbmlns->mNumOwners);
     setElementNamespace(sbmlns->getURI());
+
+    if (mSBML == this)
+      unshareSBMLNamespaces();
+  }
 }
 
 
@@ -4241,9 +4423,153 @@ SBase::getSBMLNamespaces() const
   
   // initialize SBML namespace if need be
   if (mSBMLNamespaces == NULL)
+  {
     const_cast<SBase*>(this)->mSBMLNamespaces = new SBMLNamespaces();
+    addOwner(mSBMLNamespaces->mNumOwners);
+  }
   return mSBMLNamespaces;  
 }
+
+
+/*
+ * Returns sbmlns with one more owner, or a copy owned by the caller alone
+ * if no SBase owns sbmlns.
+ */
+SBMLNamespaces*
+SBase::shareSBMLNamespaces (const SBMLNamespaces* sbmlns)
+{
+  SBMLNamespaces* shared = const_cast<SBMLNamespaces*>(sbmlns);
+
+  // namespaces no SBase owns belong to the caller, who may change or
+  // delete them
+  if (getNumOwners(shared->mNumOwners) == 0)
+  {
+    shared = sbmlns->clone();
+  }
+
+  addOwner(shared->mNumOwners);
+  return shared;
+}
+
+
+/*
+ * Returns a copy of the namespaces of a document for an element copied
+ * from it.  The copies a thread makes share one such copy for as long as
+ * the namespaces of the documents they come from are the same.
+ */
+SBMLNamespaces*
+SBase::copyDocumentNamespaces (const SBMLNamespaces* docns)
+{
+#ifdef LIBSBML_SHARE_NAMESPACE_COPIES
+  struct LastCopy
+  {
+    SBMLNamespaces* mNamespaces;
+
+    LastCopy() : mNamespaces(NULL) {}
+
+    ~LastCopy()
+    {
+      if (mNamespaces != NULL && dropOwner(mNamespaces->mNumOwners) == 0)
+        delete mNamespaces;
+    }
+  };
+  static thread_local LastCopy last;
+
+  if (last.mNamespaces == NULL
+    || !isSameSBMLNamespaces(last.mNamespaces, docns))
+  {
+    SBMLNamespaces* copy = docns->clone();
+    addOwner(copy->mNumOwners);
+    if (last.mNamespaces != NULL
+      && dropOwner(last.mNamespaces->mNumOwners) == 0)
+    {
+      delete last.mNamespaces;
+    }
+    last.mNamespaces = copy;
+  }
+
+  addOwner(last.mNamespaces->mNumOwners);
+  return last.mNamespaces;
+#else
+  SBMLNamespaces* copy = docns->clone();
+  addOwner(copy->mNumOwners);
+  return copy;
+#endif
+}
+
+
+bool
+SBase::isSameSBMLNamespaces (const SBMLNamespaces* sbmlns1,
+                             const SBMLNamespaces* sbmlns2)
+{
+  if (sbmlns1 == sbmlns2) return true;
+  if (sbmlns1 == NULL || sbmlns2 == NULL) return false;
+
+  if (typeid(*sbmlns1) != typeid(*sbmlns2)
+    || sbmlns1->mLevel != sbmlns2->mLevel
+    || sbmlns1->mVersion != sbmlns2->mVersion)
+  {
+    return false;
+  }
+
+  const ISBMLExtensionNamespaces* extns1 =
+    dynamic_cast<const ISBMLExtensionNamespaces*>(sbmlns1);
+  const ISBMLExtensionNamespaces* extns2 =
+    dynamic_cast<const ISBMLExtensionNamespaces*>(sbmlns2);
+  if (extns1 != NULL && extns2 != NULL
+    && extns1->getPackageVersion() != extns2->getPackageVersion())
+  {
+    return false;
+  }
+
+  const XMLNamespaces* xmlns1 = sbmlns1->mNamespaces;
+  const XMLNamespaces* xmlns2 = sbmlns2->mNamespaces;
+  if (xmlns1 == NULL || xmlns2 == NULL) return xmlns1 == xmlns2;
+  return xmlns1->mNamespaces == xmlns2->mNamespaces;
+}
+
+
+/*
+ * Drops this object's share of its SBMLNamespaces; a document's are its
+ * own and have no count.
+ */
+void
+SBase::releaseSBMLNamespaces ()
+{
+  if (mSBMLNamespaces != NULL
+    && (getNumOwners(mSBMLNamespaces->mNumOwners) == 0
+        || dropOwner(mSBMLNamespaces->mNumOwners) == 0))
+  {
+    delete mSBMLNamespaces;
+  }
+  mSBMLNamespaces = NULL;
+}
+
+
+/*
+ * Gives this object its own copy of shared SBMLNamespaces.
+ */
+void
+SBase::unshareSBMLNamespaces ()
+{
+  if (mSBMLNamespaces == NULL)
+    return;
+
+  if (getNumOwners(mSBMLNamespaces->mNumOwners) > 1)
+  {
+    SBMLNamespaces* copy = mSBMLNamespaces->clone();
+    addOwner(copy->mNumOwners);
+
+    releaseSBMLNamespaces();
+    mSBMLNamespaces = copy;
+  }
+
+  // callers change a document's namespaces in place through
+  // getSBMLNamespaces(), so they are never shared: with no count, any
+  // object given them takes a copy
+  if (mSBML == this)
+    mSBMLNamespaces->mNumOwners = 0;
+}
 /** @endcond */
 
 
@@ -4280,6 +4606,8 @@ SBase::read (XMLInputStream& stream)
   ExpectedAttributes expectedAttributes;
   addExpectedAttributes(expectedAttributes);
   readAttributes( element.getAttributes(), expectedAttributes );
+  if (mIdIndexDocument != NULL)
+    mIdIndexDocument->updateIdIndex(this);
 
   /* if we are reading a document pass the
    * SBML Namespace information to the input stream object
@@ -4390,6 +4718,8 @@ SBase::read (XMLInputStream& stream)
     }
     else if ( next.isStart() )
     {
+      if (skipFilteredElement(stream)) continue;
+
       const std::string nextName = next.getName();
 #if 0
       cout << "[DEBUG] SBase::read " << nextName << " uri "
@@ -4499,6 +4829,7 @@ SBase::write (XMLOutputStream& stream) const
 void
 SBase::writeElements (XMLOutputStream& stream) const
 {
+  const_cast <SBase *> (this)->loadDeferredNotes();
   if (mNotes != NULL)
   {
     mNotes->writeToStream(stream);
@@ -4641,6 +4972,131 @@ SBase::readOtherXML (XMLInputStream& stream)
 /** @endcond */
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Adds to inherited the declaration of the given namespace, unless its
+ * prefix is declared within the element being captured.
+ */
+static void
+addInheritedNamespace (const std::string& prefix, const std::string& uri,
+                       const std::vector<std::string>& scope,
+                       XMLNamespaces& inherited)
+{
+  if (prefix == "xml" || (prefix.empty() && uri.empty())) return;
+
+  if (find(scope.begin(), scope.end(), prefix) == scope.end()
+      && !inherited.hasPrefix(prefix))
+  {
+    inherited.add(uri, prefix);
+  }
+}
+
+
+/*
+ * Writes the element at the head of the stream to out the way
+ * XMLNode(stream) reads it, that is, without whitespace-only text.
+ * Namespaces the element uses from enclosing elements outside the capture
+ * are added to inherited.
+ */
+static void
+captureElement (XMLInputStream& stream, XMLOutputStream& out,
+                std::vector<std::string>& scope, XMLNamespaces& inherited)
+{
+  const XMLToken element = stream.next();
+  const size_t   depth   = scope.size();
+
+  const XMLNamespaces& declared = element.getNamespaces();
+  for (int n = 0; n < declared.getLength(); ++n)
+  {
+    scope.push_back(declared.getPrefix(n));
+  }
+
+  addInheritedNamespace(element.getPrefix(), element.getURI(),
+                        scope, inherited);
+
+  const XMLAttributes& attributes = element.getAttributes();
+  for (int n = 0; n < attributes.getLength(); ++n)
+  {
+    if (!attributes.getPrefix(n).empty())
+    {
+      addInheritedNamespace(attributes.getPrefix(n), attributes.getURI(n),
+                            scope, inherited);
+    }
+  }
+
+  out << element;
+
+  if (!element.isEnd())
+  {
+    while ( stream.isGood() )
+    {
+      const XMLToken& next = stream.peek();
+
+      if ( next.isStart() )
+      {
+        captureElement(stream, out, scope, inherited);
+      }
+      else if ( next.isText() )
+      {
+        if (next.getCharacters().find_first_not_of(" \t\r\n")
+            != string::npos)
+          out << stream.next().getCharacters();
+        else
+          stream.skipText();
+      }
+      else if ( next.isEnd() )
+      {
+        stream.next();
+        break;
+      }
+    }
+
+    out.endElement(XMLTriple(element.getName(), element.getURI(),
+                              element.getPrefix()));
+  }
+
+  scope.resize(depth);
+}
+
+
+/*
+ * Captures the element at the head of the stream as a document that reads
+ * back into the same XMLNode: the element is wrapped in a 'deferred'
+ * element declaring the namespaces it inherits from its ancestors.
+ */
+static std::string*
+captureDeferredElement (XMLInputStream& stream)
+{
+  std::vector<std::string> scope;
+  XMLNamespaces inherited;
+  std::ostringstream element;
+
+  {
+    XMLOutputStream out(element, "UTF-8", false);
+    out.setAutoIndent(false);
+    captureElement(stream, out, scope, inherited);
+  }
+
+  std::ostringstream wrapper;
+  wrapper << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
+
+  {
+    XMLOutputStream out(wrapper, "UTF-8", false);
+    out.setAutoIndent(false);
+    out.startElement("deferred");
+    out << inherited;
+  }
+
+  wrapper << '>';
+
+  std::string* xml = new std::string(wrapper.str());
+  xml->append(element.str());
+  xml->append("</deferred>");
+  return xml;
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 /*
  * @return @c true if read an <annotation> element from the stream
@@ -4666,7 +5122,7 @@ SBase::readAnnotation (XMLInputStream& stream)
     // If an annotation already exists, log it as an error and replace
     // the content of the existing annotation with the new one.
 
-    if (mAnnotation != NULL)
+    if (mAnnotation != NULL || mDeferredAnnotation != NULL)
     {
       string msg = "An SBML <" + getElementName() + "> element ";
       switch(getTypeCode()) {
@@ -4696,78 +5152,104 @@ SBase::readAnnotation (XMLInputStream& stream)
     }
 
     delete mAnnotation;
-    mAnnotation = new XMLNode(stream);
-    checkAnnotation();
-    if(mCVTerms != NULL)
+    mAnnotation = NULL;
+    delete mDeferredAnnotation;
+    mDeferredAnnotation = NULL;
+
+    if (isDeferringAnnotations())
     {
-      unsigned int size = mCVTerms->getSize();
-      while (size--) delete static_cast<CVTerm*>( mCVTerms->remove(0) );
-      delete mCVTerms;
+      mDeferredAnnotation = captureDeferredElement(stream);
     }
-    mCVTerms = new List();
-    /* might have model history on sbase objects */
-    if (getLevel() > 2 && getTypeCode()!= SBML_MODEL)
+    else
     {
-      delete mHistory;
-      if (RDFAnnotationParser::hasHistoryRDFAnnotation(mAnnotation))
-      {
-        mHistory = RDFAnnotationParser::parseRDFAnnotation(mAnnotation,
-                                                getMetaId().c_str(), &(stream));
-        if (mHistory != NULL && mHistory->hasRequiredAttributes() == false)
-        {
-          logError(RDFNotCompleteModelHistory, getLevel(), getVersion(),
-            "An invalid ModelHistory element has been stored.");
-        }
-        setModelHistory(mHistory);
-      }
-      else
-      {
-        mHistory = NULL;
-      }
+      readAnnotationElement(stream);
     }
-    if (RDFAnnotationParser::hasCVTermRDFAnnotation(mAnnotation))
+    return true;
+  }
+
+  return false;
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Reads the <annotation> element at the head of the stream into
+ * mAnnotation, together with the CVTerms and ModelHistory it holds.
+ */
+void
+SBase::readAnnotationElement (XMLInputStream& stream)
+{
+  unsigned int level = getLevel();
+
+  mAnnotation = new XMLNode(stream);
+  checkAnnotation();
+  if(mCVTerms != NULL)
+  {
+    unsigned int size = mCVTerms->getSize();
+    while (size--) delete static_cast<CVTerm*>( mCVTerms->remove(0) );
+    delete mCVTerms;
+  }
+  mCVTerms = new List();
+  /* might have model history on sbase objects */
+  if (getLevel() > 2 && getTypeCode()!= SBML_MODEL)
+  {
+    delete mHistory;
+    if (RDFAnnotationParser::hasHistoryRDFAnnotation(mAnnotation))
     {
-      RDFAnnotationParser::parseRDFAnnotation(mAnnotation, mCVTerms,
+      mHistory = RDFAnnotationParser::parseRDFAnnotation(mAnnotation,
                                               getMetaId().c_str(), &(stream));
-
-      bool hasNestedTerms = false;
-      // look at cvterms to see if we have a nested term
-      for (unsigned int cv = 0; cv < mCVTerms->getSize(); cv++)
+      if (mHistory != NULL && mHistory->hasRequiredAttributes() == false)
       {
-        CVTerm * term = (CVTerm *)(mCVTerms->get(cv));
-        if (term->getNumNestedCVTerms() > 0)
-        {
-          hasNestedTerms = true;
-          /* this essentially tells the code that rewrites the annotation to
-           * reconstruct the node and should leave out the nested bit
-           * if it not allowed
-           */
-          term->setHasBeenModifiedFlag();
-        }
+        logError(RDFNotCompleteModelHistory, getLevel(), getVersion(),
+          "An invalid ModelHistory element has been stored.");
       }
+      setModelHistory(mHistory);
+    }
+    else
+    {
+      mHistory = NULL;
+    }
+  }
+  if (RDFAnnotationParser::hasCVTermRDFAnnotation(mAnnotation))
+  {
+    RDFAnnotationParser::parseRDFAnnotation(mAnnotation, mCVTerms,
+                                            getMetaId().c_str(), &(stream));
 
-      if (hasNestedTerms == true)
+    bool hasNestedTerms = false;
+    // look at cvterms to see if we have a nested term
+    for (unsigned int cv = 0; cv < mCVTerms->getSize(); cv++)
+    {
+      CVTerm * term = (CVTerm *)(mCVTerms->get(cv));
+      if (term->getNumNestedCVTerms() > 0)
       {
-        unsigned int version = getVersion();
-        if (level < 2 || 
-            (level == 2 && version < 5) || 
-            (level == 3) )
-        {
-          logError(NestedAnnotationNotAllowed, level, version,
-            "The nested annotation has been stored but will not be written out.");
-        }
+        hasNestedTerms = true;
+        /* this essentially tells the code that rewrites the annotation to
+         * reconstruct the node and should leave out the nested bit
+         * if it not allowed
+         */
+        term->setHasBeenModifiedFlag();
       }
-      
     }
 
-    for (size_t i=0; i < mPlugins.size(); i++)
+    if (hasNestedTerms == true)
     {
-      mPlugins[i]->parseAnnotation(this, mAnnotation);
+      unsigned int version = getVersion();
+      if (level < 2 || 
+          (level == 2 && version < 5) || 
+          (level == 3) )
+      {
+        logError(NestedAnnotationNotAllowed, level, version,
+          "The nested annotation has been stored but will not be written out.");
+      }
     }
-    return true;
+    
   }
 
-  return false;
+  for (size_t i=0; i < mPlugins.size(); i++)
+  {
+    mPlugins[i]->parseAnnotation(this, mAnnotation);
+  }
 }
 /** @endcond */
 
@@ -4794,7 +5276,7 @@ SBase::readNotes (XMLInputStream& stream)
     // If an annotation element already exists, then the ordering is wrong.
     // In either case, replace existing content with the new notes read.
 
-    if (mNotes != NULL)
+    if (mNotes != NULL || mDeferredNotes != NULL)
     {
       if (getLevel() < 3)
       {
@@ -4807,7 +5289,7 @@ SBase::readNotes (XMLInputStream& stream)
         logError(OnlyOneNotesElementAllowed, getLevel(), getVersion());
       }
     }
-    else if (mAnnotation != NULL)
+    else if (mAnnotation != NULL || mDeferredAnnotation != NULL)
     {
       logError(NotSchemaConformant, getLevel(), getVersion(),
                "Incorrect ordering of <annotation> and <notes> elements -- "
@@ -4816,18 +5298,19 @@ SBase::readNotes (XMLInputStream& stream)
     }
 
     delete mNotes;
-    mNotes = new XMLNode(stream);
-
-    //
-    // checks if the given default namespace (if any) is a valid
-    // SBML namespace
-    //
-    const XMLNamespaces &xmlns = mNotes->getNamespaces();
-    checkDefaultNamespace(&xmlns,"notes");
+    mNotes = NULL;
+    delete mDeferredNotes;
+    mDeferredNotes = NULL;
 
-    if (getSBMLDocument() != NULL && getSBMLDocument()->getNumErrors() == 0)
+    // notes are only checked for valid XHTML in a document without errors,
+    // so only such notes can be checked later
+    if (isDeferringAnnotations() && getSBMLDocument()->getNumErrors() == 0)
     {
-      checkXHTML(mNotes);
+      mDeferredNotes = captureDeferredElement(stream);
+    }
+    else
+    {
+      readNotesElement(stream, false);
     }
     return true;
   }
@@ -4835,6 +5318,143 @@ SBase::readNotes (XMLInputStream& stream)
   return false;
 }
 
+
+/*
+ * Reads the <notes> element at the head of the stream into mNotes.  If
+ * deferred is true, the notes are checked for valid XHTML unless checking
+ * their namespace logs an error; otherwise only if the document has no
+ * errors.
+ */
+void
+SBase::readNotesElement (XMLInputStream& stream, bool deferred)
+{
+  mNotes = new XMLNode(stream);
+
+  SBMLDocument* doc = getSBMLDocument();
+  unsigned int errors = (doc != NULL && deferred) ? doc->getNumErrors() : 0;
+
+  //
+  // checks if the given default namespace (if any) is a valid
+  // SBML namespace
+  //
+  const XMLNamespaces &xmlns = mNotes->getNamespaces();
+  checkDefaultNamespace(&xmlns,"notes");
+
+  if (doc != NULL && doc->getNumErrors() == errors)
+  {
+    checkXHTML(mNotes);
+  }
+}
+
+
+/*
+ * @return true if the annotation and notes of this object are to be
+ * captured as text while reading, to be read in full when first used.
+ */
+bool
+SBase::isDeferringAnnotations () const
+{
+  const SBMLDocument* doc = getSBMLDocument();
+  if (doc == NULL || !doc->mDeferAnnotations) return false;
+
+  // the annotations of the document and the model are parsed by package
+  // plugins while reading, and package objects may parse their own
+  return getTypeCode() != SBML_DOCUMENT && getTypeCode() != SBML_MODEL
+      && getPackageName() == "core";
+}
+
+
+/*
+ * Skips the element at the head of the stream if the SBMLReader reading the
+ * document filters it out, and counts it for the report of the reader.
+ */
+bool
+SBase::skipFilteredElement (XMLInputStream& stream)
+{
+  SBMLDocument* doc = getSBMLDocument();
+  if (doc == NULL || doc->mReadFilter == NULL) return false;
+
+  const SBMLReader* reader = doc->mReadFilter;
+  const XMLToken& element = stream.peek();
+  std::string skipped;
+
+  if (reader->isSkippedElement(element.getName()))
+  {
+    skipped = "<" + element.getName() + ">";
+  }
+  else if (!reader->mSkippedPackages.empty())
+  {
+    const std::string& uri = element.getURI();
+    const SBMLExtension* ext =
+      SBMLExtensionRegistry::getInstance().getExtensionInternal(uri);
+
+    if (reader->isSkippedPackage(uri)
+        || (ext != NULL && reader->isSkippedPackage(ext->getName())))
+    {
+      skipped = "<" + element.getName() + "> (namespace '" + uri + "')";
+    }
+  }
+
+  if (skipped.empty()) return false;
+
+  ++doc->mNumSkippedOnRead[skipped];
+  stream.skipPastEnd(stream.next());
+  return true;
+}
+
+
+/*
+ * Builds the XMLNode tree of deferred notes.
+ */
+void
+SBase::loadDeferredNotes ()
+{
+  if (mDeferredNotes == NULL) return;
+
+  // the content must stay valid while the stream reads it
+  std::string* xml = mDeferredNotes;
+  mDeferredNotes = NULL;
+
+  {
+    SBMLDocument* doc = getSBMLDocument();
+    XMLInputStream stream(xml->c_str(), false, "",
+                          (doc != NULL) ? doc->getErrorLog() : NULL);
+    stream.setSBMLNamespaces(getSBMLNamespaces());
+
+    stream.next();
+    readNotesElement(stream, true);
+  }
+
+  delete xml;
+}
+
+
+/*
+ * Builds the XMLNode tree, CVTerms and ModelHistory of a deferred
+ * annotation.
+ */
+void
+SBase::loadDeferredAnnotation ()
+{
+  if (mDeferredAnnotation == NULL) return;
+
+  // the content must stay valid while the stream reads it
+  std::string* xml = mDeferredAnnotation;
+  mDeferredAnnotation = NULL;
+
+  {
+    SBMLDocument* doc = getSBMLDocument();
+    XMLInputStream stream(xml->c_str(), false, "",
+                          (doc != NULL) ? doc->getErrorLog() : NULL);
+    stream.setSBMLNamespaces(getSBMLNamespaces());
+
+    stream.next();
+    readAnnotationElement(stream);
+  }
+
+  delete xml;
+}
+
 bool
 SBase::getHasBeenDeleted() const
 {
@@ -5397,19 +6017,36 @@ SBase::readAttributes (const XMLAttributes& attributes,
   //
   // check that all attributes are expected
   //
-  for (int i = 0; i < attributes.getLength(); i++)
+  const int  numAttributes = attributes.getLength();
+  const bool isDocument    = (numAttributes > 0 && getElementName() == "sbml");
+
+  for (int i = 0; i < numAttributes; i++)
   {
     std::string name   = attributes.getName(i);
-    std::string uri    = attributes.getURI(i);
     std::string prefix = attributes.getPrefix(i);
 
+    //
+    // unprefixed attributes, by far the most common, only need to be
+    // looked up once
+    //
+    if (prefix.empty())
+    {
+      if (!expectedAttributes.hasAttribute(name))
+      {
+        logUnknownAttribute(name, level, version, getElementName(), prefix);
+      }
+      continue;
+    }
+
+    std::string uri    = attributes.getURI(i);
+
     //
     // To allow prefixed attribute whose namespace doesn't belong to
     // core or extension package.
     //
     // (e.g. xsi:type attribute in Curve element in layout extension)
     //
-    if (!prefix.empty() && expectedAttributes.hasAttribute(prefix + ":" + name))
+    if (expectedAttributes.hasAttribute(prefix + ":" + name))
       continue;
 
 
@@ -5419,7 +6056,7 @@ SBase::readAttributes (const XMLAttributes& attributes,
     // if we happen to be on the sbml element (document) then
     // getPrefix() and mURI have not been set and just return defaults
     // thus a prefix does not appear to come from the right place !!!
-    if (!prefix.empty() && getElementName() == "sbml")
+    if (isDocument)
     {
       if (!expectedAttributes.hasAttribute(name))
       {
@@ -5442,11 +6079,11 @@ SBase::readAttributes (const XMLAttributes& attributes,
         }
       }
     }
-    else if (!prefix.empty() && (prefix != getPrefix()) && (uri != mURI) )
+    else if ((prefix != getPrefix()) && (uri != mURI) )
     {
       storeUnknownExtAttribute(getElementName(), attributes, (unsigned int)i);
     }
-    else if (!prefix.empty() && level == 3 && getPackageCoreVersion() > 1 && (name == "id" || name == "name"))
+    else if (level == 3 && getPackageCoreVersion() > 1 && (name == "id" || name == "name"))
     {
       logUnknownAttribute(name, level, version, getElementName(), prefix);
     }
@@ -5723,6 +6360,20 @@ SBase::getRootElement()
 }
 
 
+void
+SBase::updateIdIndexes (const std::string& oldId)
+{
+  if (mIdIndexDocument != NULL)
+    mIdIndexDocument->updateIdIndex(this);
+
+  if (mParentSBMLObject != NULL
+    && mParentSBMLObject->getTypeCode() == SBML_LIST_OF)
+  {
+    static_cast<ListOf*>(mParentSBMLObject)->updateIdIndex(this, oldId);
+  }
+}
+
+
 /*
  * Subclasses should override this method to write their XML attributes
  * to the XMLOutputStream.  Be sure to call your parent's implementation
@@ -5873,6 +6524,7 @@ SBase::hasOptionalElements() const
 void
 SBase::syncAnnotation ()
 {
+  loadDeferredAnnotation();
   // look to see whether an existing history has been altered
   if (!mHistoryChanged
       && getModelHistory() != NULL
@@ -6919,6 +7571,7 @@ SBase::checkCompatibility(const SBase * object) const
 void
 SBase::removeDuplicateAnnotations()
 {
+  loadDeferredAnnotation();
   bool resetNecessary = false;
   XMLNamespaces xmlns = XMLNamespaces();
   xmlns.add("http://www.sbml.org/libsbml/annotation", "");
@@ -6993,6 +7646,24 @@ SBase::setSBaseFields (const XMLToken& element)
   {
     XMLNamespaces tmpxmlns(element.getNamespaces());
     setNamespaces(&tmpxmlns);
+    return;
+  }
+
+  // an element declaring no namespaces shares those of its parent when the
+  // parent declared none either, rather than copying the document's
+  SBMLNamespaces* parentNS = (mParentSBMLObject != NULL)
+                             ? mParentSBMLObject->mSBMLNamespaces : NULL;
+
+  if (parentNS != NULL && mSBMLNamespaces != NULL
+    && parentNS->getNamespaces() == NULL
+    && parentNS->getLevel()   == mSBMLNamespaces->getLevel()
+    && parentNS->getVersion() == mSBMLNamespaces->getVersion()
+    && parentNS->getURI()     == mSBMLNamespaces->getURI()
+    && parentNS->getPackageName() == mSBMLNamespaces->getPackageName())
+  {
+    SBMLNamespaces* shared = shareSBMLNamespaces(parentNS);
+    releaseSBMLNamespaces();
+    mSBMLNamespaces = shared;
   }
   else
   {
@@ -7078,7 +7749,9 @@ SBase::updateSBMLNamespace(const std::string& package, unsigned int level,
     if (mSBMLNamespaces == NULL)
     {
       mSBMLNamespaces = new SBMLNamespaces(level, version);
+      addOwner(mSBMLNamespaces->mNumOwners);
     }
+    unshareSBMLNamespaces();
 
 
     if (mSBMLNamespaces->getNamespaces() != NULL && 
@@ -7144,6 +7817,7 @@ SBase::updateSBMLNamespace(const std::string& package, unsigned int level,
 
       if (found)
       {
+        unshareSBMLNamespaces();
         mSBMLNamespaces->getNamespaces()->remove(uri);
         mSBMLNamespaces->getNamespaces()->add(newURI, package);
         if (this->getPackageName() == package)
@@ -700,6 +700,10 @@ public:
    * @return the XML Namespaces associated with this SBML object, or @c NULL
    * in certain very usual circumstances where a namespace is not set.
    *
+   * @note Objects that are not part of an SBMLDocument may share their
+   * namespaces with copies of them.  Use setNamespaces() to change the
+   * namespaces of one such object only.
+   *
    * @see getLevel()
    * @see getVersion()
    */
@@ -1714,6 +1718,16 @@ s.setNotes("<body xmlns='http://www.w3.org/1999/xhtml'><p>here is my note</p></b
   /** @endcond */
 
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Removes this object and the objects below it from the identifier index
+   * of its SBMLDocument.  Called when this object is taken out of its
+   * parent without being deleted.
+   */
+  void removeIdentifiersFromIndex ();
+  /** @endcond */
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * Sets the parent SBML object of this SBML object.
@@ -3678,6 +3692,15 @@ SBase.readExtensionAttributes(attributes, expectedAttributes);
   SBase* getRootElement();
 
 
+  /**
+   * Informs the parent ListOf of this element (if any) and the identifier
+   * index of the SBMLDocument that the identifier of this element changed
+   * from @p oldId, so that both indexes stay consistent.  Called by the
+   * setId()/unsetId() methods and by operator=().
+   */
+  void updateIdIndexes (const std::string& oldId);
+
+
   // ------------------------------------------------------------------
 
 
@@ -3686,7 +3709,12 @@ SBase.readExtensionAttributes(attributes, expectedAttributes);
   std::string     mMetaId;
   XMLNode*        mNotes;
   XMLNode*        mAnnotation;
+  /* notes and annotation read with deferral and not used yet */
+  std::string*    mDeferredNotes;
+  std::string*    mDeferredAnnotation;
   SBMLDocument*   mSBML;
+  /* the document whose identifier index holds this object, if any */
+  SBMLDocument*   mIdIndexDocument;
   SBMLNamespaces* mSBMLNamespaces;
   void*           mUserData;
 
@@ -3709,6 +3737,8 @@ SBase.readExtensionAttributes(attributes, expectedAttributes);
 
   std::string mEmptyString;
 
+  friend class SBMLDocumentIdIndex;
+
   //----------------------------------------------------------------------
   //
   // Additional data members for Extension
@@ -3768,6 +3798,31 @@ SBase.readExtensionAttributes(attributes, expectedAttributes);
 
   
   bool getHasBeenDeleted() const;
+
+
+  /**
+   * Builds the notes of this object if they were read with deferral (see
+   * SBMLReader::setDeferAnnotations()) and are not built yet.  Called from
+   * const accessors without any locking, which is why documents read with
+   * deferral are not safe for concurrent readers.
+   */
+  void loadDeferredNotes ();
+
+
+  /**
+   * Builds the annotation of this object, with its CVTerms and
+   * ModelHistory, if it was read with deferral (see
+   * SBMLReader::setDeferAnnotations()) and is not built yet.
+   */
+  void loadDeferredAnnotation ();
+
+
+  /**
+   * Gives this object a copy of its SBMLNamespaces of its own if it shares
+   * them with other objects.  Must be called before changing
+   * mSBMLNamespaces.
+   */
+  void unshareSBMLNamespaces ();
   
   /** @endcond */
 
@@ -3780,6 +3835,35 @@ private:
   void setSBaseFields (const XMLToken& element);
 
 
+  /**
+   * Returns the given SBMLNamespaces with one more owner if an SBase owns
+   * them already, or else a copy of them owned by the caller alone.
+   */
+  static SBMLNamespaces* shareSBMLNamespaces (const SBMLNamespaces* sbmlns);
+
+
+  /**
+   * Returns a copy of the given document namespaces, with one more owner,
+   * for an element copied from that document.
+   */
+  static SBMLNamespaces* copyDocumentNamespaces (const SBMLNamespaces* docns);
+
+
+  /**
+   * Predicate returning @c true if the two SBMLNamespaces are of the same
+   * type and have the same Level, Version and XML namespaces.
+   */
+  static bool isSameSBMLNamespaces (const SBMLNamespaces* sbmlns1,
+                                    const SBMLNamespaces* sbmlns2);
+
+
+  /**
+   * Drops this object's share of its SBMLNamespaces, deleting them with
+   * their last owner.
+   */
+  void releaseSBMLNamespaces ();
+
+
   /**
    * Reads an annotation from the stream and returns true if successful.
    *
@@ -3788,6 +3872,13 @@ private:
   bool readAnnotation (XMLInputStream& stream);
 
 
+  /**
+   * Reads the annotation at the head of the stream into mAnnotation and
+   * parses its CVTerms and ModelHistory.
+   */
+  void readAnnotationElement (XMLInputStream& stream);
+
+
   /**
    * removes resources from the term object that alread exist on this object 
    */
@@ -3806,6 +3897,30 @@ private:
   bool readNotes (XMLInputStream& stream);
 
 
+  /**
+   * Reads the notes at the head of the stream into mNotes and checks them.
+   * Notes read with deferral are checked as they would have been while
+   * reading the document.
+   */
+  void readNotesElement (XMLInputStream& stream, bool deferred);
+
+
+  /**
+   * Returns @c true if the annotation and notes of this object are to be
+   * kept as text while the document is read.
+   */
+  bool isDeferringAnnotations () const;
+
+
+  /**
+   * Skips the element at the head of the stream, with its content, if the
+   * SBMLReader reading the document filters it out.
+   *
+   * @return @c true if the element was skipped.
+   */
+  bool skipFilteredElement (XMLInputStream& stream);
+
+
   /** @endcond */
 };
 
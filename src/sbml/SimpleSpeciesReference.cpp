@@ -247,7 +247,9 @@ SimpleSpeciesReference::setId (const std::string& sid)
                    
     if (enabledLayoutL2)
     {
+      std::string oldId(mId);
       mId = sid;
+      updateIdIndexes(oldId);
       return LIBSBML_OPERATION_SUCCESS;
     }
     else
@@ -261,7 +263,9 @@ SimpleSpeciesReference::setId (const std::string& sid)
   }
   else
   {
+    std::string oldId(mId);
     mId = sid;
+    updateIdIndexes(oldId);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -296,7 +300,9 @@ SimpleSpeciesReference::setName (const std::string& name)
 int
 SimpleSpeciesReference::unsetId ()
 {
+  std::string oldId(mId);
   mId.erase();
+  updateIdIndexes(oldId);
 
   if (mId.empty())
   {
@@ -317,7 +323,9 @@ SimpleSpeciesReference::unsetName ()
 {
   if (getLevel() == 1) 
   {
+    std::string oldId(mId);
     mId.erase();
+    updateIdIndexes(oldId);
   }
   else 
   {
@@ -596,7 +596,9 @@ Species::setId (const std::string& sid)
   }
   else
   {
+    std::string oldId(mId);
     mId = sid;
+    updateIdIndexes(oldId);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -619,7 +621,9 @@ Species::setName (const std::string& name)
     }
     else
     {
+      std::string oldId(mId);
       mId = name;
+      updateIdIndexes(oldId);
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -864,7 +868,9 @@ Species::unsetName ()
 {
   if (getLevel() == 1) 
   {
+    std::string oldId(mId);
     mId.erase();
+    updateIdIndexes(oldId);
   }
   else 
   {
@@ -2456,17 +2462,6 @@ ListOfSpecies::get(unsigned int n) const
 }
 
 
-/**
- * Used by ListOf::get() to lookup an SBase based by its id.
- */
-struct IdEqS 
-{
-  const string& mId;
-
-  IdEqS (const string& id) : mId(id) { }
-  bool operator() (SBase* sb) 
-       { return static_cast <Species *> (sb)->getId() == mId; }
-};
 /* return item by id */
 Species*
 ListOfSpecies::get (const std::string& sid)
@@ -2480,10 +2475,8 @@ ListOfSpecies::get (const std::string& sid)
 const Species*
 ListOfSpecies::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqS(sid) );
-  return (result == mItems.end()) ? NULL : static_cast <Species*> (*result);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <const Species*> (mItems[n]);
 }
 
 
@@ -2499,18 +2492,8 @@ ListOfSpecies::remove (unsigned int n)
 Species*
 ListOfSpecies::remove (const std::string& sid)
 {
-  SBase* item = NULL;
-  vector<SBase*>::iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqS(sid) );
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <Species*> (item);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <Species*> (ListOf::remove(n));
 }
 
 
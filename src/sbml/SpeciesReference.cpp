@@ -1452,6 +1452,7 @@ SpeciesReference::writeAttributes (XMLOutputStream& stream) const
 void
 SpeciesReference::writeElements (XMLOutputStream& stream) const
 {
+  const_cast <SpeciesReference *> (this)->loadDeferredNotes();
   if (mNotes != NULL)
   {
     mNotes->writeToStream(stream);
@@ -1650,6 +1651,7 @@ ListOfSpeciesReferences::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <SimpleSpeciesReference*> (item);
@@ -183,7 +183,9 @@ SpeciesType::setId (const std::string& sid)
   }
   else
   {
+    std::string oldId(mId);
     mId = sid;
+    updateIdIndexes(oldId);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -206,7 +208,9 @@ SpeciesType::setName (const std::string& name)
     }
     else
     {
+      std::string oldId(mId);
       mId = name;
+      updateIdIndexes(oldId);
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -226,7 +230,9 @@ SpeciesType::unsetName ()
 {
   if (getLevel() == 1) 
   {
+    std::string oldId(mId);
     mId.erase();
+    updateIdIndexes(oldId);
   }
   else 
   {
@@ -712,19 +718,6 @@ ListOfSpeciesTypes::get(unsigned int n) const
 }
 
 
-/**
- * Used by ListOf::get() to lookup an SBase based by its id.
- */
-struct IdEqST
-{
-  const string& mId;
-
-  IdEqST (const string& id) : mId(id) { }
-  bool operator() (SBase* sb) 
-       { return static_cast <SpeciesType *> (sb)->getId() == mId; }
-};
-
-
 /* return item by id */
 SpeciesType*
 ListOfSpeciesTypes::get (const std::string& sid)
@@ -738,11 +731,8 @@ ListOfSpeciesTypes::get (const std::string& sid)
 const SpeciesType*
 ListOfSpeciesTypes::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqST(sid) );
-  return (result == mItems.end()) ? NULL : 
-                             static_cast <SpeciesType*> (*result);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <const SpeciesType*> (mItems[n]);
 }
 
 
@@ -758,18 +748,8 @@ ListOfSpeciesTypes::remove (unsigned int n)
 SpeciesType*
 ListOfSpeciesTypes::remove (const std::string& sid)
 {
-  SBase* item = NULL;
-  vector<SBase*>::iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqST(sid) );
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <SpeciesType*> (item);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <SpeciesType*> (ListOf::remove(n));
 }
 
 
@@ -242,7 +242,9 @@ UnitDefinition::setId (const std::string& sid)
   }
   else
   {
+    std::string oldId(mId);
     mId = sid;
+    updateIdIndexes(oldId);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -265,7 +267,9 @@ UnitDefinition::setName (const std::string& name)
     }
     else
     {
+      std::string oldId(mId);
       mId = name;
+      updateIdIndexes(oldId);
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -285,7 +289,9 @@ UnitDefinition::unsetName ()
 {
   if (getLevel() == 1) 
   {
+    std::string oldId(mId);
     mId.erase();
+    updateIdIndexes(oldId);
   }
   else 
   {
@@ -2219,19 +2225,6 @@ ListOfUnitDefinitions::get(unsigned int n) const
 }
 
 
-/**
- * Used by ListOf::get() to lookup an SBase based by its id.
- */
-struct IdEqUD
-{
-  const string& mId;
-
-  explicit IdEqUD (const string& id) : mId(id) { }
-  bool operator() (SBase* sb) const
-       { return static_cast <UnitDefinition *> (sb)->getId() == mId; }
-};
-
-
 /* return item by id */
 UnitDefinition*
 ListOfUnitDefinitions::get (const std::string& sid)
@@ -2245,11 +2238,8 @@ ListOfUnitDefinitions::get (const std::string& sid)
 const UnitDefinition*
 ListOfUnitDefinitions::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqUD(sid) );
-  return (result == mItems.end()) ? NULL : 
-                   static_cast <UnitDefinition*> (*result);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <const UnitDefinition*> (mItems[n]);
 }
 
 
@@ -2279,18 +2269,8 @@ ListOfUnitDefinitions::remove (unsigned int n)
 UnitDefinition*
 ListOfUnitDefinitions::remove (const std::string& sid)
 {
-  SBase* item = NULL;
-  ListItemIter result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqUD(sid) );
-
-  if (result != mItems.end())
-  {
-    item = *result;
-    mItems.erase(result);
-  }
-
-  return static_cast <UnitDefinition*> (item);
+  int n = getIndexOfId(sid);
+  return (n < 0) ? NULL : static_cast <UnitDefinition*> (ListOf::remove(n));
 }
 
 
@@ -64,6 +64,10 @@
 #include <bzlib.h>
 #endif
 
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
 LIBSBML_CPP_NAMESPACE_BEGIN
 
 LIBSBML_EXTERN
@@ -150,6 +154,16 @@ isLibSBMLCompiledWith(const char* option)
 #endif
   }
 
+  if (strcmp(option, "zstd") == 0 ||
+    strcmp(option, "zst") == 0)
+  {
+#ifdef USE_ZSTD
+    return ZSTD_VERSION_NUMBER;
+#else
+    return 0;
+#endif
+  }
+
   return 0;
 }
 
@@ -209,6 +223,16 @@ getLibSBMLDependencyVersionOf(const char* option)
 #endif
   }
 
+  if (strcmp(option, "zstd") == 0 ||
+    strcmp(option, "zst") == 0)
+  {
+#ifdef USE_ZSTD
+    return ZSTD_versionString();
+#else
+    return NULL;
+#endif
+  }
+
   return NULL;
 }
 
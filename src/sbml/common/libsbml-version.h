@@ -117,7 +117,7 @@ getLibSBMLVersionString ();
  * against a specific library. 
  *
  * @param option the library to test against, this can be one of
- *        "expat", "libxml", "xerces-c", "bzip2", "zip"
+ *        "expat", "libxml", "xerces-c", "bzip2", "zip", "zstd"
  * 
  * @return 0 in case the libSBML has not been compiled against 
  *         that library and nonzero otherwise (for libraries 
@@ -136,7 +136,7 @@ isLibSBMLCompiledWith(const char* option);
  *
  * @param option the library for which the version
  *        should be retrieved, this can be one of
- *        "expat", "libxml", "xerces-c", "bzip2", "zip"
+ *        "expat", "libxml", "xerces-c", "bzip2", "zip", "zstd"
  * 
  * @return NULL in case libSBML has not been compiled against 
  *         that library and a version string otherwise.
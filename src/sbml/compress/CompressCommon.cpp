@@ -81,5 +81,21 @@ bool hasBzip2()
 #endif // USE_BZ2
 }
 
+/**
+ * Predicate returning @c true or @c false depending on whether
+ * libSBML is linked with zstd at compile time.
+ *
+ * @return @c true if zstd is linked, @c false otherwise.
+ */
+LIBSBML_EXTERN
+bool hasZstd() 
+{
+#ifdef USE_ZSTD
+  return true;
+#else
+  return false;
+#endif // USE_ZSTD
+}
+
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
@@ -96,6 +96,21 @@ public:
 };
 
 
+/**
+ *
+ *  This exception will be thrown if a function which depends on
+ *  the zstd library invoked and underlying libSBML is not linked with
+ *  zstd.
+ *
+ */
+class LIBSBML_EXTERN ZstdNotLinked : public NotLinked
+{
+public:
+   ZstdNotLinked() throw() { }
+   virtual ~ZstdNotLinked() throw() {}
+};
+
+
 /**
  * Predicate returning @c true or @c false depending on whether
  * underlying libSBML is linked with zlib.
@@ -115,6 +130,16 @@ bool hasZlib();
 LIBSBML_EXTERN
 bool hasBzip2();
 
+
+/**
+ * Predicate returning @c true or @c false depending on whether
+ * underlying libSBML is linked with zstd.
+ *
+ * @return @c true if libSBML is linked with zstd, @c false otherwise.
+ */
+LIBSBML_EXTERN
+bool hasZstd();
+
 LIBSBML_CPP_NAMESPACE_END
 
 #endif //CompressCommon_h
@@ -62,6 +62,10 @@
 #include <sbml/compress/bzfstream.h>
 #endif //USE_BZ2
 
+#ifdef USE_ZSTD
+#include <sbml/compress/zstfstream.h>
+#endif //USE_ZSTD
+
 using namespace std;
 
 LIBSBML_CPP_NAMESPACE_BEGIN
@@ -126,6 +130,25 @@ InputDecompressor::openZipIStream (const std::string& filename)
 }
 
 
+/**
+ * Opens the given Zstandard file as a zstifstream (subclass of std::istream class)
+ * object for read access and returned the stream object.
+ *
+ * @return a istream* object bound to the given Zstandard file or NULL if the
+ * initialization for the object failed.
+ */
+std::istream* 
+InputDecompressor::openZstdIStream (const std::string& filename)
+{
+#ifdef USE_ZSTD
+  return new(std::nothrow) zstifstream(filename.c_str(), ios_base::in | ios_base::binary);
+#else
+  throw ZstdNotLinked();
+  return NULL; // never reached
+#endif
+}
+
+
 /**
  * Opens the given gzip file and returned the string in the file.
  *
@@ -203,5 +226,30 @@ InputDecompressor::getStringFromZip (const std::string& filename)
 #endif
 }
 
+
+/**
+ * Opens the given Zstandard file and returned the string in the file.
+ *
+ * @return a string, the string in the given file, or empty string if failed to open
+ * the file.
+ */
+char* 
+InputDecompressor::getStringFromZstd (const std::string& filename) 
+{
+#ifdef USE_ZSTD
+  std::ostringstream oss;
+  zstifstream in(filename.c_str(), ios_base::in | ios_base::binary);
+  istreambuf_iterator<char> in_itr(in);
+  ostreambuf_iterator<char> out_itr(oss);
+
+  std::copy(in_itr, istreambuf_iterator<char>(), out_itr);
+
+  return strdup(oss.str().c_str());
+#else
+  throw ZstdNotLinked();
+  return NULL; // never reached
+#endif
+}
+
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
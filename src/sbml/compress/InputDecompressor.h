@@ -100,6 +100,20 @@ public:
   static std::istream* openZipIStream (const std::string& filename);
 
 
+ /**
+  * Opens the given Zstandard file as a zstifstream (subclass of std::istream class)
+  * object for read access and returned the stream object.
+  *
+  * @param filename a string, the Zstandard file name to be read.
+  *
+  * @note ZstdNotLinked will be thrown if zstd is not linked with libSBML at compile time.
+  *
+  * @return a istream* object bound to the given Zstandard file or @c NULL if the
+  * initialization for the object failed.
+  */
+  static std::istream* openZstdIStream (const std::string& filename);
+
+
  /**
   * Opens the given gzip file and returned the string in the file.
   *
@@ -140,6 +154,19 @@ public:
   */
   static char* getStringFromZip (const std::string& filename);
 
+
+ /**
+  * Opens the given Zstandard file and returned the string in the file.
+  *
+  * @param filename a string, the Zstandard file name to be read.
+  *
+  * @note ZstdNotLinked will be thrown if zstd is not linked with libSBML at compile time.
+  *
+  * @return a string, the string in the given file, or empty string if failed to open
+  * the file.
+  */
+  static char* getStringFromZstd (const std::string& filename);
+
 };
 
 LIBSBML_CPP_NAMESPACE_END
@@ -53,12 +53,17 @@
 #ifdef USE_ZLIB
 #include <sbml/compress/zfstream.h>
 #include <sbml/compress/zipfstream.h>
+#include <sbml/compress/pzfstream.h>
 #endif //USE_ZLIB
 
 #ifdef USE_BZ2
 #include <sbml/compress/bzfstream.h>
 #endif //USE_BZ2
 
+#ifdef USE_ZSTD
+#include <sbml/compress/zstfstream.h>
+#endif //USE_ZSTD
+
 using namespace std;
 
 LIBSBML_CPP_NAMESPACE_BEGIN
@@ -82,6 +87,28 @@ OutputCompressor::openGzipOStream(const std::string& filename)
 }
 
 
+/**
+ * Opens the given gzip file for write access through a stream that
+ * compresses blocks of output on the given number of threads.
+ *
+ * @return a ostream* object bound to the given gzip file or NULL if the initialization
+ * for the object failed.
+ */
+std::ostream* 
+OutputCompressor::openGzipOStream(const std::string& filename, unsigned int threads)
+{
+#ifdef USE_ZLIB
+  if (threads == 0) return openGzipOStream(filename);
+
+  return new(std::nothrow) pgzofstream(filename.c_str(), threads);
+#else
+  (void)threads;
+  throw ZlibNotLinked();
+  return NULL; // never reached
+#endif
+}
+
+
 /**
  * Opens the given bzip2 file as a bzofstream (subclass of std::ofstream class) object
  * for write access and returned the stream object.
@@ -120,6 +147,54 @@ OutputCompressor::openZipOStream(const std::string& filename, const std::string&
 #endif
 }
 
+
+/**
+ * Opens the given zip file for write access through a stream that
+ * compresses blocks of output on the given number of threads.
+ *
+ * @return a ostream* object bound to the given zip file or NULL if the initialization
+ * for the object failed.
+ */
+std::ostream* 
+OutputCompressor::openZipOStream(const std::string& filename, const std::string& filenameinzip,
+                                 unsigned int threads)
+{
+#ifdef USE_ZLIB
+  if (threads == 0) return openZipOStream(filename, filenameinzip);
+
+  return new(std::nothrow) pzipofstream(filename.c_str(), filenameinzip.c_str(),
+                                        threads);
+#else
+  (void)threads;
+  throw ZlibNotLinked();
+  return NULL; // never reached
+#endif
+}
+
+
+/**
+ * Opens the given Zstandard file as a zstofstream object for write access
+ * with the given compression level and number of threads, and returned the
+ * stream object.
+ *
+ * @return a ostream* object bound to the given Zstandard file or NULL if the
+ * initialization for the object failed.
+ */
+std::ostream* 
+OutputCompressor::openZstdOStream(const std::string& filename, int level,
+                                  unsigned int threads)
+{
+#ifdef USE_ZSTD
+  return new(std::nothrow) zstofstream(filename.c_str(), level, threads,
+                                       ios_base::out | ios_base::binary);
+#else
+  (void)level;
+  (void)threads;
+  throw ZstdNotLinked();
+  return NULL; // never reached
+#endif
+}
+
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
 
@@ -70,6 +70,27 @@ public:
   static std::ostream* openGzipOStream(const std::string& filename);
 
 
+ /**
+  * Opens the given gzip file for write access through a stream that
+  * deflates blocks of output on the given number of threads, and returns
+  * the stream object.
+  *
+  * The file is a standard gzip file; it differs from one written by
+  * openGzipOStream(const std::string& filename) only in that each block
+  * of 128 KB is compressed separately.
+  *
+  * @param filename a string, the gzip file name to be written.
+  * @param threads the number of compressing threads, or @c 0 to compress
+  * on the calling thread with gzofstream.
+  *
+  * @note ZlibNotLinked will be thrown if zlib is not linked with libSBML at compile time.
+  *
+  * @return a ostream* object bound to the given gzip file or @c NULL if the initialization
+  * for the object failed.
+  */
+  static std::ostream* openGzipOStream(const std::string& filename, unsigned int threads);
+
+
  /**
   * Opens the given bzip2 file as a bzofstream (subclass of std::ofstream class) object
   * for write access and returned the stream object.
@@ -99,6 +120,44 @@ public:
   */
   static std::ostream* openZipOStream(const std::string& filename, const std::string& filenameinzip);
 
+
+ /**
+  * Opens the given zip file for write access through a stream that
+  * deflates blocks of output on the given number of threads, and returns
+  * the stream object.
+  *
+  * @param filename a string, the zip archive file name to be written.
+  * @param filenameinzip a string, the file name to be archived in the above zip archive file.
+  * @param threads the number of compressing threads, or @c 0 to compress
+  * on the calling thread with zipofstream.
+  *
+  * @note ZlibNotLinked will be thrown if zlib is not linked with libSBML at compile time.
+  *
+  * @return a ostream* object bound to the given zip file or @c NULL if the initialization
+  * for the object failed.
+  */
+  static std::ostream* openZipOStream(const std::string& filename, const std::string& filenameinzip,
+                                      unsigned int threads);
+
+
+ /**
+  * Opens the given Zstandard file as a zstofstream (subclass of std::ostream class)
+  * object for write access and returned the stream object.
+  *
+  * @param filename a string, the Zstandard file name to be written.
+  * @param level the compression level (1 to ZSTD_maxCLevel(), or negative
+  * for faster levels), or @c 0 for the default level of zstd.
+  * @param threads the number of compressing threads, or @c 0 to compress
+  * on the calling thread.
+  *
+  * @note ZstdNotLinked will be thrown if zstd is not linked with libSBML at compile time.
+  *
+  * @return a ostream* object bound to the given Zstandard file or @c NULL if the
+  * initialization for the object failed.
+  */
+  static std::ostream* openZstdOStream(const std::string& filename, int level = 0,
+                                       unsigned int threads = 0);
+
 };
 
 LIBSBML_CPP_NAMESPACE_END
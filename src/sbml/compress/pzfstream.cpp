@@ -0,0 +1,585 @@
+/*
+ * Block-parallel C++ I/O streams writing gzip and zip files through zlib.
+ *
+ * Each block is deflated as a raw deflate fragment ending in a sync flush,
+ * with the last 32 KB of the preceding block as its dictionary; the last
+ * block ends the deflate stream.  The fragments are written in order and
+ * their CRC-32 values joined with crc32_combine(), as in pigz.
+ */
+
+#include "pzfstream.h"
+#include "zipfstream.h"
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1700)
+#define PZF_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// Size of the deflate window, and so of the useful dictionary
+#define DICTIONARY_SIZE 32768
+
+/*****************************************************************************/
+
+// A block of input and, once deflated, its compressed form
+struct pdeflatejob
+{
+  std::vector<char> input;
+  std::size_t       used;
+  std::vector<char> dictionary;
+  std::vector<char> output;
+  std::size_t       out_length;
+  uLong             crc;
+  bool              last;
+  bool              done;
+  bool              failed;
+};
+
+// Deflates the input of job into its output using strm
+static bool
+deflate_block(z_stream* strm, pdeflatejob* job)
+{
+  if (deflateReset(strm) != Z_OK)
+    return false;
+
+  if (!job->dictionary.empty() &&
+      deflateSetDictionary(strm, (const Bytef*)&job->dictionary[0],
+                           (uInt)job->dictionary.size()) != Z_OK)
+    return false;
+
+  const Bytef* input = (const Bytef*)(job->used > 0 ? &job->input[0] : "");
+
+  job->crc = crc32(crc32(0L, Z_NULL, 0), input, (uInt)job->used);
+
+  // room for the block, the flush marker and the end of the stream
+  std::size_t size = deflateBound(strm, (uLong)job->used) + 16;
+  if (job->output.size() < size)
+    job->output.resize(size);
+
+  strm->next_in   = const_cast<Bytef*>(input);
+  strm->avail_in  = (uInt)job->used;
+  job->out_length = 0;
+
+  for (;;)
+  {
+    strm->next_out  = (Bytef*)&job->output[job->out_length];
+    strm->avail_out = (uInt)(job->output.size() - job->out_length);
+
+    int ret = deflate(strm, job->last ? Z_FINISH : Z_SYNC_FLUSH);
+
+    job->out_length = job->output.size() - strm->avail_out;
+
+    if (ret == Z_STREAM_ERROR)
+      return false;
+    if (job->last ? (ret == Z_STREAM_END)
+                  : (strm->avail_in == 0 && strm->avail_out > 0))
+      return true;
+
+    job->output.resize(job->output.size() * 2);
+  }
+}
+
+// Initializes strm for raw deflate at the given level
+static bool
+init_stream(z_stream* strm, int level)
+{
+  memset(strm, 0, sizeof(z_stream));
+  return deflateInit2(strm, level, Z_DEFLATED, -MAX_WBITS, 8,
+                      Z_DEFAULT_STRATEGY) == Z_OK;
+}
+
+/*****************************************************************************/
+
+#ifdef PZF_THREADS
+
+// Worker threads and the queue of blocks waiting for them
+struct pdeflatepool
+{
+  std::mutex               mutex;
+  std::condition_variable  work;
+  std::condition_variable  done;
+  std::deque<pdeflatejob*> queue;
+  std::vector<std::thread> workers;
+  int                      level;
+  bool                     stop;
+};
+
+// Deflates queued blocks until the pool is stopped and the queue empty
+static void
+pdeflate_worker(pdeflatepool* pool)
+{
+  z_stream strm;
+  bool     ready = init_stream(&strm, pool->level);
+
+  std::unique_lock<std::mutex> lock(pool->mutex);
+
+  for (;;)
+  {
+    while (!pool->stop && pool->queue.empty())
+      pool->work.wait(lock);
+    if (pool->queue.empty())
+      break;
+
+    pdeflatejob* job = pool->queue.front();
+    pool->queue.pop_front();
+    lock.unlock();
+
+    bool ok = false;
+    try
+    {
+      ok = ready && deflate_block(&strm, job);
+    }
+    catch (std::bad_alloc&)
+    {
+    }
+
+    lock.lock();
+    job->failed = !ok;
+    job->done   = true;
+    pool->done.notify_all();
+  }
+
+  if (ready)
+    deflateEnd(&strm);
+}
+
+// Stops and joins the workers of pool and deletes it
+static void
+stop_pool(pdeflatepool* pool)
+{
+  if (pool == NULL)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    pool->stop = true;
+  }
+  pool->work.notify_all();
+
+  for (std::size_t i = 0; i < pool->workers.size(); ++i)
+    pool->workers[i].join();
+
+  delete pool;
+}
+
+#else
+
+struct pdeflatepool
+{
+};
+
+static void
+stop_pool(pdeflatepool*)
+{
+}
+
+#endif
+
+/*****************************************************************************/
+
+// Constructor
+pdeflatebuf::pdeflatebuf(unsigned int threads, int level,
+                         std::size_t block_size)
+: current(NULL), pool(NULL), stream_ready(false), level(level),
+  block_size(block_size > 0 ? block_size : 131072),
+  total_crc(crc32(0L, Z_NULL, 0)), total_length(0),
+  finished(false), error(false)
+{
+#ifdef PZF_THREADS
+  if (threads > 0)
+  {
+    pool = new pdeflatepool;
+    pool->level = level;
+    pool->stop  = false;
+
+    // settle for fewer threads if the system refuses more
+    try
+    {
+      for (unsigned int i = 0; i < threads; ++i)
+        pool->workers.push_back(std::thread(pdeflate_worker, pool));
+    }
+    catch (...)
+    {
+    }
+
+    if (pool->workers.empty())
+    {
+      delete pool;
+      pool = NULL;
+    }
+  }
+#else
+  (void)threads;
+#endif
+
+  if (pool == NULL)
+  {
+    stream_ready = init_stream(&stream, level);
+    if (!stream_ready)
+      error = true;
+  }
+
+  current = new pdeflatejob;
+  current->input.resize(this->block_size);
+  this->setp(&current->input[0], &current->input[0] + this->block_size);
+}
+
+// Destructor
+pdeflatebuf::~pdeflatebuf()
+{
+  // subclasses finish; all that is left is to release resources
+  stop_pool(pool);
+
+  while (!pending.empty())
+  {
+    delete pending.front();
+    pending.pop_front();
+  }
+
+  delete current;
+
+  if (stream_ready)
+    deflateEnd(&stream);
+}
+
+// Number of worker threads
+unsigned int
+pdeflatebuf::threads() const
+{
+#ifdef PZF_THREADS
+  return (pool != NULL) ? (unsigned int)pool->workers.size() : 0;
+#else
+  return 0;
+#endif
+}
+
+// Hands the full put area over for compression and starts a new block
+pdeflatebuf::int_type
+pdeflatebuf::overflow(int_type c)
+{
+  if (finished || error)
+    return traits_type::eof();
+
+  if (this->pptr() == this->epptr() && !this->submit(false))
+    return traits_type::eof();
+
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    *(this->pptr()) = traits_type::to_char_type(c);
+    this->pbump(1);
+  }
+
+  return traits_type::not_eof(c);
+}
+
+// Blocks are only deflated once full, as flushing them early would cost
+// compression; sync merely reports errors
+int
+pdeflatebuf::sync()
+{
+  return error ? -1 : 0;
+}
+
+// Deflates the last block and writes out all pending blocks
+bool
+pdeflatebuf::finish()
+{
+  if (finished)
+    return !error;
+
+  if (!error)
+    this->submit(true);
+
+  finished = true;
+
+  stop_pool(pool);
+  pool = NULL;
+
+  return !error;
+}
+
+// Queues the current block and writes out blocks that are done
+bool
+pdeflatebuf::submit(bool last)
+{
+  pdeflatejob* job = current;
+  current = NULL;
+
+  job->used   = (std::size_t)(this->pptr() - this->pbase());
+  job->last   = last;
+  job->done   = false;
+  job->failed = false;
+  this->setp(NULL, NULL);
+
+  // the tail of the previous block primes the dictionary of this one
+  job->dictionary.swap(dictionary);
+  std::size_t keep = (job->used < DICTIONARY_SIZE) ? job->used : DICTIONARY_SIZE;
+  if (keep > 0)
+    dictionary.assign(&job->input[0] + job->used - keep,
+                      &job->input[0] + job->used);
+  else
+    dictionary.clear();
+
+  pending.push_back(job);
+
+#ifdef PZF_THREADS
+  if (pool != NULL)
+  {
+    {
+      std::lock_guard<std::mutex> lock(pool->mutex);
+      pool->queue.push_back(job);
+    }
+    pool->work.notify_one();
+  }
+  else
+#endif
+  {
+    job->failed = !(stream_ready && deflate_block(&stream, job));
+    job->done   = true;
+  }
+
+  // keep at most two blocks per thread in flight
+  while (!pending.empty())
+  {
+    bool wait = (pool == NULL) || last ||
+                pending.size() > 2 * (std::size_t)this->threads();
+
+#ifdef PZF_THREADS
+    if (!wait)
+    {
+      std::lock_guard<std::mutex> lock(pool->mutex);
+      wait = pending.front()->done;
+    }
+#endif
+
+    if (!wait)
+      break;
+    if (!this->write_front())
+      return false;
+  }
+
+  if (!last)
+  {
+    current = new pdeflatejob;
+    current->input.resize(block_size);
+    this->setp(&current->input[0], &current->input[0] + block_size);
+  }
+
+  return true;
+}
+
+// Waits for the oldest pending block and writes it out
+bool
+pdeflatebuf::write_front()
+{
+  pdeflatejob* job = pending.front();
+
+#ifdef PZF_THREADS
+  if (pool != NULL)
+  {
+    std::unique_lock<std::mutex> lock(pool->mutex);
+    while (!job->done)
+      pool->done.wait(lock);
+  }
+#endif
+
+  pending.pop_front();
+
+  if (job->failed ||
+      (job->out_length > 0 && !this->write_out(&job->output[0], job->out_length)))
+  {
+    error = true;
+  }
+  else
+  {
+    total_crc     = crc32_combine(total_crc, job->crc, (z_off_t)job->used);
+    total_length += job->used;
+  }
+
+  delete job;
+  return !error;
+}
+
+/*****************************************************************************/
+
+// Constructor
+pgzfilebuf::pgzfilebuf(unsigned int threads, int level)
+: pdeflatebuf(threads, level), file(NULL)
+{
+}
+
+// Destructor
+pgzfilebuf::~pgzfilebuf()
+{
+  this->close();
+}
+
+// Open gzipped file and write the gzip header
+pgzfilebuf*
+pgzfilebuf::open(const char* name)
+{
+  if (this->is_open() || this->failed())
+    return NULL;
+
+  if ((file = std::fopen(name, "wb")) == NULL)
+    return NULL;
+
+  // no name and no time stamp, so that equal input gives equal files;
+  // the operating system is "unknown"
+  static const unsigned char header[10] =
+    { 0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, 0, 255 };
+
+  if (std::fwrite(header, 1, sizeof(header), file) != sizeof(header))
+  {
+    std::fclose(file);
+    file = NULL;
+    return NULL;
+  }
+
+  return this;
+}
+
+// Write out remaining blocks and the trailer, and close file
+pgzfilebuf*
+pgzfilebuf::close()
+{
+  if (!this->is_open())
+    return NULL;
+
+  bool ok = this->finish();
+
+  if (ok)
+  {
+    // CRC-32 and length modulo 2^32, both little-endian
+    unsigned char trailer[8];
+    uLong crc = this->crc();
+    unsigned long long length = this->length();
+
+    for (int i = 0; i < 4; ++i)
+    {
+      trailer[i]     = (unsigned char)((crc    >> (8 * i)) & 0xff);
+      trailer[i + 4] = (unsigned char)((length >> (8 * i)) & 0xff);
+    }
+
+    ok = (std::fwrite(trailer, 1, sizeof(trailer), file) == sizeof(trailer));
+  }
+
+  if (std::fclose(file) != 0)
+    ok = false;
+  file = NULL;
+
+  return ok ? this : NULL;
+}
+
+// Write compressed data to file
+bool
+pgzfilebuf::write_out(const char* data, std::size_t length)
+{
+  return std::fwrite(data, 1, length, file) == length;
+}
+
+/*****************************************************************************/
+
+// Constructor opens file
+pgzofstream::pgzofstream(const char* name, unsigned int threads)
+: std::ostream(NULL), sb(threads)
+{
+  this->init(&sb);
+  if (!sb.open(name))
+    this->setstate(std::ios_base::failbit);
+}
+
+// Close file
+void
+pgzofstream::close()
+{
+  if (!sb.close())
+    this->setstate(std::ios_base::failbit);
+}
+
+/*****************************************************************************/
+
+// Constructor
+pzipfilebuf::pzipfilebuf(unsigned int threads, int level)
+: pdeflatebuf(threads, level), file(NULL)
+{
+}
+
+// Destructor
+pzipfilebuf::~pzipfilebuf()
+{
+  this->close();
+}
+
+// Open zip archive and its entry for raw writing
+pzipfilebuf*
+pzipfilebuf::open(const char* name, const char* filenameinzip)
+{
+  if (this->is_open() || this->failed())
+    return NULL;
+
+  if ((file = zipopen(name, filenameinzip, 0, 1)) == NULL)
+    return NULL;
+
+  return this;
+}
+
+// Write out remaining blocks and close entry and archive
+pzipfilebuf*
+pzipfilebuf::close()
+{
+  if (!this->is_open())
+    return NULL;
+
+  bool ok = this->finish();
+
+  if (zipCloseFileInZipRaw(file, (uLong)this->length(), this->crc()) != ZIP_OK)
+    ok = false;
+  if (zipclose(file) != ZIP_OK)
+    ok = false;
+  file = NULL;
+
+  return ok ? this : NULL;
+}
+
+// Write compressed data into the archive entry
+bool
+pzipfilebuf::write_out(const char* data, std::size_t length)
+{
+  while (length > 0)
+  {
+    unsigned count = (length > 1073741824) ? 1073741824u : (unsigned)length;
+
+    if (zipwrite(file, const_cast<char*>(data), count) != ZIP_OK)
+      return false;
+
+    data   += count;
+    length -= count;
+  }
+
+  return true;
+}
+
+/*****************************************************************************/
+
+// Constructor opens archive
+pzipofstream::pzipofstream(const char* name, const char* filenameinzip,
+                           unsigned int threads)
+: std::ostream(NULL), sb(threads)
+{
+  this->init(&sb);
+  if (!sb.open(name, filenameinzip))
+    this->setstate(std::ios_base::failbit);
+}
+
+// Close archive
+void
+pzipofstream::close()
+{
+  if (!sb.close())
+    this->setstate(std::ios_base::failbit);
+}
@@ -0,0 +1,297 @@
+/*
+ * Block-parallel C++ I/O streams writing gzip and zip files through zlib.
+ *
+ * The output is split into blocks that are deflated independently on
+ * worker threads, each using the end of the previous block as its
+ * dictionary, and joined into a single deflate stream, as pigz does.  The
+ * result is a standard gzip file (or zip entry) that any inflater reads.
+ */
+
+#ifndef PZFSTREAM_H
+#define PZFSTREAM_H
+
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <ostream>
+#include <vector>
+#include "zlib.h"
+#include "zip.h"
+
+/*****************************************************************************/
+
+struct pdeflatejob;
+struct pdeflatepool;
+
+/**
+ *  @brief  Block-parallel deflate stream buffer class.
+ *
+ *  This class collects output into blocks, deflates them on a number of
+ *  worker threads and passes the compressed blocks, in order, to
+ *  write_out().  Subclasses frame the raw deflate stream for a particular
+ *  file format.  Without C++11 threads the blocks are deflated on the
+ *  calling thread; the output is the same.
+*/
+class pdeflatebuf : public std::streambuf
+{
+public:
+  /**
+   *  @brief  Creates a stream buffer deflating on the given number of threads.
+   *  @param  threads  Number of worker threads (at least 1).
+   *  @param  level  Compression level (0-9, or Z_DEFAULT_COMPRESSION).
+   *  @param  block_size  Number of uncompressed bytes per block.
+  */
+  pdeflatebuf(unsigned int threads, int level = Z_DEFAULT_COMPRESSION,
+              std::size_t block_size = 131072);
+
+  //  Destructor.
+  virtual
+  ~pdeflatebuf();
+
+  /**
+   *  @brief  Number of worker threads actually running.
+   *  @return  Number of threads, or 0 if blocks are deflated in place.
+  */
+  unsigned int
+  threads() const;
+
+protected:
+  /**
+   *  @brief  Deflates the last block and waits for all blocks to be written.
+   *  @return  True on success, false if compressing or writing failed.
+   *
+   *  After this, crc() and length() describe the complete input.
+  */
+  bool
+  finish();
+
+  /**
+   *  @brief  Writes a piece of the raw deflate stream.
+   *  @return  True on success.
+  */
+  virtual bool
+  write_out(const char* data, std::size_t length) = 0;
+
+  /**
+   *  @brief  CRC-32 of the input passed on so far.
+  */
+  uLong
+  crc() const { return total_crc; }
+
+  /**
+   *  @brief  Number of input bytes passed on so far.
+  */
+  unsigned long long
+  length() const { return total_length; }
+
+  /**
+   *  @brief  True after a compression or write error.
+  */
+  bool
+  failed() const { return error; }
+
+  virtual int_type
+  overflow(int_type c = traits_type::eof());
+
+  virtual int
+  sync();
+
+private:
+  pdeflatebuf(const pdeflatebuf&);
+  pdeflatebuf& operator=(const pdeflatebuf&);
+
+  bool
+  submit(bool last);
+
+  bool
+  write_front();
+
+  pdeflatejob*  current;
+  std::deque<pdeflatejob*> pending;
+  pdeflatepool* pool;
+  z_stream      stream;
+  bool          stream_ready;
+  int           level;
+  std::size_t   block_size;
+  std::vector<char> dictionary;
+  uLong         total_crc;
+  unsigned long long total_length;
+  bool          finished;
+  bool          error;
+};
+
+/*****************************************************************************/
+
+/**
+ *  @brief  Block-parallel gzip file stream buffer class.
+ *
+ *  Writes a single gzip member, readable by gzip, zlib and gzifstream.
+*/
+class pgzfilebuf : public pdeflatebuf
+{
+public:
+  pgzfilebuf(unsigned int threads, int level = Z_DEFAULT_COMPRESSION);
+
+  //  Destructor.
+  virtual
+  ~pgzfilebuf();
+
+  /**
+   *  @brief  Check if file is open.
+   *  @return  True if file is open.
+  */
+  bool
+  is_open() const { return (file != NULL); }
+
+  /**
+   *  @brief  Open gzipped file for writing.
+   *  @param  name  File name.
+   *  @return  @c this on success, NULL on failure.
+  */
+  pgzfilebuf*
+  open(const char* name);
+
+  /**
+   *  @brief  Write out remaining blocks and the gzip trailer, and close file.
+   *  @return  @c this on success, NULL on failure.
+  */
+  pgzfilebuf*
+  close();
+
+protected:
+  virtual bool
+  write_out(const char* data, std::size_t length);
+
+private:
+  std::FILE* file;
+};
+
+/**
+ *  @brief  Block-parallel gzip file output stream class.
+*/
+class pgzofstream : public std::ostream
+{
+public:
+  /**
+   *  @brief  Construct stream on gzipped file to be opened.
+   *  @param  name  File name.
+   *  @param  threads  Number of worker threads.
+  */
+  pgzofstream(const char* name, unsigned int threads);
+
+  /**
+   *  Obtain underlying stream buffer.
+  */
+  pgzfilebuf*
+  rdbuf() const
+  { return const_cast<pgzfilebuf*>(&sb); }
+
+  /**
+   *  @brief  Check if file is open.
+   *  @return  True if file is open.
+  */
+  bool
+  is_open() { return sb.is_open(); }
+
+  /**
+   *  @brief  Close gzipped file.
+   *
+   *  Stream will be in state fail() if close failed.
+  */
+  void
+  close();
+
+private:
+  pgzfilebuf sb;
+};
+
+/*****************************************************************************/
+
+/**
+ *  @brief  Block-parallel zip archive stream buffer class.
+ *
+ *  Writes a single deflated entry into a new zip archive, passing the
+ *  compressed blocks to minizip in raw mode.
+*/
+class pzipfilebuf : public pdeflatebuf
+{
+public:
+  pzipfilebuf(unsigned int threads, int level = Z_DEFAULT_COMPRESSION);
+
+  //  Destructor.
+  virtual
+  ~pzipfilebuf();
+
+  /**
+   *  @brief  Check if file is open.
+   *  @return  True if file is open.
+  */
+  bool
+  is_open() const { return (file != NULL); }
+
+  /**
+   *  @brief  Open zip archive for writing.
+   *  @param  name  Archive file name.
+   *  @param  filenameinzip  Name of the entry to write.
+   *  @return  @c this on success, NULL on failure.
+  */
+  pzipfilebuf*
+  open(const char* name, const char* filenameinzip);
+
+  /**
+   *  @brief  Write out remaining blocks and close entry and archive.
+   *  @return  @c this on success, NULL on failure.
+  */
+  pzipfilebuf*
+  close();
+
+protected:
+  virtual bool
+  write_out(const char* data, std::size_t length);
+
+private:
+  zipFile file;
+};
+
+/**
+ *  @brief  Block-parallel zip archive output stream class.
+*/
+class pzipofstream : public std::ostream
+{
+public:
+  /**
+   *  @brief  Construct stream on zip archive to be opened.
+   *  @param  name  Archive file name.
+   *  @param  filenameinzip  Name of the entry to write.
+   *  @param  threads  Number of worker threads.
+  */
+  pzipofstream(const char* name, const char* filenameinzip,
+               unsigned int threads);
+
+  /**
+   *  Obtain underlying stream buffer.
+  */
+  pzipfilebuf*
+  rdbuf() const
+  { return const_cast<pzipfilebuf*>(&sb); }
+
+  /**
+   *  @brief  Check if file is open.
+   *  @return  True if file is open.
+  */
+  bool
+  is_open() { return sb.is_open(); }
+
+  /**
+   *  @brief  Close zip archive.
+   *
+   *  Stream will be in state fail() if close failed.
+  */
+  void
+  close();
+
+private:
+  pzipfilebuf sb;
+};
+
+#endif // PZFSTREAM_H
@@ -520,7 +520,8 @@ zipofstream::close()
  * ---------------------------------------------------------------
  */
 
-zipFile zipopen (const char* path, const char* filenameinzip, int append)
+zipFile zipopen (const char* path, const char* filenameinzip, int append,
+                 int raw)
 {
   zipFile zf = NULL;
   int err=ZIP_OK;
@@ -544,10 +545,12 @@ zipFile zipopen (const char* path, const char* filenameinzip, int append)
     zi.external_fa = 0;
     filetime(filenameinzip,&zi.tmz_date,&zi.dosDate);
 
-    err = zipOpenNewFileInZip(zf,filenameinzip,&zi,
+    // with raw set, the caller writes deflated data itself
+    err = zipOpenNewFileInZip2(zf,filenameinzip,&zi,
                      NULL,0,NULL,0,NULL,
                      Z_DEFLATED,
-                     Z_DEFAULT_COMPRESSION);
+                     Z_DEFAULT_COMPRESSION,
+                     raw);
   
     if (err != ZIP_OK)
     {
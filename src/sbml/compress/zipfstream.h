@@ -42,7 +42,7 @@
  * the code in minizip.c and miniunz.c contained in Minizip version 1.01e
  * (http://www.winimage.com/zLibDll/minizip.html) implemented by Gilles Vollant.
  *
- *  zipFile  zipopen (const char* path, const char* filenameinzip, int append);
+ *  zipFile  zipopen (const char* path, const char* filenameinzip, int append, int raw = 0);
  *  int      zipclose(zipFile file);
  *  int      zipwrite(zipFile file, voidp buf, unsigned len);
  *  unzFile  unzipopen (const char* path);
@@ -502,7 +502,8 @@ template<typename T1, typename T2>
  * ---------------------------------------------------------------
  */
 
-zipFile  zipopen (const char* path, const char* filenameinzip, int append);
+zipFile  zipopen (const char* path, const char* filenameinzip, int append,
+                  int raw = 0);
 int      zipclose(zipFile file);
 int      zipwrite(zipFile file, voidp buf, unsigned len);
 
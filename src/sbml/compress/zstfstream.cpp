@@ -0,0 +1,380 @@
+/*
+ * C++ I/O streams reading and writing Zstandard files through libzstd.
+ */
+
+#include "zstfstream.h"
+
+/*****************************************************************************/
+
+// Default constructor
+zstfilebuf::zstfilebuf()
+: file(NULL), io_mode(std::ios_base::openmode(0)), cctx(NULL), dctx(NULL),
+  level(0), threads(0), buffer(NULL), buffer_size(0), own_buffer(true),
+  zbuffer(NULL), zbuffer_size(0), more_output(false)
+{
+  zin.src  = NULL;
+  zin.size = 0;
+  zin.pos  = 0;
+}
+
+// Destructor
+zstfilebuf::~zstfilebuf()
+{
+  this->close();
+  if (own_buffer) delete [] buffer;
+}
+
+// Set compression parameters
+bool
+zstfilebuf::set_compression(int level,
+                            unsigned int threads)
+{
+  this->threads = threads;
+
+  if (level != 0 && (level < ZSTD_minCLevel() || level > ZSTD_maxCLevel()))
+    return false;
+
+  this->level = level;
+  return true;
+}
+
+// Open Zstandard file
+zstfilebuf*
+zstfilebuf::open(const char *name,
+                 std::ios_base::openmode mode)
+{
+  // Fail if file already open
+  if (this->is_open())
+    return NULL;
+  // A file is either read or written
+  if ((mode & std::ios_base::in) && (mode & std::ios_base::out))
+    return NULL;
+  if (!(mode & (std::ios_base::in | std::ios_base::out)))
+    return NULL;
+
+  io_mode = mode;
+
+  if (io_mode & std::ios_base::out)
+  {
+    cctx = ZSTD_createCCtx();
+    if (cctx == NULL)
+      return NULL;
+
+    if (level != 0)
+      ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, 1);
+    // fails harmlessly where libzstd is built without multithreading
+    if (threads > 0)
+      ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, (int)threads);
+  }
+  else
+  {
+    dctx = ZSTD_createDCtx();
+    if (dctx == NULL)
+      return NULL;
+  }
+
+  file = std::fopen(name, (io_mode & std::ios_base::out) ? "wb" : "rb");
+
+  if (file == NULL || !this->enable_buffers())
+  {
+    this->close();
+    return NULL;
+  }
+
+  return this;
+}
+
+// Close Zstandard file
+zstfilebuf*
+zstfilebuf::close()
+{
+  bool ok = this->is_open();
+
+  if (file != NULL)
+  {
+    if ((io_mode & std::ios_base::out) && !this->compress(ZSTD_e_end))
+      ok = false;
+    if (std::fclose(file) != 0)
+      ok = false;
+    file = NULL;
+  }
+
+  ZSTD_freeCCtx(cctx);
+  cctx = NULL;
+  ZSTD_freeDCtx(dctx);
+  dctx = NULL;
+
+  this->disable_buffers();
+  more_output = false;
+
+  return ok ? this : NULL;
+}
+
+/*****************************************************************************/
+
+// Fill get area with decompressed data
+zstfilebuf::int_type
+zstfilebuf::underflow()
+{
+  // If something is left in the get area by chance, return it
+  if (this->gptr() && (this->gptr() < this->egptr()))
+    return traits_type::to_int_type(*(this->gptr()));
+
+  if (!(io_mode & std::ios_base::in) || !this->is_open())
+    return traits_type::eof();
+
+  for (;;)
+  {
+    // Only read on when the decompressor holds no more output
+    if (zin.pos == zin.size && !more_output)
+    {
+      std::size_t n = std::fread(zbuffer, 1, zbuffer_size, file);
+      // A file ending in mid-frame is truncated, which the parser
+      // reports as malformed XML
+      if (n == 0)
+        return traits_type::eof();
+      zin.size = n;
+      zin.pos  = 0;
+    }
+
+    ZSTD_outBuffer zout = { buffer, buffer_size, 0 };
+    std::size_t ret = ZSTD_decompressStream(dctx, &zout, &zin);
+    if (ZSTD_isError(ret))
+      return traits_type::eof();
+
+    more_output = (zout.pos == zout.size);
+
+    if (zout.pos > 0)
+    {
+      this->setg(buffer, buffer, buffer + zout.pos);
+      return traits_type::to_int_type(*(this->gptr()));
+    }
+  }
+}
+
+// Compress put area
+zstfilebuf::int_type
+zstfilebuf::overflow(int_type c)
+{
+  if (!(io_mode & std::ios_base::out) || !this->is_open())
+    return traits_type::eof();
+
+  if (!this->compress(ZSTD_e_continue))
+    return traits_type::eof();
+
+  // The put area is empty now and has room for at least one character
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    *(this->pptr()) = traits_type::to_char_type(c);
+    this->pbump(1);
+  }
+
+  return traits_type::not_eof(c);
+}
+
+// Install external stream buffer
+std::streambuf*
+zstfilebuf::setbuf(char_type* p,
+                   std::streamsize n)
+{
+  // Unbuffered operation is not supported; keep the current buffer
+  if (p == NULL || n <= 0)
+    return this;
+
+  // Characters in the get area can't be moved to the new buffer
+  if (this->gptr() && (this->gptr() < this->egptr()))
+    return NULL;
+
+  // Pass characters in the put area on before switching buffers
+  if (this->pbase() && (this->pptr() > this->pbase()) &&
+      !this->compress(ZSTD_e_continue))
+    return NULL;
+
+  if (own_buffer) delete [] buffer;
+  buffer      = p;
+  buffer_size = (std::size_t)n;
+  own_buffer  = false;
+
+  if (io_mode & std::ios_base::out)
+    this->setp(buffer, buffer + buffer_size);
+  else
+    this->setg(buffer, buffer, buffer);
+
+  return this;
+}
+
+// Write put area and compressed data to file
+int
+zstfilebuf::sync()
+{
+  if (!(io_mode & std::ios_base::out) || !this->is_open())
+    return 0;
+
+  if (!this->compress(ZSTD_e_flush) || std::fflush(file) != 0)
+    return -1;
+
+  return 0;
+}
+
+/*****************************************************************************/
+
+// Pass put area through the compressor
+bool
+zstfilebuf::compress(ZSTD_EndDirective directive)
+{
+  ZSTD_inBuffer in = { this->pbase(),
+                       (std::size_t)(this->pptr() - this->pbase()), 0 };
+
+  for (;;)
+  {
+    ZSTD_outBuffer zout = { zbuffer, zbuffer_size, 0 };
+    std::size_t remaining = ZSTD_compressStream2(cctx, &zout, &in, directive);
+    if (ZSTD_isError(remaining))
+      return false;
+
+    if (zout.pos > 0 && std::fwrite(zbuffer, 1, zout.pos, file) != zout.pos)
+      return false;
+
+    // Flushing and ending a frame are done once nothing remains to be
+    // written; otherwise once all input has been taken
+    if (directive == ZSTD_e_continue ? (in.pos == in.size) : (remaining == 0))
+      break;
+  }
+
+  this->setp(buffer, buffer + buffer_size);
+  return true;
+}
+
+// Allocate the buffers for the open mode
+bool
+zstfilebuf::enable_buffers()
+{
+  const bool writing = (io_mode & std::ios_base::out) != 0;
+
+  if (buffer == NULL)
+  {
+    buffer_size = writing ? ZSTD_CStreamInSize() : ZSTD_DStreamOutSize();
+    buffer      = new char_type[buffer_size];
+    own_buffer  = true;
+  }
+
+  zbuffer_size = writing ? ZSTD_CStreamOutSize() : ZSTD_DStreamInSize();
+  zbuffer      = new char[zbuffer_size];
+
+  zin.src  = zbuffer;
+  zin.size = 0;
+  zin.pos  = 0;
+
+  if (writing)
+  {
+    this->setp(buffer, buffer + buffer_size);
+    this->setg(0, 0, 0);
+  }
+  else
+  {
+    this->setg(buffer, buffer, buffer);
+    this->setp(0, 0);
+  }
+
+  return true;
+}
+
+// Free the buffers and reset the buffer pointers
+void
+zstfilebuf::disable_buffers()
+{
+  delete [] zbuffer;
+  zbuffer      = NULL;
+  zbuffer_size = 0;
+
+  zin.src  = NULL;
+  zin.size = 0;
+  zin.pos  = 0;
+
+  // An external buffer stays installed for the next file
+  if (own_buffer)
+  {
+    delete [] buffer;
+    buffer      = NULL;
+    buffer_size = 0;
+  }
+
+  this->setg(0, 0, 0);
+  this->setp(0, 0);
+}
+
+/*****************************************************************************/
+
+// Default constructor initializes stream buffer
+zstifstream::zstifstream()
+: std::istream(NULL), sb()
+{ this->init(&sb); }
+
+// Initialize stream buffer and open file
+zstifstream::zstifstream(const char* name,
+                         std::ios_base::openmode mode)
+: std::istream(NULL), sb()
+{
+  this->init(&sb);
+  this->open(name, mode);
+}
+
+// Open file and go into fail() state if unsuccessful
+void
+zstifstream::open(const char* name,
+                  std::ios_base::openmode mode)
+{
+  if (!sb.open(name, (mode | std::ios_base::in) & ~std::ios_base::out))
+    this->setstate(std::ios_base::failbit);
+  else
+    this->clear();
+}
+
+// Close file
+void
+zstifstream::close()
+{
+  if (!sb.close())
+    this->setstate(std::ios_base::failbit);
+}
+
+/*****************************************************************************/
+
+// Default constructor initializes stream buffer
+zstofstream::zstofstream()
+: std::ostream(NULL), sb()
+{ this->init(&sb); }
+
+// Initialize stream buffer and open file
+zstofstream::zstofstream(const char* name,
+                         int level,
+                         unsigned int threads,
+                         std::ios_base::openmode mode)
+: std::ostream(NULL), sb()
+{
+  this->init(&sb);
+  if (!sb.set_compression(level, threads))
+    this->setstate(std::ios_base::failbit);
+  else
+    this->open(name, mode);
+}
+
+// Open file and go into fail() state if unsuccessful
+void
+zstofstream::open(const char* name,
+                  std::ios_base::openmode mode)
+{
+  if (!sb.open(name, (mode | std::ios_base::out) & ~std::ios_base::in))
+    this->setstate(std::ios_base::failbit);
+  else
+    this->clear();
+}
+
+// Close file
+void
+zstofstream::close()
+{
+  if (!sb.close())
+    this->setstate(std::ios_base::failbit);
+}
@@ -0,0 +1,273 @@
+/*
+ * C++ I/O streams reading and writing Zstandard files through libzstd.
+ *
+ * The interface follows zfstream.h and bzfstream.h.  Files are read and
+ * written with the streaming API of libzstd, so files of several frames
+ * (as written by pzstd or by concatenating .zst files) are read as one.
+ */
+
+#ifndef ZSTFSTREAM_H
+#define ZSTFSTREAM_H
+
+#include <cstdio>
+#include <istream>  // not iostream, since we don't need cin/cout
+#include <ostream>
+#include "zstd.h"
+
+/*****************************************************************************/
+
+/**
+ *  @brief  Zstandard file stream buffer class.
+ *
+ *  This class implements basic_filebuf for Zstandard files.  A file is
+ *  opened either for reading or for writing; seeking and putback are not
+ *  supported.
+*/
+class zstfilebuf : public std::streambuf
+{
+public:
+  //  Default constructor.
+  zstfilebuf();
+
+  //  Destructor.
+  virtual
+  ~zstfilebuf();
+
+  /**
+   *  @brief  Check if file is open.
+   *  @return  True if file is open.
+  */
+  bool
+  is_open() const { return (file != NULL); }
+
+  /**
+   *  @brief  Set compression parameters for files opened for writing.
+   *  @param  level  Compression level, or 0 for the libzstd default.
+   *  @param  threads  Number of compressing threads, or 0 to compress on
+   *                   the calling thread.
+   *  @return  True if libzstd accepted the level.
+   *
+   *  Must be called before open().  The thread count is a request: a
+   *  libzstd built without multithreading compresses on the calling thread.
+  */
+  bool
+  set_compression(int level,
+                  unsigned int threads);
+
+  /**
+   *  @brief  Open Zstandard file.
+   *  @param  name  File name.
+   *  @param  mode  Open mode flags (either ios::in or ios::out).
+   *  @return  @c this on success, NULL on failure.
+  */
+  zstfilebuf*
+  open(const char* name,
+       std::ios_base::openmode mode);
+
+  /**
+   *  @brief  Close Zstandard file, ending the frame when writing.
+   *  @return  @c this on success, NULL on failure.
+  */
+  zstfilebuf*
+  close();
+
+protected:
+  /**
+   *  @brief  Fill get area with decompressed data.
+   *  @return  First character in get area on success, EOF on error or at
+   *           the end of the file.
+  */
+  virtual int_type
+  underflow();
+
+  /**
+   *  @brief  Compress put area.
+   *  @param  c  Extra character to add to buffer contents.
+   *  @return  Non-EOF on success, EOF on error.
+  */
+  virtual int_type
+  overflow(int_type c = traits_type::eof());
+
+  /**
+   *  @brief  Installs external stream buffer for output.
+   *  @param  p  Pointer to char buffer.
+   *  @param  n  Size of external buffer.
+   *  @return  @c this on success, NULL on failure.
+  */
+  virtual std::streambuf*
+  setbuf(char_type* p,
+         std::streamsize n);
+
+  /**
+   *  @brief  Compress put area and flush compressed data to the file.
+   *  @return  0 on success, -1 on error.
+  */
+  virtual int
+  sync();
+
+private:
+  zstfilebuf(const zstfilebuf&);
+  zstfilebuf& operator=(const zstfilebuf&);
+
+  /**
+   *  @brief  Pass put area through the compressor.
+   *  @param  directive  ZSTD_e_continue, ZSTD_e_flush or ZSTD_e_end.
+   *  @return  True on success.
+  */
+  bool
+  compress(ZSTD_EndDirective directive);
+
+  /**
+   *  @brief  Allocate the buffers for the open mode.
+  */
+  bool
+  enable_buffers();
+
+  /**
+   *  @brief  Free the buffers and reset the buffer pointers.
+  */
+  void
+  disable_buffers();
+
+  std::FILE*   file;
+  std::ios_base::openmode io_mode;
+  ZSTD_CCtx*   cctx;
+  ZSTD_DCtx*   dctx;
+  int          level;
+  unsigned int threads;
+
+  //  Uncompressed data: the get area or the put area.
+  char_type*   buffer;
+  std::size_t  buffer_size;
+  bool         own_buffer;
+
+  //  Compressed data on its way from or to the file.
+  char*        zbuffer;
+  std::size_t  zbuffer_size;
+  ZSTD_inBuffer zin;
+
+  //  True if the decompressor may hold output it had no room for.
+  bool         more_output;
+};
+
+/*****************************************************************************/
+
+/**
+ *  @brief  Zstandard file input stream class.
+*/
+class zstifstream : public std::istream
+{
+public:
+  //  Default constructor
+  zstifstream();
+
+  /**
+   *  @brief  Construct stream on Zstandard file to be opened.
+   *  @param  name  File name.
+   *  @param  mode  Open mode flags (forced to contain ios::in).
+  */
+  explicit
+  zstifstream(const char* name,
+              std::ios_base::openmode mode = std::ios_base::in);
+
+  /**
+   *  Obtain underlying stream buffer.
+  */
+  zstfilebuf*
+  rdbuf() const
+  { return const_cast<zstfilebuf*>(&sb); }
+
+  /**
+   *  @brief  Check if file is open.
+   *  @return  True if file is open.
+  */
+  bool
+  is_open() { return sb.is_open(); }
+
+  /**
+   *  @brief  Open Zstandard file.
+   *  @param  name  File name.
+   *  @param  mode  Open mode flags (forced to contain ios::in).
+   *
+   *  Stream will be in state good() if file opens successfully;
+   *  otherwise in state fail().
+  */
+  void
+  open(const char* name,
+       std::ios_base::openmode mode = std::ios_base::in);
+
+  /**
+   *  @brief  Close Zstandard file.
+   *
+   *  Stream will be in state fail() if close failed.
+  */
+  void
+  close();
+
+private:
+  zstfilebuf sb;
+};
+
+/*****************************************************************************/
+
+/**
+ *  @brief  Zstandard file output stream class.
+*/
+class zstofstream : public std::ostream
+{
+public:
+  //  Default constructor
+  zstofstream();
+
+  /**
+   *  @brief  Construct stream on Zstandard file to be opened.
+   *  @param  name  File name.
+   *  @param  level  Compression level, or 0 for the libzstd default.
+   *  @param  threads  Number of compressing threads, or 0.
+   *  @param  mode  Open mode flags (forced to contain ios::out).
+  */
+  explicit
+  zstofstream(const char* name,
+              int level = 0,
+              unsigned int threads = 0,
+              std::ios_base::openmode mode = std::ios_base::out);
+
+  /**
+   *  Obtain underlying stream buffer.
+  */
+  zstfilebuf*
+  rdbuf() const
+  { return const_cast<zstfilebuf*>(&sb); }
+
+  /**
+   *  @brief  Check if file is open.
+   *  @return  True if file is open.
+  */
+  bool
+  is_open() { return sb.is_open(); }
+
+  /**
+   *  @brief  Open Zstandard file.
+   *  @param  name  File name.
+   *  @param  mode  Open mode flags (forced to contain ios::out).
+   *
+   *  Stream will be in state good() if file opens successfully;
+   *  otherwise in state fail().
+  */
+  void
+  open(const char* name,
+       std::ios_base::openmode mode = std::ios_base::out);
+
+  /**
+   *  @brief  Close Zstandard file.
+   *
+   *  Stream will be in state fail() if close failed.
+  */
+  void
+  close();
+
+private:
+  zstfilebuf sb;
+};
+
+#endif // ZSTFSTREAM_H
@@ -56,9 +56,11 @@
 #ifdef __cplusplus
 
 #include <algorithm>
+#include <functional>
 #include <string>
 #include <vector>
 #include <map>
+#include <queue>
 
 using namespace std;
 LIBSBML_CPP_NAMESPACE_BEGIN
@@ -168,185 +170,106 @@ static vector<string> getSymbols(const ASTNode* nodes)
 }
 
 
-static vector<AssignmentRule*> reorderRules(vector<AssignmentRule*>& assignmentRules)
+/*
+ * Sorts the items with the given variables and math so that every item
+ * comes after the items whose variables its math uses (Kahn's algorithm).
+ * Among the items whose dependencies are all placed, the one that comes
+ * first in the input is taken next, so items already in a valid order
+ * keep it.
+ *
+ * Returns true and fills order with the indexes of the items in sorted
+ * order, or returns false and fills cycle with the variables of the
+ * items that are part of, or depend on, a cycle.
+ */
+static bool sortByDependencies(const vector<string>& variables,
+                               const vector<const ASTNode*>& math,
+                               vector<size_t>& order,
+                               vector<string>& cycle)
 {
-  if (assignmentRules.size() < 2) return assignmentRules;
-  
-  map<int, vector<string> > allSymbols;
-  map<string, vector<string> > map;
-  vector<string> idList;
-  vector<AssignmentRule*> result;
-
-  // read id list, initialize all symbols
-  for (size_t index = 0; index < assignmentRules.size(); index++)
-  {
-    AssignmentRule* rule = (AssignmentRule*)assignmentRules[index];
-    string variable = rule->getVariable();
-    if (!rule->isSetMath())
-      allSymbols[(int)index] = vector<string>();
-    else
-      allSymbols[(int)index] = getSymbols(rule->getMath());
-    idList.push_back(variable);
-    map[variable] = vector<string>();
-  }
-
+  size_t numItems = variables.size();
+  order.clear();
+  cycle.clear();
 
-  // initialize order array
-  vector<int> order;
-  for (size_t i = 0; i < assignmentRules.size(); i++)
+  // the items assigning each variable
+  map<string, vector<size_t> > assigned;
+  for (size_t i = 0; i < numItems; i++)
   {
-    order.push_back((int)i);
+    assigned[variables[i]].push_back(i);
   }
 
-  // build dependency graph
-  for (size_t i = 0; i < idList.size(); i++)
+  // dependents[j] lists the items that use the variable of item j
+  vector< vector<size_t> > dependents(numItems);
+  vector<size_t> numDependencies(numItems, 0);
+  for (size_t i = 0; i < numItems; i++)
   {
-    string id = idList[i];
-    for (size_t index = 0; index < assignmentRules.size(); index++)
+    vector<string> symbols = getSymbols(math[i]);
+    for (size_t n = 0; n < symbols.size(); n++)
     {
-      vector<string>::iterator it = ::find(allSymbols[(int)index].begin(), allSymbols[(int)index].end(), id);
-      if (it != allSymbols[(int)index].end())
-      {
-        map[(assignmentRules[index])->getVariable()].push_back(id);
-      }
-    }
-  }
-
+      map<string, vector<size_t> >::const_iterator it = 
+                                                assigned.find(symbols[n]);
+      if (it == assigned.end()) continue;
 
-  // sort
-  bool changed = true;
-  while (changed)
-  {
-    changed = false;
-    for (size_t i = 0; i < order.size(); i++)
-    {
-
-      int first = order[i];
-      for (size_t j = i + 1; j < order.size(); j++)
+      for (size_t k = 0; k < it->second.size(); k++)
       {
-        int second = order[j];
-
-        string secondVar = assignmentRules[(size_t)second]->getVariable();
-        string firstVar = assignmentRules[(size_t)first]->getVariable();
-
-
-        vector<string>::iterator it = ::find(map[firstVar].begin(), map[firstVar].end(), secondVar);
-
-        if (it != map[firstVar].end())
-        {
-          // found dependency, swap and start over
-          order[i] = second;
-          order[j] = first;
-
-          changed = true;
-          break;
-        }
+        size_t j = it->second[k];
+        if (j == i) continue;
+        dependents[j].push_back(i);
+        numDependencies[i]++;
       }
-
-      // if swapped start over
-      if (changed)
-        break;
     }
   }
 
-
-  // create new order
-  for (size_t i = 0; i < order.size(); i++)
-    result.push_back(assignmentRules[(size_t)order[i]]);
-
-
-  return result;
-}
-
-
-static vector<InitialAssignment*> reorderInitialAssignments(vector<InitialAssignment*>& intialAssignments)
-{
-  if (intialAssignments.size() < 2) return intialAssignments;
-
-  map<int, vector<string> > allSymbols;
-  map<string, vector<string> > map;
-  vector<string> idList;
-  vector<InitialAssignment*> result;
-
-  // read id list, initialize all symbols
-  for (size_t index = 0; index < intialAssignments.size(); index++)
+  priority_queue<size_t, vector<size_t>, greater<size_t> > ready;
+  for (size_t i = 0; i < numItems; i++)
   {
-    InitialAssignment* ia = (InitialAssignment*)intialAssignments[index];
-    string variable = ia->getSymbol();
-    if (!ia->isSetMath())
-      allSymbols[(int)index] = vector<string>();
-    else
-      allSymbols[(int)index] = getSymbols(ia->getMath());
-    idList.push_back(variable);
-    map[variable] = vector<string>();
+    if (numDependencies[i] == 0)
+      ready.push(i);
   }
 
-  // initialize order array
-  vector<int> order;
-  for (size_t i = 0; i < intialAssignments.size(); i++)
+  while (!ready.empty())
   {
-    order.push_back((int)i);
-  }
+    size_t i = ready.top();
+    ready.pop();
+    order.push_back(i);
 
-  // build dependency graph
-  for (size_t i = 0; i < idList.size(); i++)
-  {
-    string id = idList[i];
-    for (size_t index = 0; index < intialAssignments.size(); index++)
+    for (size_t k = 0; k < dependents[i].size(); k++)
     {
-      vector<string>::iterator it = ::find(allSymbols[(int)index].begin(), allSymbols[(int)index].end(), id);
-      if (it != allSymbols[(int)index].end())
-      {
-        map[(intialAssignments[index])->getSymbol()].push_back(id);
-      }
+      size_t j = dependents[i][k];
+      if (--numDependencies[j] == 0)
+        ready.push(j);
     }
   }
 
+  if (order.size() == numItems) return true;
 
-  // sort
-  bool changed = true;
-  while (changed)
+  // the items left over are in a cycle or depend on one
+  for (size_t i = 0; i < numItems; i++)
   {
-    changed = false;
-    for (size_t i = 0; i < order.size(); i++)
-    {
-
-      int first = order[i];
-      for (size_t j = i + 1; j < order.size(); j++)
-      {
-        int second = order[j];
-
-        string secondVar = intialAssignments[(size_t)second]->getSymbol();
-        string firstVar = intialAssignments[(size_t)first]->getSymbol();
-
-
-        vector<string>::iterator it = ::find(map[firstVar].begin(), map[firstVar].end(), secondVar);
+    if (numDependencies[i] != 0)
+      cycle.push_back(variables[i]);
+  }
 
-        if (it != map[firstVar].end())
-        {
-          // found dependency, swap and start over
-          order[i] = second;
-          order[j] = first;
+  return false;
+}
 
-          changed = true;
-          break;
-        }
-      }
 
-      // if swapped start over
-      if (changed)
-        break;
-    }
+static void logCycle(SBMLDocument* document, const vector<string>& cycle,
+                     const string& type)
+{
+  string details = "The " + type + " for ";
+  for (size_t i = 0; i < cycle.size(); i++)
+  {
+    if (i > 0)
+      details += (i + 1 == cycle.size()) ? " and " : ", ";
+    details += "'" + cycle[i] + "'";
   }
+  details += " are part of or depend on a cycle, so they cannot be sorted.";
 
-
-  // create new order
-  for (size_t i = 0; i < order.size(); i++)
-    result.push_back(intialAssignments[(size_t)order[i]]);
-
-  return result;
+  document->getErrorLog()->logError(CircularRuleDependency,
+                         document->getLevel(), document->getVersion(), details);
 }
 
+
 int 
 SBMLRuleConverter::convert()
 {
@@ -382,36 +305,76 @@ SBMLRuleConverter::convert()
   }
 
 
-  vector<AssignmentRule*> assignmentRules;
+  /* the assignment rules are sorted in the order of the list, so rules
+   * that are already in a valid order keep it; the validator reports
+   * cycles above, but they are checked again here before anything is
+   * moved
+   */
+  vector<string> variables;
+  vector<const ASTNode*> math;
+  vector<size_t> ruleOrder;
+  vector<string> cycle;
   unsigned int numRules = mModel->getNumRules();
-  // for any math in document replace each function def
+  for (unsigned int i = 0; i < numRules; i++)
+  {
+    const Rule* rule = mModel->getRule(i);
+    if (rule->getTypeCode() == SBML_ASSIGNMENT_RULE)
+    {
+      variables.push_back(rule->getVariable());
+      math.push_back(rule->isSetMath() ? rule->getMath() : NULL);
+    }
+  }
+
+  if (!sortByDependencies(variables, math, ruleOrder, cycle))
+  {
+    logCycle(mDocument, cycle, "assignment rules");
+    return LIBSBML_CONV_INVALID_SRC_DOCUMENT;
+  }
+
+  variables.clear();
+  math.clear();
+  vector<size_t> iaOrder;
+  unsigned int numInitialAssignments = mModel->getNumInitialAssignments();
+  for (unsigned int i = 0; i < numInitialAssignments; i++)
+  {
+    const InitialAssignment* ia = mModel->getInitialAssignment(i);
+    variables.push_back(ia->getSymbol());
+    math.push_back(ia->isSetMath() ? ia->getMath() : NULL);
+  }
+
+  if (!sortByDependencies(variables, math, iaOrder, cycle))
+  {
+    logCycle(mDocument, cycle, "initial assignments");
+    return LIBSBML_CONV_INVALID_SRC_DOCUMENT;
+  }
+
+
+  // removed from the end of the list, and stored in the order of the list
+  vector<AssignmentRule*> assignmentRules(ruleOrder.size());
+  size_t numAssignmentRules = assignmentRules.size();
   for (unsigned int i = 1 ; i <= numRules;  i++)
   {
     Rule* rule = mModel->getRule(numRules - i);
     if (rule->getTypeCode() == SBML_ASSIGNMENT_RULE)
     {
-      assignmentRules.push_back((AssignmentRule*)mModel->removeRule(numRules - i));
+      assignmentRules[--numAssignmentRules] =
+                          (AssignmentRule*)mModel->removeRule(numRules - i);
     }
 
   }
 
-  assignmentRules = reorderRules(assignmentRules);
-
-  for (unsigned int i = 0; i < assignmentRules.size();i++)
-    mModel->getListOfRules()->insertAndOwn((int)i,assignmentRules[i]);
+  for (unsigned int i = 0; i < ruleOrder.size();i++)
+    mModel->getListOfRules()->insertAndOwn((int)i,assignmentRules[ruleOrder[i]]);
 
 
   vector<InitialAssignment*> initialAssignments;
-  unsigned int numInitialAssignments = mModel->getNumInitialAssignments();
   for (unsigned int i=0; i < numInitialAssignments; i++)
   {
     initialAssignments.push_back(mModel->getListOfInitialAssignments()->remove(0));
   }
 
-  initialAssignments = reorderInitialAssignments(initialAssignments);
-
-  for (unsigned int i = 0; i < initialAssignments.size();i++)
-    mModel->getListOfInitialAssignments()->appendAndOwn(initialAssignments[i]);
+  for (unsigned int i = 0; i < iaOrder.size();i++)
+    mModel->getListOfInitialAssignments()->appendAndOwn(initialAssignments[iaOrder[i]]);
 
   return LIBSBML_OPERATION_SUCCESS;
   
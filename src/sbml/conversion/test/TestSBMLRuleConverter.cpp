@@ -158,6 +158,48 @@ END_TEST
 
 
 
+START_TEST (test_conversion_ruleconverter_keepOrder)
+{
+  // rules already in a valid order are left in it, even where another
+  // valid order exists
+
+  SBMLDocument doc; 
+
+  Model* model = doc.createModel();
+  model->setId("m");
+
+  const char* ids[] = { "a", "c", "b" };
+  const char* formulas[] = { "1", "2", "a + 1" };
+  for (unsigned int i = 0; i < 3; i++)
+  {
+    Parameter* parameter = model->createParameter();
+    parameter->setId(ids[i]);
+    parameter->setConstant(false);
+    parameter->setValue(0);
+
+    AssignmentRule* rule = model->createAssignmentRule();
+    rule->setVariable(ids[i]);
+    rule->setFormula(formulas[i]);
+  }
+
+  ConversionProperties props;
+  props.addOption("sortRules", true, "sort rules");
+
+  SBMLConverter* converter = new SBMLRuleConverter();
+  converter->setProperties(&props);
+  converter->setDocument(&doc);
+
+  fail_unless (converter->convert() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless (model->getNumRules() == 3);
+  fail_unless (model->getRule(0)->getVariable() == "a");
+  fail_unless (model->getRule(1)->getVariable() == "c");
+  fail_unless (model->getRule(2)->getVariable() == "b");
+
+  delete converter;
+}
+END_TEST
+
+
 START_TEST (test_conversion_ruleconverter_sortIA)
 {
 
@@ -316,6 +358,95 @@ START_TEST (test_conversion_ruleconverter_with_alg)
 END_TEST
 
 
+START_TEST (test_conversion_ruleconverter_sortChainIA)
+{
+  SBMLDocument doc(3, 1);
+
+  Model* model = doc.createModel();
+  model->setId("m");
+
+  const char* ids[] = { "a", "c", "b", "d" };
+  const char* formulas[] = { "b + c", "2", "c", "4" };
+  const char* metaids[] = { "m1", "m2", "m3", "m4" };
+
+  for (unsigned int i = 0; i < 4; i++)
+  {
+    Parameter* parameter = model->createParameter();
+    parameter->setId(ids[i]);
+    parameter->setConstant(false);
+
+    InitialAssignment* ia = model->createInitialAssignment();
+    ia->setSymbol(ids[i]);
+    ASTNode * math = SBML_parseFormula(formulas[i]);
+    ia->setMath(math);
+    delete math;
+    ia->setMetaId(metaids[i]);
+  }
+
+  ConversionProperties props;
+  props.addOption("sortRules", true, "sort rules");
+
+  SBMLConverter* converter = new SBMLRuleConverter();
+  converter->setProperties(&props);
+  converter->setDocument(&doc);
+  
+  fail_unless (converter->convert() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless (model->getNumInitialAssignments() == 4);
+  fail_unless (model->getInitialAssignment(0)->getMetaId() == "m2");
+  fail_unless (model->getInitialAssignment(1)->getMetaId() == "m3");
+  fail_unless (model->getInitialAssignment(2)->getMetaId() == "m1");
+  fail_unless (model->getInitialAssignment(3)->getMetaId() == "m4");
+
+  delete converter;
+}
+END_TEST
+
+
+START_TEST (test_conversion_ruleconverter_cycle)
+{
+  SBMLDocument doc(3, 1);
+
+  Model* model = doc.createModel();
+  model->setId("m");
+
+  const char* ids[] = { "a", "b", "c", "d" };
+  const char* formulas[] = { "b + 1", "a * 2", "1", "a" };
+  const char* metaids[] = { "m1", "m2", "m3", "m4" };
+
+  for (unsigned int i = 0; i < 4; i++)
+  {
+    Parameter* parameter = model->createParameter();
+    parameter->setId(ids[i]);
+    parameter->setConstant(false);
+
+    AssignmentRule* rule = model->createAssignmentRule();
+    rule->setVariable(ids[i]);
+    rule->setFormula(formulas[i]);
+    rule->setMetaId(metaids[i]);
+  }
+
+  ConversionProperties props;
+  props.addOption("sortRules", true, "sort rules");
+
+  SBMLConverter* converter = new SBMLRuleConverter();
+  converter->setProperties(&props);
+  converter->setDocument(&doc);
+
+  fail_unless (converter->convert() == LIBSBML_CONV_INVALID_SRC_DOCUMENT);
+  fail_unless (doc.getErrorLog()->contains(CircularRuleDependency));
+
+  // the rules are left as they were
+  fail_unless (model->getNumRules() == 4);
+  fail_unless (model->getRule(0)->getMetaId() == "m1");
+  fail_unless (model->getRule(1)->getMetaId() == "m2");
+  fail_unless (model->getRule(2)->getMetaId() == "m3");
+  fail_unless (model->getRule(3)->getMetaId() == "m4");
+
+  delete converter;
+}
+END_TEST
+
+
 START_TEST (test_conversion_inlineFD_bug)
 {
   std::string filename = "/inline_bug_minimal.xml";
@@ -383,8 +514,11 @@ create_suite_TestSBMLRuleConverter (void)
   tcase_add_test(tcase, test_conversion_ruleconverter_sort);
   tcase_add_test(tcase, test_conversion_ruleconverter_dontSort);
   tcase_add_test(tcase, test_conversion_ruleconverter_with_alg);
+  tcase_add_test(tcase, test_conversion_ruleconverter_keepOrder);
   tcase_add_test(tcase, test_conversion_ruleconverter_sortIA);
   tcase_add_test(tcase, test_conversion_ruleconverter_dontSortIA);
+  tcase_add_test(tcase, test_conversion_ruleconverter_sortChainIA);
+  tcase_add_test(tcase, test_conversion_ruleconverter_cycle);
   tcase_add_test(tcase, test_conversion_inlineFD_bug);
   tcase_add_test(tcase, test_conversion_inlineIA_bug);
       
@@ -55,6 +55,12 @@
 
 #include <sbml/util/IdList.h>
 
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#define LIBSBML_REGISTRY_LOCK
+#include <atomic>
+#include <mutex>
+#endif
+
 using namespace std;
 
 LIBSBML_CPP_NAMESPACE_BEGIN
@@ -66,9 +72,27 @@ SBMLExtensionRegistry* SBMLExtensionRegistry::mInstance = NULL;
 
 bool SBMLExtensionRegistry::registered = false;
 
+#ifdef LIBSBML_REGISTRY_LOCK
+/*
+ * The registry is created, and the built-in packages are registered with
+ * it, on first use, which may happen in several threads at once (for
+ * example when formulas are parsed in several threads).  Registering a
+ * package calls getInstance() again from the registering thread, which
+ * then gets the registry without waiting for itself.
+ */
+static std::mutex sRegistryMutex;
+static std::atomic<bool> sRegistryReady(false);
+static thread_local bool sRegistering = false;
+#endif
+
 void 
 SBMLExtensionRegistry::deleteRegistry()
 {
+#ifdef LIBSBML_REGISTRY_LOCK
+  std::lock_guard<std::mutex> lock(sRegistryMutex);
+  sRegistryReady.store(false);
+#endif
+
   if (mInstance != NULL)
   {
     delete mInstance;
@@ -81,6 +105,15 @@ SBMLExtensionRegistry::deleteRegistry()
 SBMLExtensionRegistry& 
 SBMLExtensionRegistry::getInstance()
 {
+#ifdef LIBSBML_REGISTRY_LOCK
+  if (sRegistryReady.load(std::memory_order_acquire) || sRegistering)
+  {
+    return *mInstance;
+  }
+
+  std::lock_guard<std::mutex> lock(sRegistryMutex);
+#endif
+
   if (mInstance == NULL)
   {
     mInstance = new SBMLExtensionRegistry();
@@ -90,7 +123,14 @@ SBMLExtensionRegistry::getInstance()
   if (!registered)
   {
     registered = true;
+#ifdef LIBSBML_REGISTRY_LOCK
+    sRegistering = true;
+#endif
     #include <sbml/extension/RegisterExtensions.cxx>
+#ifdef LIBSBML_REGISTRY_LOCK
+    sRegistering = false;
+    sRegistryReady.store(true, std::memory_order_release);
+#endif
   }
   return *mInstance;
 }
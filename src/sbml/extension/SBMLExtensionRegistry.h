@@ -98,6 +98,11 @@ public:
    * they can invoke its methods.  The registry is implemented as a
    * singleton, and this is the method callers can use to get a copy of it.
    *
+   * The registry is created on the first call, which may be made from
+   * several threads at once when libSBML is built as C++11 or later.  With
+   * older compilers, call this method once before using libSBML from
+   * several threads.
+   *
    * @return the instance of the SBMLExtensionRegistry object.
    */
   static SBMLExtensionRegistry& getInstance();
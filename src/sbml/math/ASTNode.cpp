@@ -263,7 +263,6 @@ ASTNode::ASTNode (ASTNodeType_t type)
   // move to after we have loaded plugins
   //setType(type);
 
-  mChildren             = new List;
   mSemanticsAnnotations = new List;
   // only load plugins when we need to
   //if (type > AST_END_OF_CORE && type < AST_UNKNOWN)
@@ -306,7 +305,6 @@ ASTNode::ASTNode (Token_t* token)
   mIsBvar = false;
   mUserData      = NULL;
 
-  mChildren             = new List;
   mSemanticsAnnotations = new List;
 
   if (token != NULL)
@@ -367,7 +365,7 @@ ASTNode::ASTNode (const ASTNode& orig) :
  ,mExponent             ( orig.mExponent )
  ,mDefinitionURL        ( orig.mDefinitionURL->clone() )	
  ,hasSemantics          ( orig.hasSemantics )
- ,mChildren             ( new List() )
+ ,mChildren             ()
  ,mSemanticsAnnotations ( new List() )
  ,mParentSBMLObject     ( orig.mParentSBMLObject )
  ,mUnits                ( orig.mUnits)
@@ -382,6 +380,7 @@ ASTNode::ASTNode (const ASTNode& orig) :
     mName = safe_strdup(orig.mName);
   }
 
+  mChildren.reserve(orig.mChildren.size());
   for (unsigned int c = 0; c < orig.getNumChildren(); ++c)
   {
     addChild( orig.getChild(c)->deepCopy() );
@@ -434,17 +433,15 @@ ASTNode& ASTNode::operator=(const ASTNode& rhs)
       mName = NULL;
     }
 
-    unsigned int size = mChildren->getSize();
-    while (size--) delete static_cast<ASTNode*>( mChildren->remove(0) );
-    delete mChildren;
-    mChildren = new List();
+    clearChildren();
 
+    mChildren.reserve(rhs.mChildren.size());
     for (unsigned int c = 0; c < rhs.getNumChildren(); ++c)
     {
       addChild( rhs.getChild(c)->deepCopy() );
     }
 
-    size = mSemanticsAnnotations->getSize();
+    unsigned int size = mSemanticsAnnotations->getSize();
     while (size--)  delete static_cast<XMLNode*>(mSemanticsAnnotations->remove(0) );
     delete mSemanticsAnnotations;
     mSemanticsAnnotations = new List();
@@ -470,13 +467,9 @@ ASTNode& ASTNode::operator=(const ASTNode& rhs)
 LIBSBML_EXTERN
 ASTNode::~ASTNode ()
 {
-  unsigned int size = getNumChildren();
-
-
-  while (size--) delete static_cast<ASTNode*>( mChildren->remove(0) );
-  delete mChildren;
+  clearChildren();
 
-  size = mSemanticsAnnotations->getSize();
+  unsigned int size = mSemanticsAnnotations->getSize();
   while (size--)  delete static_cast<XMLNode*>(mSemanticsAnnotations->remove(0) );
   delete mSemanticsAnnotations;
 
@@ -830,8 +823,10 @@ int
 ASTNode::addChild (ASTNode* child, bool inRead)
 {
 
+  if (child == NULL) return LIBSBML_OPERATION_FAILED;
+
   unsigned int numBefore = getNumChildren();
-  mChildren->add(child);
+  mChildren.push_back(child);
 
   /* HACK to allow representsBVar function to be correct */
   if (inRead == false && this->getType() == AST_LAMBDA
@@ -869,7 +864,7 @@ ASTNode::prependChild (ASTNode* child)
   if (child == NULL) return LIBSBML_INVALID_OBJECT;
 
   unsigned int numBefore = getNumChildren();
-  mChildren->prepend(child);
+  mChildren.insert(mChildren.begin(), child);
 
   if (getNumChildren() == numBefore + 1)
   {
@@ -890,7 +885,7 @@ ASTNode::removeChild(unsigned int n)
   unsigned int size = getNumChildren();
   if (n < size)
   {
-    mChildren->remove(n);
+    mChildren.erase(mChildren.begin() + n);
     if (getNumChildren() == size-1)
     {
       removed = LIBSBML_OPERATION_SUCCESS;
@@ -911,7 +906,8 @@ ASTNode::replaceChild(unsigned int n, ASTNode *newChild, bool delreplaced)
   unsigned int size = getNumChildren();
   if (n < size)
   {
-    ASTNode* rep = static_cast<ASTNode*>(mChildren->remove(n));
+    ASTNode* rep = mChildren[n];
+    mChildren.erase(mChildren.begin() + n);
     if (delreplaced) 
     {
       delete rep;
@@ -931,34 +927,10 @@ ASTNode::insertChild(unsigned int n, ASTNode *newChild)
 
   int inserted = LIBSBML_INDEX_EXCEEDS_SIZE;
 
-  unsigned int i, size = getNumChildren();
-  if (n == 0)
-  {
-    prependChild(newChild);
-    inserted = LIBSBML_OPERATION_SUCCESS;
-  }
-  else if (n <= size) 
+  unsigned int size = getNumChildren();
+  if (n <= size) 
   {
-    /* starting at the end take each child in the list and prepend it
-    * then remove it from the end
-    * at the insertion point prepend the newChild
-    * eg list: a, b, c 
-    * inserting d at position 2
-    * list goes: c, a, b :  d, c, a, b : b, d, c, a : a, b, d, c
-    */
-    for (i = size-1; i >= n; i--)
-    {
-      prependChild(getChild(size-1));
-      mChildren->remove(size);
-    }
-
-    prependChild(newChild);
-
-    for (i = 0; i < n; i++)
-    {
-      prependChild(getChild(size));
-      mChildren->remove(size+1);
-    }
+    mChildren.insert(mChildren.begin() + n, newChild);
 
     if (getNumChildren() == size + 1)
       inserted = LIBSBML_OPERATION_SUCCESS;
@@ -998,7 +970,7 @@ LIBSBML_EXTERN
 ASTNode*
 ASTNode::getChild (unsigned int n) const
 {
-  return static_cast<ASTNode*>( mChildren->get(n) );
+  return (n < mChildren.size()) ? mChildren[n] : NULL;
 }
 
 
@@ -1010,7 +982,7 @@ LIBSBML_EXTERN
 ASTNode*
 ASTNode::getLeftChild () const
 {
-  return static_cast<ASTNode*>( mChildren->get(0) );
+  return mChildren.empty() ? NULL : mChildren.front();
 }
 
 
@@ -1027,7 +999,7 @@ ASTNode::getRightChild () const
   unsigned int nc = getNumChildren();
 
 
-  return (nc > 1) ? static_cast<ASTNode*>( mChildren->get(nc - 1) ): NULL;
+  return (nc > 1) ? mChildren[nc - 1] : NULL;
 }
 
 
@@ -1039,7 +1011,7 @@ LIBSBML_EXTERN
 unsigned int
 ASTNode::getNumChildren () const
 {
-  return mChildren->getSize();
+  return (unsigned int)mChildren.size();
 }
 
 
@@ -2343,9 +2315,7 @@ ASTNode::swapChildren (ASTNode *that)
   if (that == NULL)
     return LIBSBML_OPERATION_FAILED;
 
-  List *temp      = this->mChildren;
-  this->mChildren = that->mChildren;
-  that->mChildren = temp;
+  this->mChildren.swap(that->mChildren);
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -3500,6 +3470,15 @@ void ASTNode::clearPlugins()
   mPlugins.clear();
 }
 
+void ASTNode::clearChildren()
+{
+  for (size_t c = 0; c < mChildren.size(); ++c)
+  {
+    delete mChildren[c];
+  }
+  mChildren.clear();
+}
+
 
 #endif /* __cplusplus */
 
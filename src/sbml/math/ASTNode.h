@@ -2297,7 +2297,7 @@ protected:
   XMLAttributes* mDefinitionURL;
   bool hasSemantics;
 
-  List *mChildren;
+  std::vector<ASTNode*> mChildren;
 
   List *mSemanticsAnnotations;
 
@@ -2332,6 +2332,7 @@ protected:
 
 private:
   void clearPlugins();
+  void clearChildren();
 };
 
 LIBSBML_CPP_NAMESPACE_END
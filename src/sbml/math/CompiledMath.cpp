@@ -0,0 +1,1077 @@
+/**
+ * @file    CompiledMath.cpp
+ * @brief   Flat bytecode form of an ASTNode for repeated evaluation
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/math/CompiledMath.h>
+#include <sbml/math/ASTNode.h>
+#include <sbml/Model.h>
+#include <sbml/SBMLTransforms.h>
+#include <sbml/util/util.h>
+
+#include <limits>
+#include <math.h>
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+#ifdef __cplusplus
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Expressions needing a deeper stack than this are evaluated using a
+ * stack allocated on the heap.
+ */
+static const unsigned int LOCAL_STACK_SIZE = 64;
+
+/*
+ * Number of value sets evaluated together by the batch evaluate(); each
+ * stack entry then holds one value per set.
+ */
+static const size_t BATCH_BLOCK_SIZE = 256;
+/** @endcond */
+
+
+CompiledMath::CompiledMath ()
+  : mDepth    ( 0 )
+  , mMaxDepth ( 0 )
+  , mCompiled ( false )
+{
+}
+
+
+CompiledMath::CompiledMath (const ASTNode* math, const Model* m)
+  : mDepth    ( 0 )
+  , mMaxDepth ( 0 )
+  , mCompiled ( false )
+{
+  compile(math, m);
+}
+
+
+int
+CompiledMath::compile (const ASTNode* math, const Model* m)
+{
+  mCode.clear();
+  mSymbols.clear();
+  mSymbolIndex.clear();
+  mValues.clear();
+  mDepth = 0;
+  mMaxDepth = 0;
+  mCompiled = false;
+
+  if (math == NULL)
+  {
+    return LIBSBML_INVALID_OBJECT;
+  }
+
+  if (m != NULL && m->getNumFunctionDefinitions() > 0)
+  {
+    // expand the user-defined functions once, rather than on every
+    // evaluation as SBMLTransforms::evaluateASTNode() does
+    ASTNode* expanded = math->deepCopy();
+    SBMLTransforms::replaceFD(expanded, m->getListOfFunctionDefinitions());
+    compileNode(expanded);
+    delete expanded;
+  }
+  else
+  {
+    compileNode(math);
+  }
+
+  mCompiled = true;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+bool
+CompiledMath::isCompiled () const
+{
+  return mCompiled;
+}
+
+
+unsigned int
+CompiledMath::getNumSymbols () const
+{
+  return (unsigned int)mSymbols.size();
+}
+
+
+std::string
+CompiledMath::getSymbol (unsigned int n) const
+{
+  return (n < mSymbols.size()) ? mSymbols[n] : std::string();
+}
+
+
+int
+CompiledMath::getSymbolIndex (const std::string& id) const
+{
+  map<string, unsigned int>::const_iterator it = mSymbolIndex.find(id);
+  return (it != mSymbolIndex.end()) ? (int)it->second : -1;
+}
+
+
+int
+CompiledMath::setValue (unsigned int n, double value)
+{
+  if (n >= mValues.size())
+  {
+    return LIBSBML_INDEX_EXCEEDS_SIZE;
+  }
+
+  mValues[n] = value;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+int
+CompiledMath::setValue (const std::string& id, double value)
+{
+  int n = getSymbolIndex(id);
+  if (n < 0)
+  {
+    return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  mValues[n] = value;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+int
+CompiledMath::setValues (const Model* m)
+{
+  if (m == NULL)
+  {
+    return LIBSBML_INVALID_OBJECT;
+  }
+
+  SBMLTransforms::IdValueMap values;
+  SBMLTransforms::getComponentValuesForModel(m, values);
+
+  for (size_t n = 0; n < mSymbols.size(); ++n)
+  {
+    SBMLTransforms::IdValueIter it = values.find(mSymbols[n]);
+    mValues[n] = (it != values.end()) ? it->second.first
+                                      : numeric_limits<double>::quiet_NaN();
+  }
+
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+double
+CompiledMath::getValue (unsigned int n) const
+{
+  return (n < mValues.size()) ? mValues[n]
+                              : numeric_limits<double>::quiet_NaN();
+}
+
+
+double
+CompiledMath::evaluate () const
+{
+  return evaluate(mValues.empty() ? NULL : &mValues[0]);
+}
+
+
+double
+CompiledMath::evaluate (const double* values) const
+{
+  if (!mCompiled || mCode.empty())
+  {
+    return numeric_limits<double>::quiet_NaN();
+  }
+
+  double local[LOCAL_STACK_SIZE];
+  vector<double> heap;
+  double* stack = local;
+  if (mMaxDepth > LOCAL_STACK_SIZE)
+  {
+    heap.resize(mMaxDepth);
+    stack = &heap[0];
+  }
+
+  unsigned int sp = 0;
+  const Instruction* code = &mCode[0];
+  const Instruction* end = code + mCode.size();
+
+  for (const Instruction* ip = code; ip != end; ++ip)
+  {
+    switch (ip->op)
+    {
+    case OP_CONSTANT:
+      stack[sp++] = ip->value;
+      break;
+
+    case OP_SYMBOL:
+      stack[sp++] = values[ip->arg];
+      break;
+
+    case OP_ADD:
+      --sp;
+      stack[sp - 1] += stack[sp];
+      break;
+
+    case OP_SUBTRACT:
+      --sp;
+      stack[sp - 1] -= stack[sp];
+      break;
+
+    case OP_MULTIPLY:
+      --sp;
+      stack[sp - 1] *= stack[sp];
+      break;
+
+    case OP_DIVIDE:
+      --sp;
+      stack[sp - 1] /= stack[sp];
+      break;
+
+    case OP_NEGATE:
+      stack[sp - 1] = -stack[sp - 1];
+      break;
+
+    default:
+      if (ip->op >= OP_AND)
+      {
+        sp -= ip->arg;
+        stack[sp] = evaluateNary(ip->op, stack + sp, ip->arg);
+        ++sp;
+      }
+      else if (ip->op >= OP_NEGATE)
+      {
+        stack[sp - 1] = evaluateUnary(ip->op, stack[sp - 1]);
+      }
+      else
+      {
+        --sp;
+        stack[sp - 1] = evaluateBinary(ip->op, stack[sp - 1], stack[sp]);
+      }
+      break;
+    }
+  }
+
+  return stack[0];
+}
+
+
+int
+CompiledMath::evaluate (const double* const* columns, size_t n,
+                        double* out) const
+{
+  if (!mCompiled || mCode.empty() || (n > 0 && out == NULL)
+    || (columns == NULL && !mSymbols.empty()))
+  {
+    return LIBSBML_INVALID_OBJECT;
+  }
+
+  // the stack, followed by the scratch space of evaluateBlock(): two
+  // block rows for piecewise, or the operands of one n-ary operation
+  size_t stackSize = mMaxDepth * BATCH_BLOCK_SIZE;
+  size_t scratchSize = (mMaxDepth > 2 * BATCH_BLOCK_SIZE)
+                       ? mMaxDepth : 2 * BATCH_BLOCK_SIZE;
+  vector<double> stack(stackSize + scratchSize);
+
+  for (size_t start = 0; start < n; start += BATCH_BLOCK_SIZE)
+  {
+    size_t count = (n - start < BATCH_BLOCK_SIZE) ? n - start
+                                                  : BATCH_BLOCK_SIZE;
+    evaluateBlock(columns, start, count, &stack[0], &stack[stackSize]);
+
+    const double* result = &stack[0];
+    for (size_t i = 0; i < count; ++i)
+    {
+      out[start + i] = result[i];
+    }
+  }
+
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+unsigned int
+CompiledMath::getNumInstructions () const
+{
+  return (unsigned int)mCode.size();
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+double
+CompiledMath::evaluateUnary (Operation op, double x)
+{
+  switch (op)
+  {
+  case OP_NEGATE:
+    return -x;
+
+  case OP_ABS:
+    return fabs(x);
+
+  case OP_ARCCOS:
+    return acos(x);
+
+  case OP_ARCCOSH:
+    /* arccosh(x) = ln(x + sqrt(x-1).sqrt(x+1)) */
+    return log(x + pow(x - 1, 0.5) * pow(x + 1, 0.5));
+
+  case OP_ARCCOT:
+    /* arccot x =  arctan (1 / x) */
+    return atan(1.0 / x);
+
+  case OP_ARCCOTH:
+    /* arccoth x = 1/2 * ln((x+1)/(x-1)) */
+    return (1.0 / 2.0) * log((x + 1.0) / (x - 1.0));
+
+  case OP_ARCCSC:
+    /* arccsc(x) = Arcsin(1 / x) */
+    return asin(1.0 / x);
+
+  case OP_ARCCSCH:
+    /* arccsch(x) = ln((1 + sqrt(1 + x^2)) / x) */
+    return log((1.0 + pow(1.0 + pow(x, 2), 0.5)) / x);
+
+  case OP_ARCSEC:
+    /* arcsec(x) = arccos(1/x) */
+    return acos(1.0 / x);
+
+  case OP_ARCSECH:
+    /* arcsech(x) = ln((1 + sqrt(1 - x^2)) / x) */
+    return log((1.0 + pow((1.0 - pow(x, 2)), 0.5)) / x);
+
+  case OP_ARCSIN:
+    return asin(x);
+
+  case OP_ARCSINH:
+    /* arcsinh(x) = ln(x + sqrt(1 + x^2)) */
+    return log(x + pow((1.0 + pow(x, 2)), 0.5));
+
+  case OP_ARCTAN:
+    return atan(x);
+
+  case OP_ARCTANH:
+    /* arctanh = 0.5 * ln((1+x)/(1-x)) */
+    return 0.5 * log((1.0 + x) / (1.0 - x));
+
+  case OP_CEILING:
+    return ceil(x);
+
+  case OP_COS:
+    return cos(x);
+
+  case OP_COSH:
+    return cosh(x);
+
+  case OP_COT:
+    /* cot x = 1 / tan x */
+    return 1.0 / tan(x);
+
+  case OP_COTH:
+    /* coth x = cosh x / sinh x */
+    return cosh(x) / sinh(x);
+
+  case OP_CSC:
+    /* csc x = 1 / sin x */
+    return 1.0 / sin(x);
+
+  case OP_CSCH:
+    /* csch x = 1 / sinh x  */
+    return 1.0 / sinh(x);
+
+  case OP_EXP:
+    return exp(x);
+
+  case OP_FACTORIAL:
+    {
+      // converting NaN or a value out of the range of int is undefined;
+      // every factorial from 171! on overflows to infinity
+      if (util_isNaN(x)) return x;
+      if (x < 2) return 1;
+      if (x >= 171) return numeric_limits<double>::infinity();
+
+      double result = 1;
+      for (int i = (int)(floor(x)); i > 1; --i)
+      {
+        result *= i;
+      }
+      return result;
+    }
+
+  case OP_FLOOR:
+    return floor(x);
+
+  case OP_LN:
+    return log(x);
+
+  case OP_LOG10:
+    return log10(x);
+
+  case OP_SEC:
+    /* sec x = 1 / cos x */
+    return 1.0 / cos(x);
+
+  case OP_SECH:
+    /* sech x = 1 / cosh x */
+    return 1.0 / cosh(x);
+
+  case OP_SIN:
+    return sin(x);
+
+  case OP_SINH:
+    return sinh(x);
+
+  case OP_TAN:
+    return tan(x);
+
+  case OP_TANH:
+    return tanh(x);
+
+  case OP_NOT:
+    return (double)(!x);
+
+  default:
+    return numeric_limits<double>::quiet_NaN();
+  }
+}
+
+
+double
+CompiledMath::evaluateBinary (Operation op, double x, double y)
+{
+  switch (op)
+  {
+  case OP_ADD:
+    return x + y;
+
+  case OP_SUBTRACT:
+    return x - y;
+
+  case OP_MULTIPLY:
+    return x * y;
+
+  case OP_DIVIDE:
+    return x / y;
+
+  case OP_POWER:
+    return pow(x, y);
+
+  case OP_LOG:
+    /* x is the logbase */
+    return log(y) / log(x);
+
+  case OP_ROOT:
+    /* x is the degree */
+    return pow(y, 1.0 / x);
+
+  case OP_REM:
+    return x - (floor(x / y) * y);
+
+  case OP_QUOTIENT:
+    return floor(x / y);
+
+  case OP_IMPLIES:
+    return (double)(!x || y);
+
+  default:
+    return numeric_limits<double>::quiet_NaN();
+  }
+}
+
+
+double
+CompiledMath::evaluateNary (Operation op, const double* args, unsigned int n)
+{
+  double result = 0;
+  unsigned int j;
+
+  switch (op)
+  {
+  case OP_AND:
+    if (n == 1) return args[0];
+    result = 1.0;
+    for (j = 0; j < n; ++j)
+    {
+      if (!args[j]) result = 0.0;
+    }
+    break;
+
+  case OP_OR:
+    if (n == 1) return args[0];
+    for (j = 0; j < n; ++j)
+    {
+      if (args[j]) result = 1.0;
+    }
+    break;
+
+  case OP_XOR:
+    if (n == 1) return args[0];
+    for (j = 0; j < n; ++j)
+    {
+      if (args[j]) result = 1.0 - result;
+    }
+    break;
+
+  case OP_EQ:
+  case OP_GEQ:
+  case OP_GT:
+  case OP_LEQ:
+  case OP_LT:
+  case OP_NEQ:
+    if (n < 2) return 0.0;
+    result = 1.0;
+    for (j = 1; j < n; ++j)
+    {
+      double a = args[j - 1];
+      double b = args[j];
+      bool holds = (op == OP_EQ)  ? (a == b)
+                 : (op == OP_GEQ) ? (a >= b)
+                 : (op == OP_GT)  ? (a > b)
+                 : (op == OP_LEQ) ? (a <= b)
+                 : (op == OP_LT)  ? (a < b)
+                 :                  (a != b);
+      result *= (double)holds;
+    }
+    break;
+
+  case OP_MIN:
+  case OP_MAX:
+    if (n == 0) return numeric_limits<double>::quiet_NaN();
+    result = args[0];
+    for (j = 1; j < n; ++j)
+    {
+      if (op == OP_MIN ? (args[j] < result) : (args[j] > result))
+      {
+        result = args[j];
+      }
+    }
+    break;
+
+  case OP_PIECEWISE:
+    {
+      // pieces are (value, condition) pairs, optionally followed by the
+      // otherwise value; as in SBMLTransforms::evaluateASTNode() two true
+      // conditions with different values make the result undefined
+      bool assigned = false;
+      unsigned int numPieces = n / 2;
+      for (j = 0; j < numPieces; ++j)
+      {
+        double value = args[2 * j];
+        if (args[2 * j + 1] == 1.0)
+        {
+          if (!assigned)
+          {
+            result = value;
+            assigned = true;
+          }
+          else if (value != result)
+          {
+            result = numeric_limits<double>::quiet_NaN();
+          }
+        }
+      }
+      if (!assigned)
+      {
+        result = (n % 2 == 1) ? args[n - 1]
+                              : numeric_limits<double>::quiet_NaN();
+      }
+    }
+    break;
+
+  default:
+    result = numeric_limits<double>::quiet_NaN();
+    break;
+  }
+
+  return result;
+}
+
+
+/*
+ * Evaluates count value sets starting at start.  Stack entry k occupies
+ * stack[k * BATCH_BLOCK_SIZE] to stack[k * BATCH_BLOCK_SIZE + count - 1],
+ * and every instruction is a loop over the count values of its operands.
+ * The caller provides scratch space for the larger of 2 * BATCH_BLOCK_SIZE
+ * values and the deepest stack, reused by every block.
+ */
+void
+CompiledMath::evaluateBlock (const double* const* columns, size_t start,
+                             size_t count, double* stack,
+                             double* scratch) const
+{
+  const Instruction* code = &mCode[0];
+  const Instruction* end = code + mCode.size();
+  unsigned int sp = 0;
+  size_t i;
+
+  for (const Instruction* ip = code; ip != end; ++ip)
+  {
+    double* x = stack + (sp > 0 ? sp - 1 : 0) * BATCH_BLOCK_SIZE;
+    const double* y = x + BATCH_BLOCK_SIZE;
+
+    switch (ip->op)
+    {
+    case OP_CONSTANT:
+      {
+        double* r = stack + (sp++) * BATCH_BLOCK_SIZE;
+        double value = ip->value;
+        for (i = 0; i < count; ++i) r[i] = value;
+      }
+      break;
+
+    case OP_SYMBOL:
+      {
+        double* r = stack + (sp++) * BATCH_BLOCK_SIZE;
+        const double* column = columns[ip->arg] + start;
+        for (i = 0; i < count; ++i) r[i] = column[i];
+      }
+      break;
+
+    case OP_ADD:
+      x -= BATCH_BLOCK_SIZE; y -= BATCH_BLOCK_SIZE; --sp;
+      for (i = 0; i < count; ++i) x[i] += y[i];
+      break;
+
+    case OP_SUBTRACT:
+      x -= BATCH_BLOCK_SIZE; y -= BATCH_BLOCK_SIZE; --sp;
+      for (i = 0; i < count; ++i) x[i] -= y[i];
+      break;
+
+    case OP_MULTIPLY:
+      x -= BATCH_BLOCK_SIZE; y -= BATCH_BLOCK_SIZE; --sp;
+      for (i = 0; i < count; ++i) x[i] *= y[i];
+      break;
+
+    case OP_DIVIDE:
+      x -= BATCH_BLOCK_SIZE; y -= BATCH_BLOCK_SIZE; --sp;
+      for (i = 0; i < count; ++i) x[i] /= y[i];
+      break;
+
+    case OP_POWER:
+      x -= BATCH_BLOCK_SIZE; y -= BATCH_BLOCK_SIZE; --sp;
+      for (i = 0; i < count; ++i) x[i] = pow(x[i], y[i]);
+      break;
+
+    case OP_NEGATE:
+      for (i = 0; i < count; ++i) x[i] = -x[i];
+      break;
+
+    case OP_EXP:
+      for (i = 0; i < count; ++i) x[i] = exp(x[i]);
+      break;
+
+    case OP_LN:
+      for (i = 0; i < count; ++i) x[i] = log(x[i]);
+      break;
+
+    case OP_LOG10:
+      for (i = 0; i < count; ++i) x[i] = log10(x[i]);
+      break;
+
+    case OP_PIECEWISE:
+      {
+        // the same rules as evaluateNary(), applied to every value set
+        // with selects rather than branches
+        sp -= ip->arg;
+        double* r = stack + sp * BATCH_BLOCK_SIZE;
+        const double nan = numeric_limits<double>::quiet_NaN();
+        unsigned int numPieces = ip->arg / 2;
+        double* result = scratch;
+        double* assigned = scratch + BATCH_BLOCK_SIZE;
+
+        const double* otherwise = (ip->arg % 2 == 1)
+                          ? r + (ip->arg - 1) * BATCH_BLOCK_SIZE : NULL;
+        for (i = 0; i < count; ++i)
+        {
+          result[i] = (otherwise != NULL) ? otherwise[i] : nan;
+          assigned[i] = 0.0;
+        }
+
+        for (unsigned int j = 0; j < numPieces; ++j)
+        {
+          const double* value = r + (2 * j) * BATCH_BLOCK_SIZE;
+          const double* condition = r + (2 * j + 1) * BATCH_BLOCK_SIZE;
+          for (i = 0; i < count; ++i)
+          {
+            bool holds = (condition[i] == 1.0);
+            double chosen = (assigned[i] == 0.0) ? value[i]
+                          : (value[i] != result[i]) ? nan : result[i];
+            result[i] = holds ? chosen : result[i];
+            assigned[i] = holds ? 1.0 : assigned[i];
+          }
+        }
+
+        for (i = 0; i < count; ++i) r[i] = result[i];
+        ++sp;
+      }
+      break;
+
+    default:
+      if (ip->op >= OP_AND)
+      {
+        sp -= ip->arg;
+        double* r = stack + sp * BATCH_BLOCK_SIZE;
+        for (i = 0; i < count; ++i)
+        {
+          for (unsigned int j = 0; j < ip->arg; ++j)
+          {
+            scratch[j] = r[j * BATCH_BLOCK_SIZE + i];
+          }
+          r[i] = evaluateNary(ip->op, scratch, ip->arg);
+        }
+        ++sp;
+      }
+      else if (ip->op >= OP_NEGATE)
+      {
+        for (i = 0; i < count; ++i) x[i] = evaluateUnary(ip->op, x[i]);
+      }
+      else
+      {
+        x -= BATCH_BLOCK_SIZE; y -= BATCH_BLOCK_SIZE; --sp;
+        for (i = 0; i < count; ++i)
+        {
+          x[i] = evaluateBinary(ip->op, x[i], y[i]);
+        }
+      }
+      break;
+    }
+  }
+}
+
+
+void
+CompiledMath::compileNode (const ASTNode* node)
+{
+  unsigned int numChildren = node->getNumChildren();
+  unsigned int j;
+
+  switch (node->getType())
+  {
+  case AST_INTEGER:
+    emitConstant((double)(node->getInteger()));
+    break;
+
+  case AST_REAL:
+  case AST_REAL_E:
+  case AST_RATIONAL:
+  case AST_NAME_AVOGADRO:
+    emitConstant(node->getReal());
+    break;
+
+  case AST_NAME:
+    if (node->getName() != NULL)
+    {
+      emit(OP_SYMBOL, getSymbolSlot(node->getName()));
+    }
+    else
+    {
+      emitConstant(numeric_limits<double>::quiet_NaN());
+    }
+    break;
+
+  case AST_NAME_TIME:
+  case AST_CONSTANT_FALSE:
+    emitConstant(0.0);
+    break;
+
+  case AST_CONSTANT_TRUE:
+    emitConstant(1.0);
+    break;
+
+  case AST_CONSTANT_E:
+    /* exp(1) is used to adjust exponentiale to machine precision */
+    emitConstant(exp(1.0));
+    break;
+
+  case AST_CONSTANT_PI:
+    /* pi = 4 * atan 1  is used to adjust Pi to machine precision */
+    emitConstant(4.0*atan(1.0));
+    break;
+
+  case AST_PLUS:
+  case AST_TIMES:
+    if (numChildren == 0)
+    {
+      emitConstant(node->getType() == AST_PLUS ? 0.0 : 1.0);
+    }
+    else
+    {
+      compileChild(node, 0);
+      for (j = 1; j < numChildren; ++j)
+      {
+        compileChild(node, j);
+        emit(node->getType() == AST_PLUS ? OP_ADD : OP_MULTIPLY);
+      }
+    }
+    break;
+
+  case AST_MINUS:
+    if (numChildren == 1)
+    {
+      compileChild(node, 0);
+      emit(OP_NEGATE);
+    }
+    else
+    {
+      compileChildren(node, 2);
+      emit(OP_SUBTRACT);
+    }
+    break;
+
+  case AST_DIVIDE:
+    compileChildren(node, 2);
+    emit(OP_DIVIDE);
+    break;
+
+  case AST_POWER:
+  case AST_FUNCTION_POWER:
+    compileChildren(node, 2);
+    emit(OP_POWER);
+    break;
+
+  case AST_FUNCTION_LOG:
+    if (numChildren < 2
+      || (node->getChild(0)->isNumber() && node->getChild(0)->getValue() == 10))
+    {
+      compileChild(node, numChildren - 1);
+      emit(OP_LOG10);
+    }
+    else
+    {
+      compileChildren(node, 2);
+      emit(OP_LOG);
+    }
+    break;
+
+  case AST_FUNCTION_ROOT:
+    if (numChildren < 2)
+    {
+      emitConstant(2.0);
+      compileChild(node, 0);
+    }
+    else
+    {
+      compileChildren(node, 2);
+    }
+    emit(OP_ROOT);
+    break;
+
+  case AST_FUNCTION_REM:
+  case AST_FUNCTION_QUOTIENT:
+    if (numChildren < 2)
+    {
+      emitConstant(0.0);
+    }
+    else
+    {
+      compileChildren(node, 2);
+      emit(node->getType() == AST_FUNCTION_REM ? OP_REM : OP_QUOTIENT);
+    }
+    break;
+
+  case AST_LOGICAL_IMPLIES:
+    if (numChildren == 0)
+    {
+      emitConstant(0.0);
+    }
+    else if (numChildren == 1)
+    {
+      compileChild(node, 0);
+    }
+    else
+    {
+      compileChildren(node, 2);
+      emit(OP_IMPLIES);
+    }
+    break;
+
+  case AST_FUNCTION_ABS:      compileChild(node, 0); emit(OP_ABS);       break;
+  case AST_FUNCTION_ARCCOS:   compileChild(node, 0); emit(OP_ARCCOS);    break;
+  case AST_FUNCTION_ARCCOSH:  compileChild(node, 0); emit(OP_ARCCOSH);   break;
+  case AST_FUNCTION_ARCCOT:   compileChild(node, 0); emit(OP_ARCCOT);    break;
+  case AST_FUNCTION_ARCCOTH:  compileChild(node, 0); emit(OP_ARCCOTH);   break;
+  case AST_FUNCTION_ARCCSC:   compileChild(node, 0); emit(OP_ARCCSC);    break;
+  case AST_FUNCTION_ARCCSCH:  compileChild(node, 0); emit(OP_ARCCSCH);   break;
+  case AST_FUNCTION_ARCSEC:   compileChild(node, 0); emit(OP_ARCSEC);    break;
+  case AST_FUNCTION_ARCSECH:  compileChild(node, 0); emit(OP_ARCSECH);   break;
+  case AST_FUNCTION_ARCSIN:   compileChild(node, 0); emit(OP_ARCSIN);    break;
+  case AST_FUNCTION_ARCSINH:  compileChild(node, 0); emit(OP_ARCSINH);   break;
+  case AST_FUNCTION_ARCTAN:   compileChild(node, 0); emit(OP_ARCTAN);    break;
+  case AST_FUNCTION_ARCTANH:  compileChild(node, 0); emit(OP_ARCTANH);   break;
+  case AST_FUNCTION_CEILING:  compileChild(node, 0); emit(OP_CEILING);   break;
+  case AST_FUNCTION_COS:      compileChild(node, 0); emit(OP_COS);       break;
+  case AST_FUNCTION_COSH:     compileChild(node, 0); emit(OP_COSH);      break;
+  case AST_FUNCTION_COT:      compileChild(node, 0); emit(OP_COT);       break;
+  case AST_FUNCTION_COTH:     compileChild(node, 0); emit(OP_COTH);      break;
+  case AST_FUNCTION_CSC:      compileChild(node, 0); emit(OP_CSC);       break;
+  case AST_FUNCTION_CSCH:     compileChild(node, 0); emit(OP_CSCH);      break;
+  case AST_FUNCTION_EXP:      compileChild(node, 0); emit(OP_EXP);       break;
+  case AST_FUNCTION_FACTORIAL:compileChild(node, 0); emit(OP_FACTORIAL); break;
+  case AST_FUNCTION_FLOOR:    compileChild(node, 0); emit(OP_FLOOR);     break;
+  case AST_FUNCTION_LN:       compileChild(node, 0); emit(OP_LN);        break;
+  case AST_FUNCTION_SEC:      compileChild(node, 0); emit(OP_SEC);       break;
+  case AST_FUNCTION_SECH:     compileChild(node, 0); emit(OP_SECH);      break;
+  case AST_FUNCTION_SIN:      compileChild(node, 0); emit(OP_SIN);       break;
+  case AST_FUNCTION_SINH:     compileChild(node, 0); emit(OP_SINH);      break;
+  case AST_FUNCTION_TAN:      compileChild(node, 0); emit(OP_TAN);       break;
+  case AST_FUNCTION_TANH:     compileChild(node, 0); emit(OP_TANH);      break;
+  case AST_LOGICAL_NOT:       compileChild(node, 0); emit(OP_NOT);       break;
+
+  case AST_LOGICAL_AND:
+    if (numChildren == 0)
+    {
+      emitConstant(1.0);
+      break;
+    }
+    compileChildren(node, numChildren);
+    emit(OP_AND, numChildren);
+    break;
+
+  case AST_LOGICAL_OR:
+  case AST_LOGICAL_XOR:
+    if (numChildren == 0)
+    {
+      emitConstant(0.0);
+      break;
+    }
+    compileChildren(node, numChildren);
+    emit(node->getType() == AST_LOGICAL_OR ? OP_OR : OP_XOR, numChildren);
+    break;
+
+  case AST_RELATIONAL_EQ:
+    compileChildren(node, numChildren); emit(OP_EQ, numChildren);  break;
+  case AST_RELATIONAL_GEQ:
+    compileChildren(node, numChildren); emit(OP_GEQ, numChildren); break;
+  case AST_RELATIONAL_GT:
+    compileChildren(node, numChildren); emit(OP_GT, numChildren);  break;
+  case AST_RELATIONAL_LEQ:
+    compileChildren(node, numChildren); emit(OP_LEQ, numChildren); break;
+  case AST_RELATIONAL_LT:
+    compileChildren(node, numChildren); emit(OP_LT, numChildren);  break;
+  case AST_RELATIONAL_NEQ:
+    compileChildren(node, numChildren); emit(OP_NEQ, numChildren); break;
+  case AST_FUNCTION_MIN:
+    compileChildren(node, numChildren); emit(OP_MIN, numChildren); break;
+  case AST_FUNCTION_MAX:
+    compileChildren(node, numChildren); emit(OP_MAX, numChildren); break;
+
+  case AST_FUNCTION_PIECEWISE:
+    compileChildren(node, numChildren);
+    emit(OP_PIECEWISE, numChildren);
+    break;
+
+  default:
+    // user-defined functions that could not be expanded, lambda, delay,
+    // rateOf and package constructs
+    emitConstant(numeric_limits<double>::quiet_NaN());
+    break;
+  }
+}
+
+
+/*
+ * Compiles the nth child of node, or NaN if there is no such child.
+ */
+void
+CompiledMath::compileChild (const ASTNode* node, unsigned int n)
+{
+  const ASTNode* child = node->getChild(n);
+  if (child != NULL)
+  {
+    compileNode(child);
+  }
+  else
+  {
+    emitConstant(numeric_limits<double>::quiet_NaN());
+  }
+}
+
+
+/*
+ * Compiles the first n children of node.
+ */
+void
+CompiledMath::compileChildren (const ASTNode* node, unsigned int n)
+{
+  for (unsigned int j = 0; j < n; ++j)
+  {
+    compileChild(node, j);
+  }
+}
+
+
+void
+CompiledMath::emit (Operation op, unsigned int arg, double value)
+{
+  Instruction instruction;
+  instruction.op = op;
+  instruction.arg = arg;
+  instruction.value = value;
+  mCode.push_back(instruction);
+
+  if (op == OP_CONSTANT || op == OP_SYMBOL)
+  {
+    ++mDepth;
+  }
+  else if (op >= OP_AND)
+  {
+    mDepth = mDepth - arg + 1;
+  }
+  else if (op < OP_NEGATE)
+  {
+    --mDepth;
+  }
+
+  if (mDepth > mMaxDepth)
+  {
+    mMaxDepth = mDepth;
+  }
+}
+
+
+void
+CompiledMath::emitConstant (double value)
+{
+  emit(OP_CONSTANT, 0, value);
+}
+
+
+unsigned int
+CompiledMath::getSymbolSlot (const std::string& id)
+{
+  map<string, unsigned int>::iterator it = mSymbolIndex.find(id);
+  if (it != mSymbolIndex.end())
+  {
+    return it->second;
+  }
+
+  unsigned int slot = (unsigned int)mSymbols.size();
+  mSymbols.push_back(id);
+  mValues.push_back(numeric_limits<double>::quiet_NaN());
+  mSymbolIndex.insert(make_pair(id, slot));
+  return slot;
+}
+/** @endcond */
+
+
+#endif /* __cplusplus */
+LIBSBML_CPP_NAMESPACE_END
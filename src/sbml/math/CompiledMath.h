@@ -0,0 +1,392 @@
+/**
+ * @file    CompiledMath.h
+ * @brief   Flat bytecode form of an ASTNode for repeated evaluation
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class CompiledMath
+ * @sbmlbrief{core} A mathematical expression compiled for fast evaluation.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * SBMLTransforms::evaluateASTNode() walks an ASTNode tree on every call,
+ * looking up every identifier by name and expanding calls to user-defined
+ * functions as it goes.  When the same expression has to be evaluated many
+ * times with different values (for example in a parameter scan), a
+ * CompiledMath object can be used instead.  It translates the expression
+ * once into a flat sequence of stack-machine instructions, in which
+ * calls to the FunctionDefinition objects of the Model have been inlined
+ * and every identifier has been replaced by the index of a value slot.
+ * Evaluating the compiled expression is then a single loop over the
+ * instructions, without string lookups or memory allocation.
+ *
+ * The identifiers used by the expression are available through
+ * getNumSymbols(), getSymbol() and getSymbolIndex().  Their values are set
+ * with setValue(), or all at once from the initial values of a Model with
+ * setValues(), after which evaluate() computes the result.  Alternatively,
+ * evaluate(const double* values) takes an array holding the value of each
+ * symbol in the order of the symbol indexes, and evaluate(const double*
+ * const* columns, size_t n, double* out) computes the results for a whole
+ * batch of value sets in one call.  Identifiers whose value has not been
+ * set evaluate to NaN.
+ *
+ * The results are those of SBMLTransforms::evaluateASTNode(), with the
+ * following exceptions: values of identifiers are never computed from the
+ * rules or initial assignments of the Model; <code>log</code> uses its
+ * <code>logbase</code>, and a missing <code>logbase</code> or
+ * <code>degree</code> is taken to be 10 or 2; and <code>and</code>,
+ * <code>or</code> and <code>xor</code> take all of their arguments into
+ * account.  Time evaluates to zero, and constructs
+ * that cannot be evaluated (such as <code>delay</code>,
+ * <code>rateOf</code> or calls to functions not defined in the Model)
+ * evaluate to NaN.
+ *
+ * A CompiledMath object is not modified by evaluate(), so a single object
+ * can be evaluated from several threads at once, provided each thread
+ * passes its own array of values.
+ */
+
+#ifndef CompiledMath_h
+#define CompiledMath_h
+
+
+#include <sbml/common/extern.h>
+#include <sbml/common/sbmlfwd.h>
+#include <sbml/common/operationReturnValues.h>
+
+
+#ifdef __cplusplus
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class ASTNode;
+class Model;
+
+
+class LIBSBML_EXTERN CompiledMath
+{
+public:
+
+  /**
+   * Creates a new, empty CompiledMath object.
+   *
+   * Use compile() to give it an expression.
+   */
+  CompiledMath ();
+
+
+  /**
+   * Creates a new CompiledMath object from the given expression.
+   *
+   * @param math the expression to compile.
+   *
+   * @param m the Model whose FunctionDefinition objects are used to expand
+   * calls to user-defined functions, or @c NULL.
+   *
+   * @see compile(const ASTNode* math, const Model* m)
+   */
+  CompiledMath (const ASTNode* math, const Model* m = NULL);
+
+
+  /**
+   * Compiles the given expression, replacing whatever this object held
+   * before.
+   *
+   * @param math the expression to compile.
+   *
+   * @param m the Model whose FunctionDefinition objects are used to expand
+   * calls to user-defined functions, or @c NULL.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+   */
+  int compile (const ASTNode* math, const Model* m = NULL);
+
+
+  /**
+   * Predicate returning @c true if this CompiledMath object holds a
+   * compiled expression.
+   *
+   * @return @c true if compile() succeeded, @c false otherwise.
+   */
+  bool isCompiled () const;
+
+
+  /**
+   * Returns the number of distinct identifiers used by the compiled
+   * expression.
+   *
+   * @return the number of symbols.
+   */
+  unsigned int getNumSymbols () const;
+
+
+  /**
+   * Returns the identifier of the nth symbol of the compiled expression.
+   *
+   * @param n the index of the symbol.
+   *
+   * @return the identifier, or an empty string if @p n is out of range.
+   */
+  std::string getSymbol (unsigned int n) const;
+
+
+  /**
+   * Returns the index of the symbol with the given identifier.
+   *
+   * @param id the identifier of the symbol.
+   *
+   * @return the index of the symbol, or @c -1 if the compiled expression
+   * does not use @p id.
+   */
+  int getSymbolIndex (const std::string& id) const;
+
+
+  /**
+   * Sets the value used for the nth symbol by evaluate().
+   *
+   * @param n the index of the symbol.
+   * @param value the value of the symbol.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INDEX_EXCEEDS_SIZE, OperationReturnValues_t}
+   */
+  int setValue (unsigned int n, double value);
+
+
+  /**
+   * Sets the value used for the symbol with the given identifier by
+   * evaluate().
+   *
+   * @param id the identifier of the symbol.
+   * @param value the value of the symbol.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   */
+  int setValue (const std::string& id, double value);
+
+
+  /**
+   * Sets the values of all symbols from the initial values of the
+   * compartments, species, parameters and species references of the given
+   * Model.
+   *
+   * Symbols that do not have an initial value in @p m are set to NaN.
+   *
+   * @param m the Model to take the values from.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+   */
+  int setValues (const Model* m);
+
+
+  /**
+   * Returns the value used for the nth symbol by evaluate().
+   *
+   * @param n the index of the symbol.
+   *
+   * @return the value, or NaN if @p n is out of range.
+   */
+  double getValue (unsigned int n) const;
+
+
+  /**
+   * Evaluates the compiled expression using the values set with
+   * setValue() or setValues().
+   *
+   * @return the value of the expression, or NaN if nothing is compiled.
+   */
+  double evaluate () const;
+
+
+  /**
+   * Evaluates the compiled expression using the given values.
+   *
+   * @param values an array holding the value of each symbol, in the order
+   * of the symbol indexes; it must have getNumSymbols() entries.
+   *
+   * @return the value of the expression, or NaN if nothing is compiled.
+   */
+  double evaluate (const double* values) const;
+
+
+  /**
+   * Evaluates the compiled expression for many sets of values at once.
+   *
+   * The values are given column by column: @p columns holds one array per
+   * symbol, in the order of the symbol indexes, and the ith entry of each
+   * array is the value of that symbol in the ith set.  The value sets are
+   * processed in blocks, each instruction being applied to a whole block
+   * before the next one, so that the instructions are dispatched once per
+   * block rather than once per value set, and most operations run as
+   * simple loops over the block.  The results are the same as calling
+   * evaluate(const double* values) once per value set.
+   *
+   * @param columns an array of getNumSymbols() pointers, each to an array
+   * of @p n values; it may be @c NULL if the expression uses no symbols.
+   * @param n the number of value sets.
+   * @param out an array of @p n entries that receives the results.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+   */
+  int evaluate (const double* const* columns, size_t n, double* out) const;
+
+
+  /**
+   * Returns the number of instructions of the compiled expression.
+   *
+   * @return the number of instructions.
+   */
+  unsigned int getNumInstructions () const;
+
+
+  /** @cond doxygenLibsbmlInternal */
+
+  /* the operations of the compiled code */
+  enum Operation
+  {
+    OP_CONSTANT
+  , OP_SYMBOL
+    /* two operands */
+  , OP_ADD
+  , OP_SUBTRACT
+  , OP_MULTIPLY
+  , OP_DIVIDE
+  , OP_POWER
+  , OP_LOG
+  , OP_ROOT
+  , OP_REM
+  , OP_QUOTIENT
+  , OP_IMPLIES
+    /* one operand */
+  , OP_NEGATE
+  , OP_ABS
+  , OP_ARCCOS
+  , OP_ARCCOSH
+  , OP_ARCCOT
+  , OP_ARCCOTH
+  , OP_ARCCSC
+  , OP_ARCCSCH
+  , OP_ARCSEC
+  , OP_ARCSECH
+  , OP_ARCSIN
+  , OP_ARCSINH
+  , OP_ARCTAN
+  , OP_ARCTANH
+  , OP_CEILING
+  , OP_COS
+  , OP_COSH
+  , OP_COT
+  , OP_COTH
+  , OP_CSC
+  , OP_CSCH
+  , OP_EXP
+  , OP_FACTORIAL
+  , OP_FLOOR
+  , OP_LN
+  , OP_LOG10
+  , OP_SEC
+  , OP_SECH
+  , OP_SIN
+  , OP_SINH
+  , OP_TAN
+  , OP_TANH
+  , OP_NOT
+    /* arg operands */
+  , OP_AND
+  , OP_OR
+  , OP_XOR
+  , OP_EQ
+  , OP_GEQ
+  , OP_GT
+  , OP_LEQ
+  , OP_LT
+  , OP_NEQ
+  , OP_MIN
+  , OP_MAX
+  , OP_PIECEWISE
+  };
+
+  /*
+   * One instruction: OP_CONSTANT pushes value, OP_SYMBOL pushes the value
+   * of symbol arg, and the other operations pop their operands (as listed
+   * in Operation) and push their result.
+   */
+  struct Instruction
+  {
+    Operation op;
+    unsigned int arg;
+    double value;
+  };
+
+  /* applies a one-operand operation */
+  static double evaluateUnary (Operation op, double x);
+
+  /* applies a two-operand operation */
+  static double evaluateBinary (Operation op, double x, double y);
+
+  /* applies an operation on the n operands starting at args */
+  static double evaluateNary (Operation op, const double* args,
+                              unsigned int n);
+
+  /** @endcond */
+
+
+protected:
+  /** @cond doxygenLibsbmlInternal */
+
+  void evaluateBlock (const double* const* columns, size_t start,
+                      size_t count, double* stack, double* scratch) const;
+
+  void compileNode (const ASTNode* node);
+  void compileChild (const ASTNode* node, unsigned int n);
+  void compileChildren (const ASTNode* node, unsigned int n);
+  void emit (Operation op, unsigned int arg = 0, double value = 0);
+  void emitConstant (double value);
+  unsigned int getSymbolSlot (const std::string& id);
+
+  std::vector<Instruction> mCode;
+  std::vector<std::string> mSymbols;
+  std::map<std::string, unsigned int> mSymbolIndex;
+  std::vector<double> mValues;
+
+  /* stack depth while compiling, and the largest depth reached */
+  unsigned int mDepth;
+  unsigned int mMaxDepth;
+
+  bool mCompiled;
+
+  /** @endcond */
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* CompiledMath_h */
@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -34,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,20 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.5.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -68,7 +69,7 @@
 
  /** @cond doxygenLibsbmlInternal */
 
-#line 72 "L3Parser.cpp"
+#line 73 "L3Parser.cpp"
 /* Substitute the type names.  */
 #define YYSTYPE         SBML_YYSTYPE
 /* Substitute the variable and function names.  */
@@ -77,8 +78,6 @@
 #define yyerror         sbml_yyerror
 #define yydebug         sbml_yydebug
 #define yynerrs         sbml_yynerrs
-#define yylval          sbml_yylval
-#define yychar          sbml_yychar
 
 /* First part of user prologue.  */
 #line 66 "L3Parser.ypp"
@@ -123,15 +122,17 @@ class FormulaUnitsData;
  * @brief Class providing functionality for the bison-generated parser.
  *
  * The L3Parser class is an internal class designed to hold the guts of the bison parser, plus
- * the lexer.  It is designed to be a global singleton object, because that's the cleanest way
- * I could find to incorporate functions into the bison framework.
+ * the lexer.  A new L3Parser object is created for every call to
+ * SBML_parseL3FormulaWithSettings() and handed to the pure (reentrant) parser
+ * and lexer that bison creates, so that formulas can be parsed from several
+ * threads at once.
  *
  * The functions declared in this file are defined in the file L3Parser.ypp, which
  * must be compiled by bison to create L3Parser.cpp, the file included in
  * libsbml.  For more details, see the L3Parser.ypp file.
  *
  * Within the various 'sbml_yylex*' functions that bison creates, functions
- * from the global 'l3p' object (of the L3Parser class) are used to calculate
+ * from the 'l3p' parameter (of the L3Parser class) are used to calculate
  * necessary information for the parsing of the string, and to determine appropriate
  * error messages when things go wrong.
  * @internal
@@ -334,32 +335,22 @@ LIBSBML_CPP_NAMESPACE_END
 
   using namespace std;
 
-  int sbml_yylex(void);
-  L3Parser* l3p = NULL;
-
-
-LIBSBML_CPP_NAMESPACE_BEGIN
-L3Parser* L3Parser_getInstance()
-{
-  if (l3p == NULL)
-  {
-    l3p = new L3Parser();
-    std::atexit(SBML_deleteL3Parser);
-  }
-  return l3p;
-}
-LIBSBML_CPP_NAMESPACE_END
-
-  void sbml_yyerror(char const *);
-  int sbml_yylloc_first_position = 1;
-  int sbml_yylloc_last_position = 1;
+  /*
+   * The error of the last call to SBML_parseL3FormulaWithSettings(), kept
+   * per thread where the compiler allows it.
+   */
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1900)
+  static thread_local string lastParseL3Error;
+#else
+  static string lastParseL3Error;
+#endif
 
 #ifdef __BORLANDC__
 #undef DOUBLE
 #endif
 
 
-#line 363 "L3Parser.cpp"
+#line 354 "L3Parser.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -382,14 +373,6 @@ LIBSBML_CPP_NAMESPACE_END
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
 
 /* Debug traces.  */
 #ifndef SBML_YYDEBUG
@@ -407,28 +390,32 @@ LIBSBML_CPP_NAMESPACE_END
 extern int sbml_yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef SBML_YYTOKENTYPE
 # define SBML_YYTOKENTYPE
   enum sbml_yytokentype
   {
-    YYEOF = 0,
-    NOT = 258,
-    NEG = 259,
-    UPLUS = 260,
-    DOUBLE = 261,
-    INTEGER = 262,
-    E_NOTATION = 263,
-    RATIONAL = 264,
-    SYMBOL = 265
+    SBML_YYEMPTY = -2,
+    SBML_YYEOF = 0,                /* "end of string"  */
+    SBML_YYerror = 256,            /* error  */
+    SBML_YYUNDEF = 257,            /* "invalid token"  */
+    NOT = 258,                     /* NOT  */
+    NEG = 259,                     /* NEG  */
+    UPLUS = 260,                   /* UPLUS  */
+    DOUBLE = 261,                  /* "number"  */
+    INTEGER = 262,                 /* "integer"  */
+    E_NOTATION = 263,              /* "number in e-notation form"  */
+    RATIONAL = 264,                /* "number in rational notation"  */
+    SYMBOL = 265                   /* "element name"  */
   };
+  typedef enum sbml_yytokentype sbml_yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined SBML_YYSTYPE && ! defined SBML_YYSTYPE_IS_DECLARED
 union SBML_YYSTYPE
 {
-#line 345 "L3Parser.ypp"
+#line 337 "L3Parser.ypp"
 
   ASTNode* astnode;
   char character;
@@ -438,7 +425,7 @@ union SBML_YYSTYPE
   double mantissa;
   long   rational;
 
-#line 442 "L3Parser.cpp"
+#line 429 "L3Parser.cpp"
 
 };
 typedef union SBML_YYSTYPE SBML_YYSTYPE;
@@ -447,13 +434,65 @@ typedef union SBML_YYSTYPE SBML_YYSTYPE;
 #endif
 
 
-extern SBML_YYSTYPE sbml_yylval;
 
-int sbml_yyparse (void);
+
+int sbml_yyparse (L3Parser* l3p);
+
+
+
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of string"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_3_ = 3,                         /* '&'  */
+  YYSYMBOL_4_ = 4,                         /* '|'  */
+  YYSYMBOL_5_ = 5,                         /* '<'  */
+  YYSYMBOL_6_ = 6,                         /* '>'  */
+  YYSYMBOL_7_ = 7,                         /* '='  */
+  YYSYMBOL_8_ = 8,                         /* '!'  */
+  YYSYMBOL_9_ = 9,                         /* '-'  */
+  YYSYMBOL_10_ = 10,                       /* '+'  */
+  YYSYMBOL_11_ = 11,                       /* '*'  */
+  YYSYMBOL_12_ = 12,                       /* '/'  */
+  YYSYMBOL_13_ = 13,                       /* '%'  */
+  YYSYMBOL_NOT = 14,                       /* NOT  */
+  YYSYMBOL_NEG = 15,                       /* NEG  */
+  YYSYMBOL_UPLUS = 16,                     /* UPLUS  */
+  YYSYMBOL_17_ = 17,                       /* '^'  */
+  YYSYMBOL_18_ = 18,                       /* '['  */
+  YYSYMBOL_DOUBLE = 19,                    /* "number"  */
+  YYSYMBOL_INTEGER = 20,                   /* "integer"  */
+  YYSYMBOL_E_NOTATION = 21,                /* "number in e-notation form"  */
+  YYSYMBOL_RATIONAL = 22,                  /* "number in rational notation"  */
+  YYSYMBOL_SYMBOL = 23,                    /* "element name"  */
+  YYSYMBOL_24_ = 24,                       /* '('  */
+  YYSYMBOL_25_ = 25,                       /* ')'  */
+  YYSYMBOL_26_ = 26,                       /* ']'  */
+  YYSYMBOL_27_ = 27,                       /* '{'  */
+  YYSYMBOL_28_ = 28,                       /* '}'  */
+  YYSYMBOL_29_ = 29,                       /* ','  */
+  YYSYMBOL_30_ = 30,                       /* ';'  */
+  YYSYMBOL_YYACCEPT = 31,                  /* $accept  */
+  YYSYMBOL_input = 32,                     /* input  */
+  YYSYMBOL_node = 33,                      /* node  */
+  YYSYMBOL_number = 34,                    /* number  */
+  YYSYMBOL_nodelist = 35,                  /* nodelist  */
+  YYSYMBOL_nodesemicolonlist = 36          /* nodesemicolonlist  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
 
+/* Unqualified %code blocks.  */
+#line 371 "L3Parser.ypp"
 
+  int sbml_yylex(SBML_YYSTYPE* lvalp, L3Parser* l3p);
+  void sbml_yyerror(L3Parser* l3p, char const *);
+
+#line 496 "L3Parser.cpp"
 
 #ifdef short
 # undef short
@@ -492,6 +531,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -551,6 +602,7 @@ typedef int yytype_uint16;
 
 #define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
 
+
 /* Stored state numbers (used for stacks). */
 typedef yytype_int8 yy_state_t;
 
@@ -569,6 +621,7 @@ typedef int yy_state_fast_t;
 # endif
 #endif
 
+
 #ifndef YY_ATTRIBUTE_PURE
 # if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
 #  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
@@ -587,17 +640,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -626,7 +685,7 @@ typedef int yy_state_fast_t;
 
 #define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -691,8 +750,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -768,14 +826,16 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  79
 
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   265
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
-#define YYTRANSLATE(YYX)                                                \
-  (0 <= (YYX) && (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex.  */
@@ -811,7 +871,7 @@ static const yytype_int8 yytranslate[] =
 };
 
 #if SBML_YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
        0,   384,   384,   385,   386,   387,   390,   391,   417,   418,
@@ -822,31 +882,32 @@ static const yytype_int16 yyrline[] =
 };
 #endif
 
-#if SBML_YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "\"end of string\"", "error", "$undefined", "'&'", "'|'", "'<'", "'>'",
-  "'='", "'!'", "'-'", "'+'", "'*'", "'/'", "'%'", "NOT", "NEG", "UPLUS",
-  "'^'", "'['", "\"number\"", "\"integer\"",
+  "\"end of string\"", "error", "\"invalid token\"", "'&'", "'|'", "'<'",
+  "'>'", "'='", "'!'", "'-'", "'+'", "'*'", "'/'", "'%'", "NOT", "NEG",
+  "UPLUS", "'^'", "'['", "\"number\"", "\"integer\"",
   "\"number in e-notation form\"", "\"number in rational notation\"",
   "\"element name\"", "'('", "')'", "']'", "'{'", "'}'", "','", "';'",
   "$accept", "input", "node", "number", "nodelist", "nodesemicolonlist", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,    38,   124,    60,    62,    61,    33,    45,
-      43,    42,    47,    37,   258,   259,   260,    94,    91,   261,
-     262,   263,   264,   265,    40,    41,    93,   123,   125,    44,
-      59
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
 #define YYPACT_NINF (-24)
 
@@ -858,8 +919,8 @@ static const yytype_int16 yytoknum[] =
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
       58,   -24,   178,   178,   178,   -24,   -24,   -24,   -24,   -23,
@@ -872,9 +933,9 @@ static const yytype_int16 yypact[] =
      233,   233,    52,    52,    52,    52,    52,    52,   -24
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
        0,     4,     0,     0,     0,    35,    37,    36,    38,     7,
@@ -887,21 +948,21 @@ static const yytype_int8 yydefact[] =
       25,    26,    23,    20,    24,    19,    21,    22,    30
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
      -24,   -24,     0,   -24,    -7,   -24
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,    12,    21,    14,    22,    23
+       0,    12,    21,    14,    22,    23
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int8 yytable[] =
 {
       13,    18,    15,    16,    17,    50,    51,     2,     3,     4,
@@ -962,8 +1023,8 @@ static const yytype_int8 yycheck[] =
       17,    18,    -1,    17,    18
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
        0,     1,     8,     9,    10,    19,    20,    21,    22,    23,
@@ -976,7 +1037,7 @@ static const yytype_int8 yystos[] =
       33,    33,    33,    33,    33,    33,    33,    33,    26
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
        0,    31,    32,    32,    32,    32,    33,    33,    33,    33,
@@ -986,7 +1047,7 @@ static const yytype_int8 yyr1[] =
       35,    35,    36,    36
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     0,     1,     1,     2,     1,     1,     3,     3,
@@ -997,21 +1058,22 @@ static const yytype_int8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
-#define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
+#define yyclearin       (yychar = SBML_YYEMPTY)
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
 #define YYBACKUP(Token, Value)                                    \
   do                                                              \
-    if (yychar == YYEMPTY)                                        \
+    if (yychar == SBML_YYEMPTY)                                        \
       {                                                           \
         yychar = (Token);                                         \
         yylval = (Value);                                         \
@@ -1021,15 +1083,14 @@ static const yytype_int8 yyr2[] =
       }                                                           \
     else                                                          \
       {                                                           \
-        yyerror (YY_("syntax error: cannot back up")); \
+        yyerror (l3p, YY_("syntax error: cannot back up")); \
         YYERROR;                                                  \
       }                                                           \
   while (0)
 
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+/* Backward compatibility with an undocumented macro.
+   Use SBML_YYerror or SBML_YYUNDEF. */
+#define YYERRCODE SBML_YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -1046,19 +1107,16 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value, l3p); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -1069,18 +1127,16 @@ do {                                                                      \
 `-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, L3Parser* l3p)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
+  YY_USE (yyoutput);
+  YY_USE (l3p);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yytype], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -1090,12 +1146,13 @@ yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep)
 `---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, L3Parser* l3p)
 {
   YYFPRINTF (yyo, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyo, yytype, yyvaluep);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, l3p);
   YYFPRINTF (yyo, ")");
 }
 
@@ -1128,7 +1185,8 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, L3Parser* l3p)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -1140,9 +1198,8 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, int yyrule)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[+yyssp[yyi + 1 - yynrhs]],
-                       &yyvsp[(yyi + 1) - (yynrhs)]
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], l3p);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1150,15 +1207,15 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, int yyrule)
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, l3p); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !SBML_YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !SBML_YYDEBUG */
@@ -1181,12 +1238,60 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
-#  else
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
 static YYPTRDIFF_T
 yystrlen (const char *yystr)
@@ -1196,13 +1301,13 @@ yystrlen (const char *yystr)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1216,10 +1321,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1234,7 +1339,6 @@ yytnamerr (char *yyres, const char *yystr)
     {
       YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1268,31 +1372,15 @@ yytnamerr (char *yyres, const char *yystr)
   else
     return yystrlen (yystr);
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
-                yy_state_t *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat: reported tokens (one for the "unexpected",
-     one per "expected"). */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
   /* Actual size of YYARG. */
   int yycount = 0;
-  /* Cumulated lengths of YYARG.  */
-  YYPTRDIFF_T yysize = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1316,52 +1404,54 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yyn = yypact[+*yyssp];
-      YYPTRDIFF_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-      yysize = yysize0;
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYPTRDIFF_T yysize1
-                    = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-                    yysize = yysize1;
-                  else
-                    return 2;
-                }
-              }
-        }
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
     default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
@@ -1369,17 +1459,23 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    /* Don't count the "%s"s in the final size, but reserve room for
-       the terminator.  */
-    YYPTRDIFF_T yysize1 = yysize + (yystrlen (yyformat) - 2 * yycount) + 1;
-    if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-      yysize = yysize1;
-    else
-      return 2;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1388,7 +1484,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1400,7 +1496,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
@@ -1411,45 +1507,47 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, L3Parser* l3p)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
+  YY_USE (l3p);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  switch (yytype)
+  switch (yykind)
     {
-    case 33: /* node  */
-#line 359 "L3Parser.ypp"
+    case YYSYMBOL_node: /* node  */
+#line 351 "L3Parser.ypp"
             { delete(((*yyvaluep).astnode)); }
-#line 1435 "L3Parser.cpp"
+#line 1533 "L3Parser.cpp"
         break;
 
-    case 34: /* number  */
-#line 362 "L3Parser.ypp"
+    case YYSYMBOL_number: /* number  */
+#line 354 "L3Parser.ypp"
             { delete(((*yyvaluep).astnode)); }
-#line 1441 "L3Parser.cpp"
+#line 1539 "L3Parser.cpp"
         break;
 
-    case 35: /* nodelist  */
-#line 360 "L3Parser.ypp"
+    case YYSYMBOL_nodelist: /* nodelist  */
+#line 352 "L3Parser.ypp"
             { delete(((*yyvaluep).astnode)); }
-#line 1447 "L3Parser.cpp"
+#line 1545 "L3Parser.cpp"
         break;
 
-    case 36: /* nodesemicolonlist  */
-#line 361 "L3Parser.ypp"
+    case YYSYMBOL_nodesemicolonlist: /* nodesemicolonlist  */
+#line 353 "L3Parser.ypp"
             { delete(((*yyvaluep).astnode)); }
-#line 1453 "L3Parser.cpp"
+#line 1551 "L3Parser.cpp"
         break;
 
       default:
@@ -1461,13 +1559,6 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
 
 
 
-/* The lookahead symbol.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 /*----------.
@@ -1475,45 +1566,54 @@ int yynerrs;
 `----------*/
 
 int
-yyparse (void)
+yyparse (L3Parser* l3p)
 {
-    yy_state_fast_t yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* Lookahead token kind.  */
+int yychar;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
     yy_state_t yyssa[YYINITDEPTH];
-    yy_state_t *yyss;
-    yy_state_t *yyssp;
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
-
-    YYPTRDIFF_T yystacksize;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
   YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
-#endif
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1521,16 +1621,10 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY; /* Cause a token to be read.  */
+  yychar = SBML_YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
 
@@ -1552,10 +1646,11 @@ yysetstate:
   YY_IGNORE_USELESS_CAST_BEGIN
   *yyssp = YY_CAST (yy_state_t, yystate);
   YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1583,7 +1678,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1594,10 +1689,10 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
-# undef YYSTACK_RELOCATE
+#  undef YYSTACK_RELOCATE
         if (yyss1 != yyssa)
           YYSTACK_FREE (yyss1);
       }
@@ -1616,6 +1711,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1636,18 +1732,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
-  if (yychar == YYEMPTY)
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == SBML_YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, l3p);
     }
 
-  if (yychar <= YYEOF)
+  if (yychar <= SBML_YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = SBML_YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == SBML_YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = SBML_YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1681,7 +1788,7 @@ yybackup:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   /* Discard the shifted token.  */
-  yychar = YYEMPTY;
+  yychar = SBML_YYEMPTY;
   goto yynewstate;
 
 
@@ -1716,31 +1823,31 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 3:
+  case 3: /* input: node  */
 #line 385 "L3Parser.ypp"
                      {l3p->outputNode = (yyvsp[0].astnode);}
-#line 1723 "L3Parser.cpp"
+#line 1830 "L3Parser.cpp"
     break;
 
-  case 4:
+  case 4: /* input: error  */
 #line 386 "L3Parser.ypp"
                       {}
-#line 1729 "L3Parser.cpp"
+#line 1836 "L3Parser.cpp"
     break;
 
-  case 5:
+  case 5: /* input: node error  */
 #line 387 "L3Parser.ypp"
                            {delete (yyvsp[-1].astnode);}
-#line 1735 "L3Parser.cpp"
+#line 1842 "L3Parser.cpp"
     break;
 
-  case 6:
+  case 6: /* node: number  */
 #line 390 "L3Parser.ypp"
                        {(yyval.astnode) = (yyvsp[0].astnode);}
-#line 1741 "L3Parser.cpp"
+#line 1848 "L3Parser.cpp"
     break;
 
-  case 7:
+  case 7: /* node: "element name"  */
 #line 391 "L3Parser.ypp"
                        {
                    (yyval.astnode) = new ASTNode();
@@ -1768,22 +1875,22 @@ yyreduce:
                      }
                    }
         }
-#line 1772 "L3Parser.cpp"
+#line 1879 "L3Parser.cpp"
     break;
 
-  case 8:
+  case 8: /* node: '(' node ')'  */
 #line 417 "L3Parser.ypp"
                               {(yyval.astnode) = (yyvsp[-1].astnode);}
-#line 1778 "L3Parser.cpp"
+#line 1885 "L3Parser.cpp"
     break;
 
-  case 9:
+  case 9: /* node: node '^' node  */
 #line 418 "L3Parser.ypp"
                               {(yyval.astnode) = new ASTNode(AST_POWER); (yyval.astnode)->addChild((yyvsp[-2].astnode)); (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 1784 "L3Parser.cpp"
+#line 1891 "L3Parser.cpp"
     break;
 
-  case 10:
+  case 10: /* node: node '*' node  */
 #line 419 "L3Parser.ypp"
                               {
                   if ((yyvsp[-2].astnode)->getType()==AST_TIMES) {
@@ -1796,10 +1903,10 @@ yyreduce:
                     (yyval.astnode)->addChild((yyvsp[0].astnode));
                   }
                 }
-#line 1800 "L3Parser.cpp"
+#line 1907 "L3Parser.cpp"
     break;
 
-  case 11:
+  case 11: /* node: node '+' node  */
 #line 430 "L3Parser.ypp"
                               {
                   if ((yyvsp[-2].astnode)->getType()==AST_PLUS) {
@@ -1812,22 +1919,22 @@ yyreduce:
                     (yyval.astnode)->addChild((yyvsp[0].astnode));
                   }
                 }
-#line 1816 "L3Parser.cpp"
+#line 1923 "L3Parser.cpp"
     break;
 
-  case 12:
+  case 12: /* node: node '/' node  */
 #line 441 "L3Parser.ypp"
                               {(yyval.astnode) = new ASTNode(AST_DIVIDE); (yyval.astnode)->addChild((yyvsp[-2].astnode)); (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 1822 "L3Parser.cpp"
+#line 1929 "L3Parser.cpp"
     break;
 
-  case 13:
+  case 13: /* node: node '-' node  */
 #line 442 "L3Parser.ypp"
                               {(yyval.astnode) = new ASTNode(AST_MINUS); (yyval.astnode)->addChild((yyvsp[-2].astnode)); (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 1828 "L3Parser.cpp"
+#line 1935 "L3Parser.cpp"
     break;
 
-  case 14:
+  case 14: /* node: node '%' node  */
 #line 443 "L3Parser.ypp"
                               {
                   if (l3p->modulol3v2) {
@@ -1839,16 +1946,16 @@ yyreduce:
                     (yyval.astnode) = l3p->createModuloTree((yyvsp[-2].astnode), (yyvsp[0].astnode));
                   }
                 }
-#line 1843 "L3Parser.cpp"
+#line 1950 "L3Parser.cpp"
     break;
 
-  case 15:
+  case 15: /* node: '+' node  */
 #line 453 "L3Parser.ypp"
                                      {(yyval.astnode) = (yyvsp[0].astnode);}
-#line 1849 "L3Parser.cpp"
+#line 1956 "L3Parser.cpp"
     break;
 
-  case 16:
+  case 16: /* node: '-' node  */
 #line 454 "L3Parser.ypp"
                                    {
                   if (l3p->collapseminus) {
@@ -1883,58 +1990,58 @@ yyreduce:
                     (yyval.astnode)->addChild((yyvsp[0].astnode));
                   }
                 }
-#line 1887 "L3Parser.cpp"
+#line 1994 "L3Parser.cpp"
     break;
 
-  case 17:
+  case 17: /* node: node '>' node  */
 #line 487 "L3Parser.ypp"
                               {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-2].astnode), (yyvsp[0].astnode), AST_RELATIONAL_GT);}
-#line 1893 "L3Parser.cpp"
+#line 2000 "L3Parser.cpp"
     break;
 
-  case 18:
+  case 18: /* node: node '<' node  */
 #line 488 "L3Parser.ypp"
                               {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-2].astnode), (yyvsp[0].astnode), AST_RELATIONAL_LT);}
-#line 1899 "L3Parser.cpp"
+#line 2006 "L3Parser.cpp"
     break;
 
-  case 19:
+  case 19: /* node: node '>' '=' node  */
 #line 489 "L3Parser.ypp"
                                   {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-3].astnode), (yyvsp[0].astnode), AST_RELATIONAL_GEQ);}
-#line 1905 "L3Parser.cpp"
+#line 2012 "L3Parser.cpp"
     break;
 
-  case 20:
+  case 20: /* node: node '<' '=' node  */
 #line 490 "L3Parser.ypp"
                                   {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-3].astnode), (yyvsp[0].astnode), AST_RELATIONAL_LEQ);}
-#line 1911 "L3Parser.cpp"
+#line 2018 "L3Parser.cpp"
     break;
 
-  case 21:
+  case 21: /* node: node '=' '=' node  */
 #line 491 "L3Parser.ypp"
                                   {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-3].astnode), (yyvsp[0].astnode), AST_RELATIONAL_EQ);}
-#line 1917 "L3Parser.cpp"
+#line 2024 "L3Parser.cpp"
     break;
 
-  case 22:
+  case 22: /* node: node '!' '=' node  */
 #line 492 "L3Parser.ypp"
                                   {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-3].astnode), (yyvsp[0].astnode), AST_RELATIONAL_NEQ);}
-#line 1923 "L3Parser.cpp"
+#line 2030 "L3Parser.cpp"
     break;
 
-  case 23:
+  case 23: /* node: node '<' '>' node  */
 #line 493 "L3Parser.ypp"
                                   {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-3].astnode), (yyvsp[0].astnode), AST_RELATIONAL_NEQ);}
-#line 1929 "L3Parser.cpp"
+#line 2036 "L3Parser.cpp"
     break;
 
-  case 24:
+  case 24: /* node: node '>' '<' node  */
 #line 494 "L3Parser.ypp"
                                   {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-3].astnode), (yyvsp[0].astnode), AST_RELATIONAL_NEQ);}
-#line 1935 "L3Parser.cpp"
+#line 2042 "L3Parser.cpp"
     break;
 
-  case 25:
+  case 25: /* node: node '&' '&' node  */
 #line 495 "L3Parser.ypp"
                                   {
                   if ((yyvsp[-3].astnode)->getType()==AST_LOGICAL_AND) {
@@ -1947,10 +2054,10 @@ yyreduce:
                     (yyval.astnode)->addChild((yyvsp[0].astnode));
                   }
                 }
-#line 1951 "L3Parser.cpp"
+#line 2058 "L3Parser.cpp"
     break;
 
-  case 26:
+  case 26: /* node: node '|' '|' node  */
 #line 506 "L3Parser.ypp"
                                   {
                   if ((yyvsp[-3].astnode)->getType()==AST_LOGICAL_OR) {
@@ -1963,16 +2070,16 @@ yyreduce:
                     (yyval.astnode)->addChild((yyvsp[0].astnode));
                   }
                 }
-#line 1967 "L3Parser.cpp"
+#line 2074 "L3Parser.cpp"
     break;
 
-  case 27:
+  case 27: /* node: '!' node  */
 #line 517 "L3Parser.ypp"
                                    {(yyval.astnode) = new ASTNode(AST_LOGICAL_NOT); (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 1973 "L3Parser.cpp"
+#line 2080 "L3Parser.cpp"
     break;
 
-  case 28:
+  case 28: /* node: "element name" '(' ')'  */
 #line 518 "L3Parser.ypp"
                                {
                    (yyval.astnode) = new ASTNode(AST_FUNCTION);
@@ -1986,10 +2093,10 @@ yyreduce:
                      if (l3p->checkNumArguments((yyval.astnode))) YYABORT;
                    }
         }
-#line 1990 "L3Parser.cpp"
+#line 2097 "L3Parser.cpp"
     break;
 
-  case 29:
+  case 29: /* node: "element name" '(' nodelist ')'  */
 #line 530 "L3Parser.ypp"
                                         {
                    (yyval.astnode) = (yyvsp[-1].astnode);
@@ -2048,10 +2155,10 @@ yyreduce:
                    if (type == AST_LAMBDA) l3p->fixLambdaArguments((yyval.astnode));
                    if (l3p->checkNumArguments((yyval.astnode))) YYABORT;
         }
-#line 2052 "L3Parser.cpp"
+#line 2159 "L3Parser.cpp"
     break;
 
-  case 30:
+  case 30: /* node: node '[' nodelist ']'  */
 #line 587 "L3Parser.ypp"
                                       {
                   vector<ASTNode*> allnodes;
@@ -2066,10 +2173,10 @@ yyreduce:
                   }
                   if (l3p->checkNumArgumentsForPackage((yyval.astnode))) YYABORT;
                 }
-#line 2070 "L3Parser.cpp"
+#line 2177 "L3Parser.cpp"
     break;
 
-  case 31:
+  case 31: /* node: node '[' ']'  */
 #line 600 "L3Parser.ypp"
                              {
                   vector<ASTNode*> allnodes;
@@ -2082,10 +2189,10 @@ yyreduce:
                   }
                   if (l3p->checkNumArgumentsForPackage((yyval.astnode))) YYABORT;
                 }
-#line 2086 "L3Parser.cpp"
+#line 2193 "L3Parser.cpp"
     break;
 
-  case 32:
+  case 32: /* node: '{' nodelist '}'  */
 #line 611 "L3Parser.ypp"
                                   {
                   vector<ASTNode*> allnodes;
@@ -2098,10 +2205,10 @@ yyreduce:
                   }
                   if (l3p->checkNumArgumentsForPackage((yyval.astnode))) YYABORT;
                 }
-#line 2102 "L3Parser.cpp"
+#line 2209 "L3Parser.cpp"
     break;
 
-  case 33:
+  case 33: /* node: '{' nodesemicolonlist '}'  */
 #line 622 "L3Parser.ypp"
                                            {
                   vector<ASTNode*> allnodes;
@@ -2114,10 +2221,10 @@ yyreduce:
                   }
                   if (l3p->checkNumArgumentsForPackage((yyval.astnode))) YYABORT;
                 }
-#line 2118 "L3Parser.cpp"
+#line 2225 "L3Parser.cpp"
     break;
 
-  case 34:
+  case 34: /* node: '{' '}'  */
 #line 633 "L3Parser.ypp"
                          {
                   (yyval.astnode) = l3p->parsePackageInfix(INFIX_SYNTAX_CURLY_BRACES);
@@ -2127,10 +2234,10 @@ yyreduce:
                   }
                   if (l3p->checkNumArgumentsForPackage((yyval.astnode))) YYABORT;
                 }
-#line 2131 "L3Parser.cpp"
+#line 2238 "L3Parser.cpp"
     break;
 
-  case 35:
+  case 35: /* number: "number"  */
 #line 643 "L3Parser.ypp"
                        {
                   (yyval.astnode) = new ASTNode(); 
@@ -2139,10 +2246,10 @@ yyreduce:
 //                    $$->setUnits("dimensionless");
 //                  }
                 }
-#line 2143 "L3Parser.cpp"
+#line 2250 "L3Parser.cpp"
     break;
 
-  case 36:
+  case 36: /* number: "number in e-notation form"  */
 #line 650 "L3Parser.ypp"
                            {
                   (yyval.astnode) = new ASTNode();
@@ -2151,10 +2258,10 @@ yyreduce:
 //                    $$->setUnits("dimensionless");
 //                  }
                 }
-#line 2155 "L3Parser.cpp"
+#line 2262 "L3Parser.cpp"
     break;
 
-  case 37:
+  case 37: /* number: "integer"  */
 #line 657 "L3Parser.ypp"
                         {
                   (yyval.astnode) = new ASTNode(); 
@@ -2163,10 +2270,10 @@ yyreduce:
 //                    $$->setUnits("dimensionless");
 //                  }
                 }
-#line 2167 "L3Parser.cpp"
+#line 2274 "L3Parser.cpp"
     break;
 
-  case 38:
+  case 38: /* number: "number in rational notation"  */
 #line 664 "L3Parser.ypp"
                          {
                   (yyval.astnode) = new ASTNode(); 
@@ -2175,10 +2282,10 @@ yyreduce:
 //                    $$->setUnits("dimensionless");
 //                  }
                 }
-#line 2179 "L3Parser.cpp"
+#line 2286 "L3Parser.cpp"
     break;
 
-  case 39:
+  case 39: /* number: number "element name"  */
 #line 671 "L3Parser.ypp"
                               {
                   (yyval.astnode) = (yyvsp[-1].astnode);
@@ -2194,35 +2301,35 @@ yyreduce:
                   }
                   (yyval.astnode)->setUnits(*(yyvsp[0].word));
                }
-#line 2198 "L3Parser.cpp"
+#line 2305 "L3Parser.cpp"
     break;
 
-  case 40:
+  case 40: /* nodelist: node  */
 #line 687 "L3Parser.ypp"
                      {(yyval.astnode) = new ASTNode(AST_FUNCTION); (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 2204 "L3Parser.cpp"
+#line 2311 "L3Parser.cpp"
     break;
 
-  case 41:
+  case 41: /* nodelist: nodelist ',' node  */
 #line 688 "L3Parser.ypp"
                                   {(yyval.astnode) = (yyvsp[-2].astnode);  (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 2210 "L3Parser.cpp"
+#line 2317 "L3Parser.cpp"
     break;
 
-  case 42:
+  case 42: /* nodesemicolonlist: nodelist ';' nodelist  */
 #line 691 "L3Parser.ypp"
                                          {(yyval.astnode) = new ASTNode(AST_FUNCTION); (yyval.astnode)->addChild((yyvsp[-2].astnode)); (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 2216 "L3Parser.cpp"
+#line 2323 "L3Parser.cpp"
     break;
 
-  case 43:
+  case 43: /* nodesemicolonlist: nodesemicolonlist ';' nodelist  */
 #line 692 "L3Parser.ypp"
                                                {(yyval.astnode) = (yyvsp[-2].astnode);  (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 2222 "L3Parser.cpp"
+#line 2329 "L3Parser.cpp"
     break;
 
 
-#line 2226 "L3Parser.cpp"
+#line 2333 "L3Parser.cpp"
 
       default: break;
     }
@@ -2237,11 +2344,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
@@ -2265,66 +2371,60 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == SBML_YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = YY_CAST (char *, YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        yyerror (l3p, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
          error, discard it.  */
 
-      if (yychar <= YYEOF)
+      if (yychar <= SBML_YYEOF)
         {
           /* Return failure if at end of input.  */
-          if (yychar == YYEOF)
+          if (yychar == SBML_YYEOF)
             YYABORT;
         }
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
-          yychar = YYEMPTY;
+                      yytoken, &yylval, l3p);
+          yychar = SBML_YYEMPTY;
         }
     }
 
@@ -2341,6 +2441,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2357,13 +2458,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2377,7 +2479,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, l3p);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2389,7 +2491,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2400,7 +2502,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -2408,31 +2510,29 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (l3p, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
 
-/*-----------------------------------------------------.
-| yyreturn -- parsing is finished, return the result.  |
-`-----------------------------------------------------*/
-yyreturn:
-  if (yychar != YYEMPTY)
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != SBML_YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, l3p);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -2441,29 +2541,37 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[+*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, l3p);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
+
 #line 695 "L3Parser.ypp"
 
 
 
-void sbml_yyerror(char const *s)
+void sbml_yyerror(L3Parser* l3p, char const *s)
 {
-  l3p->setError(s);
+  // Newer versions of bison call characters the lexer does not know an
+  // 'invalid token'; keep reporting them as '$undefined', as we always have.
+  string error = s;
+  const string invalid = "invalid token";
+  size_t pos = error.find(invalid);
+  if (pos != string::npos)
+  {
+    error.replace(pos, invalid.size(), "$undefined");
+  }
+  l3p->setError(error);
 }
 
-int sbml_yylex(void)
+int sbml_yylex(SBML_YYSTYPE* lvalp, L3Parser* l3p)
 {
   char cc = 0;
   l3p->input.get(cc);
@@ -2495,7 +2603,7 @@ int sbml_yylex(void)
     if (!l3p->input.eof()) {
       l3p->input.unget();
     }
-    sbml_yylval.word = l3p->addWord(word);
+    lvalp->word = l3p->addWord(word);
     //cout << "\tRead word '" << word << "'." << endl;
     return SYMBOL;
   }
@@ -2526,7 +2634,7 @@ int sbml_yylex(void)
         streampos numend = l3p->input.tellg();
         string tempinput = l3p->input.str();
         l3p->input.str(failnum);
-        int ret = sbml_yylex();
+        int ret = sbml_yylex(lvalp, l3p);
         l3p->input.str(tempinput);
         l3p->input.clear();
         l3p->input.seekg(numend);
@@ -2559,11 +2667,11 @@ int sbml_yylex(void)
        l3p->input.unget();
     }
     if (!decimal && !e && number == static_cast<double>(numlong) && numlong <= SBML_INT_MAX) {
-      sbml_yylval.numlong = numlong;
+      lvalp->numlong = numlong;
       return INTEGER;
     }
     if (!e) {
-      sbml_yylval.numdouble = number;
+      lvalp->numdouble = number;
       return DOUBLE;
     }
     l3p->input.clear();
@@ -2591,13 +2699,13 @@ int sbml_yylex(void)
       mantissastr.str(mantissa);
       mantissastr >> number;
       l3p->exponent = numlong;
-      sbml_yylval.mantissa = number;
+      lvalp->mantissa = number;
       return E_NOTATION;
     }
     else {
       assert(false); //How did this happen?
       //This is an error condition, but parsing the value as a double should be sufficient.
-      sbml_yylval.numdouble = number;
+      lvalp->numdouble = number;
       return DOUBLE;
     }
   }
@@ -2618,7 +2726,7 @@ int sbml_yylex(void)
           cc = l3p->input.get();
           if (cc==')') {
             //Actually a rational number!
-            sbml_yylval.rational = numerator;
+            lvalp->rational = numerator;
             l3p->denominator = denominator;
             return RATIONAL;
           }
@@ -2977,7 +3085,7 @@ bool L3Parser::checkNumArguments(const ASTNode* function)
 
     if (children != 1) {
       error << "exactly one argument, but " << children << " were found.";
-      l3p->setError(error.str());
+      setError(error.str());
       delete function;
       return true;
     }
@@ -2991,7 +3099,7 @@ bool L3Parser::checkNumArguments(const ASTNode* function)
 
     if (children != 2) {
       error << "exactly two arguments, but " << children << " were found.";
-      l3p->setError(error.str());
+      setError(error.str());
       delete function;
       return true;
     }
@@ -3004,7 +3112,7 @@ bool L3Parser::checkNumArguments(const ASTNode* function)
   case AST_RELATIONAL_LT:
     if (children <= 1) {
       error << "at least two arguments, but " << children << " were found.";
-      l3p->setError(error.str());
+      setError(error.str());
       delete function;
       return true;
     }
@@ -3014,7 +3122,7 @@ bool L3Parser::checkNumArguments(const ASTNode* function)
   case AST_LAMBDA:
     if (children == 0) {
       error << "at least one argument, but none were found.";
-      l3p->setError(error.str());
+      setError(error.str());
       delete function;
       return true;
     }
@@ -3024,7 +3132,7 @@ bool L3Parser::checkNumArguments(const ASTNode* function)
   case AST_MINUS:
     if (children < 1 || children > 2) {
       error << "exactly one or two arguments, but " << children << " were found.";
-      l3p->setError(error.str());
+      setError(error.str());
       delete function;
       return true;
     }
@@ -3042,7 +3150,7 @@ bool L3Parser::checkNumArguments(const ASTNode* function)
       bool ret = currentSettings->checkNumArgumentsForPackage(function, error);
       if (ret)
       {
-        l3p->setError(error.str());
+        setError(error.str());
         delete function;
       }
       return ret;
@@ -3133,7 +3241,7 @@ bool L3Parser::checkNumArgumentsForPackage(const ASTNode* function)
   stringstream error;
   bool ret = currentSettings->checkNumArgumentsForPackage(function, error);
   if (ret) {
-    l3p->setError(error.str());
+    setError(error.str());
     delete function;
   }
   return ret;
@@ -3229,7 +3337,7 @@ LIBSBML_EXTERN
 ASTNode_t *
 SBML_parseL3Formula (const char *formula)
 {
-  L3ParserSettings l3ps = L3Parser_getInstance()->getDefaultL3ParserSettings();
+  L3ParserSettings l3ps;
   return SBML_parseL3FormulaWithSettings(formula, &l3ps);
 }
 
@@ -3243,7 +3351,7 @@ LIBSBML_EXTERN
 ASTNode_t *
 SBML_parseL3FormulaWithModel (const char *formula, const Model_t * model)
 {
-  L3ParserSettings l3ps = L3Parser_getInstance()->getDefaultL3ParserSettings();
+  L3ParserSettings l3ps;
   l3ps.setModel(model);
   return SBML_parseL3FormulaWithSettings(formula, &l3ps);
 }
@@ -3258,23 +3366,24 @@ LIBSBML_EXTERN
 ASTNode_t *
 SBML_parseL3FormulaWithSettings (const char *formula, const L3ParserSettings_t * settings)
 {
-  l3p = L3Parser_getInstance();
   if (settings == NULL) {
-    L3ParserSettings l3ps = l3p->getDefaultL3ParserSettings();
+    L3ParserSettings l3ps;
     return SBML_parseL3FormulaWithSettings(formula, &l3ps);
   }
-  l3p->clear();
-  l3p->setInput(formula);
-  l3p->model = settings->getModel();
-  l3p->parselog = settings->getParseLog();
-  l3p->collapseminus = settings->getParseCollapseMinus();
-  l3p->parseunits = settings->getParseUnits();
-  l3p->avocsymbol = settings->getParseAvogadroCsymbol();
-  l3p->currentSettings = settings;
-  l3p->strCmpIsCaseSensitive = settings->getComparisonCaseSensitivity();
-  l3p->modulol3v2 = settings->getParseModuloL3v2();
-  sbml_yyparse();
-  return l3p->outputNode;
+  L3Parser parser;
+  parser.clear();
+  parser.setInput(formula);
+  parser.model = settings->getModel();
+  parser.parselog = settings->getParseLog();
+  parser.collapseminus = settings->getParseCollapseMinus();
+  parser.parseunits = settings->getParseUnits();
+  parser.avocsymbol = settings->getParseAvogadroCsymbol();
+  parser.currentSettings = settings;
+  parser.strCmpIsCaseSensitive = settings->getComparisonCaseSensitivity();
+  parser.modulol3v2 = settings->getParseModuloL3v2();
+  sbml_yyparse(&parser);
+  lastParseL3Error = parser.getError();
+  return parser.outputNode;
 }
 
 
@@ -3287,7 +3396,7 @@ LIBSBML_EXTERN
 L3ParserSettings_t* 
 SBML_getDefaultL3ParserSettings ()
 {
-  return new L3ParserSettings(L3Parser_getInstance()->getDefaultL3ParserSettings());
+  return new L3ParserSettings();
 }
 
 /**
@@ -3299,7 +3408,7 @@ LIBSBML_EXTERN
 char*
 SBML_getLastParseL3Error()
 {
-  return safe_strdup(L3Parser_getInstance()->getError().c_str());
+  return safe_strdup(lastParseL3Error.c_str());
 }
 
 /** @cond doxygenLibsbmlInternal */
@@ -3308,11 +3417,9 @@ LIBSBML_EXTERN
 void
 SBML_deleteL3Parser()
 {
-  if (l3p!=NULL) 
-  {
-    delete l3p;
-    l3p = NULL;
-  }
+  // the parser is no longer kept between calls, so there is nothing to
+  // delete; the error of the last parse is cleared for compatibility
+  lastParseL3Error.clear();
 }
 
 /** @endcond */
@@ -142,6 +142,11 @@ SBML_parseL3FormulaWithModel (const char *formula, const Model_t * model);
  * is returned, an error is recorded internally; information about the
  * error can be retrieved using @sbmlfunction{getLastParseL3Error,}.
  *
+ * @note Formulas may be parsed in several threads at once.  The parser
+ * looks up packages in the SBMLExtensionRegistry, which is created on
+ * first use; if libSBML was built with a compiler older than C++11, call
+ * SBMLExtensionRegistry::getInstance() once before starting the threads.
+ *
  * @see @sbmlfunction{parseL3Formula, String}
  * @see @sbmlfunction{parseL3FormulaWithSettings, String\, L3ParserSettings}
  * @see @sbmlfunction{parseL3FormulaWithModel, String\, Model}
@@ -55,6 +55,9 @@
 #include <sbml/math/DefinitionURLRegistry.h>
 
 #include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstring>
 
 #ifdef USE_MULTI
 #include <sbml/packages/multi/common/MultiExtensionTypes.h>
@@ -567,6 +570,77 @@ setTypeCI (ASTNode& node, const XMLToken& element, XMLInputStream& stream)
 /** @endcond */
 
 /** @cond doxygenLibsbmlInternal */
+/*
+ * Returns the first character of chars that is not whitespace.
+ */
+static const char*
+skipSpace (const string& chars)
+{
+  const char* first = chars.data();
+  const char* last  = first + chars.size();
+
+  while (first != last && isspace((unsigned char)*first)) ++first;
+
+  return first;
+}
+
+
+/*
+ * Reads a double from the start of chars, ignoring leading whitespace and
+ * whatever follows the number, as reading it from an istringstream in the
+ * classic locale would.  Returns false if there is no number.
+ */
+static bool
+readDouble (const string& chars, double& value)
+{
+  const char* first = skipSpace(chars);
+  const char* last  = chars.data() + chars.size();
+  const char* next  = util_parseDouble(first, last, &value, NULL);
+
+  // a stream refuses an exponent marker that is not followed by digits
+  return next != first && (next == last || (*next != 'e' && *next != 'E'));
+}
+
+
+/*
+ * Reads an int from the start of chars as readDouble() reads a double.
+ * Returns false if there is no number or it does not fit into an int, in
+ * which case value is the nearest int, as a stream leaves it.
+ */
+static bool
+readInt (const string& chars, int& value)
+{
+  const char* first  = skipSpace(chars);
+  const char* last   = chars.data() + chars.size();
+  long        result = 0;
+
+  if (util_parseLong(first, last, &result, NULL) == first) return false;
+
+  if (result > INT_MAX || result < INT_MIN)
+  {
+    value = (result > 0) ? INT_MAX : INT_MIN;
+    return false;
+  }
+
+  value = (int)result;
+  return true;
+}
+
+
+/*
+ * Reads a long from the start of chars as readDouble() reads a double.
+ */
+static bool
+readLong (const string& chars, long& value)
+{
+  const char* first    = skipSpace(chars);
+  const char* last     = chars.data() + chars.size();
+  int         overflow = 0;
+
+  return util_parseLong(first, last, &value, &overflow) != first && !overflow;
+}
+
+
 /*
  * Sets the type of an ASTNode based on the given MathML &lt;cn> element.
  * Errors will be logged in the stream's SBMLErrorLog object.
@@ -590,13 +664,11 @@ setTypeCN (ASTNode& node, const XMLToken& element, XMLInputStream& stream)
   if (type == "real")
   {
     double value = 0;
-    istringstream isreal;
-    isreal.str( stream.next().getCharacters() );
-    isreal >> value;
+    bool   read  = readDouble(stream.next().getCharacters(), value);
 
     node.setValue(value);
 
-    if (isreal.fail() 
+    if (!read 
       || node.isInfinity()
       || node.isNegInfinity()
       )
@@ -609,11 +681,8 @@ setTypeCN (ASTNode& node, const XMLToken& element, XMLInputStream& stream)
   else if (type == "integer")
   {
     int value = 0;
-    istringstream isint;
-    isint.str( stream.next().getCharacters() );
-    isint >> value;
 
-    if (isint.fail())
+    if (!readInt(stream.next().getCharacters(), value))
     {
       logError(stream, element, FailedMathMLReadOfInteger);      
     }
@@ -627,24 +696,21 @@ setTypeCN (ASTNode& node, const XMLToken& element, XMLInputStream& stream)
 
   else if (type == "e-notation")
   {
-    double mantissa = 0;
-    long   exponent = 0;
-    istringstream ismantissa;
-    istringstream isexponent;
-    ismantissa.str( stream.next().getCharacters() );
-    ismantissa >> mantissa;
+    double mantissa     = 0;
+    long   exponent     = 0;
+    bool   readMantissa = readDouble(stream.next().getCharacters(), mantissa);
+    bool   readExponent = true;
 
     if (stream.peek().getName() == "sep")
     {
       stream.next();
-      isexponent.str( stream.next().getCharacters() );
-      isexponent >> exponent;
+      readExponent = readLong(stream.next().getCharacters(), exponent);
     }
 
     node.setValue(mantissa, exponent);
 
-    if (ismantissa.fail() 
-      || isexponent.fail()
+    if (!readMantissa 
+      || !readExponent
       || node.isInfinity()
       || node.isNegInfinity())
     {
@@ -658,19 +724,16 @@ setTypeCN (ASTNode& node, const XMLToken& element, XMLInputStream& stream)
     int numerator = 0;
     int denominator = 1;
 
-    istringstream isnumerator;
-    istringstream isdenominator;
-    isnumerator.str( stream.next().getCharacters() );
-    isnumerator >> numerator;
+    bool readNumerator   = readInt(stream.next().getCharacters(), numerator);
+    bool readDenominator = true;
 
     if (stream.peek().getName() == "sep")
     {
       stream.next();
-      isdenominator.str( stream.next().getCharacters() );
-      isdenominator >> denominator;
+      readDenominator = readInt(stream.next().getCharacters(), denominator);
     }
 
-    if (isnumerator.fail() || isdenominator.fail())
+    if (!readNumerator || !readDenominator)
     {
       logError(stream, element, FailedMathMLReadOfRational);      
     }
@@ -1562,28 +1625,23 @@ writeCSymbol(const ASTNode& node, XMLOutputStream& stream, SBMLNamespaces *sbmln
 static void
 writeDouble (const double& value, XMLOutputStream& stream)
 {
+  char buffer[32];
+  XMLOutputStream::formatDouble(value, buffer);
 
-  ostringstream output;
-
-  output.precision(LIBSBML_DOUBLE_PRECISION);
-  output << value;
-
-  string            value_string = output.str();
-  string::size_type position     = value_string.find('e');
+  const char* position = strchr(buffer, 'e');
 
-  if (position == string::npos)
+  if (position == NULL)
   {
-    stream << " " << value_string << " ";
+    stream << " " << buffer << " ";
   }
   else
   {
-    const string mantissa_string = value_string.substr(0, position);
-    const string exponent_string = value_string.substr(position + 1);
+    const string mantissa_string(buffer, (size_t)(position - buffer));
 
-    double mantissa = strtod(mantissa_string.c_str(), 0);
-    long   exponent = strtol(exponent_string.c_str(), 0, 10);
+    ostringstream output;
+    output << strtol(position + 1, NULL, 10);
 
-    writeENotation(mantissa, exponent, stream);
+    writeENotation(mantissa_string, output.str(), stream);
   }
 }
 /** @endcond */
@@ -1599,25 +1657,23 @@ writeENotation (  const double&    mantissa
                 , long             exponent
                 , XMLOutputStream& stream )
 {
+  char buffer[32];
+  XMLOutputStream::formatDouble(mantissa, buffer);
 
-  ostringstream output;
-
-  output.precision(LIBSBML_DOUBLE_PRECISION);
-  output << mantissa;
-
-  const string      value_string = output.str();
-  string::size_type position     = value_string.find('e');
+  const char* position = strchr(buffer, 'e');
 
-  if (position != string::npos)
+  if (position != NULL)
   {
-    const string exponent_string = value_string.substr(position + 1);
-    exponent += strtol(exponent_string.c_str(), NULL, 10);
+    exponent += strtol(position + 1, NULL, 10);
   }
 
-  output.str("");
+  ostringstream output;
   output << exponent;
 
-  const string mantissa_string = value_string.substr(0, position);
+  const size_t length = (position == NULL) ? strlen(buffer)
+                                           : (size_t)(position - buffer);
+
+  const string mantissa_string(buffer, length);
   const string exponent_string = output.str();
 
   writeENotation(mantissa_string, exponent_string, stream);
@@ -2633,6 +2633,57 @@ START_TEST (test_ChildFunctions_insertIntoRoot_3)
 END_TEST
 
 
+START_TEST (test_ChildFunctions_manyChildren)
+{
+  N = new ASTNode(AST_PLUS);
+  char name[16];
+
+  for (unsigned int i = 0; i < 1000; i++)
+  {
+    ASTNode * c = new ASTNode(AST_NAME);
+    sprintf(name, "c%u", i);
+    c->setName(name);
+    fail_unless( N->addChild(c) == LIBSBML_OPERATION_SUCCESS );
+  }
+
+  fail_unless( N->addChild(NULL) == LIBSBML_OPERATION_FAILED );
+  fail_unless( N->getNumChildren() == 1000 );
+  fail_unless( strcmp(N->getLeftChild()->getName(), "c0") == 0 );
+  fail_unless( strcmp(N->getRightChild()->getName(), "c999") == 0 );
+  fail_unless( strcmp(N->getChild(500)->getName(), "c500") == 0 );
+  fail_unless( N->getChild(1000) == NULL );
+
+  ASTNode * newChild = new ASTNode(AST_NAME);
+  newChild->setName("newChild");
+  fail_unless( N->insertChild(500, newChild) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( N->getNumChildren() == 1001 );
+  fail_unless( N->getChild(500) == newChild );
+  fail_unless( strcmp(N->getChild(501)->getName(), "c500") == 0 );
+
+  ASTNode * removed = N->getChild(0);
+  fail_unless( N->removeChild(0) == LIBSBML_OPERATION_SUCCESS );
+  delete removed;
+  fail_unless( N->getNumChildren() == 1000 );
+  fail_unless( N->getChild(499) == newChild );
+
+  ASTNode * copy = N->deepCopy();
+  fail_unless( copy->getNumChildren() == 1000 );
+  fail_unless( strcmp(copy->getChild(499)->getName(), "newChild") == 0 );
+  fail_unless( strcmp(copy->getChild(999)->getName(), "c999") == 0 );
+
+  ASTNode * other = new ASTNode(AST_TIMES);
+  fail_unless( N->swapChildren(other) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( N->getNumChildren() == 0 );
+  fail_unless( N->getLeftChild() == NULL );
+  fail_unless( other->getNumChildren() == 1000 );
+  fail_unless( other->getChild(499) == newChild );
+
+  delete other;
+  delete copy;
+}
+END_TEST
+
+
 Suite *
 create_suite_TestChildFunctions ()
 {
@@ -2695,6 +2746,7 @@ create_suite_TestChildFunctions ()
   tcase_add_test( tcase, test_ChildFunctions_insertIntoRoot_1               );
   tcase_add_test( tcase, test_ChildFunctions_insertIntoRoot_2               );
   tcase_add_test( tcase, test_ChildFunctions_insertIntoRoot_3               );
+  tcase_add_test( tcase, test_ChildFunctions_manyChildren               );
 
   suite_add_tcase(suite, tcase);
 
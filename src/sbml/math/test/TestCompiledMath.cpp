@@ -0,0 +1,473 @@
+/**
+ * \file    TestCompiledMath.cpp
+ * \brief   Test the CompiledMath evaluator
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <map>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cmath>
+
+#include <check.h>
+
+#include <sbml/math/ASTNode.h>
+#include <sbml/math/CompiledMath.h>
+#include <sbml/math/L3Parser.h>
+#include <sbml/math/FormulaFormatter.h>
+#include <sbml/SBMLTransforms.h>
+#include <sbml/SBMLDocument.h>
+#include <sbml/Model.h>
+#include <sbml/FunctionDefinition.h>
+#include <sbml/Parameter.h>
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+/** @endcond */
+
+CK_CPPSTART
+
+
+static bool
+equalResults (double a, double b)
+{
+  if (util_isNaN(a) || util_isNaN(b))
+  {
+    return util_isNaN(a) && util_isNaN(b);
+  }
+
+  if (a == b)
+  {
+    return true;
+  }
+
+  return fabs(a - b) <= 1e-12 * (fabs(a) + fabs(b));
+}
+
+
+/*
+ * Compiles the formula and checks that it evaluates to the same value as
+ * SBMLTransforms::evaluateASTNode() for the given values.
+ */
+static bool
+matchesEvaluateASTNode (const char* formula,
+                        const map<string, double>& values,
+                        const Model* m = NULL)
+{
+  ASTNode* math = SBML_parseL3Formula(formula);
+  if (math == NULL)
+  {
+    return false;
+  }
+
+  CompiledMath compiled(math, m);
+
+  for (map<string, double>::const_iterator it = values.begin();
+       it != values.end(); ++it)
+  {
+    compiled.setValue(it->first, it->second);
+  }
+
+  double expected = SBMLTransforms::evaluateASTNode(math, values, m);
+  double actual = compiled.evaluate();
+
+  delete math;
+
+  return compiled.isCompiled() && equalResults(expected, actual);
+}
+
+
+START_TEST (test_CompiledMath_empty)
+{
+  CompiledMath compiled;
+
+  fail_unless( compiled.isCompiled() == false );
+  fail_unless( compiled.getNumSymbols() == 0 );
+  fail_unless( compiled.getNumInstructions() == 0 );
+  fail_unless( util_isNaN(compiled.evaluate()) );
+
+  fail_unless( compiled.compile(NULL) == LIBSBML_INVALID_OBJECT );
+  fail_unless( compiled.isCompiled() == false );
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_matchesEvaluateASTNode)
+{
+  map<string, double> values;
+  values["a"] = 0.5;
+  values["b"] = 2.0;
+  values["c"] = 3.25;
+
+  const char* formulas[] =
+  {
+    "a + b * c",
+    "a - b / c - 4",
+    "-a + -(b * c)",
+    "a^b + pow(c, 0.5)",
+    "exp(a) - ln(b) + log10(c)",
+    "sqrt(c) + root(3, b)",
+    "abs(-c) + floor(c) + ceil(a)",
+    "factorial(4) + factorial(b)",
+    "sin(a) * cos(b) / tan(c)",
+    "sec(a) + csc(b) + cot(c)",
+    "sinh(a) + cosh(b) - tanh(c)",
+    "sech(a) + csch(b) + coth(c)",
+    "arcsin(a) + arccos(a) + arctan(c)",
+    "arcsec(b) + arccsc(b) + arccot(c)",
+    "arcsinh(a) + arccosh(b) + arctanh(a)",
+    "arcsech(a) + arccsch(b) + arccoth(c)",
+    "a < b",
+    "a > b",
+    "a <= b && b >= c",
+    "a == b || b != c",
+    "a < b < c",
+    "!(a > b)",
+    "piecewise(a, b > c, c)",
+    "piecewise(a, a > b, b, b > c, c)",
+    "piecewise(a, a < b, b, b < c)",
+    "piecewise(a + 1, true)",
+    "exponentiale * pi + avogadro",
+    "true + false",
+    "a / 0",
+    "1e300 * 1e300 - a",
+    "d + 1"
+  };
+
+  for (size_t i = 0; i < sizeof(formulas) / sizeof(formulas[0]); ++i)
+  {
+    fail_unless( matchesEvaluateASTNode(formulas[i], values) );
+  }
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_l3v2Functions)
+{
+  CompiledMath compiled;
+  ASTNode* math = SBML_parseL3Formula("max(a, b, c) - min(a, b, c)");
+
+  fail_unless( compiled.compile(math) == LIBSBML_OPERATION_SUCCESS );
+  compiled.setValue("a", 1.0);
+  compiled.setValue("b", 5.0);
+  compiled.setValue("c", -2.0);
+  fail_unless( compiled.evaluate() == 7.0 );
+  delete math;
+
+  math = SBML_parseL3Formula("rem(a, b) + quotient(a, b)");
+  fail_unless( compiled.compile(math) == LIBSBML_OPERATION_SUCCESS );
+  compiled.setValue("a", 17.0);
+  compiled.setValue("b", 5.0);
+  fail_unless( compiled.evaluate() == 5.0 );
+  delete math;
+
+  math = SBML_parseL3Formula("implies(a > b, a > 0) + xor(a > 0, b > 0, true)");
+  fail_unless( compiled.compile(math) == LIBSBML_OPERATION_SUCCESS );
+  compiled.setValue("a", 2.0);
+  compiled.setValue("b", 1.0);
+  fail_unless( compiled.evaluate() == 2.0 );
+  delete math;
+
+  math = SBML_parseL3Formula("log(2, 8)");
+  fail_unless( compiled.compile(math) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( compiled.getNumSymbols() == 0 );
+  fail_unless( equalResults(compiled.evaluate(), 3.0) );
+  delete math;
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_factorialRange)
+{
+  map<string, double> values;
+  const double args[] = { 5.5, 1, 0, -3, -1e300, 170, 171, 1e300,
+                          util_PosInf(), util_NegInf(), util_NaN() };
+
+  for (size_t n = 0; n < sizeof(args) / sizeof(args[0]); ++n)
+  {
+    values["a"] = args[n];
+    fail_unless( matchesEvaluateASTNode("factorial(a)", values) );
+  }
+
+  CompiledMath compiled;
+  ASTNode* math = SBML_parseL3Formula("factorial(a)");
+
+  fail_unless( compiled.compile(math) == LIBSBML_OPERATION_SUCCESS );
+  compiled.setValue("a", 5.5);
+  fail_unless( compiled.evaluate() == 120.0 );
+  compiled.setValue("a", -1e300);
+  fail_unless( compiled.evaluate() == 1.0 );
+  compiled.setValue("a", 1e300);
+  fail_unless( util_isInf(compiled.evaluate()) == 1 );
+  compiled.setValue("a", util_NaN());
+  fail_unless( util_isNaN(compiled.evaluate()) );
+  delete math;
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_symbols)
+{
+  ASTNode* math = SBML_parseL3Formula("x * y + x / z");
+  CompiledMath compiled(math);
+
+  fail_unless( compiled.isCompiled() == true );
+  fail_unless( compiled.getNumSymbols() == 3 );
+  fail_unless( compiled.getSymbol(0) == "x" );
+  fail_unless( compiled.getSymbol(1) == "y" );
+  fail_unless( compiled.getSymbol(2) == "z" );
+  fail_unless( compiled.getSymbol(3) == "" );
+  fail_unless( compiled.getSymbolIndex("y") == 1 );
+  fail_unless( compiled.getSymbolIndex("w") == -1 );
+
+  fail_unless( util_isNaN(compiled.evaluate()) );
+  fail_unless( util_isNaN(compiled.getValue(0)) );
+
+  fail_unless( compiled.setValue(0u, 4.0) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( compiled.setValue("y", 3.0) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( compiled.setValue("z", 2.0) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( compiled.setValue(3u, 1.0) == LIBSBML_INDEX_EXCEEDS_SIZE );
+  fail_unless( compiled.setValue("w", 1.0)
+                                    == LIBSBML_INVALID_ATTRIBUTE_VALUE );
+
+  fail_unless( compiled.getValue(1) == 3.0 );
+  fail_unless( util_isNaN(compiled.getValue(3)) );
+  fail_unless( compiled.evaluate() == 14.0 );
+
+  double values[] = { 1.0, 2.0, 4.0 };
+  fail_unless( compiled.evaluate(values) == 2.25 );
+
+  /* evaluating with an array does not change the stored values */
+  fail_unless( compiled.evaluate() == 14.0 );
+
+  delete math;
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_functionDefinitions)
+{
+  SBMLDocument doc(3, 2);
+  Model* m = doc.createModel();
+
+  FunctionDefinition* fd = m->createFunctionDefinition();
+  fd->setId("f");
+  ASTNode* def = SBML_parseL3Formula("lambda(x, y, x * y + 1)");
+  fd->setMath(def);
+  delete def;
+
+  fd = m->createFunctionDefinition();
+  fd->setId("g");
+  def = SBML_parseL3Formula("lambda(x, f(x, x) - 1)");
+  fd->setMath(def);
+  delete def;
+
+  map<string, double> values;
+  values["a"] = 1.5;
+  values["b"] = -2.0;
+
+  fail_unless( matchesEvaluateASTNode("f(a, b) + g(b)", values, m) );
+  fail_unless( matchesEvaluateASTNode("g(f(a, 2))", values, m) );
+
+  /* the arguments of the functions are not symbols of the expression */
+  ASTNode* math = SBML_parseL3Formula("f(a, b) + g(b)");
+  CompiledMath compiled(math, m);
+  fail_unless( compiled.getNumSymbols() == 2 );
+  fail_unless( compiled.getSymbolIndex("x") == -1 );
+
+  /* without the model the call cannot be evaluated */
+  compiled.compile(math);
+  compiled.setValue("a", 1.0);
+  compiled.setValue("b", 1.0);
+  fail_unless( util_isNaN(compiled.evaluate()) );
+
+  delete math;
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_setValues)
+{
+  SBMLDocument doc(3, 2);
+  Model* m = doc.createModel();
+
+  Parameter* p = m->createParameter();
+  p->setId("k1");
+  p->setValue(2.5);
+  p = m->createParameter();
+  p->setId("k2");
+  p->setValue(4.0);
+
+  ASTNode* math = SBML_parseL3Formula("k1 * k2 + unknown");
+  CompiledMath compiled(math, m);
+
+  fail_unless( compiled.setValues(NULL) == LIBSBML_INVALID_OBJECT );
+  fail_unless( compiled.setValues(m) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( compiled.getValue(compiled.getSymbolIndex("k1")) == 2.5 );
+  fail_unless( compiled.getValue(compiled.getSymbolIndex("k2")) == 4.0 );
+  fail_unless( util_isNaN(compiled.evaluate()) );
+
+  compiled.setValue("unknown", 1.0);
+  fail_unless( compiled.evaluate() == 11.0 );
+
+  delete math;
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_largeExpression)
+{
+  ostringstream formula;
+  map<string, double> values;
+
+  for (unsigned int i = 0; i < 500; ++i)
+  {
+    ostringstream id;
+    id << "s" << i;
+    values[id.str()] = 0.01 * i;
+
+    if (i > 0)
+    {
+      formula << " + ";
+    }
+    formula << "k * " << id.str() << "^2";
+  }
+  values["k"] = 1.5;
+
+  fail_unless( matchesEvaluateASTNode(formula.str().c_str(), values) );
+
+  /* deep nesting needs more than the fixed evaluation stack */
+  string nested = "a";
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    nested = "(1 + " + nested + ")";
+  }
+  nested = nested + " * " + nested;
+  values["a"] = 0.5;
+
+  fail_unless( matchesEvaluateASTNode(nested.c_str(), values) );
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_batch)
+{
+  const char* formulas[] =
+  {
+    "a * b + c / a - 2",
+    "-a^b + pow(c, 0.5)",
+    "exp(a) - ln(b) + log10(c) + log(2, b)",
+    "piecewise(a, b > c, c)",
+    "piecewise(a, a > b, b, b > c, c)",
+    "piecewise(a, a < 1, a, a < 1)",
+    "max(a, b, c) + (a < b < c) + sin(a) + rem(b, a)",
+    "3"
+  };
+
+  const size_t n = 1000;
+  vector<double> a(n), b(n), c(n), out(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    a[i] = 0.25 + 0.01 * (double)i;
+    b[i] = 7.0 - 0.005 * (double)i;
+    c[i] = (i % 3 == 0) ? 0.0 : 1.5;
+  }
+
+  for (size_t f = 0; f < sizeof(formulas) / sizeof(formulas[0]); ++f)
+  {
+    ASTNode* math = SBML_parseL3Formula(formulas[f]);
+    CompiledMath compiled(math);
+
+    /* columns in the order of the symbol indexes */
+    vector<const double*> columns;
+    for (unsigned int k = 0; k < compiled.getNumSymbols(); ++k)
+    {
+      string id = compiled.getSymbol(k);
+      columns.push_back(id == "a" ? &a[0] : id == "b" ? &b[0] : &c[0]);
+    }
+
+    fail_unless( compiled.evaluate(columns.empty() ? NULL : &columns[0],
+                                   n, &out[0]) == LIBSBML_OPERATION_SUCCESS );
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      double values[3];
+      for (unsigned int k = 0; k < compiled.getNumSymbols(); ++k)
+      {
+        values[k] = columns[k][i];
+      }
+      fail_unless( equalResults(out[i], compiled.evaluate(values)) );
+    }
+
+    delete math;
+  }
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_batch_invalid)
+{
+  double out[2] = { 0.0, 0.0 };
+  double x[2] = { 1.0, 2.0 };
+  const double* columns[] = { x };
+
+  CompiledMath empty;
+  fail_unless( empty.evaluate(columns, 2, out) == LIBSBML_INVALID_OBJECT );
+
+  ASTNode* math = SBML_parseL3Formula("x + 1");
+  CompiledMath compiled(math);
+
+  fail_unless( compiled.evaluate(NULL, 2, out) == LIBSBML_INVALID_OBJECT );
+  fail_unless( compiled.evaluate(columns, 2, NULL) == LIBSBML_INVALID_OBJECT );
+  fail_unless( compiled.evaluate(columns, 0, NULL) == LIBSBML_OPERATION_SUCCESS );
+
+  fail_unless( compiled.evaluate(columns, 2, out) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( out[0] == 2.0 );
+  fail_unless( out[1] == 3.0 );
+
+  delete math;
+}
+END_TEST
+
+
+Suite *create_suite_CompiledMath ()
+{
+  Suite *suite = suite_create("CompiledMath");
+  TCase *tcase = tcase_create("CompiledMath");
+
+  tcase_add_test( tcase, test_CompiledMath_empty                  );
+  tcase_add_test( tcase, test_CompiledMath_matchesEvaluateASTNode );
+  tcase_add_test( tcase, test_CompiledMath_l3v2Functions          );
+  tcase_add_test( tcase, test_CompiledMath_factorialRange         );
+  tcase_add_test( tcase, test_CompiledMath_symbols                );
+  tcase_add_test( tcase, test_CompiledMath_functionDefinitions    );
+  tcase_add_test( tcase, test_CompiledMath_setValues              );
+  tcase_add_test( tcase, test_CompiledMath_largeExpression        );
+  tcase_add_test( tcase, test_CompiledMath_batch                  );
+  tcase_add_test( tcase, test_CompiledMath_batch_invalid          );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+CK_CPPEND
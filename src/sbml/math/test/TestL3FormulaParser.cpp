@@ -43,10 +43,17 @@
 #include <sbml/util/util.h>
 #include <sbml/math/L3Parser.h>
 #include <sbml/math/L3ParserSettings.h>
+#include <sbml/math/L3FormulaFormatter.h>
 #include <sbml/Model.h>
 
 #include <check.h>
 
+#if (__cplusplus >= 201103L)
+#include <string>
+#include <thread>
+#include <vector>
+#endif
+
 #if __cplusplus
 LIBSBML_CPP_NAMESPACE_USE
 CK_CPPSTART
@@ -3758,6 +3765,90 @@ START_TEST(test_SBML_parseL3Formula_named_lambda_arguments7)
 END_TEST
 
 
+#if (__cplusplus >= 201103L)
+
+static const char* threadFormulas[] =
+{
+  "x + y * 3",
+  "piecewise(k1 * S, S > 0.5, 0)",
+  "(1/2) + 4.5e-3 mL",
+  "-(a - b) ^ 2 && c || !d",
+  "log(2, x) + sqrt(y)",
+  "f(x, g(y, z))"
+};
+static const size_t numThreadFormulas =
+                      sizeof(threadFormulas) / sizeof(threadFormulas[0]);
+
+
+/*
+ * Parses the formulas repeatedly, checking each result against the
+ * expected infix, and checks that the last error is that of this thread.
+ */
+static void
+parseInThread(const std::vector<std::string>* expected, unsigned int* failures)
+{
+  for (unsigned int n = 0; n < 200; ++n)
+  {
+    for (size_t i = 0; i < numThreadFormulas; ++i)
+    {
+      ASTNode_t* r = SBML_parseL3Formula(threadFormulas[i]);
+      char* infix = SBML_formulaToL3String(r);
+      if (infix == NULL || (*expected)[i] != infix) ++(*failures);
+      safe_free(infix);
+      ASTNode_free(r);
+    }
+
+    ASTNode_t* r = SBML_parseL3Formula("1 +* 2");
+    char* error = SBML_getLastParseL3Error();
+    if (r != NULL || strstr(error, "'1 +* 2'") == NULL) ++(*failures);
+    safe_free(error);
+  }
+}
+
+
+START_TEST (test_SBML_parseL3Formula_threads)
+{
+  std::vector<std::string> expected;
+  for (size_t i = 0; i < numThreadFormulas; ++i)
+  {
+    ASTNode_t* r = SBML_parseL3Formula(threadFormulas[i]);
+    char* infix = SBML_formulaToL3String(r);
+    fail_unless(infix != NULL);
+    expected.push_back(infix);
+    safe_free(infix);
+    ASTNode_free(r);
+  }
+
+  const size_t numThreads = 8;
+  std::vector<unsigned int> failures(numThreads, 0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    threads.push_back(std::thread(parseInThread, &expected, &failures[t]));
+  }
+
+  /* the error of a parse is not affected by other threads */
+  ASTNode_t* r = SBML_parseL3Formula("2 2");
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    threads[t].join();
+  }
+
+  char* error = SBML_getLastParseL3Error();
+  fail_unless(r == NULL);
+  fail_unless(!strcmp(error, "Error when parsing input '2 2' at position 3:  syntax error, unexpected integer"));
+  safe_free(error);
+
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    fail_unless(failures[t] == 0);
+  }
+}
+END_TEST
+
+#endif
+
+
 Suite *
 create_suite_L3FormulaParser (void) 
 { 
@@ -3888,6 +3979,9 @@ create_suite_L3FormulaParser (void)
   tcase_add_test(tcase, test_SBML_parseL3Formula_named_lambda_arguments5);
   tcase_add_test(tcase, test_SBML_parseL3Formula_named_lambda_arguments6);
   tcase_add_test(tcase, test_SBML_parseL3Formula_named_lambda_arguments7);
+#if (__cplusplus >= 201103L)
+  tcase_add_test(tcase, test_SBML_parseL3Formula_threads);
+#endif
 
 
   suite_add_tcase(suite, tcase);
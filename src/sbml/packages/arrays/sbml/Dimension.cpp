@@ -221,7 +221,10 @@ Dimension::isSetArrayDimension() const
 int
 Dimension::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
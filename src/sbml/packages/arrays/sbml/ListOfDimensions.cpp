@@ -191,6 +191,7 @@ ListOfDimensions::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <Dimension*> (item);
@@ -120,7 +120,9 @@ Deletion::setId(const string& id)
   if (!SyntaxChecker::isValidSBMLSId(id)) {
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
   }
+  std::string oldId(mId);
   mId = id;
+  updateIdIndexes(oldId);
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -128,7 +130,9 @@ Deletion::setId(const string& id)
 int 
 Deletion::unsetId()
 {
+  std::string oldId(mId);
   mId = "";
+  updateIdIndexes(oldId);
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -157,7 +157,9 @@ ExternalModelDefinition::setId(const string& id)
   if (!SyntaxChecker::isValidSBMLSId(id)) {
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
   }
+  std::string oldId(mId);
   mId = id;
+  updateIdIndexes(oldId);
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -168,7 +170,9 @@ ExternalModelDefinition::setId(const string& id)
 int 
 ExternalModelDefinition::unsetId()
 {
+  std::string oldId(mId);
   mId = "";
+  updateIdIndexes(oldId);
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -124,6 +124,7 @@ ListOfExternalModelDefinitions::remove (const std::string &sid)
   ListItemIter result = find_if( mItems.begin(), mItems.end(), IdEq<ExternalModelDefinition>(sid) );
   if (result == mItems.end()) return NULL;
 
+  (*result)->removeIdentifiersFromIndex();
   mItems.erase(result);
   return static_cast<ExternalModelDefinition*>(*result);
 }
@@ -125,6 +125,7 @@ ListOfModelDefinitions::remove (const std::string &sid)
   result = find_if( mItems.begin(), mItems.end(), IdEq<ModelDefinition>(sid) );
   if (result == mItems.end()) return NULL;
 
+  (*result)->removeIdentifiersFromIndex();
   mItems.erase(result);
   return static_cast<ModelDefinition*>(*result);
 }
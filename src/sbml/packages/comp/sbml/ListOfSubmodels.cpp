@@ -125,6 +125,7 @@ ListOfSubmodels::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast<Submodel*>(item);
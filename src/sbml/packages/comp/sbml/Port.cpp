@@ -107,7 +107,9 @@ Port::setId (const std::string& id)
     //LS DEBUG return something else
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
   }
+  std::string oldId(mId);
   mId = id;
+  updateIdIndexes(oldId);
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -181,7 +181,9 @@ Submodel::setId (const std::string& id)
   {
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
   }
+  std::string oldId(mId);
   mId = id;
+  updateIdIndexes(oldId);
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -174,7 +174,10 @@ DistribBase::isSetName() const
 int
 DistribBase::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -196,6 +196,7 @@ ListOfUncertParameters::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <UncertParameter*> (item);
@@ -238,7 +238,10 @@ DynElement::setIdRef(const std::string& idRef)
 int
 DynElement::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -861,6 +864,7 @@ ListOfDynElements::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
 	return static_cast <DynElement*> (item);
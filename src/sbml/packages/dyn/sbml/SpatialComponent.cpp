@@ -262,7 +262,10 @@ SpatialComponent::setVariable(const std::string& variable)
 int
 SpatialComponent::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -862,6 +865,7 @@ ListOfSpatialComponents::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
 	return static_cast <SpatialComponent*> (item);
@@ -1065,6 +1065,7 @@ ListOfFbcAssociations::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <FbcAssociation*> (item);
@@ -172,7 +172,10 @@ FluxBound::isSetId () const
 int 
 FluxBound::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id,mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -1137,6 +1140,7 @@ ListOfFluxBounds::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <FluxBound*> (item);
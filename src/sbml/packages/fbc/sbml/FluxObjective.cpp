@@ -230,7 +230,10 @@ FluxObjective::isSetCoefficient() const
 int
 FluxObjective::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -1148,6 +1151,7 @@ ListOfFluxObjectives::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <FluxObjective*> (item);
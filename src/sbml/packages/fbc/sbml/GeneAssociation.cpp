@@ -247,7 +247,10 @@ GeneAssociation::isSetId () const
 int 
 GeneAssociation::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id ,mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -660,6 +663,7 @@ ListOfGeneAssociations::remove (const std::string& symbol)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <GeneAssociation*> (item);
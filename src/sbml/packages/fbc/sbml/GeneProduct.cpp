@@ -222,7 +222,10 @@ GeneProduct::isSetAssociatedSpecies() const
 int
 GeneProduct::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -1146,6 +1149,7 @@ ListOfGeneProducts::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <GeneProduct*> (item);
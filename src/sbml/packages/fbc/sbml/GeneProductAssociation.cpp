@@ -288,7 +288,10 @@ GeneProductAssociation::isSetAssociation() const
 int
 GeneProductAssociation::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -369,7 +369,10 @@ bool BoundingBox::isSetId () const
   */
 int BoundingBox::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id,mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
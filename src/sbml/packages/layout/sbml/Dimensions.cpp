@@ -209,7 +209,10 @@ bool Dimensions::isSetId () const
   */
 int Dimensions::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id,mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -391,7 +391,10 @@ int GraphicalObject::setId(const std::string& id)
 {
   if (id.empty())
     return unsetId();
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -1190,6 +1193,7 @@ ListOfGraphicalObjects::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <GraphicalObject*> (item);
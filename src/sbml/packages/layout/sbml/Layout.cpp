@@ -453,7 +453,10 @@ bool Layout::isSetName () const
   */
 int Layout::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id,mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 int Layout::setName (const std::string& name)
@@ -1996,6 +1999,7 @@ ListOfLayouts::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <Layout*> (item);
@@ -2178,6 +2182,7 @@ ListOfCompartmentGlyphs::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <CompartmentGlyph*> (item);
@@ -2330,6 +2335,7 @@ ListOfSpeciesGlyphs::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <SpeciesGlyph*> (item);
@@ -2502,6 +2508,7 @@ ListOfReactionGlyphs::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <ReactionGlyph*> (item);
@@ -2651,6 +2658,7 @@ ListOfTextGlyphs::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <TextGlyph*> (item);
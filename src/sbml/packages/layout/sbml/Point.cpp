@@ -227,7 +227,10 @@ bool Point::isSetId () const
   */
 int Point::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id,mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
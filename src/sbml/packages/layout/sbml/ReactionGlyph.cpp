@@ -961,6 +961,7 @@ ListOfSpeciesReferenceGlyphs::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <SpeciesReferenceGlyph*> (item);
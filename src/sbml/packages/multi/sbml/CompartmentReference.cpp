@@ -188,7 +188,10 @@ CompartmentReference::isSetCompartment() const
 int
 CompartmentReference::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -693,6 +696,7 @@ ListOfCompartmentReferences::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <CompartmentReference*> (item);
@@ -212,7 +212,10 @@ InSpeciesTypeBond::isSetBindingSite2() const
 int
 InSpeciesTypeBond::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -793,6 +796,7 @@ ListOfInSpeciesTypeBonds::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <InSpeciesTypeBond*> (item);
@@ -222,7 +222,10 @@ MultiSpeciesType::isSetCompartment() const
 int
 MultiSpeciesType::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -1577,6 +1580,7 @@ ListOfMultiSpeciesTypes::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <MultiSpeciesType*> (item);
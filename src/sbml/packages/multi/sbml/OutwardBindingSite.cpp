@@ -204,7 +204,10 @@ OutwardBindingSite::isSetComponent() const
 int
 OutwardBindingSite::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -793,6 +796,7 @@ ListOfOutwardBindingSites::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <OutwardBindingSite*> (item);
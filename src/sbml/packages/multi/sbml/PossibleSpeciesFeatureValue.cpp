@@ -188,7 +188,10 @@ PossibleSpeciesFeatureValue::isSetNumericValue() const
 int
 PossibleSpeciesFeatureValue::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -691,6 +694,7 @@ ListOfPossibleSpeciesFeatureValues::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <PossibleSpeciesFeatureValue*> (item);
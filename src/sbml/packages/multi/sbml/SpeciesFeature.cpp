@@ -252,7 +252,10 @@ SpeciesFeature::isSetComponent() const
 int
 SpeciesFeature::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -1179,6 +1182,7 @@ ListOfSpeciesFeatures::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <SpeciesFeature*> (item);
@@ -209,7 +209,10 @@ SpeciesFeatureType::isSetOccur() const
 int
 SpeciesFeatureType::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -951,6 +954,7 @@ ListOfSpeciesFeatureTypes::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <SpeciesFeatureType*> (item);
@@ -538,6 +538,7 @@ ListOfSpeciesFeatureValues::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <SpeciesFeatureValue*> (item);
@@ -209,7 +209,10 @@ SpeciesTypeComponentIndex::isSetIdentifyingParent() const
 int
 SpeciesTypeComponentIndex::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -812,6 +815,7 @@ ListOfSpeciesTypeComponentIndexes::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <SpeciesTypeComponentIndex*> (item);
@@ -230,7 +230,10 @@ SpeciesTypeComponentMapInProduct::isSetProductComponent() const
 int
 SpeciesTypeComponentMapInProduct::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -881,6 +884,7 @@ ListOfSpeciesTypeComponentMapInProducts::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <SpeciesTypeComponentMapInProduct*> (item);
@@ -212,7 +212,10 @@ SpeciesTypeInstance::isSetCompartmentReference() const
 int
 SpeciesTypeInstance::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -806,6 +809,7 @@ ListOfSpeciesTypeInstances::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <SpeciesTypeInstance*> (item);
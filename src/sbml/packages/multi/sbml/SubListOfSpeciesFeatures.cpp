@@ -156,7 +156,10 @@ SubListOfSpeciesFeatures::isSetName() const
 int
 SubListOfSpeciesFeatures::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -357,6 +360,7 @@ SubListOfSpeciesFeatures::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <SpeciesFeature*> (item);
@@ -989,6 +989,7 @@ ListOfFunctionTerms::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <FunctionTerm*> (item);
@@ -280,7 +280,10 @@ QualitativeSpecies::isSetMaxLevel() const
 int
 QualitativeSpecies::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -1296,6 +1299,7 @@ ListOfQualitativeSpecies::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <QualitativeSpecies*> (item);
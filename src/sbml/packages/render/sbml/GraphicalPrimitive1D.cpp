@@ -377,7 +377,10 @@ bool GraphicalPrimitive1D::isSetDashArray() const
 int
 GraphicalPrimitive1D::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
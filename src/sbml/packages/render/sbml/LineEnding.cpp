@@ -340,7 +340,10 @@ LineEnding::isSetEnableRotationalMapping() const
 int
 LineEnding::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -235,6 +235,7 @@ ListOfColorDefinitions::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <ColorDefinition*> (item);
@@ -264,6 +264,7 @@ ListOfCurveElements::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <RenderPoint*> (item);
@@ -201,6 +201,7 @@ ListOfDrawables::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <Transformation2D*> (item);
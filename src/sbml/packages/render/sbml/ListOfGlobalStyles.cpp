@@ -223,6 +223,7 @@ ListOfGlobalStyles::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <GlobalStyle*> (item);
@@ -245,6 +245,7 @@ ListOfGradientDefinitions::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <GradientBase*> (item);
@@ -244,6 +244,7 @@ ListOfGradientStops::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <GradientStop*> (item);
@@ -522,6 +522,7 @@ ListOfLocalRenderInformation::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <LocalRenderInformation*> (item);
@@ -412,7 +412,10 @@ RenderInformationBase::isSetBackgroundColor() const
 int
 RenderInformationBase::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
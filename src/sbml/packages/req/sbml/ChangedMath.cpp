@@ -223,7 +223,10 @@ ChangedMath::isSetViableWithoutChange() const
 int
 ChangedMath::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -744,6 +747,7 @@ ListOfChangedMaths::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <ChangedMath*> (item);
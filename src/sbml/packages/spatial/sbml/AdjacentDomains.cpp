@@ -220,7 +220,10 @@ AdjacentDomains::isSetDomain2() const
 int
 AdjacentDomains::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
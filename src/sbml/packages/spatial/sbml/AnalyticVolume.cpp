@@ -284,7 +284,10 @@ AnalyticVolume::isSetDomainType() const
 int
 AnalyticVolume::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -225,7 +225,10 @@ CompartmentMapping::isSetUnitSize() const
 int
 CompartmentMapping::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
@@ -211,7 +211,10 @@ GeometryDefinition::isSetIsActive() const
 int
 GeometryDefinition::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  std::string oldId(mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateIdIndexes(oldId);
+  return result;
 }
 
 
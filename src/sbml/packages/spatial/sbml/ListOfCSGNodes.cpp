@@ -202,6 +202,7 @@ ListOfCSGNodes::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <CSGNode*> (item);
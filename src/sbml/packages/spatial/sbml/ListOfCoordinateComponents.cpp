@@ -199,6 +199,7 @@ ListOfCoordinateComponents::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <CoordinateComponent*> (item);
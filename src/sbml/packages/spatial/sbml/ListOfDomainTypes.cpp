@@ -192,6 +192,7 @@ ListOfDomainTypes::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <DomainType*> (item);
@@ -190,6 +190,7 @@ ListOfDomains::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <Domain*> (item);
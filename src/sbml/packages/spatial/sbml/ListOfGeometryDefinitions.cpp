@@ -209,6 +209,7 @@ ListOfGeometryDefinitions::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <GeometryDefinition*> (item);
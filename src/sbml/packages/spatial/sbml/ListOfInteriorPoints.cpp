@@ -193,6 +193,7 @@ ListOfInteriorPoints::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <InteriorPoint*> (item);
@@ -195,6 +195,7 @@ ListOfOrdinalMappings::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <OrdinalMapping*> (item);
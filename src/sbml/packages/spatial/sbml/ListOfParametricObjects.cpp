@@ -197,6 +197,7 @@ ListOfParametricObjects::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <ParametricObject*> (item);
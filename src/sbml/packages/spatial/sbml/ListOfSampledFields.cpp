@@ -193,6 +193,7 @@ ListOfSampledFields::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <SampledField*> (item);
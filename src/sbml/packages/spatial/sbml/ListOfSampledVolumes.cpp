@@ -193,6 +193,7 @@ ListOfSampledVolumes::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    item->removeIdentifiersFromIndex();
   }
 
   return static_cast <SampledVolume*> (item);
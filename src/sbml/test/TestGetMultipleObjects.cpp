@@ -499,6 +499,200 @@ START_TEST (test_GetMultipleObjects_withFilter)
 }
 END_TEST
 
+START_TEST (test_GetMultipleObjects_idIndex)
+{
+  SBMLReader        reader;
+  SBMLDocument*     d;
+
+  std::string filename(TestDataDirectory);
+  filename += "multiple-ids.xml";
+
+
+  d = reader.readSBML(filename);
+
+  if (d->getModel() == NULL)
+  {
+    fail("readSBML(\"multiple-ids.xml\") returned an empty model.");
+  }
+
+  fail_unless(d->isIdIndexEnabled() == false);
+  fail_unless(d->getNumIdIndexLookups() == 0);
+
+  // every lookup answers the same with and without the index
+  List* list = d->getAllElements();
+  for (unsigned int n = 0; n < list->getSize(); n++)
+  {
+    SBase* element = static_cast<SBase*>(list->get(n));
+
+    d->setIdIndexEnabled(false);
+    SBase* bySId = d->getElementBySId(element->getId());
+    SBase* byMetaId = d->getElementByMetaId(element->getMetaId());
+    SBase* inModel = d->getModel()->getElementBySId(element->getId());
+
+    d->setIdIndexEnabled(true);
+    fail_unless(d->getElementBySId(element->getId()) == bySId);
+    fail_unless(d->getElementByMetaId(element->getMetaId()) == byMetaId);
+    fail_unless(d->getModel()->getElementBySId(element->getId()) == inModel);
+  }
+  delete list;
+
+  fail_unless(d->getNumIdIndexLookups() > 0);
+  fail_unless(d->getNumIdIndexHits() > 0);
+  fail_unless(d->getNumIdIndexBuilds() == 1);
+
+  // "x" is both a parameter and a local parameter
+  SBase* obj = d->getElementBySId("x");
+  fail_unless(obj != NULL);
+  fail_unless(obj->getTypeCode() == SBML_PARAMETER);
+  obj = d->getElementBySId("volume");
+  fail_unless(obj == NULL);
+  obj = d->getElementByMetaId("meta28");
+  fail_unless(obj != NULL);
+  fail_unless(obj->getTypeCode() == SBML_LOCAL_PARAMETER);
+
+  // the index follows changes to the document without being rebuilt
+  d->getModel()->getParameter("x")->setId("y");
+  fail_unless(d->getElementBySId("y") == d->getModel()->getParameter("y"));
+  fail_unless(d->getElementBySId("x") == NULL);
+
+  d->getModel()->getSpecies("b")->setMetaId("newmeta");
+  fail_unless(d->getElementByMetaId("newmeta") == d->getModel()->getSpecies("b"));
+  fail_unless(d->getElementByMetaId("meta6") == NULL);
+
+  delete d->getModel()->removeSpecies("b");
+  fail_unless(d->getElementBySId("b") == NULL);
+  fail_unless(d->getElementByMetaId("newmeta") == NULL);
+
+  Parameter* p = d->getModel()->createParameter();
+  p->setId("new_param");
+  fail_unless(d->getElementBySId("new_param") == p);
+
+  Species* s = d->getModel()->getSpecies(0);
+  std::string sid = s->getId();
+  s = d->getModel()->removeSpecies(sid);
+  fail_unless(d->getElementBySId(sid) == NULL);
+  d->getModel()->addSpecies(s);
+  delete s;
+  fail_unless(d->getElementBySId(sid) == d->getModel()->getSpecies(sid));
+  fail_unless(d->getNumIdIndexBuilds() == 1);
+
+  // lookups made while the index is enabled are counted
+  unsigned long lookups = d->getNumIdIndexLookups();
+  d->setIdIndexEnabled(false);
+  fail_unless(d->getElementBySId("new_param") == p);
+  fail_unless(d->getNumIdIndexLookups() == lookups);
+
+  // an element removed from the document leaves the index at once
+  s = d->getModel()->removeSpecies(sid);
+  s->setId("renamed");
+  fail_unless(d->getElementBySId("renamed") == NULL);
+  delete s;
+  fail_unless(d->getElementBySId(sid) == NULL);
+
+  delete d;
+}
+END_TEST
+
+START_TEST (test_GetMultipleObjects_idIndexAssignment)
+{
+  SBMLReader        reader;
+  SBMLDocument*     d;
+
+  std::string filename(TestDataDirectory);
+  filename += "multiple-ids.xml";
+
+
+  d = reader.readSBML(filename);
+
+  if (d->getModel() == NULL)
+  {
+    fail("readSBML(\"multiple-ids.xml\") returned an empty model.");
+  }
+
+  d->setIdIndexEnabled(true);
+  Parameter* p = d->getModel()->getParameter("x");
+  fail_unless(d->getElementBySId("x") == p);
+
+  // an assignment renames the element in its own document
+  Parameter other(*p);
+  other.setId("assigned");
+  other.setMetaId("assigned_meta");
+  *p = other;
+  fail_unless(d->getElementBySId("assigned") == p);
+  fail_unless(d->getElementByMetaId("assigned_meta") == p);
+  fail_unless(d->getElementBySId("x") == NULL);
+  fail_unless(d->getModel()->getParameter("assigned") == p);
+  fail_unless(d->getModel()->getParameter("x") == NULL);
+
+  // whatever the element assigned from
+  Parameter detached(3, 1);
+  detached.setId("detached");
+  *p = detached;
+  fail_unless(d->getElementBySId("detached") == p);
+  fail_unless(d->getElementBySId("assigned") == NULL);
+  fail_unless(d->getElementByMetaId("assigned_meta") == NULL);
+  fail_unless(d->getModel()->getParameter("detached") == p);
+
+  // and unsetting the identifier of the model is followed
+  Model* m = d->getModel();
+  fail_unless(d->getElementBySId("find_id") == m);
+  m->unsetId();
+  fail_unless(d->getElementBySId("find_id") == NULL);
+  m->setId("renamed_model");
+  fail_unless(d->getElementBySId("renamed_model") == m);
+  fail_unless(d->getNumIdIndexBuilds() == 1);
+
+  delete d;
+}
+END_TEST
+
+
+START_TEST (test_GetMultipleObjects_idIndexClear)
+{
+  SBMLReader        reader;
+  SBMLDocument*     d;
+
+  std::string filename(TestDataDirectory);
+  filename += "multiple-ids.xml";
+
+
+  d = reader.readSBML(filename);
+
+  if (d->getModel() == NULL)
+  {
+    fail("readSBML(\"multiple-ids.xml\") returned an empty model.");
+  }
+
+  d->setIdIndexEnabled(true);
+  ListOfParameters* lo = d->getModel()->getListOfParameters();
+  Parameter* x = d->getModel()->getParameter("x");
+  fail_unless(d->getElementBySId("x") == x);
+  fail_unless(d->getElementBySId("C") != NULL);
+
+  // the items of a list cleared without deleting them may be deleted by
+  // the caller before or after the list is cleared
+  std::vector<SBase*> items;
+  for (unsigned int i = 0; i < lo->size(); ++i)
+  {
+    if (lo->get(i) != x) items.push_back(lo->get(i));
+  }
+  for (size_t i = 0; i < items.size(); ++i)
+  {
+    delete items[i];
+  }
+  lo->clear(false);
+  fail_unless(d->getElementBySId("x") == NULL);
+  fail_unless(d->getElementByMetaId("meta18") == NULL);
+  fail_unless(d->getElementBySId("C") == NULL);
+  fail_unless(d->getElementBySId("find_id") == d->getModel());
+  fail_unless(d->getNumIdIndexBuilds() == 2);
+  delete x;
+
+  delete d;
+}
+END_TEST
+
+
 Suite *
 create_suite_GetMultipleObjects (void)
 {
@@ -513,6 +707,9 @@ create_suite_GetMultipleObjects (void)
   tcase_add_test(tcase, test_GetMultipleObjects_noAssignments);
   tcase_add_test(tcase, test_GetMultipleObjects_allElements);
   tcase_add_test(tcase, test_GetMultipleObjects_withFilter);
+  tcase_add_test(tcase, test_GetMultipleObjects_idIndex);
+  tcase_add_test(tcase, test_GetMultipleObjects_idIndexAssignment);
+  tcase_add_test(tcase, test_GetMultipleObjects_idIndexClear);
 
 
   suite_add_tcase(suite, tcase);
@@ -46,6 +46,7 @@
 #include <sbml/Species.h>
 #include <sbml/Compartment.h>
 #include <sbml/Model.h>
+#include <sbml/SBMLDocument.h>
 
 #include <check.h>
 
@@ -316,6 +317,128 @@ START_TEST(test_ListOf_sort_rules)
 END_TEST
 
 
+START_TEST(test_ListOf_idIndex)
+{
+  SBMLDocument *d = new SBMLDocument(3, 2);
+  Model *m = d->createModel();
+
+  fail_unless( d->isIdIndexEnabled() == false );
+  d->setIdIndexEnabled(true);
+  fail_unless( d->isIdIndexEnabled() == true );
+
+  char id[16];
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    sprintf(id, "s%u", i);
+    Species *s = m->createSpecies();
+    s->setId(id);
+  }
+
+  fail_unless( m->getNumSpecies() == 100 );
+  fail_unless( m->getSpecies("s0") == m->getSpecies(0) );
+  fail_unless( m->getSpecies("s57") == m->getSpecies(57) );
+  fail_unless( m->getSpecies("s99") == m->getSpecies(99) );
+  fail_unless( m->getSpecies("s100") == NULL );
+
+  // append after the index has been built
+  Species *s = m->createSpecies();
+  fail_unless( m->getSpecies("s100") == NULL );
+  s->setId("s100");
+  fail_unless( m->getSpecies("s100") == s );
+
+  // rename and unset
+  Species *renamed = m->getSpecies(10);
+  renamed->setId("renamed");
+  fail_unless( m->getSpecies("s10") == NULL );
+  fail_unless( m->getSpecies("renamed") == renamed );
+  m->getSpecies(11)->unsetId();
+  fail_unless( m->getSpecies("s11") == NULL );
+  m->getSpecies(11)->setId("s11");
+  fail_unless( m->getSpecies("s11") == m->getSpecies(11) );
+
+  // duplicate ids resolve to the first item
+  m->getSpecies(20)->setId("s5");
+  fail_unless( m->getSpecies("s5") == m->getSpecies(5) );
+  m->getSpecies(20)->setId("s20");
+
+  // remove and insert
+  Species *removed = m->removeSpecies("s30");
+  fail_unless( removed != NULL );
+  fail_unless( removed->getId() == "s30" );
+  fail_unless( m->getSpecies("s30") == NULL );
+  fail_unless( m->getSpecies("s31") == m->getSpecies(30) );
+  m->getListOfSpecies()->insertAndOwn(0, removed);
+  fail_unless( m->getSpecies("s30") == m->getSpecies(0) );
+  fail_unless( m->getSpecies("s31") == m->getSpecies(31) );
+
+  // disabling falls back to a linear search
+  d->setIdIndexEnabled(false);
+  fail_unless( m->getSpecies("s99") == m->getSpecies(99) );
+  fail_unless( m->getSpecies("renamed") == renamed );
+
+  delete d;
+}
+END_TEST
+
+
+START_TEST(test_ListOf_idIndex_removeInsert)
+{
+  SBMLDocument *d = new SBMLDocument(3, 2);
+  Model *m = d->createModel();
+  d->setIdIndexEnabled(true);
+
+  char id[16];
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    sprintf(id, "p%u", i);
+    m->createParameter()->setId(id);
+  }
+  fail_unless( m->getParameter("p99") == m->getParameter(99) );
+
+  // removing by id keeps the positions of the remaining items
+  for (unsigned int i = 0; i < 100; i += 2)
+  {
+    sprintf(id, "p%u", i);
+    delete m->removeParameter(id);
+  }
+  fail_unless( m->getNumParameters() == 50 );
+  for (unsigned int i = 1; i < 100; i += 2)
+  {
+    sprintf(id, "p%u", i);
+    fail_unless( m->getParameter(id) == m->getParameter(i / 2) );
+  }
+  fail_unless( m->getParameter("p0") == NULL );
+
+  // inserting in the middle moves the items after it
+  Parameter *p = new Parameter(3, 2);
+  p->setId("inserted");
+  m->getListOfParameters()->insertAndOwn(10, p);
+  fail_unless( m->getParameter("inserted") == m->getParameter(10) );
+  fail_unless( m->getParameter("p19") == m->getParameter(9) );
+  fail_unless( m->getParameter("p21") == m->getParameter(11) );
+  fail_unless( m->getParameter("p99") == m->getParameter(50) );
+
+  // an item inserted before another with the same id comes first
+  p = new Parameter(3, 2);
+  p->setId("p21");
+  m->getListOfParameters()->insertAndOwn(5, p);
+  fail_unless( m->getParameter("p21") == p );
+  delete m->removeParameter("p21");
+  fail_unless( m->getParameter("p21") == m->getParameter(11) );
+
+  // items without an id move too
+  p = new Parameter(3, 2);
+  m->getListOfParameters()->insertAndOwn(0, p);
+  delete m->removeParameter(3);
+  p->setId("late");
+  fail_unless( m->getParameter("late") == m->getParameter(0) );
+  fail_unless( m->getParameter("p99") == m->getParameter(50) );
+
+  delete d;
+}
+END_TEST
+
+
 
 
 Suite *
@@ -333,6 +456,8 @@ create_suite_ListOf (void)
   tcase_add_test(tcase, test_ListOf_sort      );
   tcase_add_test(tcase, test_ListOf_sort_meta );
   tcase_add_test(tcase, test_ListOf_sort_rules);
+  tcase_add_test(tcase, test_ListOf_idIndex   );
+  tcase_add_test(tcase, test_ListOf_idIndex_removeInsert);
 
   suite_add_tcase(suite, tcase);
 
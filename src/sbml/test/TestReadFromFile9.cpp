@@ -436,6 +436,374 @@ START_TEST (test_read_l3v1_new)
 END_TEST
 
 
+START_TEST (test_read_l3v1_new_memory_map)
+{
+  SBMLReader reader;
+
+  std::string filename(TestDataDirectory);
+  filename += "l3v1-new-invalid.xml";
+
+  fail_unless( reader.getUseMemoryMap() == false );
+  fail_unless( reader.setUseMemoryMap(true) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( reader.getUseMemoryMap() == true );
+
+  SBMLDocument* mapped = reader.readSBML(filename);
+
+  reader.setUseMemoryMap(false);
+  SBMLDocument* streamed = reader.readSBML(filename);
+
+  fail_unless( mapped   != NULL );
+  fail_unless( streamed != NULL );
+
+  fail_unless( mapped->getNumErrors() == streamed->getNumErrors() );
+  fail_unless( mapped->getModel() != NULL );
+  fail_unless( mapped->getModel()->getNumEvents() == 2 );
+
+  char* mappedXML   = writeSBMLToString(mapped);
+  char* streamedXML = writeSBMLToString(streamed);
+
+  fail_unless( strcmp(mappedXML, streamedXML) == 0 );
+
+  safe_free(mappedXML);
+  safe_free(streamedXML);
+  delete mapped;
+  delete streamed;
+}
+END_TEST
+
+
+START_TEST (test_read_memory_map_missing_file)
+{
+  SBMLReader_t* reader = SBMLReader_create();
+
+  fail_unless( SBMLReader_setUseMemoryMap(reader, 1) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( SBMLReader_getUseMemoryMap(reader) == 1 );
+  fail_unless( SBMLReader_setUseMemoryMap(NULL, 1) == LIBSBML_INVALID_OBJECT );
+  fail_unless( SBMLReader_getUseMemoryMap(NULL) == 0 );
+
+  std::string filename(TestDataDirectory);
+  filename += "no-such-file.xml";
+
+  SBMLDocument_t* d = SBMLReader_readSBML(reader, filename.c_str());
+
+  fail_unless( d != NULL );
+  fail_unless( SBMLDocument_getNumErrors(d) == 1 );
+  fail_unless( XMLError_getErrorId((const XMLError_t*)
+               SBMLDocument_getError(d, 0)) == XMLFileUnreadable );
+
+  SBMLDocument_free(d);
+  SBMLReader_free(reader);
+}
+END_TEST
+
+
+START_TEST (test_read_l3v1_new_chunk_size)
+{
+  SBMLReader reader;
+
+  std::string filename(TestDataDirectory);
+  filename += "l3v1-new-invalid.xml";
+
+  fail_unless( reader.getChunkSize() == 0 );
+  fail_unless( reader.setChunkSize(2000000000) == LIBSBML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( reader.getChunkSize() == 0 );
+
+  SBMLDocument* expected    = reader.readSBML(filename);
+  char*         expectedXML = writeSBMLToString(expected);
+
+  // chunk boundaries fall inside names, attribute values and character
+  // references; the document read must not depend on them
+  const unsigned int sizes[] = { 1, 7, 100, 4096, 1048576 };
+
+  for (unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+  {
+    for (int mapped = 0; mapped < 2; ++mapped)
+    {
+      fail_unless( reader.setChunkSize(sizes[i]) == LIBSBML_OPERATION_SUCCESS );
+      fail_unless( reader.getChunkSize() == sizes[i] );
+      reader.setUseMemoryMap(mapped != 0);
+
+      SBMLDocument* d   = reader.readSBML(filename);
+      char*         xml = writeSBMLToString(d);
+
+      fail_unless( d->getNumErrors() == expected->getNumErrors() );
+      fail_unless( strcmp(xml, expectedXML) == 0 );
+
+      safe_free(xml);
+      delete d;
+    }
+  }
+
+  SBMLReader_t* sr = SBMLReader_create();
+
+  fail_unless( SBMLReader_setChunkSize(sr, 65536) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( SBMLReader_getChunkSize(sr) == 65536 );
+  fail_unless( SBMLReader_setChunkSize(NULL, 65536) == LIBSBML_INVALID_OBJECT );
+  fail_unless( SBMLReader_getChunkSize(NULL) == 0 );
+
+  SBMLReader_free(sr);
+  safe_free(expectedXML);
+  delete expected;
+}
+END_TEST
+
+
+static const char* DEFERRED_XML =
+  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+  "<sbml xmlns=\"http://www.sbml.org/sbml/level3/version1/core\" level=\"3\""
+  " version=\"1\" xmlns:ex=\"http://example.org/ns\">\n"
+  "  <model id=\"m\">\n"
+  "    <listOfCompartments>\n"
+  "      <compartment metaid=\"_c\" id=\"c\" constant=\"true\">\n"
+  "        <notes>\n"
+  "          <body xmlns=\"http://www.w3.org/1999/xhtml\">\n"
+  "            <p>A compartment &amp; its &lt;contents&gt;</p>\n"
+  "          </body>\n"
+  "        </notes>\n"
+  "        <annotation>\n"
+  "          <ex:info ex:value=\"1\"> text </ex:info>\n"
+  "          <rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\""
+  " xmlns:bqbiol=\"http://biomodels.net/biology-qualifiers/\">\n"
+  "            <rdf:Description rdf:about=\"#_c\">\n"
+  "              <bqbiol:is>\n"
+  "                <rdf:Bag>\n"
+  "                  <rdf:li rdf:resource=\"urn:miriam:go:GO%3A0005623\"/>\n"
+  "                </rdf:Bag>\n"
+  "              </bqbiol:is>\n"
+  "            </rdf:Description>\n"
+  "          </rdf:RDF>\n"
+  "        </annotation>\n"
+  "      </compartment>\n"
+  "    </listOfCompartments>\n"
+  "    <listOfSpecies>\n"
+  "      <species metaid=\"_s\" id=\"s\" compartment=\"c\""
+  " hasOnlySubstanceUnits=\"false\" boundaryCondition=\"false\""
+  " constant=\"false\">\n"
+  "        <annotation>\n"
+  "          <rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\""
+  " xmlns:bqbiol=\"http://biomodels.net/biology-qualifiers/\">\n"
+  "            <rdf:Description rdf:about=\"#_other\">\n"
+  "              <bqbiol:is>\n"
+  "                <rdf:Bag>\n"
+  "                  <rdf:li rdf:resource=\"urn:miriam:chebi:CHEBI%3A17234\"/>\n"
+  "                </rdf:Bag>\n"
+  "              </bqbiol:is>\n"
+  "            </rdf:Description>\n"
+  "          </rdf:RDF>\n"
+  "        </annotation>\n"
+  "      </species>\n"
+  "    </listOfSpecies>\n"
+  "  </model>\n"
+  "</sbml>\n";
+
+
+START_TEST (test_read_defer_annotations)
+{
+  SBMLReader reader;
+
+  SBMLDocument* eager = reader.readSBMLFromString(DEFERRED_XML);
+  char*         eagerXML = writeSBMLToString(eager);
+
+  fail_unless( reader.getDeferAnnotations() == false );
+  fail_unless( reader.setDeferAnnotations(true) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( reader.getDeferAnnotations() == true );
+
+  // the error in the RDF of the species is only logged once it is used
+  SBMLDocument* d = reader.readSBMLFromString(DEFERRED_XML);
+  fail_unless( eager->getNumErrors() > 0 );
+  fail_unless( d->getNumErrors() == eager->getNumErrors() - 1 );
+
+  SBMLDocument* copy = d->clone();
+
+  Species* s = d->getModel()->getSpecies(0);
+  fail_unless( s->getNumCVTerms() == eager->getModel()->getSpecies(0)->getNumCVTerms() );
+  fail_unless( d->getNumErrors() == eager->getNumErrors() );
+
+  // namespaces declared on the <sbml> element still apply
+  Compartment* c = d->getModel()->getCompartment(0);
+  fail_unless( c->getNumCVTerms() == 1 );
+  fail_unless( c->getCVTerm(0)->getResourceURI(0) == "urn:miriam:go:GO%3A0005623" );
+  fail_unless( c->getAnnotation()->getChild(0).getName() == "info" );
+  fail_unless( c->getAnnotation()->getChild(0).getURI() == "http://example.org/ns" );
+  fail_unless( c->getAnnotation()->getNamespaces().getLength() == 0 );
+  fail_unless( c->getNotesString() ==
+               eager->getModel()->getCompartment(0)->getNotesString() );
+  fail_unless( c->getAnnotationString() ==
+               eager->getModel()->getCompartment(0)->getAnnotationString() );
+
+  char* xml     = writeSBMLToString(d);
+  char* copyXML = writeSBMLToString(copy);
+
+  fail_unless( strcmp(xml, eagerXML) == 0 );
+  fail_unless( strcmp(copyXML, eagerXML) == 0 );
+
+  safe_free(xml);
+  safe_free(copyXML);
+  delete copy;
+  delete d;
+
+  // a whole document reads the same
+  std::string filename(TestDataDirectory);
+  filename += "l3v1-new-invalid.xml";
+
+  d   = reader.readSBML(filename);
+  xml = writeSBMLToString(d);
+
+  reader.setDeferAnnotations(false);
+  SBMLDocument* expected    = reader.readSBML(filename);
+  char*         expectedXML = writeSBMLToString(expected);
+
+  fail_unless( strcmp(xml, expectedXML) == 0 );
+  fail_unless( d->getNumErrors() == expected->getNumErrors() );
+
+  safe_free(xml);
+  safe_free(expectedXML);
+  delete expected;
+  delete d;
+
+  SBMLReader_t* sr = SBMLReader_create();
+
+  fail_unless( SBMLReader_setDeferAnnotations(sr, 1) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( SBMLReader_getDeferAnnotations(sr) == 1 );
+  fail_unless( SBMLReader_setDeferAnnotations(NULL, 1) == LIBSBML_INVALID_OBJECT );
+  fail_unless( SBMLReader_getDeferAnnotations(NULL) == 0 );
+
+  SBMLReader_free(sr);
+  safe_free(eagerXML);
+  delete eager;
+}
+END_TEST
+
+
+static const char* FILTERED_XML =
+  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+  "<sbml xmlns=\"http://www.sbml.org/sbml/level3/version1/core\" level=\"3\""
+  " version=\"1\" xmlns:ex=\"http://www.sbml.org/sbml/level3/version1/ex/version1\""
+  " ex:required=\"false\">\n"
+  "  <model id=\"m\">\n"
+  "    <listOfCompartments>\n"
+  "      <compartment id=\"c\" constant=\"true\">\n"
+  "        <notes>\n"
+  "          <body xmlns=\"http://www.w3.org/1999/xhtml\"><p>c</p></body>\n"
+  "        </notes>\n"
+  "      </compartment>\n"
+  "    </listOfCompartments>\n"
+  "    <listOfSpecies>\n"
+  "      <species id=\"s1\" compartment=\"c\" hasOnlySubstanceUnits=\"false\""
+  " boundaryCondition=\"false\" constant=\"false\">\n"
+  "        <notes>\n"
+  "          <body xmlns=\"http://www.w3.org/1999/xhtml\"><p>s1</p></body>\n"
+  "        </notes>\n"
+  "      </species>\n"
+  "      <species id=\"s2\" compartment=\"c\" hasOnlySubstanceUnits=\"false\""
+  " boundaryCondition=\"false\" constant=\"false\"/>\n"
+  "    </listOfSpecies>\n"
+  "    <listOfReactions>\n"
+  "      <reaction id=\"r\" reversible=\"false\" fast=\"false\">\n"
+  "        <listOfReactants>\n"
+  "          <speciesReference species=\"s1\" constant=\"true\"/>\n"
+  "        </listOfReactants>\n"
+  "      </reaction>\n"
+  "    </listOfReactions>\n"
+  "    <ex:listOfThings>\n"
+  "      <ex:thing ex:id=\"t\"/>\n"
+  "    </ex:listOfThings>\n"
+  "  </model>\n"
+  "</sbml>\n";
+
+
+START_TEST (test_read_skipped_elements)
+{
+  SBMLReader reader;
+  const std::string exURI = "http://www.sbml.org/sbml/level3/version1/ex/version1";
+
+  SBMLDocument* full = reader.readSBMLFromString(FILTERED_XML);
+  fail_unless( full->getModel()->getNumReactions() == 1 );
+  fail_unless( full->getModel()->getSpecies(0)->isSetNotes() == true );
+
+  fail_unless( reader.isSkippedElement("notes") == false );
+  fail_unless( reader.addSkippedElement("") == LIBSBML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( reader.addSkippedPackage("") == LIBSBML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( reader.addSkippedElement("notes") == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( reader.addSkippedElement("listOfReactions") == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( reader.addSkippedPackage(exURI) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( reader.isSkippedElement("notes") == true );
+  fail_unless( reader.isSkippedPackage(exURI) == true );
+  fail_unless( reader.isSkippedPackage("ex") == false );
+
+  SBMLDocument* d = reader.readSBMLFromString(FILTERED_XML);
+  Model* m = d->getModel();
+
+  fail_unless( m->getNumCompartments() == 1 );
+  fail_unless( m->getNumSpecies() == 2 );
+  fail_unless( m->getNumReactions() == 0 );
+  fail_unless( m->getCompartment(0)->isSetNotes() == false );
+  fail_unless( m->getSpecies(0)->isSetNotes() == false );
+
+  // one report for each element name, and nothing else changes
+  fail_unless( d->getNumErrors() == full->getNumErrors() + 3 );
+  fail_unless( d->getErrorLog()->getNumFailsWithSeverity(LIBSBML_SEV_INFO) ==
+               full->getErrorLog()->getNumFailsWithSeverity(LIBSBML_SEV_INFO) + 3 );
+
+  unsigned int n, reports = 0;
+  for (n = 0; n < d->getNumErrors(); ++n)
+  {
+    const SBMLError* e = d->getError(n);
+    if (e->getErrorId() != ElementSkippedWhileReading) continue;
+
+    ++reports;
+    fail_unless( e->getSeverity() == LIBSBML_SEV_INFO );
+    const std::string& msg = e->getMessage();
+    fail_unless( msg.find("Skipped 2 <notes> elements") != std::string::npos
+              || msg.find("Skipped 1 <listOfReactions> element ") != std::string::npos
+              || msg.find("Skipped 1 <listOfThings> (namespace '" + exURI + "') element ")
+                 != std::string::npos );
+  }
+  fail_unless( reports == 3 );
+
+  char* xml = writeSBMLToString(d);
+  fail_unless( strstr(xml, "notes") == NULL );
+  fail_unless( strstr(xml, "listOfReactions") == NULL );
+  fail_unless( strstr(xml, "listOfThings") == NULL );
+  fail_unless( strstr(xml, "s2") != NULL );
+  safe_free(xml);
+  delete d;
+
+  // without filters the document is read in full again
+  fail_unless( reader.clearSkipped() == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( reader.isSkippedElement("notes") == false );
+  d = reader.readSBMLFromString(FILTERED_XML);
+  fail_unless( d->getModel()->getNumReactions() == 1 );
+  fail_unless( d->getNumErrors() == full->getNumErrors() );
+  delete d;
+
+  SBMLReader_t* sr = SBMLReader_create();
+
+  fail_unless( SBMLReader_addSkippedElement(sr, "listOfSpecies") == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( SBMLReader_addSkippedElement(sr, NULL) == LIBSBML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( SBMLReader_addSkippedElement(NULL, "notes") == LIBSBML_INVALID_OBJECT );
+  fail_unless( SBMLReader_addSkippedPackage(sr, "ex") == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( SBMLReader_addSkippedPackage(NULL, "ex") == LIBSBML_INVALID_OBJECT );
+  fail_unless( SBMLReader_isSkippedElement(sr, "listOfSpecies") == 1 );
+  fail_unless( SBMLReader_isSkippedElement(sr, NULL) == 0 );
+  fail_unless( SBMLReader_isSkippedPackage(sr, "ex") == 1 );
+  fail_unless( SBMLReader_isSkippedPackage(NULL, "ex") == 0 );
+
+  d = SBMLReader_readSBMLFromString(sr, FILTERED_XML);
+  fail_unless( d->getModel()->getNumSpecies() == 0 );
+  fail_unless( d->getModel()->getNumReactions() == 1 );
+  delete d;
+
+  fail_unless( SBMLReader_clearSkipped(sr) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( SBMLReader_clearSkipped(NULL) == LIBSBML_INVALID_OBJECT );
+  fail_unless( SBMLReader_isSkippedPackage(sr, "ex") == 0 );
+
+  SBMLReader_free(sr);
+  delete full;
+}
+END_TEST
+
+
 Suite *
 create_suite_TestReadFromFile9 (void)
 { 
@@ -444,6 +812,11 @@ create_suite_TestReadFromFile9 (void)
 
 
   tcase_add_test(tcase, test_read_l3v1_new);
+  tcase_add_test(tcase, test_read_l3v1_new_memory_map);
+  tcase_add_test(tcase, test_read_memory_map_missing_file);
+  tcase_add_test(tcase, test_read_l3v1_new_chunk_size);
+  tcase_add_test(tcase, test_read_defer_annotations);
+  tcase_add_test(tcase, test_read_skipped_elements);
 
   suite_add_tcase(suite, tcase);
 
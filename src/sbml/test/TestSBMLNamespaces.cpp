@@ -43,6 +43,7 @@
 #include <sbml/common/extern.h>
 
 #include <sbml/SBMLNamespaces.h>
+#include <sbml/SBMLTypes.h>
 #include <sbml/xml/XMLNamespaces.h>
 
 #include <check.h>
@@ -262,6 +263,76 @@ START_TEST (test_SBMLNamespaces_invalid)
 END_TEST
 
 
+START_TEST (test_SBMLNamespaces_shared_by_elements)
+{
+  SBMLDocument doc(3, 1);
+  Species*     s  = doc.createModel()->createSpecies();
+  Species*     c1 = s->clone();
+  Species*     c2 = c1->clone();
+
+  // copies of an element share its namespaces, not the document's
+  fail_unless( c1->getSBMLNamespaces() != doc.getSBMLNamespaces() );
+  fail_unless( c2->getSBMLNamespaces() == c1->getSBMLNamespaces() );
+
+  // until one of them is given namespaces of its own
+  XMLNamespaces xmlns;
+  xmlns.add("http://www.sbml.org/sbml/level3/version1/core");
+  xmlns.add("http://www.example.org/extra", "extra");
+
+  fail_unless( c1->setNamespaces(&xmlns) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( c1->getSBMLNamespaces() != c2->getSBMLNamespaces() );
+  fail_unless( c1->getNamespaces()->getLength() == 2 );
+  fail_unless( c2->getNamespaces()->getLength() == 1 );
+  fail_unless( s->getNamespaces()->getLength() == 1 );
+  fail_unless( doc.getNamespaces()->getLength() == 1 );
+
+  // changes made in place through a copy do not reach the document
+  c2->getSBMLNamespaces()->setLevel(2);
+  fail_unless( c2->getLevel() == 2 );
+  fail_unless( doc.getSBMLNamespaces()->getLevel() == 3 );
+  fail_unless( s->getLevel() == 3 );
+
+  delete c1;
+  fail_unless( c2->getNamespaces()->getLength() == 1 );
+  delete c2;
+
+  // namespaces that no element owns are copied
+  SBMLNamespaces sbmlns(3, 1);
+  Species        s3(&sbmlns);
+
+  fail_unless( s3.getSBMLNamespaces() != &sbmlns );
+
+  // documents do not share their namespaces
+  SBMLDocument* copy = doc.clone();
+
+  fail_unless( copy->getSBMLNamespaces() != doc.getSBMLNamespaces() );
+
+  copy->getSBMLNamespaces()->addNamespace("http://www.example.org/extra", "extra");
+  fail_unless( copy->getNamespaces()->getLength() == 2 );
+  fail_unless( doc.getNamespaces()->getLength() == 1 );
+
+  delete copy;
+
+  // a copy of an element whose namespaces no longer match the document's
+  // takes the document's
+  doc.getSBMLNamespaces()->addNamespace("http://www.example.org/extra", "extra");
+  Species* c3 = s->clone();
+
+  fail_unless( c3->getNamespaces()->getLength() == 2 );
+  fail_unless( c3->getLevel() == 3 );
+
+  // and shares them with the other copies taken from the document
+  Species* c4 = s->clone();
+
+  fail_unless( c4->getSBMLNamespaces() == c3->getSBMLNamespaces() );
+  fail_unless( c4->getSBMLNamespaces() != doc.getSBMLNamespaces() );
+
+  delete c3;
+  delete c4;
+}
+END_TEST
+
+
 Suite *
 create_suite_SBMLNamespaces (void)
 {
@@ -279,6 +350,7 @@ create_suite_SBMLNamespaces (void)
   tcase_add_test(tcase, test_SBMLNamespaces_getURI);
   tcase_add_test(tcase, test_SBMLNamespaces_invalid);
   tcase_add_test(tcase, test_SBMLNamespaces_add_and_remove_namespaces);
+  tcase_add_test(tcase, test_SBMLNamespaces_shared_by_elements);
 
 
   suite_add_tcase(suite, tcase);
@@ -50,6 +50,11 @@
 #include <check.h>
 
 #include <iostream>
+#include <vector>
+
+#if (__cplusplus >= 201103L)
+#include <thread>
+#endif
 
 LIBSBML_CPP_NAMESPACE_USE
 
@@ -954,6 +959,150 @@ START_TEST(test_SBMLTransforms_evaluateAST_L2SpeciesReference)
 }
 END_TEST
 
+/*
+ * Creates a model in which x is set by an initial assignment from k.
+ */
+static SBMLDocument*
+createModelWithInitialAssignment(double k)
+{
+  SBMLDocument* d = new SBMLDocument(3, 1);
+  Model* m = d->createModel();
+
+  Parameter* p = m->createParameter();
+  p->setId("k");
+  p->setValue(k);
+  p->setConstant(true);
+
+  p = m->createParameter();
+  p->setId("x");
+  p->setConstant(true);
+
+  InitialAssignment* ia = m->createInitialAssignment();
+  ia->setSymbol("x");
+  ASTNode* math = SBML_parseL3Formula("k * 2 + 1");
+  ia->setMath(math);
+  delete math;
+
+  return d;
+}
+
+
+START_TEST(test_SBMLTransforms_evaluationContext)
+{
+  SBMLDocument* d1 = createModelWithInitialAssignment(1.0);
+  SBMLDocument* d2 = createModelWithInitialAssignment(5.0);
+  ASTNode* math = SBML_parseL3Formula("k + x");
+
+  SBMLEvaluationContext empty;
+  fail_unless(empty.isEmpty());
+  fail_unless(empty.getModel() == NULL);
+
+  SBMLEvaluationContext c1(d1->getModel());
+  SBMLEvaluationContext c2(d2->getModel());
+
+  fail_unless(!c1.isEmpty());
+  fail_unless(c1.getModel() == d1->getModel());
+  fail_unless(c1.getValues()["k"].first == 1.0);
+
+  /* x is computed from its initial assignment */
+  fail_unless(c1.evaluateASTNode(math) == 4.0);
+  fail_unless(c2.evaluateASTNode(math) == 16.0);
+
+  /* the contexts do not affect the values of the static API */
+  SBMLTransforms::clearComponentValues();
+  fail_unless(SBMLTransforms::evaluateASTNode(math, d2->getModel()) == 16.0);
+
+  /* mapped values are kept until they are cleared */
+  fail_unless(SBMLTransforms::evaluateASTNode(math, d1->getModel()) == 16.0);
+  SBMLTransforms::clearComponentValues();
+  fail_unless(SBMLTransforms::evaluateASTNode(math, d1->getModel()) == 4.0);
+  SBMLTransforms::clearComponentValues();
+
+  c1.clear();
+  fail_unless(c1.isEmpty());
+  fail_unless(c1.getModel() == NULL);
+
+  delete math;
+  delete d1;
+  delete d2;
+}
+END_TEST
+
+
+#if (__cplusplus >= 201103L)
+
+/*
+ * Expands the initial assignments of the given models and evaluates math
+ * (which must be "k + 1") for each of them, recording the number of wrong
+ * results.
+ */
+static void
+processModels(std::vector<SBMLDocument*>* docs, const ASTNode* math,
+              size_t first, size_t step, unsigned int* failures)
+{
+  for (size_t i = first; i < docs->size(); i += step)
+  {
+    Model* m = (*docs)[i]->getModel();
+    double k = m->getParameter("k")->getValue();
+
+    for (unsigned int n = 0; n < 20; ++n)
+    {
+      SBMLTransforms::clearComponentValues();
+      SBMLTransforms::mapComponentValues(m);
+      if (SBMLTransforms::evaluateASTNode(math, m) != k + 1) ++(*failures);
+      SBMLTransforms::clearComponentValues();
+
+      SBMLEvaluationContext context(m);
+      if (context.evaluateASTNode(math) != k + 1) ++(*failures);
+    }
+
+    SBMLTransforms::expandInitialAssignments(m);
+    if (m->getNumInitialAssignments() != 0) ++(*failures);
+    if (m->getParameter("x")->getValue() != k * 2 + 1) ++(*failures);
+  }
+}
+
+
+START_TEST(test_SBMLTransforms_threads)
+{
+  const size_t numThreads = 8;
+  std::vector<SBMLDocument*> docs;
+  for (unsigned int i = 0; i < 400; ++i)
+  {
+    docs.push_back(createModelWithInitialAssignment(i));
+  }
+
+  // the formula is parsed here: only the evaluation runs in the threads
+  ASTNode* math = SBML_parseL3Formula("k + 1");
+
+  std::vector<unsigned int> failures(numThreads, 0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    threads.push_back(std::thread(processModels, &docs, math, t, numThreads,
+                                  &failures[t]));
+  }
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    threads[t].join();
+  }
+
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    fail_unless(failures[t] == 0);
+  }
+
+  delete math;
+  for (size_t i = 0; i < docs.size(); ++i)
+  {
+    delete docs[i];
+  }
+}
+END_TEST
+
+#endif
+
+
 Suite *
 create_suite_SBMLTransforms (void)
 {
@@ -972,6 +1121,10 @@ create_suite_SBMLTransforms (void)
   tcase_add_test(tcase, test_SBMLTransforms_evaluateL3V2ASTWithModel);
   tcase_add_test(tcase, test_SBMLTransforms_L3V2AssignmentNoMath);
   tcase_add_test(tcase, test_SBMLTransforms_StoichiometryMath);
+  tcase_add_test(tcase, test_SBMLTransforms_evaluationContext);
+#if (__cplusplus >= 201103L)
+  tcase_add_test(tcase, test_SBMLTransforms_threads);
+#endif
 
 
   suite_add_tcase(suite, tcase);
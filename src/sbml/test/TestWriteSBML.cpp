@@ -39,6 +39,8 @@
  * and also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
@@ -2939,6 +2941,46 @@ START_TEST (test_WriteSBML_locale)
 END_TEST
 
 
+START_TEST (test_WriteSBML_bufferSize)
+{
+  const unsigned int sizes[] = { 0, 1, 7, 4096, 1048576 };
+  const char* xmlfile = "test_buffered.xml";
+
+  SBMLDocument* d = readSBML(
+    "../../../examples/sample-models/from-spec/level-2/enzymekinetics.xml");
+  fail_unless( d != NULL );
+
+  SBMLWriter writer;
+  string     expected = writer.writeSBMLToStdString(d);
+
+  fail_unless( writer.getBufferSize() == 0 );
+  fail_unless( writer.setBufferSize(2000000000) == LIBSBML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( writer.getBufferSize() == 0 );
+
+  for (unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+  {
+    fail_unless( writer.setBufferSize(sizes[i]) == LIBSBML_OPERATION_SUCCESS );
+    fail_unless( writer.getBufferSize() == sizes[i] );
+    fail_unless( writer.writeSBML(d, xmlfile) );
+
+    ifstream      in(xmlfile, ios_base::in | ios_base::binary);
+    ostringstream content;
+    content << in.rdbuf();
+
+    fail_unless( content.str() == expected );
+  }
+
+  remove(xmlfile);
+
+  fail_unless( d->getNumErrors() == 0 );
+  fail_unless( writer.writeSBML(d, "nonexistent-dir/test.xml") == false );
+  fail_unless( d->getErrorLog()->contains(XMLFileUnwritable) );
+
+  delete d;
+}
+END_TEST
+
+
 #ifdef USE_ZLIB
 START_TEST (test_WriteSBML_gzip)
 {
@@ -3093,6 +3135,125 @@ START_TEST (test_WriteSBML_zip)
   }
 }
 END_TEST
+
+
+START_TEST (test_WriteSBML_compressionThreads)
+{
+  const char* files[] = { "test_parallel.xml.gz", "test_parallel.xml.zip" };
+
+  // large enough for many blocks of 128 KB
+  SBMLDocument* d = new SBMLDocument(3, 1);
+  Model*        m = d->createModel();
+
+  for (unsigned int i = 0; i < 20000; i++)
+  {
+    ostringstream id;
+    id << "p" << i;
+
+    Parameter* p = m->createParameter();
+    p->setId(id.str());
+    p->setValue(i / 7.0);
+    p->setConstant(i % 2 == 0);
+  }
+
+  SBMLWriter writer;
+
+  fail_unless( writer.getCompressionThreads() == 0 );
+  fail_unless( writer.setCompressionThreads(1000) == LIBSBML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( writer.setCompressionThreads(3) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( writer.getCompressionThreads() == 3 );
+
+  char* dtos = d->toSBML();
+
+  for (unsigned int i = 0; i < 2; i++)
+  {
+    if ( ! SBMLWriter::hasZlib() )
+    {
+      fail_unless( writer.writeSBML(d, files[i]) == false );
+      continue;
+    }
+
+    fail_unless( writer.writeSBML(d, files[i]) );
+
+    SBMLDocument* dg = readSBML(files[i]);
+    fail_unless( dg != NULL );
+    fail_unless( dg->getNumErrors() == 0 );
+
+    char* dgtos = dg->toSBML();
+    fail_unless( strcmp(dtos, dgtos) == 0 );
+    safe_free(dgtos);
+
+    delete dg;
+    remove(files[i]);
+  }
+
+  safe_free(dtos);
+  delete d;
+}
+END_TEST
+#endif
+
+#ifdef USE_ZSTD
+START_TEST (test_WriteSBML_zstd)
+{
+  const unsigned int filenum = 12;
+  const char* file[filenum] = {
+                        "../../../examples/sample-models/from-spec/level-2/algebraicrules.xml",
+                        "../../../examples/sample-models/from-spec/level-2/assignmentrules.xml",
+                        "../../../examples/sample-models/from-spec/level-2/boundarycondition.xml",
+                        "../../../examples/sample-models/from-spec/level-2/delay.xml",
+                        "../../../examples/sample-models/from-spec/level-2/dimerization.xml",
+                        "../../../examples/sample-models/from-spec/level-2/enzymekinetics.xml",
+                        "../../../examples/sample-models/from-spec/level-2/events.xml",
+                        "../../../examples/sample-models/from-spec/level-2/functiondef.xml",
+                        "../../../examples/sample-models/from-spec/level-2/multicomp.xml",
+                        "../../../examples/sample-models/from-spec/level-2/overdetermined.xml",
+                        "../../../examples/sample-models/from-spec/level-2/twodimensional.xml",
+                        "../../../examples/sample-models/from-spec/level-2/units.xml"
+                        };
+
+  const char* zstfile = "test.xml.zst";
+
+  SBMLWriter writer;
+
+  fail_unless( writer.getCompressionLevel() == 0 );
+  fail_unless( writer.setCompressionLevel(23) == LIBSBML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( writer.setCompressionLevel(19) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( writer.getCompressionLevel() == 19 );
+  fail_unless( writer.setCompressionThreads(2) == LIBSBML_OPERATION_SUCCESS );
+
+  for(unsigned int i=0; i < filenum; i++)
+  {
+    SBMLDocument* d = readSBML(file[i]);
+    fail_unless( d != NULL);
+
+    if ( ! SBMLWriter::hasZstd() )
+    {
+      fail_unless( writer.writeSBML(d, zstfile) == false );
+      delete d;
+      continue;
+    }
+
+    bool result = writer.writeSBML(d, zstfile);
+    fail_unless( result );
+
+    SBMLDocument* dg = readSBML(zstfile);
+    fail_unless( dg != NULL);
+    fail_unless( dg->getNumErrors() == 0 );
+
+    char* dtos = d->toSBML();
+    char* dgtos = dg->toSBML();
+    fail_unless( strcmp(dtos, dgtos) == 0 );
+    safe_free(dtos);
+    safe_free(dgtos);
+
+    delete d;
+    delete dg;
+  }
+
+  remove(zstfile);
+}
+END_TEST
 #endif
 
 START_TEST (test_WriteSBML_elements_L1v2)
@@ -3432,18 +3593,25 @@ create_suite_WriteSBML ()
   tcase_add_test( tcase, test_WriteSBML_INF     );
   tcase_add_test( tcase, test_WriteSBML_NegINF  );
   tcase_add_test( tcase, test_WriteSBML_locale  );
+  tcase_add_test( tcase, test_WriteSBML_bufferSize  );
 
   // Compressed SBML
 #ifdef USE_ZLIB 
 #ifndef LIBSBML_USE_VLD
   tcase_add_test( tcase, test_WriteSBML_gzip  );
   tcase_add_test( tcase, test_WriteSBML_zip  );
+  tcase_add_test( tcase, test_WriteSBML_compressionThreads  );
 #endif
 #endif
 #ifdef USE_BZ2
 #ifndef LIBSBML_USE_VLD
   tcase_add_test( tcase, test_WriteSBML_bzip2  );
 #endif
+#endif
+#ifdef USE_ZSTD
+#ifndef LIBSBML_USE_VLD
+  tcase_add_test( tcase, test_WriteSBML_zstd  );
+#endif
 #endif
 
   tcase_add_test( tcase, test_WriteSBML_elements_L1v2  );
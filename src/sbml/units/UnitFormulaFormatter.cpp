@@ -592,9 +592,8 @@ UnitFormulaFormatter::getUnitDefinitionFromPower(const ASTNode * node,
     exponentNode->isReal() == true ||
     exponentUD->isVariantOfDimensionless())
   {
-    SBMLTransforms::mapComponentValues(model);
-    exponentValue = SBMLTransforms::evaluateASTNode(node->getRightChild(), model);
-    SBMLTransforms::clearComponentValues();
+    SBMLEvaluationContext context(model);
+    exponentValue = context.evaluateASTNode(node->getRightChild());
 
     for (unsigned int n = 0; n < variableUD->getNumUnits(); n++)
     {
@@ -749,9 +748,9 @@ UnitFormulaFormatter::getUnitDefinitionFromRoot(const ASTNode * node,
 
           if (tempUD2->isVariantOfDimensionless())
           {
-            SBMLTransforms::mapComponentValues(model);
-            double value = SBMLTransforms::evaluateASTNode(child);
-            SBMLTransforms::clearComponentValues();
+            SBMLEvaluationContext context(model);
+            double value = SBMLTransforms::evaluateASTNode(child,
+                                                  context.getValues());
             if (!util_isNaN(value))
             {
               double doubleExponent =
@@ -2716,8 +2715,8 @@ UnitFormulaFormatter::inverseFunctionOnUnits(UnitDefinition* expectedUD,
       if (mathUD == NULL || mathUD->getNumUnits() == 0 
         || mathUD->isVariantOfDimensionless() == true)
       {
-        SBMLTransforms::mapComponentValues(this->model);
-        double exp = 1.0/(SBMLTransforms::evaluateASTNode(math, this->model));
+        SBMLEvaluationContext context(this->model);
+        double exp = 1.0/(context.evaluateASTNode(math));
         resolvedUD = new UnitDefinition(*expectedUD);
         for (unsigned int i = 0; i < resolvedUD->getNumUnits(); i++)
         {
@@ -51,6 +51,7 @@
 #include <sbml/common/common.h>
 #include <sbml/common/operationReturnValues.h>
 #include <locale.h>
+#include <limits.h>
 
 #include <check.h>
 
@@ -134,6 +135,114 @@ START_TEST (test_c_locale_strtod)
 END_TEST
 
 
+START_TEST (test_util_parseDouble)
+{
+  const char *s;
+  const char *end;
+  double      d;
+  int         outOfRange;
+
+  s   = "-2.72e+3";
+  end = util_parseDouble(s, s + strlen(s), &d, &outOfRange);
+  fail_unless( end == s + strlen(s) );
+  fail_unless( d   == -2720.0       );
+  fail_unless( outOfRange == 0      );
+
+  s   = "0.1";
+  end = util_parseDouble(s, s + strlen(s), &d, &outOfRange);
+  fail_unless( end == s + 3            );
+  fail_unless( d   == strtod(s, NULL)  );
+
+  s   = ".5e";
+  end = util_parseDouble(s, s + strlen(s), &d, &outOfRange);
+  fail_unless( end == s + 2 );
+  fail_unless( d   == 0.5   );
+
+  s   = "12.5mol";
+  end = util_parseDouble(s, s + strlen(s), &d, &outOfRange);
+  fail_unless( end == s + 4 );
+  fail_unless( d   == 12.5  );
+
+  /* only the given range is read */
+  s   = "123";
+  end = util_parseDouble(s, s + 2, &d, &outOfRange);
+  fail_unless( end == s + 2 );
+  fail_unless( d   == 12    );
+
+  s   = "1e400";
+  end = util_parseDouble(s, s + strlen(s), &d, &outOfRange);
+  fail_unless( end == s + 5           );
+  fail_unless( util_isInf(d) == 1    );
+  fail_unless( outOfRange == 1        );
+
+  s   = "1e-400";
+  end = util_parseDouble(s, s + strlen(s), &d, NULL);
+  fail_unless( end == s + 6 );
+  fail_unless( d   == 0     );
+
+  s   = " 1";
+  fail_unless( util_parseDouble(s, s + strlen(s), &d, NULL) == s );
+  s   = "inf";
+  fail_unless( util_parseDouble(s, s + strlen(s), &d, NULL) == s );
+  s   = "-.";
+  fail_unless( util_parseDouble(s, s + strlen(s), &d, NULL) == s );
+  fail_unless( util_parseDouble(s, s, &d, NULL)               == s );
+}
+END_TEST
+
+
+START_TEST (test_util_parseDouble_locale)
+{
+  const char *s = "2.72";
+  double      d = 0;
+
+  setlocale(LC_ALL, "de_DE");
+
+  fail_unless( util_parseDouble(s, s + 4, &d, NULL) == s + 4 );
+  fail_unless( util_isEqual(d, 2.72) );
+
+  setlocale(LC_ALL, "C");
+}
+END_TEST
+
+
+START_TEST (test_util_parseLong)
+{
+  const char *s;
+  const char *end;
+  long        l;
+  int         outOfRange;
+
+  s   = "-42";
+  end = util_parseLong(s, s + strlen(s), &l, &outOfRange);
+  fail_unless( end == s + 3  );
+  fail_unless( l   == -42    );
+  fail_unless( outOfRange == 0 );
+
+  s   = "+7.5";
+  end = util_parseLong(s, s + strlen(s), &l, &outOfRange);
+  fail_unless( end == s + 2 );
+  fail_unless( l   == 7     );
+
+  s   = "99999999999999999999999";
+  end = util_parseLong(s, s + strlen(s), &l, &outOfRange);
+  fail_unless( end == s + strlen(s) );
+  fail_unless( l   == LONG_MAX      );
+  fail_unless( outOfRange == 1      );
+
+  s   = "-99999999999999999999999";
+  end = util_parseLong(s, s + strlen(s), &l, &outOfRange);
+  fail_unless( l   == LONG_MIN );
+  fail_unless( outOfRange == 1 );
+
+  s   = "x1";
+  fail_unless( util_parseLong(s, s + strlen(s), &l, NULL) == s );
+  s   = "-";
+  fail_unless( util_parseLong(s, s + strlen(s), &l, NULL) == s );
+}
+END_TEST
+
+
 START_TEST (test_util_file_exists)
 {
   fail_unless(  util_file_exists("TestUtil.c")      );
@@ -368,6 +477,9 @@ create_suite_util (void)
   tcase_add_test( tcase, test_util_isInf              );
   tcase_add_test( tcase, test_util_accessWithNULL     );
   tcase_add_test( tcase, test_util_operationReturn    );
+  tcase_add_test( tcase, test_util_parseDouble        );
+  tcase_add_test( tcase, test_util_parseDouble_locale );
+  tcase_add_test( tcase, test_util_parseLong          );
 
   suite_add_tcase(suite, tcase);
 
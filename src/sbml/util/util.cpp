@@ -64,9 +64,18 @@
 
 
 #include <math.h>
+#include <float.h>
+#include <limits.h>
+#include <string.h>
 
-#if defined(_MSC_VER) || defined(__BORLANDC__)
-#  include <float.h>
+#include <string>
+
+#if (__cplusplus >= 201703L) || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
 #endif
 
 #ifndef __DBL_EPSILON__ 
@@ -159,6 +168,201 @@ c_locale_strtod (const char *nptr, char **endptr)
 }
 
 
+/*
+ * Whether double expressions are evaluated in double precision, rather
+ * than in the 80 bit registers of the x87 unit.
+ */
+#if (defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0)            \
+ || (defined(__FLT_EVAL_METHOD__) && __FLT_EVAL_METHOD__ == 0)    \
+ || defined(_M_X64) || defined(_M_ARM64)                          \
+ || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTIL_DOUBLE_EVALUATION
+#endif
+
+
+/*
+ * Reads the decimal number in [first, last), which has already been
+ * checked to be one, with full precision.
+ */
+static double
+parseDecimal (const char *first, const char *last)
+{
+#if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+  const char *digits = (*first == '-' || *first == '+') ? first + 1 : first;
+  double      value  = 0;
+
+  std::from_chars_result result = std::from_chars(digits, last, value);
+
+  if (result.ec == std::errc())
+  {
+    return (*first == '-') ? -value : value;
+  }
+
+  // out of range; from_chars leaves value alone, so let strtod decide
+  // between zero and infinity
+#endif
+
+  // strtod needs a null-terminated string with the decimal point of the
+  // current locale
+  const char  point  = *localeconv()->decimal_point;
+  std::string number(first, last);
+
+  if (point != '.')
+  {
+    std::string::size_type position = number.find('.');
+    if (position != std::string::npos) number[position] = point;
+  }
+
+  return strtod(number.c_str(), NULL);
+}
+
+
+LIBSBML_EXTERN
+const char *
+util_parseDouble (const char *first, const char *last, double *value,
+                  int *outOfRange)
+{
+  const char *next = first;
+
+  if (next != last && (*next == '-' || *next == '+')) ++next;
+
+  // the significand, as long as it has at most 15 significant digits
+  double mantissa    = 0;
+  int    significant = 0;
+  int    scale       = 0;
+  bool   digits      = false;
+
+  for ( ; next != last && *next >= '0' && *next <= '9'; ++next)
+  {
+    digits = true;
+    if (significant > 0 || *next != '0') ++significant;
+    if (significant <= 15) mantissa = mantissa * 10 + (*next - '0');
+    else ++scale;
+  }
+
+  if (next != last && *next == '.')
+  {
+    ++next;
+    for ( ; next != last && *next >= '0' && *next <= '9'; ++next)
+    {
+      digits = true;
+      if (significant > 0 || *next != '0') ++significant;
+      if (significant <= 15)
+      {
+        mantissa = mantissa * 10 + (*next - '0');
+        --scale;
+      }
+    }
+  }
+
+  if (!digits) return first;
+
+  if (next != last && (*next == 'e' || *next == 'E'))
+  {
+    const char *exponent = next + 1;
+    bool        minus    = false;
+
+    if (exponent != last && (*exponent == '-' || *exponent == '+'))
+    {
+      minus = (*exponent == '-');
+      ++exponent;
+    }
+
+    if (exponent != last && *exponent >= '0' && *exponent <= '9')
+    {
+      long power = 0;
+      for ( ; exponent != last && *exponent >= '0' && *exponent <= '9'; ++exponent)
+      {
+        if (power < 100000) power = power * 10 + (*exponent - '0');
+      }
+
+      scale += minus ? -(int)power : (int)power;
+      next   = exponent;
+    }
+  }
+
+  double result;
+
+  // Clinger's fast path: a significand and a power of ten that are both
+  // exact doubles give a correctly rounded product or quotient, as long as
+  // the arithmetic is done in double precision
+#ifdef UTIL_DOUBLE_EVALUATION
+  static const double powers[] =
+  {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+  if (significant <= 15 && scale >= -22 && scale <= 22)
+  {
+    result = (scale < 0) ? mantissa / powers[-scale] : mantissa * powers[scale];
+    if (*first == '-') result = -result;
+  }
+  else
+#endif
+  {
+    result = parseDecimal(first, next);
+  }
+
+  if (outOfRange != NULL)
+  {
+    const double magnitude = fabs(result);
+    *outOfRange = (magnitude > DBL_MAX
+                   || (magnitude < DBL_MIN && significant > 0)) ? 1 : 0;
+  }
+
+  *value = result;
+  return next;
+}
+
+
+LIBSBML_EXTERN
+const char *
+util_parseLong (const char *first, const char *last, long *value,
+                int *outOfRange)
+{
+  const char *next     = first;
+  const bool  negative = (next != last && *next == '-');
+
+  if (next != last && (*next == '-' || *next == '+')) ++next;
+
+  if (next == last || *next < '0' || *next > '9') return first;
+
+  // accumulate the magnitude, which may be one more than LONG_MAX
+  const unsigned long limit = negative ? 0UL - (unsigned long)LONG_MIN
+                                       : (unsigned long)LONG_MAX;
+  unsigned long magnitude = 0;
+  bool          overflow  = false;
+
+  for ( ; next != last && *next >= '0' && *next <= '9'; ++next)
+  {
+    const unsigned long digit = (unsigned long)(*next - '0');
+
+    if (overflow || magnitude > (limit - digit) / 10)
+    {
+      overflow = true;
+    }
+    else
+    {
+      magnitude = magnitude * 10 + digit;
+    }
+  }
+
+  if (overflow)
+  {
+    *value = negative ? LONG_MIN : LONG_MAX;
+  }
+  else
+  {
+    *value = negative ? (long)(0UL - magnitude) : (long)magnitude;
+  }
+
+  if (outOfRange != NULL) *outOfRange = overflow ? 1 : 0;
+
+  return next;
+}
+
+
 LIBSBML_EXTERN
 FILE *
 safe_fopen (const char *filename, const char *mode)
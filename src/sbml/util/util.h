@@ -112,6 +112,44 @@ double
 c_locale_strtod (const char *nptr, char **endptr);
 
 
+/**
+ * Reads a decimal number, an optional sign followed by digits with an
+ * optional decimal point and exponent, from the characters [first, last)
+ * as strtod() would in the "C" locale.  Unlike strtod(), leading
+ * whitespace, hexadecimal numbers, infinities and NaNs are not accepted,
+ * the input need not be null-terminated, and neither the locale nor errno
+ * is touched.
+ *
+ * If outOfRange is not NULL, it is set to 1 if the number overflows, or
+ * underflows to zero or a subnormal value, where strtod() would set
+ * errno to ERANGE, and to 0 otherwise.
+ *
+ * @return a pointer to the first character not used, or first if the
+ * characters do not start with a number, in which case value is not
+ * changed.
+ */
+LIBSBML_EXTERN
+const char *
+util_parseDouble (const char *first, const char *last, double *value,
+                  int *outOfRange);
+
+
+/**
+ * Reads an optionally signed base 10 integer from the characters [first,
+ * last) as strtol() would, except that leading whitespace is not skipped
+ * and errno is not touched.  Out of range numbers are read as LONG_MAX or
+ * LONG_MIN and set outOfRange, if it is not NULL, to 1.
+ *
+ * @return a pointer to the first character not used, or first if the
+ * characters do not start with a number, in which case value is not
+ * changed.
+ */
+LIBSBML_EXTERN
+const char *
+util_parseLong (const char *first, const char *last, long *value,
+                int *outOfRange);
+
+
 /**
  * Attempts to open filename for the given access mode and return a pointer
  * to it.  If the filename could not be opened, prints an error message and
@@ -41,7 +41,9 @@
  * and also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <algorithm>
 #include <cstring>
+#include <set>
 
 #include <sbml/Model.h>
 #include <sbml/Rule.h>
@@ -65,6 +67,8 @@ LIBSBML_CPP_NAMESPACE_BEGIN
  */
 AssignmentCycles::AssignmentCycles (unsigned int id, Validator& v) :
   TConstraint<Model>(id, v)
+  , mNumTargets(0)
+  , mNumComponents(0)
 {
 }
 
@@ -91,10 +95,41 @@ AssignmentCycles::check_ (const Model& m, const Model& object)
 
   unsigned int n;
 
-  mIdMap.clear();
+  mNodeIndex.clear();
+  mNodes.clear();
+  mDependencies.clear();
+
+  /* the ids of Reactions, AssignmentRules and InitialAssignments come
+   * first in the graph; as with Model::getRule only the first rule for
+   * a variable counts
+   */
+  std::set<std::string> ruleVariables;
+
+  for (n = 0; n < m.getNumInitialAssignments(); ++n)
+  {
+    getNode(m.getInitialAssignment(n)->getSymbol());
+  }
+
+  for (n = 0; n < m.getNumReactions(); ++n)
+  {
+    getNode(m.getReaction(n)->getId());
+  }
+
+  for (n = 0; n < m.getNumRules(); ++n)
+  {
+    const Rule* rule = m.getRule(n);
+    if (ruleVariables.insert(rule->getVariable()).second
+      && rule->isAssignment())
+    {
+      getNode(rule->getVariable());
+    }
+  }
 
-  /* create map of id mapped to id that it refers to that is
-   * also the id of a Reaction, AssignmentRule or InitialAssignment
+  mNumTargets = (unsigned int)(mNodes.size());
+
+  /* create a graph with an edge from each id to each id that it refers
+   * to that is also the id of a Reaction, AssignmentRule or
+   * InitialAssignment
    */
   for (n = 0; n < m.getNumInitialAssignments(); ++n)
   { 
@@ -125,7 +160,7 @@ AssignmentCycles::check_ (const Model& m, const Model& object)
   // check for self assignment
   checkForSelfAssignment(m);
 
-  determineAllDependencies();
+  determineComponents();
   determineCycles(m);
 
   checkForImplicitCompartmentReference(m);
@@ -136,12 +171,12 @@ AssignmentCycles::addInitialAssignmentDependencies(const Model& m,
                                          const InitialAssignment& object)
 {
   unsigned int ns;
-  std::string thisId = object.getSymbol();
+  unsigned int thisId = getNode(object.getSymbol());
 
   /* loop thru the list of names in the Math
     * if they refer to a Reaction, an Assignment Rule
-    * or an Initial Assignment add to the map
-    * with the variable as key
+    * or an Initial Assignment add an edge
+    * from the variable to them
     */
   List* variables = object.getMath()->getListOfNodes( ASTNode_isName );
   for (ns = 0; ns < variables->getSize(); ns++)
@@ -149,18 +184,7 @@ AssignmentCycles::addInitialAssignmentDependencies(const Model& m,
     ASTNode* node = static_cast<ASTNode*>( variables->get(ns) );
     string   name = node->getName() ? node->getName() : "";
 
-    if (m.getReaction(name))
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-    else if (m.getRule(name) && m.getRule(name)->isAssignment())
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-    else if (m.getInitialAssignment(name))
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
+    addDependency(thisId, name);
   }
 
   delete variables;
@@ -171,12 +195,12 @@ void
 AssignmentCycles::addReactionDependencies(const Model& m, const Reaction& object)
 {
   unsigned int ns;
-  std::string thisId = object.getId();
+  unsigned int thisId = getNode(object.getId());
 
   /* loop thru the list of names in the Math
     * if they refer to a Reaction, an Assignment Rule
-    * or an Initial Assignment add to the map
-    * with the variable as key
+    * or an Initial Assignment add an edge
+    * from the variable to them
     */
   List* variables = object.getKineticLaw()->getMath()
                                       ->getListOfNodes( ASTNode_isName );
@@ -190,18 +214,7 @@ AssignmentCycles::addReactionDependencies(const Model& m, const Reaction& object
       continue;
     }
 
-    if (m.getReaction(name))
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-    else if (m.getRule(name) && m.getRule(name)->isAssignment())
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-    else if (m.getInitialAssignment(name))
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
+    addDependency(thisId, name);
   }
 
   delete variables;
@@ -212,12 +225,12 @@ void
 AssignmentCycles::addRuleDependencies(const Model& m, const Rule& object)
 {
   unsigned int ns;
-  std::string thisId = object.getVariable();
+  unsigned int thisId = getNode(object.getVariable());
 
   /* loop thru the list of names in the Math
     * if they refer to a Reaction, an Assignment Rule
-    * or an Initial Assignment add to the map
-    * with the variable as key
+    * or an Initial Assignment add an edge
+    * from the variable to them
     */
   List* variables = object.getMath()->getListOfNodes( ASTNode_isName );
   for (ns = 0; ns < variables->getSize(); ns++)
@@ -225,81 +238,134 @@ AssignmentCycles::addRuleDependencies(const Model& m, const Rule& object)
     ASTNode* node = static_cast<ASTNode*>( variables->get(ns) );
     string   name = node->getName() ? node->getName() : "";
 
-    if (m.getReaction(name))
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-    else if (m.getRule(name) && m.getRule(name)->isAssignment())
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-    else if (m.getInitialAssignment(name))
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
+    addDependency(thisId, name);
   }
 
   delete variables;
 }
 
 
-void 
-AssignmentCycles::determineAllDependencies()
+void
+AssignmentCycles::addDependency(unsigned int id, const std::string& name)
 {
-  IdIter iterator;
-  IdIter inner_it;
-  IdRange range;
-
-  /* for each pair in the map (x, y)
-   * retrieve all other pairs where y is first (e.g. (y, s))
-   * and create pairs showing that x depends on these e.g. (x, s)
-   * check whether the pair already exists in the map
-   * and add it if not
-   */
-  for (iterator = mIdMap.begin(); iterator != mIdMap.end(); iterator++)
+  std::map<std::string, unsigned int>::const_iterator it = 
+                                                      mNodeIndex.find(name);
+  if (it != mNodeIndex.end() && it->second < mNumTargets)
   {
-    range = mIdMap.equal_range((*iterator).second);
-    for (inner_it = range.first; inner_it != range.second; inner_it++)
-    {
-      const pair<const std::string, std::string> &depend = 
-            pair<const std::string, std::string>((*iterator).first, (*inner_it).second);
-      if (!alreadyExistsInMap(mIdMap, depend))
-        mIdMap.insert(depend);
-    }
+    mDependencies[id].push_back(it->second);
   }
 }
 
 
-bool 
-AssignmentCycles::alreadyExistsInMap(IdMap map, 
-                                     pair<const std::string, std::string> dependency)
+unsigned int
+AssignmentCycles::getNode(const std::string& id)
 {
-  bool exists = false;
-
-  IdIter it;
-  
-  for (it = map.begin(); it != map.end(); it++)
+  std::map<std::string, unsigned int>::const_iterator it = mNodeIndex.find(id);
+  if (it != mNodeIndex.end())
   {
-    if (((*it).first == dependency.first)
-      && ((*it).second == dependency.second))
-      exists = true;
+    return it->second;
   }
 
-  return exists;
+  unsigned int node = (unsigned int)(mNodes.size());
+  mNodeIndex.insert(pair<const std::string, unsigned int>(id, node));
+  mNodes.push_back(id);
+  mDependencies.push_back(std::vector<unsigned int>());
+  return node;
 }
 
-  
+
 void 
 AssignmentCycles::checkForSelfAssignment(const Model& m)
 {
-  IdIter the_iterator;
+  std::map<std::string, unsigned int>::const_iterator it;
 
-  for (the_iterator = mIdMap.begin();
-    the_iterator != mIdMap.end(); the_iterator++)
+  /* report each use of an id within its own math */
+  for (it = mNodeIndex.begin(); it != mNodeIndex.end(); ++it)
   {
-    if ((*the_iterator).first == (*the_iterator).second)
+    const std::vector<unsigned int>& dependencies = mDependencies[it->second];
+    for (size_t n = 0; n < dependencies.size(); ++n)
     {
-      logMathRefersToSelf(m, (*the_iterator).first);
+      if (dependencies[n] == it->second)
+      {
+        logMathRefersToSelf(m, it->first);
+      }
+    }
+  }
+}
+
+
+/*
+ * Tarjan's algorithm, using an explicit stack so that long chains of
+ * assignments cannot exhaust the call stack.
+ */
+void
+AssignmentCycles::determineComponents()
+{
+  const unsigned int unvisited = (unsigned int)(-1);
+  unsigned int numNodes = (unsigned int)(mNodes.size());
+
+  std::vector<unsigned int> index(numNodes, unvisited);
+  std::vector<unsigned int> lowlink(numNodes, 0);
+  std::vector<bool> onStack(numNodes, false);
+  std::vector<unsigned int> stack;
+  /* the nodes being visited and the next of their edges to follow */
+  std::vector< std::pair<unsigned int, size_t> > visiting;
+  unsigned int counter = 0;
+
+  mComponent.assign(numNodes, 0);
+  mNumComponents = 0;
+
+  for (unsigned int root = 0; root < numNodes; ++root)
+  {
+    if (index[root] != unvisited) continue;
+
+    index[root] = lowlink[root] = counter++;
+    stack.push_back(root);
+    onStack[root] = true;
+    visiting.push_back(std::make_pair(root, (size_t)0));
+
+    while (!visiting.empty())
+    {
+      unsigned int node = visiting.back().first;
+      size_t edge = visiting.back().second;
+
+      if (edge < mDependencies[node].size())
+      {
+        visiting.back().second = edge + 1;
+        unsigned int next = mDependencies[node][edge];
+        if (index[next] == unvisited)
+        {
+          index[next] = lowlink[next] = counter++;
+          stack.push_back(next);
+          onStack[next] = true;
+          visiting.push_back(std::make_pair(next, (size_t)0));
+        }
+        else if (onStack[next] && index[next] < lowlink[node])
+        {
+          lowlink[node] = index[next];
+        }
+        continue;
+      }
+
+      visiting.pop_back();
+      if (!visiting.empty() && lowlink[node] < lowlink[visiting.back().first])
+      {
+        lowlink[visiting.back().first] = lowlink[node];
+      }
+
+      if (lowlink[node] == index[node])
+      {
+        unsigned int member;
+        do
+        {
+          member = stack.back();
+          stack.pop_back();
+          onStack[member] = false;
+          mComponent[member] = mNumComponents;
+        }
+        while (member != node);
+        ++mNumComponents;
+      }
     }
   }
 }
@@ -308,50 +374,130 @@ AssignmentCycles::checkForSelfAssignment(const Model& m)
 void 
 AssignmentCycles::determineCycles(const Model& m)
 {
-  IdIter it;
-  IdRange range;
-  IdList variables;
-  IdMap logged;
-  std::string id;
-  variables.clear();
+  unsigned int numNodes = (unsigned int)(mNodes.size());
+  unsigned int n, c;
+
+  /* an id is part of a cycle if its component has more than one member
+   * or if it refers to itself
+   */
+  std::vector< std::vector<unsigned int> > members(mNumComponents);
+  std::vector<bool> cyclic(mNumComponents, false);
+  bool found = false;
+
+  for (n = 0; n < numNodes; ++n)
+  {
+    c = mComponent[n];
+    members[c].push_back(n);
+    if (members[c].size() > 1 
+      || std::find(mDependencies[n].begin(), mDependencies[n].end(), n) 
+                                                != mDependencies[n].end())
+    {
+      cyclic[c] = true;
+      found = true;
+    }
+  }
+
+  if (!found) return;
 
-  /* create a list of variables that are cycles ie (x, x) */
-  for (it = mIdMap.begin(); it != mIdMap.end(); it++)
+  /* for each component in a cycle record the components in cycles that
+   * can be reached from it, including itself
+   */
+  std::vector< std::vector<unsigned int> > reached(mNumComponents);
+  std::vector<unsigned int> visited(numNodes, 0);
+  std::vector<unsigned int> pending;
+
+  for (c = 0; c < mNumComponents; ++c)
   {
-    if ((*it).first == (*it).second)
+    if (!cyclic[c]) continue;
+
+    unsigned int mark = c + 1;
+    pending.push_back(members[c][0]);
+    visited[members[c][0]] = mark;
+    while (!pending.empty())
     {
-      id = (*it).first;
-      if (!variables.contains(id))
+      unsigned int node = pending.back();
+      pending.pop_back();
+      const std::vector<unsigned int>& dependencies = mDependencies[node];
+      for (size_t d = 0; d < dependencies.size(); ++d)
       {
-        variables.append(id);
+        if (visited[dependencies[d]] != mark)
+        {
+          visited[dependencies[d]] = mark;
+          pending.push_back(dependencies[d]);
+        }
+      }
+      if (cyclic[mComponent[node]] && members[mComponent[node]][0] == node)
+      {
+        reached[c].push_back(mComponent[node]);
       }
     }
+    std::sort(reached[c].begin(), reached[c].end());
   }
 
-  /* loop thru other dependencies for each; if the dependent is also
-   * in the list then this is the cycle
-   * keep a record of logged dependencies to avoid logging twice
+  /* log each pair of ids in cycles where one depends on the other once,
+   * with the ids in alphabetical order unless only the second depends on
+   * the first
    */
-   
-  for (unsigned int n = 0; n < variables.size(); n++)
+  std::vector<unsigned int> sorted;
+  std::vector<unsigned int> rank(numNodes);
+  std::map<std::string, unsigned int>::const_iterator it;
+  for (it = mNodeIndex.begin(); it != mNodeIndex.end(); ++it)
   {
-    id = variables.at((int)n);
-    range = mIdMap.equal_range(id);
-    for (it = range.first; it != range.second; it++)
+    rank[it->second] = (unsigned int)(sorted.size());
+    sorted.push_back(it->second);
+  }
+
+  std::vector<unsigned int> targets;
+  for (n = 0; n < numNodes; ++n)
+  {
+    unsigned int node = sorted[n];
+    c = mComponent[node];
+    if (!cyclic[c]) continue;
+
+    targets.clear();
+    for (size_t r = 0; r < reached[c].size(); ++r)
     {
-      if (((*it).second != id)
-        && (variables.contains((*it).second))
-        && !alreadyExistsInMap(logged, pair<const std::string, std::string>(id, (*it).second))
-        && !alreadyExistsInMap(logged, pair<const std::string, std::string>((*it).second, id)))
+      const std::vector<unsigned int>& other = members[reached[c][r]];
+      for (size_t o = 0; o < other.size(); ++o)
+      {
+        targets.push_back(rank[other[o]]);
+      }
+    }
+    std::sort(targets.begin(), targets.end());
+
+    for (size_t t = 0; t < targets.size(); ++t)
+    {
+      unsigned int target = sorted[targets[t]];
+      if (target == node) continue;
+
+      const std::vector<unsigned int>& back = reached[mComponent[target]];
+      if (targets[t] > n 
+        || !std::binary_search(back.begin(), back.end(), c))
       {
-        logCycle(m, id, (*it).second);
-        logged.insert(pair<const std::string, std::string>(id, (*it).second));
+        logCycle(m, mNodes[node], mNodes[target]);
       }
     }
   }
 }
  
 
+/* returns true if the map already records that id refers to name */
+static bool
+containsDependency(const IdMap& map, const std::string& id, 
+                   const std::string& name)
+{
+  std::pair<IdMap::const_iterator, IdMap::const_iterator> range = 
+                                                    map.equal_range(id);
+  for (IdMap::const_iterator it = range.first; it != range.second; ++it)
+  {
+    if ((*it).second == name)
+      return true;
+  }
+
+  return false;
+}
+
+
 void 
 AssignmentCycles::checkForImplicitCompartmentReference(const Model& m)
 {
@@ -374,7 +520,7 @@ AssignmentCycles::checkForImplicitCompartmentReference(const Model& m)
         {
           ASTNode* node = static_cast<ASTNode*>( variables->get(ns) );
           string   name = node->getName() ? node->getName() : "";
-          if (!name.empty() && !alreadyExistsInMap(mIdMap, pair<const std::string, std::string>(id, name)))
+          if (!name.empty() && !containsDependency(mIdMap, id, name))
             mIdMap.insert(pair<const std::string, std::string>(id, name));
         }
         delete variables;
@@ -395,7 +541,7 @@ AssignmentCycles::checkForImplicitCompartmentReference(const Model& m)
         {
           ASTNode* node = static_cast<ASTNode*>( variables->get(ns) );
           string   name = node->getName() ? node->getName() : "";
-          if (!name.empty() && !alreadyExistsInMap(mIdMap, pair<const std::string, std::string>(id, name)))
+          if (!name.empty() && !containsDependency(mIdMap, id, name))
             mIdMap.insert(pair<const std::string, std::string>(id, name));
         }
         delete variables;
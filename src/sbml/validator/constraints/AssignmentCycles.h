@@ -47,7 +47,9 @@
 
 #ifdef __cplusplus
 
+#include <map>
 #include <string>
+#include <vector>
 #include <sbml/validator/VConstraint.h>
 
 #include <sbml/util/IdList.h>
@@ -78,7 +80,7 @@ protected:
   virtual void check_ (const Model& m, const Model& object);
 
   
-  /* create pairs of ids that depend on each other */
+  /* add edges from an id to the ids it refers to */
   void addInitialAssignmentDependencies(const Model &, 
                                         const InitialAssignment &);
   
@@ -87,20 +89,26 @@ protected:
   
   void addRuleDependencies(const Model &, const Rule &);
 
-  
-  void determineAllDependencies();
+
+  /* add an edge from id to a name used in its math, if the name is the
+   * id of a Reaction, an AssignmentRule or an InitialAssignment
+   */
+  void addDependency(unsigned int id, const std::string& name);
 
 
-  /* helper function to check if a pair already exists */
-  bool alreadyExistsInMap(IdMap map, 
-                          std::pair<const std::string, std::string> dependency);
+  /* returns the index of the node for id, adding one if necessary */
+  unsigned int getNode(const std::string& id);
 
   
   /* check for explicit use of original variable */
   void checkForSelfAssignment(const Model &);
 
 
-  /* find cycles in the map of dependencies */
+  /* find the strongly connected components of the dependency graph */
+  void determineComponents();
+
+
+  /* find cycles in the graph of dependencies */
   void determineCycles(const Model& m);
 
 
@@ -144,6 +152,22 @@ protected:
   
   IdMap mIdMap;
 
+  /* the dependency graph: ids are numbered in the order they are met,
+   * the first mNumTargets being those of Reactions, AssignmentRules and
+   * InitialAssignments, and mDependencies[n] lists the nodes that node n
+   * refers to, once per reference
+   */
+  std::map<std::string, unsigned int> mNodeIndex;
+  std::vector<std::string> mNodes;
+  std::vector< std::vector<unsigned int> > mDependencies;
+  unsigned int mNumTargets;
+
+  /* the strongly connected component of each node; components are
+   * numbered in reverse topological order
+   */
+  std::vector<unsigned int> mComponent;
+  unsigned int mNumComponents;
+
 };
 
 LIBSBML_CPP_NAMESPACE_END
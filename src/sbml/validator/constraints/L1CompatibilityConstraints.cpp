@@ -173,7 +173,8 @@ START_CONSTRAINT (91008, SpeciesReference, sr)
           if (!math->isInteger() && !math->isRational())
           {
             // do a last minute check on whether the math will evaluate to an integer
-            double value = SBMLTransforms::evaluateASTNode(math, &m);
+            SBMLEvaluationContext context(&m);
+            double value = context.evaluateASTNode(math);
             if (!util_isNaN(value))
             {
               if (!util_isEqual(value, floor(value)))
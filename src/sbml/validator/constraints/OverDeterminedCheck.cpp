@@ -153,28 +153,18 @@ OverDeterminedCheck::logOverDetermined (const Model& m)
   logFailure(m);
 }
 
+static const unsigned int NO_MATCH = (unsigned int)(-1);
+
 EquationMatching::EquationMatching()
+  : mFreeLayer (NO_MATCH)
 {
 }
 
 EquationMatching::~EquationMatching ()
 {
-  mEquations.clear(); // list of equation vertexes
-  mVariables.clear(); // list of variable vertexes
-  mGraph.clear();
-
-  /* these are to enable the bipartite matching without passing variables */
-  mMatching.clear();
-  mVarNeighInPrev.clear();
-  mEqnNeighInPrev.clear();
-
-  revisited.clear();
-  visited.clear();
-
 }
 
 
-
 /* 
  * creates equation vertexes according to the L2V2 spec 4.11.5 for every
  * 1. a Species that has the boundaryCondition field set to false 
@@ -203,23 +193,18 @@ EquationMatching::writeEquationVertexes(const Model& m)
     if (m.getReaction(n)->isSetKineticLaw())
     {
       r = m.getReaction(n);
-      for (sr = 0; sr < r->getNumReactants(); sr++)
+      for (sr = 0; sr < r->getNumReactants() + r->getNumProducts(); sr++)
       {
-        s = m.getSpecies(r->getReactant(sr)->getSpecies());
-        if (!s->getBoundaryCondition() && !s->getConstant())
+        s = (sr < r->getNumReactants()) 
+          ? m.getSpecies(r->getReactant(sr)->getSpecies())
+          : m.getSpecies(r->getProduct(sr - r->getNumReactants())->getSpecies());
+        if (s != NULL && !s->getBoundaryCondition() && !s->getConstant())
         {
-          if (!mEquations.contains(s->getId()))
-            mEquations.append(s->getId());
-        }
-      }
-
-      for (sr = 0; sr < r->getNumProducts(); sr++)
-      {
-        s = m.getSpecies(r->getProduct(sr)->getSpecies());
-        if (!s->getBoundaryCondition() && !s->getConstant())
-        {
-          if (!mEquations.contains(s->getId()))
+          if (mEquationIds.count(s->getId()) == 0)
+          {
+            mEquationIds[s->getId()] = mEquations.size();
             mEquations.append(s->getId());
+          }
         }
       }
     }
@@ -229,6 +214,7 @@ EquationMatching::writeEquationVertexes(const Model& m)
   for (n = 0; n < m.getNumRules(); n++)
   {
     SET_NAME(rule, "rule_", n);
+    mEquationIds.insert(make_pair(rule, mEquations.size()));
     mEquations.append(rule);
   }
 
@@ -238,6 +224,7 @@ EquationMatching::writeEquationVertexes(const Model& m)
     if (m.getReaction(n)->isSetKineticLaw())
     {
         SET_NAME(react, "KL_", n);
+        mEquationIds.insert(make_pair(react, mEquations.size()));
         mEquations.append(react);
     }
   }
@@ -259,11 +246,11 @@ EquationMatching::writeVariableVertexes(const Model& m)
   {
     if (!m.getCompartment(n)->getConstant())
     {
-      mVariables.append(m.getCompartment(n)->getId());
+      addVariable(m.getCompartment(n)->getId());
     }
     else if (m.getLevel() == 1)
     {
-      mVariables.append(m.getCompartment(n)->getId());
+      addVariable(m.getCompartment(n)->getId());
     }
   }
 
@@ -271,11 +258,11 @@ EquationMatching::writeVariableVertexes(const Model& m)
   {
     if (!m.getSpecies(n)->getConstant())
     {
-      mVariables.append(m.getSpecies(n)->getId());
+      addVariable(m.getSpecies(n)->getId());
     }
     else if (m.getLevel() == 1)
     {
-      mVariables.append(m.getSpecies(n)->getId());
+      addVariable(m.getSpecies(n)->getId());
     }
   }
 
@@ -283,11 +270,11 @@ EquationMatching::writeVariableVertexes(const Model& m)
   {
     if (!m.getParameter(n)->getConstant())
     {
-      mVariables.append(m.getParameter(n)->getId());
+      addVariable(m.getParameter(n)->getId());
     }
     else if (m.getLevel() == 1)
     {
-      mVariables.append(m.getParameter(n)->getId());
+      addVariable(m.getParameter(n)->getId());
     }
   }
 
@@ -295,7 +282,7 @@ EquationMatching::writeVariableVertexes(const Model& m)
   {
     if (m.getReaction(n)->isSetKineticLaw())
     {
-      mVariables.append(m.getReaction(n)->getId());
+      addVariable(m.getReaction(n)->getId());
     }
     if (m.getLevel() > 2)
     {
@@ -307,20 +294,51 @@ EquationMatching::writeVariableVertexes(const Model& m)
       {
         if (m.getReaction(n)->getReactant(k)->getConstant() == false )
         {
-          mVariables.append(m.getReaction(n)->getReactant(k)->getId());
+          addVariable(m.getReaction(n)->getReactant(k)->getId());
         }
       }
       for (k = 0; k < m.getReaction(n)->getNumProducts(); k++)
       {
         if (m.getReaction(n)->getProduct(k)->getConstant() == false )
         {
-          mVariables.append(m.getReaction(n)->getProduct(k)->getId());
+          addVariable(m.getReaction(n)->getProduct(k)->getId());
         }
       }
     }
   }
 }
 
+
+/*
+ * appends the variable vertex and returns its integer id; a name that
+ * is already present keeps the id it was given first
+ */
+unsigned int
+EquationMatching::addVariable(const std::string& id)
+{
+  mVariables.append(id);
+
+  return mVariableIds.insert(
+    make_pair(id, (unsigned int)(mVariableIds.size()))).first->second;
+}
+
+
+/*
+ * connects the equation vertex to the variable vertex with the given 
+ * name, if there is one
+ */
+void
+EquationMatching::addEdge(unsigned int eqn, const std::string& id)
+{
+  map<string, unsigned int>::const_iterator it = mVariableIds.find(id);
+
+  if (it != mVariableIds.end())
+  {
+    mGraph[eqn].push_back(it->second);
+  }
+}
+
+
 unsigned int 
 EquationMatching::getNumEquations()
 {
@@ -334,24 +352,18 @@ EquationMatching::getNumVariables()
 /*
  * creates a bipartite graph according to the L2V2 spec 4.11.5 
  * creates edges between the equation vertexes and the variable vertexes
- * graph produced is an id representimg the equation and an IdList
- * listing the edges the equation vertex is connected to
+ * graph produced is indexed by the position of the equation vertex and
+ * lists the integer ids of the variable vertexes it is connected to
  */
 void
 EquationMatching::createGraph(const Model& m)
 {
-  IdList joined;
-  IdList speciesAdded;
   unsigned int n, sr;
-  const Reaction *r;
-  const Species *s;
-  const char * sId;
   const Rule *rule;
   const ASTNode *math;
   const KineticLaw * kl;
   List * names;
   ASTNode * node;
-  string name;
 
   /* create a list of ids relating to
    * 1. species
@@ -368,6 +380,8 @@ EquationMatching::createGraph(const Model& m)
    */
   writeVariableVertexes(m);
 
+  mGraph.assign(mEquations.size(), vector<unsigned int>());
+
   /* create the edges for the graph */
 
   /*
@@ -376,57 +390,25 @@ EquationMatching::createGraph(const Model& m)
    * or product lists of a Reaction structure containing a KineticLaw structure. 
    * The edge connects the vertex representing the species 
    *    to the vertex representing the species' equation
+   * 
+   * these are the equation vertexes written before those of the rules
+   * and kinetic laws
    */
-
-  speciesAdded.clear();
-  unsigned int eqnCount = 0;
+  unsigned int numSpeciesEqns = mEquations.size() - m.getNumRules();
   for (n = 0; n < m.getNumReactions(); n++)
   {
     if (m.getReaction(n)->isSetKineticLaw())
     {
-      r = m.getReaction(n);
-      for (sr = 0; sr < r->getNumReactants(); sr++)
-      {
-        s = m.getSpecies(r->getReactant(sr)->getSpecies());
-        sId = s->getId().c_str();
-
-        if (mEquations.contains(sId) 
-          && mVariables.contains(sId)
-          && !speciesAdded.contains(sId))
-        {
-          joined.append(sId);
-          speciesAdded.append(sId);
-        }
-        if (joined.size() > 0)
-        {
-          mGraph[mEquations.at((int)eqnCount)] = joined;
-          joined.clear();
-          eqnCount++;
-        }
-      }
-
-      for (sr = 0; sr < r->getNumProducts(); sr++)
-      {
-        s = m.getSpecies(r->getProduct(sr)->getSpecies());
-        sId = s->getId().c_str();
-
-        if (mEquations.contains(sId) 
-          && mVariables.contains(sId)
-          && !speciesAdded.contains(sId))
-        {
-          joined.append(sId);
-          speciesAdded.append(sId);
-        }
-        if (joined.size() > 0)
-        {
-          mGraph[mEquations.at((int)eqnCount)] = joined;
-          joined.clear();
-          eqnCount++;
-        }
-      }
+      numSpeciesEqns--;
     }
   }
 
+  unsigned int eqnCount = 0;
+  for (eqnCount = 0; eqnCount < numSpeciesEqns; eqnCount++)
+  {
+    addEdge(eqnCount, mEquations.at((int)eqnCount));
+  }
+
   /* rules */
   for (n = 0; n < m.getNumRules(); n++)
   {
@@ -439,10 +421,7 @@ EquationMatching::createGraph(const Model& m)
      */
     if (rule->isAssignment() || rule->isRate())
     {
-      if (mVariables.contains(rule->getVariable()))
-      {
-        joined.append(rule->getVariable());
-      }
+      addEdge(eqnCount, rule->getVariable());
     }
 
     /*
@@ -462,19 +441,13 @@ EquationMatching::createGraph(const Model& m)
       for (sr = 0; sr < names->getSize(); sr++)
       {
         node = static_cast<ASTNode*>( names->get(sr) );
-        name = node->getName() ? node->getName() : "";
-        if (mVariables.contains(name))
-        {
-          joined.append(name);
-        }
+        addEdge(eqnCount, node->getName() ? node->getName() : "");
       }
 
       delete names;
 
     }
 
-    mGraph[mEquations.at((int)eqnCount)] = joined;
-    joined.clear();
     eqnCount++;
   }
 
@@ -489,10 +462,7 @@ EquationMatching::createGraph(const Model& m)
        * to the variable vertex representing the Reaction containing the 
        * KineticLaw.
        */
-      if (mVariables.contains(m.getReaction(n)->getId()))
-      {
-        joined.append(m.getReaction(n)->getId());
-      }
+      addEdge(eqnCount, m.getReaction(n)->getId());
 
       /*
        * the occurrence of a MathML ci symbol referencing a variable within 
@@ -513,267 +483,167 @@ EquationMatching::createGraph(const Model& m)
         for (sr = 0; sr < names->getSize(); sr++)
         {
           node = static_cast<ASTNode*>( names->get(sr) );
-          name = node->getName() ? node->getName() : "";
-          if (mVariables.contains(name))
-          {
-            joined.append(name);
-          }
+          addEdge(eqnCount, node->getName() ? node->getName() : "");
         }
 
-  delete names;
-  
+        delete names;
       }
-      mGraph[mEquations.at((int)eqnCount)] = joined;
-      joined.clear();
       eqnCount++;
     }
   }
 }
 
 /*
- * finds a maximal matching of the bipartite graph
- * adapted from the only implementation I could find:
- * # Hopcroft-Karp bipartite max-cardinality mMatching and max independent set
- * # David Eppstein, UC Irvine, 27 Apr 2002 - Python Cookbook
+ * finds a maximum matching of the bipartite graph using the
+ * Hopcroft-Karp algorithm, starting from a greedy matching
  *
  * returns an IdList of any equation vertexes that are unconnected 
- * in the maximal matching
+ * in the maximum matching
  */ 
 IdList 
 EquationMatching::findMatching()
 {
   IdList unmatchedEquations;
+  unsigned int n, p;
 
+  mEquationMatch.assign(mGraph.size(), NO_MATCH);
+  mVariableMatch.assign(mVariableIds.size(), NO_MATCH);
 
-  unsigned int n, p;
-  IdList temp;
-  IdList tempVarsInMatching;
-  IdList unmatch;
-  IdList layer;
-  IdList unmatchFlag;
-  unmatchFlag.append("unmatched");
-  graph newLayer;
-
-  /* create greedy mMatching */
-  for (n = 0; n < mEquations.size(); n++)
+  /* create greedy matching */
+  for (n = 0; n < mGraph.size(); n++)
   {
-    for (p = 0; p < mGraph[mEquations.at((int)n)].size(); p++)
+    for (p = 0; p < mGraph[n].size(); p++)
     {
-      if (mMatching.count(mGraph[mEquations.at((int)n)].at((int)p)) == 0)
+      if (mVariableMatch[mGraph[n][p]] == NO_MATCH)
       {
-        temp.append(mEquations.at((int)n));
-        mMatching[mGraph[mEquations.at((int)n)].at((int)p)] = temp;
-        temp.clear();
+        mVariableMatch[mGraph[n][p]] = n;
+        mEquationMatch[n] = mGraph[n][p];
         break;
       }
     }
   }
 
-  unsigned int maximal = 1;
-  while (maximal == 1)
+  /* each phase augments along a maximal set of vertex disjoint 
+   * shortest augmenting paths
+   */
+  while (buildLayers())
   {
-    unmatch.clear();
-    mVarNeighInPrev.clear();
-
-    /* create mEqnNeighInPrev - graph giving neighbour in previous layer */
-
-    /* list of variables in mMatching */
-    tempVarsInMatching.clear();
-    for (graph::iterator iter = mMatching.begin(); iter != mMatching.end(); iter++)
-    {
-      tempVarsInMatching.append((*iter).second.at(0));
-    }
-
+    mNextEdge.assign(mGraph.size(), 0);
 
-    for (n = 0; n < mEquations.size(); n++)
+    for (n = 0; n < mGraph.size(); n++)
     {
-      if (!tempVarsInMatching.contains(mEquations.at((int)n)))
+      if (mEquationMatch[n] == NO_MATCH)
       {
-        mEqnNeighInPrev[mEquations.at((int)n)] = unmatchFlag;
-        layer.append(mEquations.at((int)n));
+        augment(n);
       }
     }
+  }
 
-    /* extend layering structure */
-    while (layer.size() > 0 && unmatch.size() == 0)
+  /* list any equations that are not matched */
+  for (n = 0; n < mGraph.size(); n++)
+  {
+    if (mEquationMatch[n] == NO_MATCH)
     {
-      graph::iterator iter;
+      unmatchedEquations.append(mEquations.at((int)n));
+    }
+  }
 
-      newLayer.clear();
+  return unmatchedEquations;
+}
 
-      temp.clear();
-      for (iter = mVarNeighInPrev.begin(); 
-                        iter != mVarNeighInPrev.end(); iter++)
-      {
-        temp.append((*iter).first); 
-      }
-      for (n = 0; n < layer.size(); n++)
-      {
-        for (p = 0; p < mGraph[layer.at((int)n)].size(); p++)
-        {
-          if (!temp.contains(mGraph[layer.at((int)n)].at((int)p)))
-          {
-            newLayer[mGraph[layer.at((int)n)].at((int)p)].append(layer.at((int)n));
-          }
-        }
-      }
 
-      layer.clear();
-      temp.clear();
-      for (iter = newLayer.begin(); 
-                        iter != newLayer.end(); iter++)
-      {
-        mVarNeighInPrev[(*iter).first] = (*iter).second;
-        if (tempVarsInMatching.contains((*iter).first))
-        {
-          layer.append(mMatching[(*iter).first].at(0));
-          temp.append((*iter).first);
-          mEqnNeighInPrev[mMatching[(*iter).first].at(0)] = temp;
-        }
-        else
-        {
-          unmatch.append((*iter).first);
-        }
-      }
-    } // end of extending layers while statement
+bool
+EquationMatching::buildLayers()
+{
+  vector<unsigned int> queue;
+  unsigned int n, p, eqn, next;
+
+  mLayer.assign(mGraph.size(), NO_MATCH);
+  mFreeLayer = NO_MATCH;
 
-    /* finished without needing alternative paths */
-    if (unmatch.size() == 0)
+  for (n = 0; n < mGraph.size(); n++)
+  {
+    if (mEquationMatch[n] == NO_MATCH)
     {
-      /* list any equations that are not matched */
-      temp.clear();
-      for (graph::iterator iter = mMatching.begin(); 
-                        iter != mMatching.end(); iter++)
-      {
-        temp.append(mMatching[(*iter).first].at(0));
-      }
+      mLayer[n] = 0;
+      queue.push_back(n);
+    }
+  }
+
+  for (n = 0; n < queue.size(); n++)
+  {
+    eqn = queue[n];
 
-      for (n = 0; n < mEquations.size(); n++)
+    /* no need to look past the layer of the shortest augmenting path */
+    if (mLayer[eqn] >= mFreeLayer) break;
+
+    for (p = 0; p < mGraph[eqn].size(); p++)
+    {
+      next = mVariableMatch[mGraph[eqn][p]];
+
+      if (next == NO_MATCH)
       {
-        if (!temp.contains(mEquations.at((int)n)))
+        if (mFreeLayer == NO_MATCH)
         {
-          unmatchedEquations.append(mEquations.at((int)n));
+          mFreeLayer = mLayer[eqn] + 1;
         }
       }
-      maximal = 0;
-    }
-    else
-    {
-      for (n = 0; n < unmatch.size(); n++)
+      else if (mLayer[next] == NO_MATCH)
       {
-        maximal = Recurse(unmatch.at((int)n));
-        if (maximal == 2) break;
+        mLayer[next] = mLayer[eqn] + 1;
+        queue.push_back(next);
       }
     }
   }
 
-  if (maximal == 2)
-  {
-    // we have a flip flopping set of matches
-    unmatchedEquations.append(mMatching[unmatch.at((int)n)].at(0));
-  }
-  return unmatchedEquations;
-
+  return mFreeLayer != NO_MATCH;
 }
 
 
-/*
- * function that looks for alternative paths and adds these to the matching
- * where necessary
- */
-unsigned int
-EquationMatching::Recurse(std::string v)
+bool
+EquationMatching::augment(unsigned int eqn)
 {
-  //static graph revisited;
-  //static IdList visited;
-  unsigned int rec = 0;
-  unsigned int n;
-  IdList tempVarNeigh;
-  IdList tempEqnNeigh;
-  IdList L;
-  IdList pu;
-  IdList prev;
+  vector<unsigned int> path;
+  unsigned int top, var, next;
 
-  graph::iterator iter;
+  path.push_back(eqn);
 
-  tempVarNeigh.clear();
-  for (iter = mVarNeighInPrev.begin(); 
-                    iter != mVarNeighInPrev.end(); iter++)
+  while (!path.empty())
   {
-    tempVarNeigh.append((*iter).first);
-  }
+    top = path.back();
 
-  tempEqnNeigh.clear();
-  for (iter = mEqnNeighInPrev.begin(); 
-                    iter != mEqnNeighInPrev.end(); iter++)
-  {
-    tempEqnNeigh.append((*iter).first);
-  }
+    if (mNextEdge[top] == mGraph[top].size())
+    {
+      /* a dead end - no other path will get through here in this phase */
+      mLayer[top] = NO_MATCH;
+      path.pop_back();
+      continue;
+    }
 
-  if (tempVarNeigh.contains(v))
-  {
-    L = mVarNeighInPrev[v];
-    mVarNeighInPrev.erase(v);
+    var = mGraph[top][mNextEdge[top]++];
+    next = mVariableMatch[var];
 
-    for (n = 0; n < L.size(); n++)
+    if (next == NO_MATCH)
     {
-      if (tempEqnNeigh.contains(L.at((int)n)))
-      {
-        pu = mEqnNeighInPrev[L.at((int)n)];
-        mEqnNeighInPrev.erase(L.at((int)n));
+      if (mLayer[top] + 1 != mFreeLayer) continue;
 
-        if (pu.size() == 0)
-          break;
-
-        if (pu.size() == 1 && !strcmp(pu.at(0).c_str(), "unmatched"))
-        {
-          /* look to see if variable has been here before
-           * in order t catch variables that are flip flopping
-           * between equations
-           */
-          bool repeat = false;
-          if (!visited.contains(v))
-          {
-            visited.append(v);
-            revisited[v] = L;
-          }
-          else
-          {
-            prev = revisited[v];
-            unsigned int i;
-            for (i = 0; i < L.size(); i++)
-            {
-              if (prev.contains(L.at((int)i)))
-              {
-                repeat = true;
-              }
-              else
-              {
-                prev.append(L.at((int)i));
-              }
-              if (repeat) break;
-            }
-          }
-          if (!repeat)
-          {
-            mMatching[v] = L;
-            rec = 1;
-          }
-          else
-          {
-            rec = 2;
-            return rec;
-          }
-        }
-        else if (Recurse(pu.at(0)))
-        {
-          mMatching[v] = L;
-          rec = 1;
-        }
+      /* flip the matching along the path */
+      for (size_t i = path.size(); i > 0; i--)
+      {
+        top = path[i - 1];
+        var = mGraph[top][mNextEdge[top] - 1];
+        mVariableMatch[var] = top;
+        mEquationMatch[top] = var;
       }
+      return true;
+    }
+    else if (mLayer[next] == mLayer[top] + 1)
+    {
+      path.push_back(next);
     }
   }
-  return rec;
+
+  return false;
 }
 
 
@@ -782,14 +652,16 @@ EquationMatching::Recurse(std::string v)
 bool
 EquationMatching::match_dependency(const std::string& var, const std::string& eq)
 {
-  bool match = false;
-  IdList matches = mMatching[var];
+  map<string, unsigned int>::const_iterator v = mVariableIds.find(var);
+  map<string, unsigned int>::const_iterator e = mEquationIds.find(eq);
 
-  if (matches.size() == 1 && matches.at(0) == eq)
-    match = true;
+  if (v == mVariableIds.end() || e == mEquationIds.end() 
+    || e->second >= mEquationMatch.size())
+  {
+    return false;
+  }
 
-  
-  return match;
+  return mEquationMatch[e->second] == v->second;
 }
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
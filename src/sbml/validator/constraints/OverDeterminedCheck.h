@@ -62,8 +62,6 @@
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
-typedef std::map< std::string, IdList> graph;
-
 class Model;
 class Validator;
 
@@ -99,42 +97,59 @@ public:
   /**
    * creates a bipartite graph according to the L2V2 spec 4.11.5 
    * creates edges between the equation vertexes and the variable vertexes
-   * graph produced is an id representimg the equation and an IdList
-   * listing the edges the equation vertex is connected to
+   * graph produced is indexed by the position of the equation vertex and
+   * lists the integer ids of the variable vertexes it is connected to
    */
   void createGraph(const Model &);
 
   /**
-   * finds a maximal matching of the bipartite graph
-   * adapted from the only implementation I could find:
-   * # Hopcroft-Karp bipartite max-cardinality mMatching and max independent set
-   * # David Eppstein, UC Irvine, 27 Apr 2002 - Python Cookbook
+   * finds a maximum matching of the bipartite graph using the
+   * Hopcroft-Karp algorithm, starting from a greedy matching
    *
    * returns an IdList of any equation vertexes that are unconnected 
-   * in the maximal matching
+   * in the maximum matching
    */
   IdList findMatching();
 
-  /**
-  * function that looks for alternative paths and adds these to the matching
-  * where necessary
-  */
-  unsigned int Recurse(std::string);
-
   bool match_dependency(const std::string& var, const std::string& eq); 
 
 
   IdList mEquations; // list of equation vertexes
   IdList mVariables; // list of variable vertexes
-  graph mGraph;
 
-  /* these are to enable the bipartite matching without passing variables */
-  graph mMatching;
-  graph mVarNeighInPrev;
-  graph mEqnNeighInPrev;
+  /* integer ids of the vertexes; a repeated name maps to the first id */
+  std::map<std::string, unsigned int> mEquationIds;
+  std::map<std::string, unsigned int> mVariableIds;
+
+  /* variable ids connected to each equation vertex */
+  std::vector< std::vector<unsigned int> > mGraph;
+
+  /* the matching in both directions */
+  std::vector<unsigned int> mEquationMatch;
+  std::vector<unsigned int> mVariableMatch;
+
+protected:
+
+  unsigned int addVariable(const std::string& id);
+
+  void addEdge(unsigned int eqn, const std::string& id);
+
+  /**
+   * builds the layers of the breadth first search from the unmatched
+   * equations; returns false when there is no augmenting path left
+   */
+  bool buildLayers();
+
+  /**
+   * follows the layers from the unmatched equation vertex and flips the
+   * first augmenting path it finds
+   */
+  bool augment(unsigned int eqn);
 
-  graph revisited;
-  IdList visited;
+  /* these are to enable the search without passing variables */
+  std::vector<unsigned int> mLayer;
+  std::vector<unsigned int> mNextEdge;
+  unsigned int mFreeLayer;
 };
 
 class OverDeterminedCheck: public TConstraint<Model>
@@ -233,9 +233,9 @@ PowerUnitsCheck::checkUnitsFromPower (const Model& m,
 
       if (tempUD->isVariantOfDimensionless())
       {
-        SBMLTransforms::mapComponentValues(&m);
-        double value1 = SBMLTransforms::evaluateASTNode(child);
-        SBMLTransforms::clearComponentValues();
+        SBMLEvaluationContext context(&m);
+        double value1 = SBMLTransforms::evaluateASTNode(child,
+                                                  context.getValues());
         if (!util_isNaN(value1))
         {
           if (floor(value1) != value1)
@@ -319,9 +319,8 @@ PowerUnitsCheck::checkUnitsFromPower (const Model& m,
       {
         // technically here there is an issue
         // stoichiometry is dimensionless
-        SBMLTransforms::mapComponentValues(&m);
-        double value1 = SBMLTransforms::evaluateASTNode(child, &m);
-        SBMLTransforms::clearComponentValues();
+        SBMLEvaluationContext context(&m);
+        double value1 = context.evaluateASTNode(child);
         // but it may not be an integer
         if (util_isNaN(value1))
           // we cant check
@@ -68,6 +68,7 @@ ExpatAttributes::ExpatAttributes (const XML_Char** attrs,
     mValues.push_back( string   ( attrs[2 * n + 1]  ) );
   }
 
+  indexNames();
   mElementName = elementName;
 }
 
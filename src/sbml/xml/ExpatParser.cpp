@@ -49,6 +49,7 @@
 
 #include <sbml/xml/XMLFileBuffer.h>
 #include <sbml/xml/XMLMemoryBuffer.h>
+#include <sbml/xml/XMLMmapBuffer.h>
 #include <sbml/xml/XMLErrorLog.h>
 
 #include <sbml/xml/ExpatHandler.h>
@@ -164,10 +165,11 @@ ExpatParser::reportError (const XMLErrorCode_t code,
  * The parser will notify the given XMLHandler of parse events and errors.
  */
 ExpatParser::ExpatParser (XMLHandler& handler) :
-   mParser ( XML_ParserCreateNS(NULL, ' ') )
- , mHandler( mParser, handler )
- , mBuffer ( NULL )
- , mSource ( NULL )
+   mParser    ( XML_ParserCreateNS(NULL, ' ') )
+ , mHandler   ( mParser, handler )
+ , mBuffer    ( NULL )
+ , mChunkBytes( BUFFER_SIZE )
+ , mSource    ( NULL )
 {
   if (mParser != NULL) mBuffer = XML_GetBuffer(mParser, BUFFER_SIZE);
 }
@@ -271,12 +273,23 @@ ExpatParser::parseFirst (const char* content, bool isFile)
   if ( error() ) return false;
  
   if (content == NULL) return false;
+
+  mChunkBytes = chooseChunkSize(content, isFile);
   
   if (isFile)
   {
     try
     {
-      mSource = new XMLFileBuffer(content);
+      if ( getUseMemoryMap() && XMLMmapBuffer::isMappable(content) )
+      {
+        XMLMmapBuffer* mapped = new XMLMmapBuffer(content);
+
+        // fall back to reading through a stream if the file can't be mapped
+        if ( mapped->error() ) delete mapped;
+        else                   mSource = mapped;
+      }
+
+      if ( mSource == NULL ) mSource = new XMLFileBuffer(content);
     }
     catch ( ZlibNotLinked& )
     {
@@ -296,6 +309,15 @@ ExpatParser::parseFirst (const char* content, bool isFile)
       reportError(XMLFileUnreadable, oss.str(), 0, 0);
       return false;
     } 
+    catch ( ZstdNotLinked& )
+    {
+      // libSBML is not linked with zstd.
+      std::ostringstream oss;
+      oss << "Tried to read " << content << ". Reading a zstd file is not enabled because "
+          << "underlying libSBML is not linked with zstd."; 
+      reportError(XMLFileUnreadable, oss.str(), 0, 0);
+      return false;
+    }
 
     if (mSource->error())
     {
@@ -334,35 +356,52 @@ ExpatParser::parseNext ()
 {
   if ( error() ) return false;
 
-  mBuffer = XML_GetBuffer(mParser, BUFFER_SIZE);
+  // A memory-mapped source is handed to Expat directly; anything else is
+  // copied into Expat's own buffer first.
 
-  if ( mBuffer == NULL )
+  unsigned int count = 0;
+  const char*  chunk = mSource->next(mChunkBytes, count);
+  XML_Status   status;
+  int          done;
+
+  if ( chunk != NULL )
+  {
+    done   = (count == 0);
+    status = XML_Parse(mParser, chunk, (int)count, done);
+  }
+  else
   {
-    // See if Expat logged an error.  There are only two things that
-    // XML_GetErrorCode will report: parser state errors and "out of memory".
-    // So we check for the first and default to the out-of-memory case.
+    mBuffer = XML_GetBuffer(mParser, (int)mChunkBytes);
 
-    switch ( XML_GetErrorCode(mParser) )
+    if ( mBuffer == NULL )
     {
-    case XML_ERROR_SUSPENDED:
-    case XML_ERROR_FINISHED:
-      reportError(InternalXMLParserError);
-      break;
-
-    default:
-      reportError(XMLOutOfMemory);
-      break;
+      // See if Expat logged an error.  There are only two things that
+      // XML_GetErrorCode will report: parser state errors and "out of memory".
+      // So we check for the first and default to the out-of-memory case.
+
+      switch ( XML_GetErrorCode(mParser) )
+      {
+      case XML_ERROR_SUSPENDED:
+      case XML_ERROR_FINISHED:
+        reportError(InternalXMLParserError);
+        break;
+
+      default:
+        reportError(XMLOutOfMemory);
+        break;
+      }
+
+      return false;
     }
 
-    return false;
+    int bytes = mSource->copyTo(mBuffer, mChunkBytes);
+    done      = (bytes == 0);
+    status    = XML_ParseBuffer(mParser, bytes, done);
   }
 
-  int bytes = mSource->copyTo(mBuffer, BUFFER_SIZE);
-  int done  = (bytes == 0);
-
-  // Attempt to parse the content, checking for the Expat return status.
+  // Check the Expat return status.
 
-  if ( XML_ParseBuffer(mParser, bytes, done) == XML_STATUS_ERROR )
+  if ( status == XML_STATUS_ERROR )
   {
     reportError(translateError(XML_GetErrorCode(mParser)), "",
 		XML_GetCurrentLineNumber(mParser),
@@ -152,6 +152,7 @@ protected:
   XML_Parser    mParser;
   ExpatHandler  mHandler;
   void*         mBuffer;
+  unsigned int  mChunkBytes;
   XMLBuffer*    mSource;
 
 
@@ -41,6 +41,8 @@
  * also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <cstring>
+
 #include <sbml/xml/LibXMLTranscode.h>
 #include <sbml/xml/LibXMLAttributes.h>
 
@@ -61,9 +63,9 @@ LibXMLAttributes::LibXMLAttributes (  const xmlChar** attributes
 
   for (unsigned int n = 0; n < size; ++n)
   {
-    const string name    = LibXMLTranscode( attributes[5 * n]     );
-    const string prefix  = LibXMLTranscode( attributes[5 * n + 1] );
-    const string uri     = LibXMLTranscode( attributes[5 * n + 2], true );
+    const char* name     = reinterpret_cast<const char*>(attributes[5 * n]);
+    const char* prefix   = reinterpret_cast<const char*>(attributes[5 * n + 1]);
+    const char* uri      = reinterpret_cast<const char*>(attributes[5 * n + 2]);
 
     const xmlChar* start = attributes[5 * n + 3];
     const xmlChar* end   = attributes[5 * n + 4];
@@ -71,10 +73,23 @@ LibXMLAttributes::LibXMLAttributes (  const xmlChar** attributes
 
     const string value   =  LibXMLTranscode((length > 0) ? start : 0, true, length);
 
-    mNames .push_back( XMLTriple(name, uri, prefix) );
+    // only a URI holding a character reference needs transcoding; all
+    // others are interned as they are
+    if (uri != NULL && strstr(uri, "&#38;") != NULL)
+    {
+      const string transcoded = LibXMLTranscode( attributes[5 * n + 2], true );
+      mNames.push_back( XMLTriple(string(name != NULL ? name : ""), transcoded,
+                                  string(prefix != NULL ? prefix : "")) );
+    }
+    else
+    {
+      mNames.push_back( XMLTriple(name, uri, prefix) );
+    }
+
     mValues.push_back( value );
   }
 
+  indexNames();
   mElementName = LibXMLTranscode(elementName);
 }
 
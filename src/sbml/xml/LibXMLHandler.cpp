@@ -239,11 +239,11 @@ LibXMLHandler::startElement (  const xmlChar*           localname
                              , const LibXMLAttributes&  attributes
                              , const LibXMLNamespaces&  namespaces )
 {
-  const string nsuri    = LibXMLTranscode( uri       );
-  const string name     = LibXMLTranscode( localname );
-  const string nsprefix = LibXMLTranscode( prefix    );
-
-  const XMLTriple  triple ( name, nsuri, nsprefix );
+  // libxml hands over UTF-8, which XMLTriple interns without copying it
+  // into temporary strings first
+  const XMLTriple  triple ( reinterpret_cast<const char*>(localname),
+                            reinterpret_cast<const char*>(uri),
+                            reinterpret_cast<const char*>(prefix) );
   const XMLToken   element( triple, attributes, namespaces,
                             getLine(), getColumn() );
 
@@ -263,11 +263,11 @@ LibXMLHandler::endElement (  const xmlChar*   localname
                            , const xmlChar*   prefix
                            , const xmlChar*   uri )
 {
-  const string nsuri    = LibXMLTranscode( uri       );
-  const string name     = LibXMLTranscode( localname );
-  const string nsprefix = LibXMLTranscode( prefix    );
-
-  const XMLTriple  triple ( name, nsuri, nsprefix );
+  // libxml hands over UTF-8, which XMLTriple interns without copying it
+  // into temporary strings first
+  const XMLTriple  triple ( reinterpret_cast<const char*>(localname),
+                            reinterpret_cast<const char*>(uri),
+                            reinterpret_cast<const char*>(prefix) );
   const XMLToken   element( triple, getLine(), getColumn() );
 
   mHandler.endElement(element);
@@ -48,6 +48,7 @@
 
 #include <sbml/xml/XMLFileBuffer.h>
 #include <sbml/xml/XMLMemoryBuffer.h>
+#include <sbml/xml/XMLMmapBuffer.h>
 
 #include <sbml/xml/LibXMLHandler.h>
 #include <sbml/xml/LibXMLParser.h>
@@ -243,10 +244,12 @@ LibXMLParser::reportError (const XMLErrorCode_t code,
  * of parse events and errors.
  */
 LibXMLParser::LibXMLParser (XMLHandler& handler) :
-   mParser ( NULL                  )
- , mHandler( handler               )
- , mBuffer ( new char[BUFFER_SIZE] )
- , mSource ( NULL                  )
+   mParser     ( NULL                  )
+ , mHandler    ( handler               )
+ , mBuffer     ( new char[BUFFER_SIZE] )
+ , mBufferSize ( BUFFER_SIZE           )
+ , mChunkBytes ( BUFFER_SIZE           )
+ , mSource     ( NULL                  )
 {
   xmlSAXHandler* sax  = LibXMLHandler::getInternalHandler();
   void*          data = static_cast<void*>(&mHandler);
@@ -348,12 +351,23 @@ LibXMLParser::parseFirst (const char* content, bool isFile)
   if ( error() ) return false;
   
   if (content == NULL) return false;
+
+  mChunkBytes = chooseChunkSize(content, isFile);
   
   if ( isFile )
   {
     try
     {
-      mSource = new XMLFileBuffer(content);
+      if ( getUseMemoryMap() && XMLMmapBuffer::isMappable(content) )
+      {
+        XMLMmapBuffer* mapped = new XMLMmapBuffer(content);
+
+        // fall back to reading through a stream if the file can't be mapped
+        if ( mapped->error() ) delete mapped;
+        else                   mSource = mapped;
+      }
+
+      if ( mSource == NULL ) mSource = new XMLFileBuffer(content);
     }
     catch ( ZlibNotLinked& )
     {
@@ -373,6 +387,15 @@ LibXMLParser::parseFirst (const char* content, bool isFile)
       reportError(XMLFileUnreadable, oss.str(), 0, 0);
       return false;
     } 
+    catch ( ZstdNotLinked& )
+    {
+      // libSBML is not linked with zstd.
+      std::ostringstream oss;
+      oss << "Tried to read " << content << ". Reading a zstd file is not enabled because "
+          << "underlying libSBML is not linked with zstd."; 
+      reportError(XMLFileUnreadable, oss.str(), 0, 0);
+      return false;
+    }
 
 
     if ( mSource->error() )
@@ -412,7 +435,25 @@ LibXMLParser::parseNext ()
 {
   if ( error() ) return false;
 
-  int bytes = (int)mSource->copyTo(mBuffer, BUFFER_SIZE);
+  // a memory-mapped source is handed to libxml directly, anything else is
+  // copied into our buffer first
+  unsigned int count = 0;
+  const char*  chunk = mSource->next(mChunkBytes, count);
+
+  if ( chunk == NULL )
+  {
+    if ( mBufferSize < mChunkBytes )
+    {
+      delete [] mBuffer;
+      mBuffer     = new char[mChunkBytes];
+      mBufferSize = mChunkBytes;
+    }
+
+    count = mSource->copyTo(mBuffer, mChunkBytes);
+    chunk = mBuffer;
+  }
+
+  int bytes = (int)count;
   int done  = (bytes == 0);
 
   if ( mSource->error() )
@@ -422,7 +463,7 @@ LibXMLParser::parseNext ()
     return false;
   }
 
-  if ( xmlParseChunk(mParser, mBuffer, bytes, done) )
+  if ( xmlParseChunk(mParser, chunk, bytes, done) )
   {
     xmlErrorPtr libxmlError = xmlGetLastError();
 
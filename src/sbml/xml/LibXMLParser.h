@@ -148,6 +148,8 @@ protected:
   xmlParserCtxt*  mParser;
   LibXMLHandler   mHandler;
   char*           mBuffer;
+  unsigned int    mBufferSize;
+  unsigned int    mChunkBytes;
   XMLBuffer*      mSource;
 
 
@@ -50,6 +50,7 @@
 #include <sbml/xml/XMLAttributes.h>
 /** @cond doxygenLibsbmlInternal */
 #include <sbml/xml/XMLOutputStream.h>
+#include <sbml/xml/XMLStringTable.h>
 #include <sbml/util/util.h>
 /** @endcond */
 
@@ -59,6 +60,14 @@ using namespace std;
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 #ifdef __cplusplus
+
+/*
+ * Attribute sets with at least this many attributes keep a hash index of
+ * their names; shorter ones are searched linearly.
+ */
+static const size_t MIN_INDEXED_LENGTH = 8;
+
+
 /*
  * @return s with whitespace removed from the beginning and end.
  */
@@ -74,10 +83,34 @@ trim (const std::string& s)
 }
 
 
+/*
+ * Sets first and last to the beginning and end of s with whitespace
+ * removed from both ends, as trim() would.
+ */
+static void
+trimmedRange (const std::string& s, const char*& first, const char*& last)
+{
+  first = s.data();
+  last  = first + s.size();
+
+  while (first != last && (*first == ' ' || *first == '\t' ||
+                           *first == '\r' || *first == '\n'))
+  {
+    ++first;
+  }
+
+  while (last != first && (last[-1] == ' ' || last[-1] == '\t' ||
+                           last[-1] == '\r' || last[-1] == '\n'))
+  {
+    --last;
+  }
+}
+
+
 /*
  * Creates a new empty XMLAttributes set.
  */
-XMLAttributes::XMLAttributes () : mLog( NULL )
+XMLAttributes::XMLAttributes () : mLog( NULL ), mIndexed( 0 )
 {
 }
 
@@ -97,6 +130,8 @@ XMLAttributes::XMLAttributes(const XMLAttributes& orig)
  , mValues(orig.mValues.begin(), orig.mValues.end())
  , mElementName(orig.mElementName)
  , mLog(orig.mLog)
+ , mIndex(orig.mIndex)
+ , mIndexed(orig.mIndexed)
 {
 }
 
@@ -113,6 +148,8 @@ XMLAttributes::operator=(const XMLAttributes& rhs)
     this->mValues.assign( rhs.mValues.begin(), rhs.mValues.end() ); 
     this->mElementName = rhs.mElementName;
     this->mLog = rhs.mLog;
+    this->mIndex = rhs.mIndex;
+    this->mIndexed = rhs.mIndexed;
   }
 
   return *this;
@@ -154,6 +191,7 @@ XMLAttributes::add (const std::string& name,
   {
     mNames .push_back( XMLTriple(name, namespaceURI, prefix) );
     mValues.push_back( value );
+    indexNames();
   }
   else
   {
@@ -187,6 +225,7 @@ XMLAttributes::addResource (const std::string& name, const std::string& value)
 {
   mNames .push_back( XMLTriple(name, "", "") );
   mValues.push_back( value );
+  indexNames();
   return LIBSBML_OPERATION_SUCCESS;
 }
 /** @endcond */
@@ -211,6 +250,11 @@ XMLAttributes::removeResource (int n)
   mNames.erase(names_iter);
   mValues.erase(values_iter);
 
+  // the indices after n have shifted
+  mIndex.clear();
+  mIndexed = 0;
+  indexNames();
+
   return LIBSBML_OPERATION_SUCCESS;
 }
 /** @endcond */
@@ -256,6 +300,8 @@ XMLAttributes::clear()
 {
   mNames.clear();
   mValues.clear();
+  mIndex.clear();
+  mIndexed = 0;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -268,9 +314,23 @@ XMLAttributes::clear()
 int
 XMLAttributes::getIndex (const std::string& name) const
 {
+  if (isIndexed())
+  {
+    const size_t mask = mIndex.size() - 1;
+    size_t       slot = XMLStringTable::hash(name.data(), name.size()) & mask;
+
+    for ( ; mIndex[slot] != -1; slot = (slot + 1) & mask)
+    {
+      const int index = mIndex[slot];
+      if (mNames[(size_t)index].getName() == name) return index;
+    }
+
+    return -1;
+  }
+
   for (int index = 0; index < getLength(); ++index)
   {
-    if (getName(index) == name) return index;
+    if (mNames[(size_t)index].getName() == name) return index;
   }
   
   return -1;
@@ -286,9 +346,27 @@ XMLAttributes::getIndex (const std::string& name) const
 int
 XMLAttributes::getIndex (const std::string& name, const std::string& uri) const
 {
+  if (isIndexed())
+  {
+    const size_t mask = mIndex.size() - 1;
+    size_t       slot = XMLStringTable::hash(name.data(), name.size()) & mask;
+
+    for ( ; mIndex[slot] != -1; slot = (slot + 1) & mask)
+    {
+      const XMLTriple& triple = mNames[(size_t)mIndex[slot]];
+      if ( (triple.getName() == name) && (triple.getURI() == uri) )
+      {
+        return mIndex[slot];
+      }
+    }
+
+    return -1;
+  }
+
   for (int index = 0; index < getLength(); ++index)
   {
-    if ( (getName(index) == name) && (getURI(index) == uri) ) return index;
+    const XMLTriple& triple = mNames[(size_t)index];
+    if ( (triple.getName() == name) && (triple.getURI() == uri) ) return index;
   }
   
   return -1;
@@ -303,6 +381,19 @@ XMLAttributes::getIndex (const std::string& name, const std::string& uri) const
 int 
 XMLAttributes::getIndex (const XMLTriple& triple) const
 {
+  if (isIndexed())
+  {
+    const std::string& name = triple.getName();
+    const size_t       mask = mIndex.size() - 1;
+    size_t             slot = XMLStringTable::hash(name.data(), name.size()) & mask;
+
+    for ( ; mIndex[slot] != -1; slot = (slot + 1) & mask)
+    {
+      if (mNames[(size_t)mIndex[slot]] == triple) return mIndex[slot];
+    }
+
+    return -1;
+  }
 
   for (int index = 0; index < getLength(); ++index)
   {
@@ -313,6 +404,62 @@ XMLAttributes::getIndex (const XMLTriple& triple) const
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Brings the name index up to date after attributes were appended to
+ * mNames; sets shorter than MIN_INDEXED_LENGTH drop the index.  Entries
+ * are inserted in attribute order, so that a probe meets the first of
+ * several attributes with the same name first, as a linear search would.
+ */
+void
+XMLAttributes::indexNames ()
+{
+  const size_t length = mNames.size();
+
+  if (length < MIN_INDEXED_LENGTH)
+  {
+    mIndex.clear();
+    mIndexed = 0;
+    return;
+  }
+
+  // keep at least half of the slots empty
+  if (mIndexed > length || mIndex.size() < 2 * length)
+  {
+    size_t slots = 2 * MIN_INDEXED_LENGTH;
+    while (slots < 2 * length) slots *= 2;
+
+    mIndex.assign(slots, -1);
+    mIndexed = 0;
+  }
+
+  const size_t mask = mIndex.size() - 1;
+
+  for ( ; mIndexed < length; ++mIndexed)
+  {
+    const std::string& name = mNames[mIndexed].getName();
+    size_t             slot = XMLStringTable::hash(name.data(), name.size()) & mask;
+
+    while (mIndex[slot] != -1) slot = (slot + 1) & mask;
+
+    mIndex[slot] = (int)mIndexed;
+  }
+}
+
+
+/*
+ * The index is only used when it covers every attribute; attributes
+ * appended to mNames directly are found by the linear search until
+ * indexNames() is called.
+ */
+bool
+XMLAttributes::isIndexed () const
+{
+  return !mIndex.empty() && mIndexed == mNames.size();
+}
+/** @endcond */
+
+
 /*
  * @return the number of attributes in this list.
  */
@@ -633,11 +780,28 @@ XMLAttributes::readInto (  int          index
   bool assigned = false;
   bool missing  = true;
 
-  if ( index != -1 )
+  if ( index >= 0 && index < getLength() )
   {
-    const std::string& trimmed = trim( getValue(index) );
-    if ( !trimmed.empty() )
+    const char* first;
+    const char* last;
+    trimmedRange(mValues[(size_t)index], first, last);
+
+    double parsed     = 0;
+    int    outOfRange = 0;
+
+    if ( first != last
+      && util_parseDouble(first, last, &parsed, &outOfRange) == last
+      && !outOfRange )
+    {
+      value    = parsed;
+      assigned = true;
+    }
+    else if ( first != last )
     {
+      // special values and anything strtod accepts beyond plain decimal
+      // numbers, or that it reports as out of range
+      const std::string trimmed(first, last);
+
       if (trimmed == "-INF")
       {
         value    = - numeric_limits<double>::infinity();
@@ -779,11 +943,28 @@ XMLAttributes::readInto (  int          index
   bool assigned = false;
   bool missing  = true;
 
-  if ( index != -1 )
+  if ( index >= 0 && index < getLength() )
   {
-    const std::string& trimmed = trim( getValue(index) );
-    if ( !trimmed.empty())
+    const char* first;
+    const char* last;
+    trimmedRange(mValues[(size_t)index], first, last);
+
+    long parsed     = 0;
+    int  outOfRange = 0;
+
+    if ( first != last
+      && util_parseLong(first, last, &parsed, &outOfRange) == last
+      && !outOfRange )
     {
+      missing  = false;
+      value    = parsed;
+      assigned = true;
+    }
+    else if ( first != last )
+    {
+      // anything else strtol accepts, such as leading vertical tabs
+      const std::string trimmed(first, last);
+
       missing = false;
 
       errno               = 0;
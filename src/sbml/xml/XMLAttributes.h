@@ -1808,6 +1808,19 @@ protected:
                  , const unsigned int column   = 0) const;
 
 
+  /**
+   * Updates the hash index of attribute names after attributes have been
+   * added.  Subclasses that fill mNames directly call this once they are
+   * done; until then lookups fall back to a linear search.
+   */
+  void indexNames ();
+
+
+  /**
+   * @returns @c true if the name index covers every attribute.
+   */
+  bool isIndexed () const;
+
 
   std::vector<XMLTriple>    mNames;
   std::vector<std::string>  mValues;
@@ -1815,6 +1828,10 @@ protected:
   std::string               mElementName;
   XMLErrorLog*              mLog;
 
+  // open addressing hash index of mNames by name, or empty for short sets
+  std::vector<int>          mIndex;
+  size_t                    mIndexed;
+
   /** @endcond */
 };
 
@@ -41,6 +41,8 @@
  * also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <cstddef>
+
 #include <sbml/xml/XMLBuffer.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
@@ -60,5 +62,17 @@ XMLBuffer::~XMLBuffer ()
 {
 }
 
+
+/*
+ * Returns a pointer to at most bytes of the remaining content of this
+ * XMLBuffer, or NULL if the content can only be copied out with copyTo().
+ */
+const char*
+XMLBuffer::next (unsigned int /*bytes*/, unsigned int& count)
+{
+  count = 0;
+  return NULL;
+}
+
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
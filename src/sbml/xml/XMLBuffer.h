@@ -77,6 +77,20 @@ public:
   virtual bool error () = 0;
 
 
+  /**
+   * Returns a pointer to at most @p bytes of the remaining content of this
+   * XMLBuffer and advances past them, storing the number of bytes made
+   * available in @p count.  The pointer stays valid for the lifetime of
+   * this XMLBuffer.
+   *
+   * Buffers that cannot hand out their content without copying it return
+   * @c NULL, in which case callers should use copyTo() instead.
+   *
+   * @return a pointer to the next @p count bytes, or @c NULL.
+   */
+  virtual const char* next (unsigned int bytes, unsigned int& count);
+
+
 protected:
 
   XMLBuffer ();
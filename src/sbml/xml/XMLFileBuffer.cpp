@@ -87,6 +87,11 @@ XMLFileBuffer::XMLFileBuffer (const string& filename)
     {
       mStream = InputDecompressor::openZipIStream(filename);
     }
+    // open a zstd file
+    else if ( string::npos != filename.find(".zst", filename.length() - 4) )
+    {
+      mStream = InputDecompressor::openZstdIStream(filename);
+    }
     else
     {
       // open an uncompressed file
@@ -103,6 +108,11 @@ XMLFileBuffer::XMLFileBuffer (const string& filename)
     // liBSBML is not linked with bzip2.
     throw;
   }
+  catch ( ZstdNotLinked& )
+  {
+    // liBSBML is not linked with zstd.
+    throw;
+  }
 
   if(mStream != NULL)
   {
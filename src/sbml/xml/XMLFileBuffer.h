@@ -67,7 +67,8 @@ public:
    * @note ZlibNotLinked will be thrown if .gz or .zip file is given and 
    * zlib is not linked with libSBML at compile time. Similarly, Bzip2NotLinked
    * will be thrown if .bz2 file is given and bzip2 is not linked with libSBML 
-   * at compile time.
+   * at compile time, and ZstdNotLinked if .zst file is given and zstd is not
+   * linked with libSBML at compile time.
    */
   XMLFileBuffer (const std::string& filename);
 
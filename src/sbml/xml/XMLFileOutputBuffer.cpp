@@ -0,0 +1,341 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLFileOutputBuffer.cpp
+ * @brief   XMLFileOutputBuffer is a stream buffer writing to a file descriptor
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#if defined(WIN32) && !defined(CYGWIN)
+
+#include <io.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#else
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#endif
+
+#include <sbml/xml/XMLFileOutputBuffer.h>
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * The buffer size used when none is given.
+ */
+static const size_t DEFAULT_SIZE = 262144;
+
+
+/*
+ * The largest buffer handed out; the put area is advanced with pbump(),
+ * which takes an int.
+ */
+static const size_t MAX_SIZE = 1073741824;
+
+
+/*
+ * Creates a stream buffer writing to the given file.
+ */
+XMLFileOutputBuffer::XMLFileOutputBuffer (const string& filename,
+                                          size_t        bufferSize) :
+   mBuffer ( NULL  )
+ , mSize   ( (bufferSize == 0) ? DEFAULT_SIZE : bufferSize )
+ , mFile   ( -1    )
+ , mError  ( false )
+{
+  if (mSize > MAX_SIZE) mSize = MAX_SIZE;
+
+#if defined(WIN32) && !defined(CYGWIN)
+  // text mode, so that line endings match those written by std::ofstream
+  mFile = _open(filename.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_TEXT,
+                _S_IREAD | _S_IWRITE);
+#else
+  int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_CLOEXEC
+  flags |= O_CLOEXEC;
+#endif
+
+  do
+  {
+    mFile = open(filename.c_str(), flags, 0666);
+  }
+  while (mFile < 0 && errno == EINTR);
+#endif
+
+  if (mFile < 0) return;
+
+  mBuffer = new(std::nothrow) char[mSize];
+
+  if (mBuffer == NULL)
+  {
+    close();
+    mError = true;
+    return;
+  }
+
+  setp(mBuffer, mBuffer + mSize);
+}
+
+
+/*
+ * Destroys this XMLFileOutputBuffer, writing out pending output first.
+ */
+XMLFileOutputBuffer::~XMLFileOutputBuffer ()
+{
+  close();
+  delete [] mBuffer;
+}
+
+
+/*
+ * Writes out pending output and closes the file.
+ */
+bool
+XMLFileOutputBuffer::close ()
+{
+  if (mFile < 0) return false;
+
+  flushBuffer();
+
+#if defined(WIN32) && !defined(CYGWIN)
+  if (_close(mFile) != 0) mError = true;
+#else
+  // on failure the descriptor is released anyway; retrying could close a
+  // descriptor opened meanwhile by another thread
+  if (::close(mFile) != 0) mError = true;
+#endif
+
+  mFile = -1;
+  setp(NULL, NULL);
+
+  return !mError;
+}
+
+
+/*
+ * @return true if the file is open.
+ */
+bool
+XMLFileOutputBuffer::isOpen () const
+{
+  return (mFile >= 0);
+}
+
+
+/*
+ * @return true if writing to the file has failed.
+ */
+bool
+XMLFileOutputBuffer::error () const
+{
+  return mError;
+}
+
+
+/*
+ * @return the size of the buffer in bytes.
+ */
+size_t
+XMLFileOutputBuffer::getBufferSize () const
+{
+  return mSize;
+}
+
+
+/*
+ * Called when the buffer is full: writes it out and appends c.
+ */
+XMLFileOutputBuffer::int_type
+XMLFileOutputBuffer::overflow (int_type c)
+{
+  if (!flushBuffer()) return traits_type::eof();
+
+  if (traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    return traits_type::not_eof(c);
+  }
+
+  *pptr() = traits_type::to_char_type(c);
+  pbump(1);
+
+  return c;
+}
+
+
+/*
+ * Appends n characters to the buffer, or writes them out together with
+ * the pending output if they would not fit into an empty buffer.
+ */
+streamsize
+XMLFileOutputBuffer::xsputn (const char* s, streamsize n)
+{
+  if (n <= 0) return 0;
+
+  const size_t length = (size_t)n;
+
+  if (mFile < 0 || mError) return 0;
+
+  if (length <= (size_t)(epptr() - pptr()))
+  {
+    memcpy(pptr(), s, length);
+    pbump((int)length);
+    return n;
+  }
+
+  if (length < mSize)
+  {
+    if (!flushBuffer()) return 0;
+
+    memcpy(pptr(), s, length);
+    pbump((int)length);
+    return n;
+  }
+
+  if (!writeOut(pbase(), (size_t)(pptr() - pbase()), s, length)) return 0;
+
+  setp(mBuffer, mBuffer + mSize);
+  return n;
+}
+
+
+/*
+ * Writes out pending output.
+ */
+int
+XMLFileOutputBuffer::sync ()
+{
+  return flushBuffer() ? 0 : -1;
+}
+
+
+/*
+ * Writes out the pending output and empties the buffer.
+ */
+bool
+XMLFileOutputBuffer::flushBuffer ()
+{
+  if (mFile < 0 || mError) return false;
+
+  if (!writeOut(pbase(), (size_t)(pptr() - pbase()), NULL, 0)) return false;
+
+  setp(mBuffer, mBuffer + mSize);
+  return true;
+}
+
+
+/*
+ * Writes the two given blocks, in order, to the file, retrying after
+ * partial writes and interruptions.
+ */
+bool
+XMLFileOutputBuffer::writeOut (const char* first,  size_t firstLength,
+                               const char* second, size_t secondLength)
+{
+  while (firstLength + secondLength > 0)
+  {
+#if defined(WIN32) && !defined(CYGWIN)
+    const char*  data   = (firstLength > 0) ? first : second;
+    size_t       length = (firstLength > 0) ? firstLength : secondLength;
+    unsigned int count  = (length > MAX_SIZE) ? (unsigned int)MAX_SIZE
+                                              : (unsigned int)length;
+
+    int written = _write(mFile, data, count);
+#else
+    struct iovec parts[2];
+    int          count = 0;
+
+    if (firstLength > 0)
+    {
+      parts[count].iov_base = const_cast<char*>(first);
+      parts[count].iov_len  = firstLength;
+      ++count;
+    }
+
+    if (secondLength > 0)
+    {
+      parts[count].iov_base = const_cast<char*>(second);
+      parts[count].iov_len  = secondLength;
+      ++count;
+    }
+
+    ssize_t written = writev(mFile, parts, count);
+#endif
+
+    if (written < 0)
+    {
+      if (errno == EINTR) continue;
+
+      mError = true;
+      return false;
+    }
+
+    size_t done = (size_t)written;
+
+    if (done < firstLength)
+    {
+      first       += done;
+      firstLength -= done;
+    }
+    else
+    {
+      done        -= firstLength;
+      first       += firstLength;
+      firstLength  = 0;
+      second       += done;
+      secondLength -= done;
+    }
+  }
+
+  return true;
+}
+
+LIBSBML_CPP_NAMESPACE_END
+/** @endcond */
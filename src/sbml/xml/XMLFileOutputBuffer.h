@@ -0,0 +1,142 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLFileOutputBuffer.h
+ * @brief   XMLFileOutputBuffer is a stream buffer writing to a file descriptor
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+
+#ifndef XMLFileOutputBuffer_h
+#define XMLFileOutputBuffer_h
+
+#ifdef __cplusplus
+
+#include <string>
+#include <cstddef>
+#include <streambuf>
+
+#include <sbml/common/extern.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class XMLFileOutputBuffer : public std::streambuf
+{
+public:
+
+  /**
+   * Creates a stream buffer writing to the given file, which is created
+   * or truncated.  Output is collected in a buffer of the given size and
+   * handed to the operating system directly, without the locale and
+   * character conversion layers of std::filebuf; writes larger than the
+   * buffer go out in a single system call together with whatever is
+   * pending.
+   *
+   * If the file cannot be opened, isOpen() returns @c false and all
+   * output fails.
+   *
+   * @param filename the name of the file to write.
+   * @param bufferSize the size of the buffer in bytes, or @c 0 for the
+   * default of 256 KB.
+   */
+  XMLFileOutputBuffer (const std::string& filename, size_t bufferSize = 0);
+
+
+  /**
+   * Destroys this XMLFileOutputBuffer, writing out pending output and
+   * closing the file if close() has not been called.
+   */
+  virtual ~XMLFileOutputBuffer ();
+
+
+  /**
+   * Writes out pending output and closes the file.
+   *
+   * @return @c true if all output was written and the file was closed
+   * without error, @c false otherwise.
+   */
+  bool close ();
+
+
+  /**
+   * @return @c true if the file is open, @c false if it could not be
+   * opened or has been closed.
+   */
+  bool isOpen () const;
+
+
+  /**
+   * @return @c true if writing to the file has failed, @c false otherwise.
+   */
+  bool error () const;
+
+
+  /**
+   * @return the size of the buffer in bytes.
+   */
+  size_t getBufferSize () const;
+
+
+protected:
+
+  virtual int_type overflow (int_type c);
+  virtual std::streamsize xsputn (const char* s, std::streamsize n);
+  virtual int sync ();
+
+
+private:
+
+  XMLFileOutputBuffer ();
+  XMLFileOutputBuffer (const XMLFileOutputBuffer&);
+  XMLFileOutputBuffer& operator= (const XMLFileOutputBuffer&);
+
+  bool writeOut (const char* first, size_t firstLength,
+                 const char* second, size_t secondLength);
+
+  bool flushBuffer ();
+
+  char*   mBuffer;
+  size_t  mSize;
+  int     mFile;
+  bool    mError;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* XMLFileOutputBuffer_h */
+/** @endcond */
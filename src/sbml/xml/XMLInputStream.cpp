@@ -59,7 +59,9 @@ class XMLParser;
 XMLInputStream::XMLInputStream (  const char*   content
                                 , bool          isFile
                                 , const std::string  library 
-                                , XMLErrorLog*  errorLog ) :
+                                , XMLErrorLog*  errorLog
+                                , bool          useMemoryMap
+                                , unsigned int  chunkSize ) :
 
 
    mIsError ( false )
@@ -72,6 +74,8 @@ XMLInputStream::XMLInputStream (  const char*   content
 
   if ( !isGood() ) return;
   if ( errorLog != NULL ) setErrorLog(errorLog);
+  if ( useMemoryMap ) mParser->setUseMemoryMap(true);
+  if ( chunkSize > 0 ) mParser->setChunkSize(chunkSize);
   // if this fails we should probably flag the stream as error
   if (!mParser->parseFirst(content, isFile))
     mIsError = true; 
@@ -316,22 +320,55 @@ XMLInputStream::setSBMLNamespaces(SBMLNamespaces * sbmlns)
   }
 }
 
+/*
+ * The counting functions of the tokenizer can only give a valid answer
+ * once the end of the element they count the children of has been queued.
+ * Rather than counting again each time the parser has queued more tokens,
+ * only count again when one of the new tokens is an end tag with that
+ * name.  The tokenizer stops two tokens short of the end of the queue, so
+ * the last two tokens of the previous count are looked at again.
+ */
+bool
+XMLInputStream::needsRecount(const std::string& name, size_t& checked, 
+                             size_t counted)
+{
+  if (counted < 2)
+  {
+    return true;
+  }
+
+  size_t start = (checked == counted) ? counted - 2 : checked;
+  checked = this->mTokenizer.mTokens.size();
+
+  return this->mTokenizer.hasEndElement(name, start);
+}
+
+
 unsigned int
 XMLInputStream::determineNumberChildren(const std::string elementName)
 {
   bool valid = false;
   unsigned int num = this->mTokenizer.determineNumberChildren(valid, elementName);
+  size_t counted = this->mTokenizer.mTokens.size();
+  size_t checked = counted;
+  const std::string closingTag = elementName.empty() ? "apply" : elementName;
 
   bool canReQ = true;
   while (canReQ == true && isGood() == true && valid == false)
   {
     canReQ = requeueToken();
-    if (canReQ == true)
+    if (canReQ == true && needsRecount(closingTag, checked, counted))
     {
       num = this->mTokenizer.determineNumberChildren(valid, elementName);
+      counted = checked = this->mTokenizer.mTokens.size();
     }
   }
 
+  if (valid == false && counted != this->mTokenizer.mTokens.size())
+  {
+    num = this->mTokenizer.determineNumberChildren(valid, elementName);
+  }
+
   return num;
 }
 
@@ -343,17 +380,27 @@ XMLInputStream::determineNumSpecificChildren(const std::string& childName,
   bool valid = false;
   unsigned int num = this->mTokenizer.determineNumSpecificChildren(valid, 
                                                        childName, container);
+  size_t counted = this->mTokenizer.mTokens.size();
+  size_t checked = counted;
 
-  while (isGood() == true && valid == false)
+  bool canReQ = true;
+  while (canReQ == true && isGood() == true && valid == false)
   {
-    requeueToken();
-    if (isGood() == true)
+    canReQ = requeueToken();
+    if (canReQ == true && needsRecount(container, checked, counted))
     {
       num = this->mTokenizer.determineNumSpecificChildren(valid, 
                                                        childName, container);
+      counted = checked = this->mTokenizer.mTokens.size();
     }
   }
 
+  if (valid == false && counted != this->mTokenizer.mTokens.size())
+  {
+    num = this->mTokenizer.determineNumSpecificChildren(valid, 
+                                                       childName, container);
+  }
+
   return num;
 }
 
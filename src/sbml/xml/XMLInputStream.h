@@ -151,12 +151,21 @@ public:
    *
    * @param errorLog the XMLErrorLog object to use.
    *
+   * @param useMemoryMap a boolean flag to indicate whether an uncompressed
+   * file named by @p content is memory-mapped rather than read through a
+   * stream.  Ignored if @p isFile is @c false.
+   *
+   * @param chunkSize the number of bytes the parser reads at a time, or
+   * @c 0 to choose it from the size of @p content.
+   *
    * @ifnot hasDefaultArgs @htmlinclude warn-default-args-in-docs.html @endif@~
    */
   XMLInputStream (  const char*        content
-                  , bool               isFile   = true
-                  , const std::string  library  = "" 
-                  , XMLErrorLog*       errorLog = NULL );
+                  , bool               isFile       = true
+                  , const std::string  library      = "" 
+                  , XMLErrorLog*       errorLog     = NULL
+                  , bool               useMemoryMap = false
+                  , unsigned int       chunkSize    = 0 );
 
 
   /**
@@ -420,6 +429,14 @@ protected:
   bool requeueToken ();
 
 
+  /**
+   * Returns true if the tokens queued since the children were last
+   * counted may change the count.
+   */
+  bool needsRecount (const std::string& name, size_t& checked, 
+                     size_t counted);
+
+
   bool mIsError;
 
   XMLToken     mEOF;
@@ -0,0 +1,264 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLMmapBuffer.cpp
+ * @brief   XMLMmapBuffer implements the XMLBuffer interface for memory-mapped files
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+
+#include <cstring>
+
+#if defined(WIN32) && !defined(CYGWIN)
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <windows.h>
+
+#else
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#endif
+
+#include <sbml/xml/XMLMmapBuffer.h>
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Creates a XMLBuffer by mapping the given file read-only into memory.
+ */
+XMLMmapBuffer::XMLMmapBuffer (const string& filename) :
+   mData   ( NULL  )
+ , mLength ( 0     )
+ , mOffset ( 0     )
+ , mError  ( true  )
+#if defined(WIN32) && !defined(CYGWIN)
+ , mFile   ( INVALID_HANDLE_VALUE )
+ , mMapping( NULL  )
+#endif
+{
+#if defined(WIN32) && !defined(CYGWIN)
+
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                            NULL);
+  if (file == INVALID_HANDLE_VALUE) return;
+
+  mFile = file;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart < 0) return;
+
+  if ((unsigned long long)size.QuadPart > (size_t)(-1)) return;
+
+  mLength = (size_t)size.QuadPart;
+
+  // CreateFileMapping refuses empty files; there is nothing to map anyway
+  if (mLength == 0)
+  {
+    mError = false;
+    return;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL) return;
+
+  mMapping = mapping;
+
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (view == NULL) return;
+
+  mData  = static_cast<const char*>(view);
+  mError = false;
+
+#else
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) return;
+
+  struct stat info;
+
+  // only regular files can be mapped; pipes and devices are left to the
+  // stream based XMLFileBuffer
+  if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) ||
+      (unsigned long long)info.st_size > (size_t)(-1))
+  {
+    close(fd);
+    return;
+  }
+
+  mLength = (size_t)info.st_size;
+
+  if (mLength > 0)
+  {
+    void* view = mmap(NULL, mLength, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (view == MAP_FAILED)
+    {
+      close(fd);
+      mLength = 0;
+      return;
+    }
+
+#ifdef MADV_SEQUENTIAL
+    madvise(view, mLength, MADV_SEQUENTIAL);
+#endif
+
+    mData = static_cast<const char*>(view);
+  }
+
+  // the mapping keeps its own reference to the file
+  close(fd);
+  mError = false;
+
+#endif
+}
+
+
+/*
+ * Destroys this XMLMmapBuffer and unmaps the underlying file.
+ */
+XMLMmapBuffer::~XMLMmapBuffer ()
+{
+#if defined(WIN32) && !defined(CYGWIN)
+  if (mData    != NULL) UnmapViewOfFile(mData);
+  if (mMapping != NULL) CloseHandle(static_cast<HANDLE>(mMapping));
+  if (mFile    != INVALID_HANDLE_VALUE) CloseHandle(static_cast<HANDLE>(mFile));
+#else
+  if (mData != NULL) munmap(const_cast<char*>(mData), mLength);
+#endif
+}
+
+
+/*
+ * Copies at most nbytes from this XMLMmapBuffer to the memory pointed to
+ * by destination.
+ *
+ * @return the number of bytes actually copied (may be 0).
+ */
+unsigned int
+XMLMmapBuffer::copyTo (void* destination, unsigned int bytes)
+{
+  unsigned int count = 0;
+  const char*  chunk = next(bytes, count);
+
+  if (count > 0) memcpy(destination, chunk, count);
+
+  return count;
+}
+
+
+/*
+ * @return @c true if the file could not be opened or mapped, false
+ * otherwise.
+ */
+bool
+XMLMmapBuffer::error ()
+{
+  return mError;
+}
+
+
+/*
+ * Returns a pointer into the mapping for at most bytes of the remaining
+ * content and advances past them.
+ */
+const char*
+XMLMmapBuffer::next (unsigned int bytes, unsigned int& count)
+{
+  size_t remaining = mLength - mOffset;
+
+  count = (remaining < bytes) ? (unsigned int)remaining : bytes;
+
+  const char* chunk = (mData != NULL) ? mData + mOffset : "";
+  mOffset += count;
+
+  return chunk;
+}
+
+
+/*
+ * @return a pointer to the start of the mapped content.
+ */
+const char*
+XMLMmapBuffer::getData () const
+{
+  return mData;
+}
+
+
+/*
+ * @return the number of bytes of mapped content.
+ */
+size_t
+XMLMmapBuffer::getLength () const
+{
+  return mLength;
+}
+
+
+/*
+ * Predicate returning true if XMLFileBuffer would read the given file as
+ * an uncompressed file.
+ */
+bool
+XMLMmapBuffer::isMappable (const string& filename)
+{
+  const size_t length = filename.length();
+
+  if (length >= 4 && filename.compare(length - 4, 4, ".xml") == 0) return true;
+
+  if (length >= 3 && filename.compare(length - 3, 3, ".gz")  == 0) return false;
+  if (length >= 4 && filename.compare(length - 4, 4, ".bz2") == 0) return false;
+  if (length >= 4 && filename.compare(length - 4, 4, ".zip") == 0) return false;
+  if (length >= 4 && filename.compare(length - 4, 4, ".zst") == 0) return false;
+
+  return true;
+}
+
+LIBSBML_CPP_NAMESPACE_END
+/** @endcond */
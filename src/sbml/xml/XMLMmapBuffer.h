@@ -0,0 +1,148 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLMmapBuffer.h
+ * @brief   XMLMmapBuffer implements the XMLBuffer interface for memory-mapped files
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+
+#ifndef XMLMmapBuffer_h
+#define XMLMmapBuffer_h
+
+#ifdef __cplusplus
+
+#include <string>
+#include <cstddef>
+
+#include <sbml/xml/XMLBuffer.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class XMLMmapBuffer : public XMLBuffer
+{
+public:
+
+  /**
+   * Creates a XMLBuffer by mapping the given file read-only into memory.
+   * The content is read straight from the mapping, so parsers can be fed
+   * without copying it through an intermediate stream buffer.
+   *
+   * If the file cannot be opened or mapped, error() returns @c true and
+   * the caller should fall back to an XMLFileBuffer.  An empty file is not
+   * an error; it simply yields no content.
+   */
+  XMLMmapBuffer (const std::string& filename);
+
+
+  /**
+   * Destroys this XMLMmapBuffer and unmaps the underlying file.
+   */
+  virtual ~XMLMmapBuffer ();
+
+
+  /**
+   * Copies at most nbytes from this XMLMmapBuffer to the memory pointed to
+   * by destination.
+   *
+   * @return the number of bytes actually copied (may be 0).
+   */
+  virtual unsigned int copyTo (void* destination, unsigned int bytes);
+
+
+  /**
+   * Returns @c true if the file could not be opened or mapped, @c false
+   * otherwise.
+   *
+   * @return @c true if there was an error mapping the underlying file,
+   * @c false otherwise.
+   */
+  virtual bool error ();
+
+
+  /**
+   * Returns a pointer into the mapping for at most @p bytes of the
+   * remaining content and advances past them.
+   *
+   * @return a pointer to the next @p count bytes of the file.
+   */
+  virtual const char* next (unsigned int bytes, unsigned int& count);
+
+
+  /**
+   * @return a pointer to the start of the mapped content, or @c NULL if
+   * the file is empty or could not be mapped.
+   */
+  const char* getData () const;
+
+
+  /**
+   * @return the number of bytes of mapped content.
+   */
+  size_t getLength () const;
+
+
+  /**
+   * Predicate returning @c true if the given file can be read through an
+   * XMLMmapBuffer, i.e., if XMLFileBuffer would read it as an uncompressed
+   * file rather than as a gzip, bzip2 or zip archive.
+   */
+  static bool isMappable (const std::string& filename);
+
+
+private:
+
+  XMLMmapBuffer ();
+  XMLMmapBuffer (const XMLMmapBuffer&);
+  XMLMmapBuffer& operator= (const XMLMmapBuffer&);
+
+  const char*   mData;
+  size_t        mLength;
+  size_t        mOffset;
+  bool          mError;
+
+#if defined(WIN32) && !defined(CYGWIN)
+  void*         mFile;
+  void*         mMapping;
+#endif
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* XMLMmapBuffer_h */
+/** @endcond */
@@ -46,6 +46,18 @@
 #include <fstream>
 
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if (__cplusplus >= 201703L) || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+#endif
+
 #include <sbml/xml/XMLTriple.h>
 #include <sbml/xml/XMLOutputStream.h>
 #include <sbml/xml/XMLAttributes.h>
@@ -63,6 +75,49 @@ using namespace std;
 LIBSBML_CPP_NAMESPACE_BEGIN
 #ifdef __cplusplus
 
+/*
+ * Writes the decimal digits of value to buffer, followed by a null
+ * character, and returns their number.
+ */
+static unsigned int
+formatUnsigned (unsigned long value, char* buffer)
+{
+  char  digits[24];
+  char* first = digits + sizeof(digits);
+
+  do
+  {
+    *--first = (char)('0' + value % 10);
+    value   /= 10;
+  }
+  while (value != 0);
+
+  const unsigned int length = (unsigned int)(digits + sizeof(digits) - first);
+
+  memcpy(buffer, first, length);
+  buffer[length] = '\0';
+
+  return length;
+}
+
+
+/*
+ * Writes value to buffer, followed by a null character, and returns the
+ * number of characters written.
+ */
+static unsigned int
+formatLong (long value, char* buffer)
+{
+  if (value < 0)
+  {
+    buffer[0] = '-';
+    return 1 + formatUnsigned(0UL - (unsigned long)value, buffer + 1);
+  }
+
+  return formatUnsigned((unsigned long)value, buffer);
+}
+
+
 /**
  * Checks if the given string has a character reference at index in the string.
  *
@@ -784,10 +839,21 @@ bool XMLOutputStream::getStringStream()
 void
 XMLOutputStream::writeIndent (bool isEnd)
 {
+  static const char spaces[] = "                                ";
+  static const unsigned int width = sizeof(spaces) - 1;
+
   if (mDoIndent)
   {
-    if (mIndent > 0 || isEnd) mStream << endl;
-    for (unsigned int n = 0; n < mIndent; ++n) mStream << ' ' << ' ';
+    // a newline rather than endl: flushing every line would hand each line
+    // to the operating system separately
+    if (mIndent > 0 || isEnd) mStream << '\n';
+
+    for (unsigned int n = 2 * mIndent; n > 0; )
+    {
+      unsigned int count = (n < width) ? n : width;
+      mStream.write(spaces, count);
+      n -= count;
+    }
   }
 }
 
@@ -798,9 +864,19 @@ XMLOutputStream::writeIndent (bool isEnd)
 void
 XMLOutputStream::writeChars (const std::string& chars)
 {
-  for (size_t i=0; i < chars.length(); i++)
+  const char*  data   = chars.data();
+  const size_t length = chars.length();
+  size_t       start  = 0;
+
+  // characters that need no escaping are written a run at a time
+  for (size_t i=0; i < length; i++)
   {
-    const char& c = chars.at(i);
+    const char& c = data[i];
+    if (c != '&' && c != '\'' && c != '<' && c != '>' && c != '"') continue;
+
+    if (i > start) mStream.write(data + start, (streamsize)(i - start));
+    start = i + 1;
+
     if ( c == '&' && 
         (LIBSBML_CPP_NAMESPACE ::hasCharacterReference(chars, i) || 
          LIBSBML_CPP_NAMESPACE ::hasPredefinedEntity(chars,i)) )
@@ -808,6 +884,8 @@ XMLOutputStream::writeChars (const std::string& chars)
 
     *this << c;
   }
+
+  if (length > start) mStream.write(data + start, (streamsize)(length - start));
 }
 
 
@@ -882,27 +960,11 @@ XMLOutputStream::writeValue (const bool& value)
 void
 XMLOutputStream::writeValue (const double& value)
 {
-  mStream << '=' << '"';
+  char         buffer[40] = { '=', '"' };
+  unsigned int length     = 2 + formatDouble(value, buffer + 2);
 
-  if (value != value)
-  {
-    mStream << "NaN";
-  }
-  else if (value == numeric_limits<double>::infinity())
-  {
-    mStream << "INF";
-  }
-  else if (value == - numeric_limits<double>::infinity())
-  {
-    mStream << "-INF";
-  }
-  else
-  {
-    mStream.precision(LIBSBML_DOUBLE_PRECISION);
-    mStream <<   value;
-  }
-
-  mStream << '"';
+  buffer[length++] = '"';
+  mStream.write(buffer, length);
 }
 
 
@@ -912,7 +974,11 @@ XMLOutputStream::writeValue (const double& value)
 void
 XMLOutputStream::writeValue (const long& value)
 {
-  mStream << '=' << '"' << value << '"';
+  char         buffer[32] = { '=', '"' };
+  unsigned int length     = 2 + formatLong(value, buffer + 2);
+
+  buffer[length++] = '"';
+  mStream.write(buffer, length);
 }
 
 
@@ -922,7 +988,7 @@ XMLOutputStream::writeValue (const long& value)
 void
 XMLOutputStream::writeValue (const int& value)
 {
-  mStream << '=' << '"' << value << '"';
+  writeValue( (long)value );
 }
 
 
@@ -932,7 +998,120 @@ XMLOutputStream::writeValue (const int& value)
 void
 XMLOutputStream::writeValue (const unsigned int& value)
 {
-  mStream << '=' << '"' << value << '"';
+  char         buffer[32] = { '=', '"' };
+  unsigned int length     = 2 + formatUnsigned(value, buffer + 2);
+
+  buffer[length++] = '"';
+  mStream.write(buffer, length);
+}
+
+
+/*
+ * Writes the shortest decimal form of value that reads back as the same
+ * double to buffer, laid out as printf's "%g" would.
+ */
+unsigned int
+XMLOutputStream::formatDouble (double value, char* buffer)
+{
+  if (value != value)
+  {
+    strcpy(buffer, "NaN");
+    return 3;
+  }
+  else if (value == numeric_limits<double>::infinity())
+  {
+    strcpy(buffer, "INF");
+    return 3;
+  }
+  else if (value == - numeric_limits<double>::infinity())
+  {
+    strcpy(buffer, "-INF");
+    return 4;
+  }
+
+  // first, the significant digits and exponent in scientific notation
+  char scientific[32];
+
+#if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+  std::to_chars_result result = std::to_chars(scientific,
+    scientific + sizeof(scientific) - 1, value, std::chars_format::scientific);
+  *result.ptr = '\0';
+#else
+  // the correctly rounded value with the fewest of 15, 16 or 17 digits
+  // that reads back as value; as sprintf and strtod agree on the decimal
+  // point of the current locale, the comparison holds in any locale
+  for (int precision = LIBSBML_DOUBLE_PRECISION; precision <= 17; ++precision)
+  {
+    sprintf(scientific, "%.*e", precision - 1, value);
+    if (precision == 17 || strtod(scientific, NULL) == value) break;
+  }
+#endif
+
+  const char* next      = scientific;
+  const bool  negative  = (*next == '-');
+  char        digits[24];
+  int         numDigits = 0;
+
+  if (negative) ++next;
+
+  for ( ; *next != 'e' && *next != '\0'; ++next)
+  {
+    if (*next >= '0' && *next <= '9' && numDigits < (int)sizeof(digits))
+    {
+      digits[numDigits++] = *next;
+    }
+  }
+
+  const int exponent = (*next == 'e') ? atoi(next + 1) : 0;
+
+  while (numDigits > 1 && digits[numDigits - 1] == '0') --numDigits;
+
+  // then lay them out as "%g" does
+  char* out = buffer;
+
+  if (negative) *out++ = '-';
+
+  if (exponent < -4 || exponent >= LIBSBML_DOUBLE_PRECISION)
+  {
+    *out++ = digits[0];
+    if (numDigits > 1)
+    {
+      *out++ = '.';
+      memcpy(out, digits + 1, (size_t)(numDigits - 1));
+      out += numDigits - 1;
+    }
+
+    *out++ = 'e';
+    *out++ = (exponent < 0) ? '-' : '+';
+    if (exponent > -10 && exponent < 10) *out++ = '0';
+    out += formatUnsigned((unsigned long)(exponent < 0 ? -exponent : exponent), out);
+  }
+  else if (exponent >= 0)
+  {
+    for (int i = 0; i <= exponent; ++i)
+    {
+      *out++ = (i < numDigits) ? digits[i] : '0';
+    }
+
+    if (numDigits > exponent + 1)
+    {
+      *out++ = '.';
+      memcpy(out, digits + exponent + 1, (size_t)(numDigits - exponent - 1));
+      out += numDigits - exponent - 1;
+    }
+  }
+  else
+  {
+    *out++ = '0';
+    *out++ = '.';
+    for (int i = -1; i > exponent; --i) *out++ = '0';
+    memcpy(out, digits, (size_t)numDigits);
+    out += numDigits;
+  }
+
+  *out = '\0';
+
+  return (unsigned int)(out - buffer);
 }
 
 void
@@ -1054,7 +1233,8 @@ XMLOutputStream::operator<< (const double& value)
     mStream << '>';
   }
 
-  mStream << value;
+  char buffer[32];
+  mStream.write(buffer, formatDouble(value, buffer));
 
   return *this;
 }
@@ -1072,7 +1252,8 @@ XMLOutputStream::operator<< (const long& value)
     mStream << '>';
   }
 
-  mStream << value;
+  char buffer[32];
+  mStream.write(buffer, formatLong(value, buffer));
 
   return *this;
 }
@@ -777,6 +777,19 @@ on yyyy-MM-dd HH:mm with libSBML version <libsbml version>. -->
   /** @cond doxygenLibsbmlInternal */
   unsigned int getIndent();
   void setIndent(unsigned int indent);
+
+
+  /**
+   * Writes the shortest decimal form of @p value that reads back as the
+   * same double, or "NaN", "INF" or "-INF", to @p buffer, which must hold
+   * at least 32 characters.  The digits are laid out as printf's "%g"
+   * lays out LIBSBML_DOUBLE_PRECISION digits, so values that need no more
+   * digits than that are written as before.
+   *
+   * @return the number of characters written, not counting the
+   * terminating null character.
+   */
+  static unsigned int formatDouble (double value, char* buffer);
   /** @endcond */
 
 private:
@@ -59,15 +59,33 @@
 #include <sbml/xml/XMLErrorLog.h>
 #include <sbml/xml/XMLParser.h>
 
+#include <cstring>
+#include <sys/types.h>
+#include <sys/stat.h>
+
 using namespace std;
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+/*
+ * The adaptive chunk size is the smallest power of two from MIN_CHUNK_SIZE
+ * that reads the content in at most CHUNKS_PER_CONTENT chunks, capped at
+ * MAX_CHUNK_SIZE.  LIMIT_CHUNK_SIZE is the largest size setChunkSize() accepts,
+ * as the back ends hand chunk lengths to the XML libraries as int.
+ */
+static const unsigned int MIN_CHUNK_SIZE     = 8192;
+static const unsigned int MAX_CHUNK_SIZE     = 262144;
+static const unsigned int CHUNKS_PER_CONTENT = 256;
+static const unsigned int LIMIT_CHUNK_SIZE   = 1073741824;
+
 /*
  * Creates a new XMLParser.  The parser will notify the given XMLHandler
  * of parse events and errors.
  */
-XMLParser::XMLParser () : mErrorLog(NULL)
+XMLParser::XMLParser () :
+    mErrorLog    ( NULL  )
+  , mUseMemoryMap( false )
+  , mChunkSize   ( 0     )
 {
 }
 
@@ -140,5 +158,98 @@ XMLParser::setErrorLog (XMLErrorLog* log)
 }
 
 
+/*
+ * Sets whether input files are memory-mapped instead of being read
+ * through a stream.
+ */
+int
+XMLParser::setUseMemoryMap (bool useMemoryMap)
+{
+  mUseMemoryMap = useMemoryMap;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return true if input files are memory-mapped, false otherwise.
+ */
+bool
+XMLParser::getUseMemoryMap () const
+{
+  return mUseMemoryMap;
+}
+
+
+/*
+ * Sets the number of bytes handed to the XML library per parseNext().
+ */
+int
+XMLParser::setChunkSize (unsigned int bytes)
+{
+  if (bytes > LIMIT_CHUNK_SIZE) return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+
+  mChunkSize = bytes;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the chunk size set with setChunkSize(), or 0 if it is adaptive.
+ */
+unsigned int
+XMLParser::getChunkSize () const
+{
+  return mChunkSize;
+}
+
+
+/*
+ * @return the chunk size used for content of the given length when no
+ * chunk size has been set.
+ */
+unsigned int
+XMLParser::getAdaptiveChunkSize (size_t length)
+{
+  size_t chunk = MIN_CHUNK_SIZE;
+
+  while (chunk < MAX_CHUNK_SIZE && chunk * CHUNKS_PER_CONTENT < length)
+  {
+    chunk *= 2;
+  }
+
+  return (unsigned int)chunk;
+}
+
+
+/*
+ * @return the chunk size to use for parsing the given content.
+ */
+unsigned int
+XMLParser::chooseChunkSize (const char* content, bool isFile) const
+{
+  if (mChunkSize > 0) return mChunkSize;
+  if (content == NULL) return MIN_CHUNK_SIZE;
+
+  size_t length = 0;
+
+  if (isFile)
+  {
+#ifdef _MSC_VER
+    struct _stat info;
+    if (_stat(content, &info) == 0) length = (size_t)info.st_size;
+#else
+    struct stat info;
+    if (stat(content, &info) == 0) length = (size_t)info.st_size;
+#endif
+  }
+  else
+  {
+    length = strlen(content);
+  }
+
+  return getAdaptiveChunkSize(length);
+}
+
+
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
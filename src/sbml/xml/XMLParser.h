@@ -55,6 +55,7 @@
 #ifdef __cplusplus
 
 #include <string>
+#include <cstddef>
 #include <sbml/xml/XMLExtern.h>
 #include <sbml/common/operationReturnValues.h>
 
@@ -179,6 +180,69 @@ public:
   int setErrorLog (XMLErrorLog* log);
 
 
+  /**
+   * Sets whether files passed to parse() or parseFirst() are memory-mapped
+   * instead of being read through a stream.  Mapping only applies to
+   * uncompressed files; compressed files and files that cannot be mapped
+   * are read as before.
+   *
+   * @param useMemoryMap @c true to memory-map input files.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   */
+  int setUseMemoryMap (bool useMemoryMap);
+
+
+  /**
+   * Returns @c true if this parser memory-maps its input files, @c false
+   * otherwise.
+   *
+   * @return @c true if input files are memory-mapped, @c false otherwise.
+   */
+  bool getUseMemoryMap () const;
+
+
+  /**
+   * Sets the number of bytes handed to the underlying XML library on each
+   * call to parseNext().  Larger chunks mean fewer calls into the library
+   * for large files; smaller chunks keep fewer parsed tokens pending
+   * during a progressive parse.  A value of @c 0 (the default) selects a
+   * chunk size from the size of the content; see getAdaptiveChunkSize().
+   *
+   * The chunk size applies to the Expat and libxml2 parsers; Xerces reads
+   * its input through its own buffers and ignores it.
+   *
+   * @param bytes the chunk size in bytes, or @c 0 for the adaptive size.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   */
+  int setChunkSize (unsigned int bytes);
+
+
+  /**
+   * Returns the chunk size set with setChunkSize(), or @c 0 if the chunk
+   * size is chosen from the size of the content.
+   *
+   * @return the chunk size in bytes, or @c 0.
+   */
+  unsigned int getChunkSize () const;
+
+
+  /**
+   * Returns the chunk size used for content of the given length when no
+   * chunk size has been set.  This is 8 KB for content up to 2 MB and
+   * doubles with every doubling of the content, up to 256 KB.
+   *
+   * @param length the length of the content in bytes.
+   *
+   * @return the chunk size in bytes.
+   */
+  static unsigned int getAdaptiveChunkSize (size_t length);
+
+
 protected:
   /**
    * Creates a new XMLParser.  The parser will notify the given XMLHandler
@@ -189,7 +253,17 @@ protected:
    */
   XMLParser ();
 
+
+  /**
+   * Returns the chunk size to use for parsing the given content: the size
+   * set with setChunkSize() or, if none is set, the adaptive size for the
+   * length of the content.
+   */
+  unsigned int chooseChunkSize (const char* content, bool isFile) const;
+
   XMLErrorLog* mErrorLog;
+  bool         mUseMemoryMap;
+  unsigned int mChunkSize;
 };
 
 
@@ -0,0 +1,281 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLStringTable.cpp
+ * @brief   Process-wide table of interned XML names, prefixes and URIs
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+
+#include <cstring>
+#include <vector>
+
+#include <sbml/xml/XMLStringTable.h>
+
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1700)
+#include <mutex>
+#elif defined(WIN32) && !defined(CYGWIN)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * The table is split into shards, chosen by the low bits of the hash, each
+ * with its own lock, so that parsers in different threads interning
+ * different names rarely wait for each other.
+ */
+#define XML_STRING_TABLE_SHARD_BITS 4
+#define XML_STRING_TABLE_NUM_SHARDS (1 << XML_STRING_TABLE_SHARD_BITS)
+
+/*
+ * The locks guarding the shards.  They must be usable before any
+ * constructor has run, as XMLTriple objects may be created during static
+ * initialization; each variant below is initialized statically.
+ */
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1700)
+
+static std::mutex sShardMutex[XML_STRING_TABLE_NUM_SHARDS];
+
+class XMLStringTableLock
+{
+public:
+  XMLStringTableLock (size_t shard) : mShard(shard)
+                                    { sShardMutex[mShard].lock();   }
+  ~XMLStringTableLock ()            { sShardMutex[mShard].unlock(); }
+private:
+  size_t mShard;
+};
+
+#elif defined(WIN32) && !defined(CYGWIN)
+
+static volatile LONG sShardMutex[XML_STRING_TABLE_NUM_SHARDS] = { 0 };
+
+class XMLStringTableLock
+{
+public:
+  XMLStringTableLock (size_t shard) : mShard(shard)
+  {
+    while (InterlockedCompareExchange(&sShardMutex[mShard], 1, 0) != 0)
+      Sleep(0);
+  }
+  ~XMLStringTableLock () { InterlockedExchange(&sShardMutex[mShard], 0); }
+private:
+  size_t mShard;
+};
+
+#else
+
+static pthread_mutex_t sShardMutex[XML_STRING_TABLE_NUM_SHARDS] =
+{
+  PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+  PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+  PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+  PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+  PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+  PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+  PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+  PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER
+};
+
+class XMLStringTableLock
+{
+public:
+  XMLStringTableLock (size_t shard) : mShard(shard)
+                                    { pthread_mutex_lock(&sShardMutex[mShard]);   }
+  ~XMLStringTableLock ()            { pthread_mutex_unlock(&sShardMutex[mShard]); }
+private:
+  size_t mShard;
+};
+
+#endif
+
+
+/*
+ * Each shard is an open addressing hash table of interned strings, indexed
+ * by the hash bits above the shard bits.  The slots are created on first
+ * use and deliberately never destroyed, so that XMLTriple objects destroyed
+ * during static destruction still point at valid strings.
+ */
+struct XMLStringTableShard
+{
+  vector<const string*>* mSlots;
+  size_t                 mCount;
+};
+
+static XMLStringTableShard sShards[XML_STRING_TABLE_NUM_SHARDS];
+
+
+size_t
+XMLStringTable::hash (const char* str, size_t length)
+{
+  // FNV-1a
+  size_t value = 2166136261u;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    value ^= (unsigned char)str[i];
+    value *= 16777619u;
+  }
+
+  return value;
+}
+
+
+/*
+ * Returns the slot holding the given string, or the empty slot where it
+ * belongs.  The number of slots is a power of two.
+ */
+static size_t
+findSlot (const vector<const string*>& slots, size_t hash,
+          const char* str, size_t length)
+{
+  const size_t mask = slots.size() - 1;
+  size_t       slot = (hash >> XML_STRING_TABLE_SHARD_BITS) & mask;
+
+  while (slots[slot] != NULL)
+  {
+    const string& entry = *slots[slot];
+
+    if (entry.size() == length && memcmp(entry.data(), str, length) == 0)
+    {
+      break;
+    }
+
+    slot = (slot + 1) & mask;
+  }
+
+  return slot;
+}
+
+
+static void
+growSlots (XMLStringTableShard& shard)
+{
+  vector<const string*>* grown =
+    new vector<const string*>(shard.mSlots->size() * 2, (const string*)NULL);
+
+  for (size_t i = 0; i < shard.mSlots->size(); ++i)
+  {
+    const string* entry = (*shard.mSlots)[i];
+    if (entry == NULL) continue;
+
+    size_t hash = XMLStringTable::hash(entry->data(), entry->size());
+    (*grown)[findSlot(*grown, hash, entry->data(), entry->size())] = entry;
+  }
+
+  delete shard.mSlots;
+  shard.mSlots = grown;
+}
+
+
+const string*
+XMLStringTable::intern (const char* str, size_t length)
+{
+  if (str == NULL)
+  {
+    str    = "";
+    length = 0;
+  }
+
+  const size_t hash  = XMLStringTable::hash(str, length);
+  const size_t index = hash & (XML_STRING_TABLE_NUM_SHARDS - 1);
+
+  XMLStringTableLock   lock(index);
+  XMLStringTableShard& shard = sShards[index];
+
+  if (shard.mSlots == NULL)
+  {
+    shard.mSlots = new vector<const string*>(32, (const string*)NULL);
+  }
+
+  size_t slot = findSlot(*shard.mSlots, hash, str, length);
+
+  if ((*shard.mSlots)[slot] == NULL)
+  {
+    // keep the load factor at or below one half
+    if (2 * (shard.mCount + 1) > shard.mSlots->size())
+    {
+      growSlots(shard);
+      slot = findSlot(*shard.mSlots, hash, str, length);
+    }
+
+    (*shard.mSlots)[slot] = new string(str, length);
+    ++shard.mCount;
+  }
+
+  return (*shard.mSlots)[slot];
+}
+
+
+const string*
+XMLStringTable::intern (const char* str)
+{
+  return intern(str, (str != NULL) ? strlen(str) : 0);
+}
+
+
+const string*
+XMLStringTable::intern (const string& str)
+{
+  return intern(str.data(), str.size());
+}
+
+
+size_t
+XMLStringTable::size ()
+{
+  size_t count = 0;
+
+  for (size_t index = 0; index < XML_STRING_TABLE_NUM_SHARDS; ++index)
+  {
+    XMLStringTableLock lock(index);
+    count += sShards[index].mCount;
+  }
+
+  return count;
+}
+
+LIBSBML_CPP_NAMESPACE_END
+/** @endcond */
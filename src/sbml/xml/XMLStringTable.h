@@ -0,0 +1,119 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLStringTable.h
+ * @brief   Process-wide table of interned XML names, prefixes and URIs
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+
+#ifndef XMLStringTable_h
+#define XMLStringTable_h
+
+#ifdef __cplusplus
+
+#include <string>
+#include <cstddef>
+
+#include <sbml/xml/XMLExtern.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * XMLStringTable keeps one shared copy of each distinct XML name, prefix
+ * and namespace URI seen by the process.  XMLTriple stores pointers into
+ * the table, so that the same element and attribute names read millions
+ * of times are allocated once, copying a triple copies three pointers,
+ * and equal strings compare as equal pointers.
+ *
+ * Interned strings live for the life of the process: they are never
+ * removed or freed, not even when the library is unloaded, so the table
+ * grows with the vocabulary of all documents read, not with their size.
+ * Applications that read documents with unbounded sets of element or
+ * attribute names (for example generated ones) keep all of them in memory.
+ *
+ * All functions are thread-safe.  The table is split into shards with one
+ * lock each, so concurrent parsers contend only when they intern names
+ * that fall into the same shard at the same time.
+ */
+class LIBLAX_EXTERN XMLStringTable
+{
+public:
+
+  /**
+   * Returns the interned copy of the @p length characters at @p str.
+   */
+  static const std::string* intern (const char* str, size_t length);
+
+
+  /**
+   * Returns the interned copy of the null-terminated @p str; a @c NULL
+   * pointer is taken as the empty string.
+   */
+  static const std::string* intern (const char* str);
+
+
+  /**
+   * Returns the interned copy of @p str.
+   */
+  static const std::string* intern (const std::string& str);
+
+
+  /**
+   * Returns the hash the table uses for the @p length characters at @p
+   * str; callers keeping their own small lookup tables of XML names may
+   * use it too.
+   */
+  static size_t hash (const char* str, size_t length);
+
+
+  /**
+   * Returns the number of distinct strings interned so far.
+   */
+  static size_t size ();
+
+
+private:
+
+  XMLStringTable ();
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* XMLStringTable_h */
+/** @endcond */
@@ -152,7 +152,7 @@ XMLToken::~XMLToken ()
  * Copy constructor; creates a copy of this XMLToken.
  */
 XMLToken::XMLToken(const XMLToken& orig)
- : mTriple()
+ : mTriple (orig.mTriple)
  , mAttributes()
  , mNamespaces()
  , mChars (orig.mChars)
@@ -162,9 +162,6 @@ XMLToken::XMLToken(const XMLToken& orig)
  , mLine (orig.mLine)
  , mColumn (orig.mColumn)
 {
-  if (!orig.mTriple.isEmpty())
-    mTriple = XMLTriple(orig.getName(), orig.getURI(), orig.getPrefix());
-  
   if (!orig.mAttributes.isEmpty())
     mAttributes = XMLAttributes(orig.getAttributes());
   
@@ -182,10 +179,7 @@ XMLToken::operator=(const XMLToken& rhs)
 {
   if(&rhs!=this)
   {
-    if (rhs.mTriple.isEmpty())
-      mTriple = XMLTriple();
-    else
-      mTriple = XMLTriple(rhs.getName(), rhs.getURI(), rhs.getPrefix());
+    mTriple = rhs.mTriple;
     
     if (rhs.mAttributes.isEmpty())
       mAttributes = XMLAttributes();
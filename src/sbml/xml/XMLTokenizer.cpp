@@ -317,12 +317,12 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
   // need to count the number of starts
 
   unsigned int index = 0;
-  XMLToken firstUnread = mTokens.at(index);
-  while (firstUnread.isText() && index < size - 1)
+  const XMLToken* firstUnread = &mTokens.at(index);
+  while (firstUnread->isText() && index < size - 1)
   {
     // skip any text
     index++;
-    firstUnread = mTokens.at(index);
+    firstUnread = &mTokens.at(index);
   }
 
 
@@ -336,12 +336,12 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
   // and the error gets logged elsewhere
   if (closingTag == "apply")
   {
-    std::string firstName = firstUnread.getName();
+    std::string firstName = firstUnread->getName();
 
     if (firstName != "ci" && firstName != "csymbol")
     {
-      if (firstUnread.isStart() != true 
-        || (firstUnread.isStart() == true &&  firstUnread.isEnd() != true))
+      if (firstUnread->isStart() != true 
+        || (firstUnread->isStart() == true &&  firstUnread->isEnd() != true))
       {
         valid = true;
         return numChildren;
@@ -358,25 +358,25 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
   unsigned int depth = 0;
   std::string name;
   bool cleanBreak = false;
-  XMLToken next = mTokens.at(index);
+  const XMLToken* next = &mTokens.at(index);
   while (index < size-2)
   {
     // skip any text elements
-    while(next.isText() == true && index < size-1)
+    while(next->isText() == true && index < size-1)
     {
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
-    if (next.isEnd() == true && next.getName() == closingTag)
+    if (next->isEnd() == true && next->getName() == closingTag)
     {
       valid = true;
       break;
     }
     // iterate to first start element
-    while (next.isStart() == false && index < size-1)
+    while (next->isStart() == false && index < size-1)
     {
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
 
     // check we have not reached the end
@@ -388,7 +388,7 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
     }
 
     // record the name of the start element
-    name = next.getName();
+    name = next->getName();
     numChildren++;
 
  //   index++;
@@ -398,12 +398,12 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
       numChildren = 0;
       break;
     }
-    else if (next.isEnd() == false)
+    else if (next->isEnd() == false)
     {
       index++;
       if (index < size)
       {
-        next = mTokens.at(index);
+        next = &mTokens.at(index);
       }
       else
       {
@@ -416,12 +416,12 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
     cleanBreak = false;
     while (index < size-1)
     {
-      if (next.isStart() == true && next.isEnd() == false && next.getName() == name)
+      if (next->isStart() == true && next->isEnd() == false && next->getName() == name)
       {
         depth++;
       }
 
-      if (next.isEnd() == true && next.getName() == name)
+      if (next->isEnd() == true && next->getName() == name)
       {
         if (depth == 0)
         {
@@ -435,13 +435,13 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
       }
 
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
 
     index++;
     if (index < size)
     {
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
   } 
 
@@ -449,7 +449,7 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
   // but the loop hits before it can record that it was valid
   if (valid == false && cleanBreak == true)
   {
-  if (index >= size-2 && next.isEnd() == true && next.getName() == closingTag)
+  if (index >= size-2 && next->isEnd() == true && next->getName() == closingTag)
   {
       valid = true;
   }
@@ -478,48 +478,48 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
   std::string prevName = "";
   std::string rogueTag = "";
   
-  XMLToken next = mTokens.at(index);
-  name = next.getName();
-  if (next.isStart() == true && next.isEnd() == true && 
+  const XMLToken* next = &mTokens.at(index);
+  name = next->getName();
+  if (next->isStart() == true && next->isEnd() == true && 
     name == qualifier && index < size)
   {
     numQualifiers++;
     index++;
-    next = mTokens.at(index);
+    next = &mTokens.at(index);
   }
   bool cleanBreak = false;
 
   while (index < size-2)
   {
     // skip any text elements
-    while(next.isText() == true && index < size-1)
+    while(next->isText() == true && index < size-1)
     {
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
 
-    if (next.isEnd() == true)
+    if (next->isEnd() == true)
     {
-      if (next.getName() == container)
+      if (next->getName() == container)
       {
         valid = true;
         break;
       }
-      //else if (!rogueTag.empty() && next.getName() == rogueTag)
+      //else if (!rogueTag.empty() && next->getName() == rogueTag)
       //{
       //  index++;
-      //  next = mTokens.at(index);
+      //  next = &mTokens.at(index);
       //  break;
       //}
     }
     // iterate to first start element
-    while (next.isStart() == false && index < size-1)
+    while (next->isStart() == false && index < size-1)
     {
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
 
-    if (next.isStart() == true && next.isEnd() == true)
+    if (next->isStart() == true && next->isEnd() == true)
     {
       if (qualifier.empty() == true)
       {
@@ -531,7 +531,7 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
       index++;
       if (index < size)
       {
-        next = mTokens.at(index);
+        next = &mTokens.at(index);
         continue;
       }
     }
@@ -544,7 +544,7 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
     }
 
     // record the name of the start element
-    name = next.getName();
+    name = next->getName();
 
     // need to deal with the weird situation where someone has used a tag
     // after the piece but before the next correct element
@@ -556,7 +556,7 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
     //    {
     //      rogueTag = name;
     //      index++;
-    //      next = mTokens.at(index);
+    //      next = &mTokens.at(index);
     //      continue;
     //    }
     //  }
@@ -576,7 +576,7 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
     else
     {
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
 
     // iterate to the end of </name>
@@ -584,12 +584,12 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
     cleanBreak = false;
     while (index < size-1)
     {
-      if (next.isStart() == true && next.getName() == name)
+      if (next->isStart() == true && next->getName() == name)
       {
         depth++;
       }
 
-      if (next.isEnd() == true && next.getName() == name)
+      if (next->isEnd() == true && next->getName() == name)
       {
         if (depth == 0)
         {
@@ -605,7 +605,7 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
       index++;
       if (index < size)
       {
-        next = mTokens.at(index);
+        next = &mTokens.at(index);
       }
     }
 
@@ -613,14 +613,14 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
     index++;
     if (index < size)
     {
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
   }  
 
   // we might have hit the end of the loop and the end of the correct tag
   if (valid == false && cleanBreak == true)
   {
-    if (index >= size-2 && next.isEnd() == true && next.getName() == container)
+    if (index >= size-2 && next->isEnd() == true && next->getName() == container)
     {
         valid = true;
     }
@@ -629,6 +629,25 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
   return numQualifiers;
 }
 
+/*
+ * Returns true if any of the queued tokens from position 'start' on is the
+ * end of an element with the given name.
+ */
+bool
+XMLTokenizer::hasEndElement(const std::string& name, size_t start) const
+{
+  for (size_t index = start; index < mTokens.size(); ++index)
+  {
+    if (mTokens[index].isEnd() && mTokens[index].getName() == name)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
 bool
 XMLTokenizer::containsChild(bool & valid, 
                             const std::string& qualifier, 
@@ -648,19 +667,19 @@ XMLTokenizer::containsChild(bool & valid,
   //unsigned int depth = 0;
   std::string name;
   
-  XMLToken next = mTokens.at(index);
-  name = next.getName();
+  const XMLToken* next = &mTokens.at(index);
+  name = next->getName();
 
   while (index < size-2)
   {
     // skip any text elements
-    while(next.isText() == true && index < size-1)
+    while(next->isText() == true && index < size-1)
     {
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
 
-    if (next.getName() == qualifier)
+    if (next->getName() == qualifier)
     {
       valid = true;
       return true;
@@ -669,7 +688,7 @@ XMLTokenizer::containsChild(bool & valid,
     index++;
     if (index < size)
     {
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
   }  
 
@@ -197,6 +197,12 @@ protected:
   bool containsChild(bool & valid, 
                const std::string& qualifier,  const std::string& container);
 
+  /**
+   * Returns true if any of the queued tokens from position 'start' on is
+   * the end of an element with the given name.
+   */
+  bool hasEndElement(const std::string& name, size_t start) const;
+
   bool mInChars;
   bool mInStart;
   bool mEOFSeen;
@@ -39,7 +39,10 @@
  * also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <cstring>
+
 #include <sbml/xml/XMLTriple.h>
+#include <sbml/xml/XMLStringTable.h>
 #include <sbml/util/util.h>
 #include <sbml/xml/XMLAttributes.h>
 #include <sbml/xml/XMLConstructorException.h>
@@ -55,6 +58,9 @@ LIBSBML_CPP_NAMESPACE_BEGIN
  * Creates a new empty XMLTriple.
  */
 XMLTriple::XMLTriple ()
+ : mName   ( XMLStringTable::intern("", 0) )
+ , mURI    ( mName )
+ , mPrefix ( mName )
 {
 }
 
@@ -65,9 +71,23 @@ XMLTriple::XMLTriple ()
 XMLTriple::XMLTriple (  const std::string&  name
                       , const std::string&  uri
                       , const std::string&  prefix ) 
- : mName   ( name )
- , mURI    ( uri  )
- , mPrefix ( prefix )
+ : mName   ( XMLStringTable::intern(name)   )
+ , mURI    ( XMLStringTable::intern(uri)    )
+ , mPrefix ( XMLStringTable::intern(prefix) )
+{
+}
+
+
+/*
+ * Creates a new XMLTriple with the given null-terminated name, uri and
+ * prefix.
+ */
+XMLTriple::XMLTriple (  const char*  name
+                      , const char*  uri
+                      , const char*  prefix ) 
+ : mName   ( XMLStringTable::intern(name)   )
+ , mURI    ( XMLStringTable::intern(uri)    )
+ , mPrefix ( XMLStringTable::intern(prefix) )
 {
 }
 
@@ -82,31 +102,59 @@ XMLTriple::XMLTriple (  const std::string&  name
  */
 XMLTriple::XMLTriple (const std::string& triplet, const char sepchar)
 { 
+  split(triplet.data(), triplet.size(), sepchar);
+}
+
+
+/*
+ * Creates a new XMLTriple by splitting the null-terminated triplet on
+ * sepchar.
+ */
+XMLTriple::XMLTriple (const char* triplet, const char sepchar)
+{ 
+  split(triplet, (triplet != NULL) ? strlen(triplet) : 0, sepchar);
+}
+
+
+/*
+ * Sets the parts of this XMLTriple from the given triplet.  The parts are
+ * interned straight from triplet, without copying them into temporary
+ * strings first.
+ */
+void
+XMLTriple::split (const char* triplet, size_t length, const char sepchar)
+{
+  const std::string* empty = XMLStringTable::intern("", 0);
+
+  mName   = empty;
+  mURI    = empty;
+  mPrefix = empty;
+
+  if (triplet == NULL) return;
+
+  const char* end   = triplet + length;
+  const char* first = static_cast<const char*>(memchr(triplet, sepchar, length));
+
+  if (first == NULL)
+  {
+    mName = XMLStringTable::intern(triplet, length);
+    return;
+  }
 
-  string::size_type start = 0;
-  string::size_type pos   = triplet.find(sepchar, start);
+  mURI = XMLStringTable::intern(triplet, (size_t)(first - triplet));
 
+  const char* name   = first + 1;
+  const char* second = static_cast<const char*>(
+                         memchr(name, sepchar, (size_t)(end - name)));
 
-  if (pos != string::npos)
+  if (second != NULL)
   {
-    mURI = triplet.substr(start, pos);
-
-    start = pos + 1;
-    pos   = triplet.find(sepchar, start);
-
-    if (pos != string::npos)
-    {
-      mName   = triplet.substr(start, pos - start);
-      mPrefix = triplet.substr(pos + 1);
-    }
-    else
-    {
-      mName = triplet.substr(start);
-    }
+    mName   = XMLStringTable::intern(name, (size_t)(second - name));
+    mPrefix = XMLStringTable::intern(second + 1, (size_t)(end - second - 1));
   }
   else
   {
-    mName = triplet;
+    mName = XMLStringTable::intern(name, (size_t)(end - name));
   }
 }
 
@@ -161,7 +209,7 @@ XMLTriple::clone () const
 const std::string&
 XMLTriple::getName () const
 {
-  return mName;
+  return *mName;
 }
 
 
@@ -171,7 +219,7 @@ XMLTriple::getName () const
 const std::string& 
 XMLTriple::getPrefix () const
 {
-  return mPrefix;
+  return *mPrefix;
 }
 
 
@@ -181,7 +229,7 @@ XMLTriple::getPrefix () const
 const std::string&
 XMLTriple::getURI () const
 {
-  return mURI;
+  return *mURI;
 }
 
 
@@ -191,7 +239,8 @@ XMLTriple::getURI () const
 const std::string 
 XMLTriple::getPrefixedName () const
 {
-  return mPrefix + ((mPrefix != "") ? ":" : "") + mName;
+  if (mPrefix->empty()) return *mName;
+  return *mPrefix + ":" + *mName;
 }
 
 
@@ -215,9 +264,10 @@ XMLTriple::isEmpty () const
  */
 bool operator==(const XMLTriple& lhs, const XMLTriple& rhs)
 {
-  if (lhs.getName()   != rhs.getName()  ) return false;
-  if (lhs.getURI()    != rhs.getURI()   ) return false;
-  if (lhs.getPrefix() != rhs.getPrefix()) return false;
+  // interned strings are equal exactly when they are the same string
+  if (&lhs.getName()   != &rhs.getName()  ) return false;
+  if (&lhs.getURI()    != &rhs.getURI()   ) return false;
+  if (&lhs.getPrefix() != &rhs.getPrefix()) return false;
 
   return true;
 }
@@ -71,6 +71,11 @@
  * of libSBML.  Other objects such as XMLToken make use of XMLTriple
  * objects.
  *
+ * LibSBML keeps a single copy of each distinct name, prefix and URI used
+ * in an XMLTriple, shared by all triples and threads.  These copies are
+ * kept for the life of the process, even after every triple using them
+ * has been deleted.
+ *
  * @see XMLToken
  * @see XMLNode
  * @see XMLAttributes
@@ -113,6 +118,27 @@ public:
              , const std::string&  prefix );
 
 
+#ifndef SWIG
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Creates a new XMLTriple object from null-terminated strings, as
+   * handed over by the XML parsers; a @c NULL pointer is taken as the
+   * empty string.
+   */
+  XMLTriple (  const char*  name
+             , const char*  uri
+             , const char*  prefix );
+
+
+  /**
+   * Creates an XMLTriple object by splitting the null-terminated @p
+   * triplet at @p sepchar, as the constructor taking a string does.
+   */
+  explicit XMLTriple (const char* triplet, const char sepchar = ' ');
+  /** @endcond */
+#endif
+
+
   /**
    * Creates an XMLTriple object by splitting a given string at a given
    * separator character.
@@ -211,9 +237,13 @@ public:
 
 private:
   /** @cond doxygenLibsbmlInternal */
-  std::string  mName;
-  std::string  mURI;
-  std::string  mPrefix;
+  // interned in XMLStringTable; never NULL
+  const std::string*  mName;
+  const std::string*  mURI;
+  const std::string*  mPrefix;
+
+
+  void split (const char* triplet, size_t length, const char sepchar);
 
   /** @endcond */
 };
@@ -82,6 +82,7 @@ XercesAttributes::XercesAttributes (const Attributes& attrs,
     }
   }
 
+  indexNames();
   mElementName = elementName;
 }
 
@@ -55,6 +55,7 @@
 
 #include <sbml/xml/XMLHandler.h>
 #include <sbml/xml/XMLErrorLog.h>
+#include <sbml/xml/XMLMmapBuffer.h>
 
 #include <sbml/xml/XercesTranscode.h>
 #include <sbml/xml/XercesParser.h>
@@ -364,6 +365,7 @@ protected:
 XercesParser::XercesParser (XMLHandler& handler) :
    mReader         ( NULL    )
  , mSource         ( NULL    )
+ , mMapped         ( NULL    )
  , mHandler        ( handler )
 {
   try
@@ -393,6 +395,7 @@ XercesParser::~XercesParser ()
 {
   delete mReader;
   delete mSource;
+  delete mMapped;
   XMLPlatformUtils::Terminate();
 }
 
@@ -412,7 +415,8 @@ XercesParser::createSource (const char* content, bool isFile)
     if (  
           ( string::npos != filename.find(".gz",  filename.length() - 3) ) ||
           ( string::npos != filename.find(".zip", filename.length() - 4) ) ||
-          ( string::npos != filename.find(".bz2", filename.length() - 4) ) 
+          ( string::npos != filename.find(".bz2", filename.length() - 4) ) ||
+          ( string::npos != filename.find(".zst", filename.length() - 4) ) 
        )
     {
       char* xmlstring = NULL;
@@ -433,6 +437,11 @@ XercesParser::createSource (const char* content, bool isFile)
          {
            xmlstring = InputDecompressor::getStringFromZip(filename);
          }
+         // open a zstd file
+         else if ( string::npos != filename.find(".zst", filename.length() - 4) )
+         {
+           xmlstring = InputDecompressor::getStringFromZstd(filename);
+         }
       }
       catch(const char* error)
       {
@@ -457,6 +466,15 @@ XercesParser::createSource (const char* content, bool isFile)
         reportError(XMLFileUnreadable, oss.str(), 0, 0);
         return source;
       }
+      catch ( ZstdNotLinked& )
+      {
+        // libSBML is not linked with zstd.
+        std::ostringstream oss;
+        oss << "Tried to read " << content << ". Reading a zstd file is not enabled because "
+            << "underlying libSBML is not linked with zstd."; 
+        reportError(XMLFileUnreadable, oss.str(), 0, 0);
+        return source;
+      }
  
       if ( xmlstring == NULL || strlen(xmlstring) == 0)
       {
@@ -480,18 +498,48 @@ XercesParser::createSource (const char* content, bool isFile)
     }
     else
     {
-      XMLCh* filename = XMLString::transcode(content);
-
-      try
+      if ( getUseMemoryMap() && mMapped == NULL )
       {
-        source = new LocalFileInputSource(filename);
+        mMapped = new XMLMmapBuffer(filename);
+
+        // Xerces reads the mapping in place; empty files and files that
+        // can't be mapped are left to LocalFileInputSource below
+        if ( mMapped->error() || mMapped->getLength() == 0 )
+        {
+          delete mMapped;
+          mMapped = NULL;
+        }
+        else
+        {
+          const XercesSize_t size  = (XercesSize_t)mMapped->getLength();
+          const XMLByte*     bytes =
+            reinterpret_cast<const XMLByte*>(mMapped->getData());
+
+          try
+          {
+            source = new MemBufInputSource(bytes, size, content, false);
+          }
+          catch (...)
+          {
+          }
+        }
       }
-      catch (const XMLException& )
+
+      if ( source == NULL )
       {
-        reportError(XMLFileUnreadable, content, 0, 0);
+        XMLCh* xfilename = XMLString::transcode(content);
+
+        try
+        {
+          source = new LocalFileInputSource(xfilename);
+        }
+        catch (const XMLException& )
+        {
+          reportError(XMLFileUnreadable, content, 0, 0);
+        }
+
+        XMLString::release(&xfilename);
       }
-
-      XMLString::release(&filename);
     }
   }
   else
@@ -704,6 +752,9 @@ XercesParser::parseReset ()
 
   delete mSource;
   mSource = NULL;
+
+  delete mMapped;
+  mMapped = NULL;
 }
 
 LIBSBML_CPP_NAMESPACE_END
@@ -57,6 +57,7 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 
 class SAX2XMLReader;
 class XMLHandler;
+class XMLMmapBuffer;
 
 
 class XercesParser : public XMLParser
@@ -157,6 +158,7 @@ protected:
 
   xercesc::SAX2XMLReader*  mReader;
   xercesc::InputSource*    mSource;
+  XMLMmapBuffer*           mMapped;
   xercesc::XMLPScanToken   mToken;
   XercesHandler            mHandler;
 
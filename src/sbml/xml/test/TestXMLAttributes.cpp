@@ -42,6 +42,7 @@
 #include <limits>
 
 #include <iostream>
+#include <sstream>
 #include <check.h>
 #include <XMLAttributes.h>
 #include <string>
@@ -365,6 +366,60 @@ START_TEST(test_XMLAttributes_add_removeResource)
 }
 END_TEST
 
+START_TEST(test_XMLAttributes_wide)
+{
+  XMLAttributes attrs;
+
+  // enough attributes for the lookups to go through the name index
+  for (int n = 0; n < 40; ++n)
+  {
+    ostringstream name;
+    name << "attr" << n;
+    attrs.add(name.str(), name.str() + "_value");
+  }
+
+  attrs.add("attr7", "other", "http://foo.org/", "foo");
+  attrs.addResource("attr3", "again");
+
+  fail_unless( attrs.getLength() == 42 );
+
+  fail_unless( attrs.getIndex("attr0" ) ==  0 );
+  fail_unless( attrs.getIndex("attr39") == 39 );
+  fail_unless( attrs.getIndex("attr40") == -1 );
+  fail_unless( attrs.getValue("attr21") == "attr21_value" );
+
+  // the first attribute of a given name is found, as for short sets
+  fail_unless( attrs.getIndex("attr7") ==  7 );
+  fail_unless( attrs.getIndex("attr3") ==  3 );
+  fail_unless( attrs.getIndex("attr7", "http://foo.org/") == 40 );
+  fail_unless( attrs.getIndex("attr7", "http://bar.org/") == -1 );
+  fail_unless( attrs.getIndex(XMLTriple("attr7", "http://foo.org/", "foo")) == 40 );
+  fail_unless( attrs.getIndex(XMLTriple("attr7", "http://foo.org/", "")) == -1 );
+
+  attrs.remove(7);
+  fail_unless( attrs.getLength() == 41 );
+  fail_unless( attrs.getIndex("attr7" ) == 39 );
+  fail_unless( attrs.getIndex("attr8" ) ==  7 );
+  fail_unless( attrs.getIndex("attr39") == 38 );
+
+  XMLAttributes copy(attrs);
+  fail_unless( copy.getIndex("attr39") == 38 );
+  fail_unless( copy.getValue("attr3" ) == "attr3_value" );
+
+  int value = 0;
+  copy.add("count", "42");
+  fail_unless( copy.readInto("count", value) == true );
+  fail_unless( value == 42 );
+
+  attrs.clear();
+  fail_unless( attrs.getIndex("attr0") == -1 );
+
+  attrs.add("attr0", "value");
+  fail_unless( attrs.getIndex("attr0") == 0 );
+}
+END_TEST
+
+
 
 Suite *
 create_suite_XMLAttributes (void)
@@ -381,6 +436,7 @@ create_suite_XMLAttributes (void)
   tcase_add_test( tcase, test_XMLAttributes_assignment      );
   tcase_add_test( tcase, test_XMLAttributes_clone           );
   tcase_add_test( tcase, test_XMLAttributes_add_removeResource);
+  tcase_add_test( tcase, test_XMLAttributes_wide              );
 
   suite_add_tcase(suite, tcase);
 
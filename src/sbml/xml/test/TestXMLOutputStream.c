@@ -178,6 +178,39 @@ START_TEST (test_XMLOutputStream_Elements)
 }
 END_TEST
 
+START_TEST (test_XMLOutputStream_Numbers)
+{
+  XMLOutputStream_t *stream = XMLOutputStream_createAsString("", 0);
+  XMLOutputStream_startElement(stream, "fred");
+  XMLOutputStream_writeAttributeDouble(stream, "a", 0.1);
+  XMLOutputStream_writeAttributeDouble(stream, "b", 0.1 + 0.2);
+  XMLOutputStream_writeAttributeDouble(stream, "c", 100000.0);
+  XMLOutputStream_writeAttributeDouble(stream, "d", 1e-05);
+  XMLOutputStream_writeAttributeDouble(stream, "e", -0.000123);
+  XMLOutputStream_writeAttributeDouble(stream, "f", 1e15);
+  XMLOutputStream_writeAttributeDouble(stream, "g", 1.7976931348623157e308);
+  XMLOutputStream_writeAttributeDouble(stream, "h", util_NaN());
+  XMLOutputStream_writeAttributeDouble(stream, "i", util_NegInf());
+  XMLOutputStream_writeAttributeLong(stream, "j", -2147483647L - 1);
+  XMLOutputStream_writeAttributeUInt(stream, "k", 4294967295U);
+  XMLOutputStream_writeAttributeInt(stream, "l", 0);
+  XMLOutputStream_endElement(stream, "fred");
+
+  const char * expected = "<fred a=\"0.1\" b=\"0.30000000000000004\" "
+    "c=\"100000\" d=\"1e-05\" e=\"-0.000123\" f=\"1e+15\" "
+    "g=\"1.7976931348623157e+308\" h=\"NaN\" i=\"-INF\" "
+    "j=\"-2147483648\" k=\"4294967295\" l=\"0\"/>";
+  const char * s = XMLOutputStream_getString(stream);
+
+  fail_unless(!strcmp(s,expected));
+  
+  safe_free((void*)(s));
+
+  XMLOutputStream_free(stream);
+}
+END_TEST
+
+
 START_TEST (test_XMLOutputStream_CharacterReference)
 {
   XMLOutputStream_t *stream = XMLOutputStream_createAsString("", 0);
@@ -300,6 +333,7 @@ create_suite_XMLOutputStream (void)
   tcase_add_test( tcase, test_XMLOutputStream_createStringWithProgramInfo  );
   tcase_add_test( tcase, test_XMLOutputStream_startEnd  );
   tcase_add_test( tcase, test_XMLOutputStream_Elements  );
+  tcase_add_test( tcase, test_XMLOutputStream_Numbers  );
   tcase_add_test( tcase, test_XMLOutputStream_CharacterReference );
   tcase_add_test( tcase, test_XMLOutputStream_PredefinedEntity );
 
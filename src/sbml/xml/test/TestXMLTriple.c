@@ -118,6 +118,31 @@ START_TEST (test_XMLTriple_comparison)
 }
 END_TEST
 
+START_TEST (test_XMLTriple_sharedStrings)
+{
+  XMLTriple_t *t1 = XMLTriple_createWith("attr", "uri", "prefix");
+  XMLTriple_t *t2 = XMLTriple_createWith("attr", "uri", "prefix");
+  XMLTriple_t *t3 = XMLTriple_clone(t1);
+
+  fail_unless( XMLTriple_getName(t1)   == XMLTriple_getName(t2)   );
+  fail_unless( XMLTriple_getURI(t1)    == XMLTriple_getURI(t2)    );
+  fail_unless( XMLTriple_getPrefix(t1) == XMLTriple_getPrefix(t2) );
+  fail_unless( XMLTriple_getName(t1)   == XMLTriple_getName(t3)   );
+
+  XMLTriple_free(t3);
+  t3 = XMLTriple_createWith("attr2", "uri", "prefix");
+
+  fail_unless( XMLTriple_getName(t1) != XMLTriple_getName(t3) );
+  fail_unless( strcmp(XMLTriple_getName(t3), "attr2") == 0 );
+  fail_unless( XMLTriple_getURI(t1)  == XMLTriple_getURI(t3)  );
+
+  XMLTriple_free(t1);
+  XMLTriple_free(t2);
+  XMLTriple_free(t3);
+}
+END_TEST
+
+
 START_TEST (test_XMLTriple_accessWithNULL)
 {
   XMLTriple_t * temp = XMLTriple_create();
@@ -148,6 +173,7 @@ create_suite_XMLTriple (void)
 
   tcase_add_test( tcase, test_XMLTriple_create  );
   tcase_add_test( tcase, test_XMLTriple_comparison );
+  tcase_add_test( tcase, test_XMLTriple_sharedStrings );
   tcase_add_test( tcase, test_XMLTriple_accessWithNULL );
   
   suite_add_tcase(suite, tcase);